@@ -0,0 +1,107 @@
+#pragma once
+
+#include <LabyrinthGraph.hpp>
+
+/* @brief Compiled, read-only representation of a valid labyrinth graph.
+ * Segments, connections and junctions are referred to by their dense indices (@see Segment::idx, Connection::idx, Junction::idx).
+ * The connections of each segment are stored in a contiguous range of a flat array (compressed sparse row format),
+ * and junction side orientations are quantized to 0..3 (@see JunctionTopology::side),
+ * so that navigation does not need to chase pointers or to search maps with angular tolerance.
+ * @note The graph needs to be recompiled whenever the source graph changes.
+ */
+class CompiledLabyrinthGraph {
+public:
+    typedef uint8_t index_t;
+
+    static constexpr index_t INVALID_INDEX          = 0xff;
+    static constexpr uint32_t MAX_NUM_SEGMENTS      = cfg::MAX_NUM_LABYRINTH_SEGMENTS;
+    static constexpr uint32_t MAX_NUM_JUNCTIONS     = cfg::MAX_NUM_LABYRINTH_SEGMENTS;
+    static constexpr uint32_t MAX_NUM_CONNECTIONS   = 2 * cfg::MAX_NUM_LABYRINTH_SEGMENTS;
+    static constexpr uint8_t NUM_SIDES              = 4;
+    static constexpr uint8_t NUM_DIRECTIONS         = 3;
+
+    struct SegmentInfo {
+        micro::meter_t length;  // The segment length.
+        index_t firstEdge;      // Index of the first connection of the segment in the edge array.
+        index_t numEdges;       // Number of connections of the segment.
+        char name;
+        bool isDeadEnd;
+    };
+
+    struct ConnectionInfo {
+        index_t segments[2];            // The connected segments, in the order of Connection::node1 and Connection::node2.
+        index_t junction;               // The junction of the connection.
+        uint8_t sides[2];               // The quantized orientations of the junction decisions of the segments.
+        micro::Direction directions[2]; // The directions of the junction decisions of the segments.
+    };
+
+    /* @brief Contiguous range of connection indices.
+     */
+    struct EdgeRange {
+        const index_t *first;
+        const index_t *last;
+
+        const index_t* begin() const { return this->first; }
+        const index_t* end() const { return this->last; }
+        uint32_t size() const { return static_cast<uint32_t>(this->last - this->first); }
+    };
+
+    CompiledLabyrinthGraph();
+
+    /* @brief Compiles the graph.
+     * @param graph The source graph - must outlive the compiled graph.
+     * @returns Status::INVALID_DATA if the graph is invalid or exceeds the capacity, Status::OK otherwise.
+     */
+    micro::Status compile(const LabyrinthGraph& graph);
+
+    bool isCompiled() const { return nullptr != this->source_; }
+
+    const LabyrinthGraph& source() const { return *this->source_; }
+
+    uint32_t numSegments() const { return this->numSegments_; }
+    uint32_t numConnections() const { return this->numConnections_; }
+    uint32_t numJunctions() const { return this->numJunctions_; }
+
+    const SegmentInfo& segment(const index_t seg) const { return this->segments_[seg]; }
+    const ConnectionInfo& connection(const index_t conn) const { return this->connections_[conn]; }
+
+    EdgeRange edges(const index_t seg) const {
+        const index_t *first = &this->edges_[this->segments_[seg].firstEdge];
+        return { first, first + this->segments_[seg].numEdges };
+    }
+
+    index_t findSegment(char name) const;
+
+    index_t findConnection(const index_t seg1, const index_t seg2) const;
+
+    index_t getOtherSegment(const index_t conn, const index_t seg) const;
+
+    index_t getJunctionSegment(const index_t junc, const uint8_t side, const micro::Direction dir) const;
+
+    bool isConnected(const index_t junc, const index_t seg) const;
+
+    /* @brief Checks if the new connection does not lead back through the decision the segment was approached through.
+     * @see LabyrinthRoute::isForwardConnection
+     */
+    bool isForwardConnection(const index_t prevConn, const index_t seg, const index_t newConn) const;
+
+    /* @brief Calculates the route cost of stepping through the new connection.
+     * @see LabyrinthRoute::connectionCost
+     */
+    micro::meter_t connectionCost(const index_t prevConn, const index_t seg, const index_t newConn, const bool isStartSeg, const bool allowBackwardNavigation) const;
+
+private:
+    static uint8_t directionIndex(const micro::Direction dir);
+
+    uint8_t decisionIndex(const index_t conn, const index_t seg) const;
+
+    const LabyrinthGraph *source_;
+    SegmentInfo segments_[MAX_NUM_SEGMENTS];
+    ConnectionInfo connections_[MAX_NUM_CONNECTIONS];
+    index_t edges_[2 * MAX_NUM_CONNECTIONS];                                    // Connection indices of the segments, grouped by segment.
+    index_t junctionSegments_[MAX_NUM_JUNCTIONS][NUM_SIDES][NUM_DIRECTIONS];    // Segment indices of the junction sides.
+    index_t segmentsByName_['Z' - 'A' + 1];                                     // Segment indices by name.
+    uint8_t numSegments_;
+    uint8_t numConnections_;
+    uint8_t numJunctions_;
+};
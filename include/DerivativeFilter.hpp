@@ -0,0 +1,67 @@
+#pragma once
+
+#include <micro/utils/units.hpp>
+
+/* @brief Estimates the derivative of a noisy signal with an alpha-beta tracker.
+ * The tracker predicts the next value from the current value and rate estimates, and corrects both with the prediction error.
+ * It follows a constant-rate signal without lag, while smoothing the measurement noise - as opposed to a backward difference,
+ * whose group delay is half of its window.
+ * The measurements do not need to be evenly spaced: each update takes the time elapsed since the previous measurement,
+ * and the rate is given in units per second.
+ * @note The state is constant size: the value and rate estimates.
+ * @tparam T The signal type
+ */
+template <typename T>
+class DerivativeFilter {
+public:
+    /* @brief Constructor.
+     * @param alpha The value correction gain, in range (0, 1] - the higher it is, the faster the filter reacts to changes
+     * @param beta The rate correction gain, in range (0, 2) - @see criticalBeta()
+     */
+    DerivativeFilter(const float alpha, const float beta)
+        : alpha(alpha)
+        , beta(beta)
+        , value_()
+        , rate_()
+        , isInitialized_(false) {}
+
+    /* @brief Gets the rate correction gain that makes the tracker critically damped for the given value correction gain.
+     */
+    static constexpr float criticalBeta(const float alpha) { return alpha * alpha / (2.0f - alpha); }
+
+    /* @brief Updates the estimates with the new measurement.
+     * @param measured The new value of the signal
+     * @param dt The time elapsed since the previous measurement - if it is not positive, the estimates are not updated
+     * @returns The estimated derivative, in units per second
+     */
+    const T& update(const T& measured, const micro::second_t dt) {
+        if (this->isInitialized_) {
+            if (dt > micro::second_t(0)) {
+                const T predicted = this->value_ + this->rate_ * dt.get();
+                const T residual  = measured - predicted;
+                this->value_ = predicted + residual * this->alpha;
+                this->rate_ += residual * (this->beta / dt.get());
+            }
+        } else {
+            this->value_ = measured;
+            this->rate_ = T();
+            this->isInitialized_ = true;
+        }
+        return this->rate_;
+    }
+
+    /* @brief Restarts the estimation from the next measurement - needed when the signal jumps, e.g. when the controlled line is changed.
+     */
+    void reset() { this->isInitialized_ = false; }
+
+    const T& value() const { return this->value_; }
+    const T& rate() const { return this->rate_; } // The estimated derivative, in units per second.
+
+    float alpha;
+    float beta;
+
+private:
+    T value_;
+    T rate_;    // Rate estimate, in units per second.
+    bool isInitialized_;
+};
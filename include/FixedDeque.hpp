@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+/* @brief Fixed-capacity double-ended queue, stored in a ring buffer.
+ * Pushing and popping at both ends take O(1) time, the elements are never shifted.
+ * Pushing to a full queue is ignored, as in case of micro::vec.
+ */
+template <typename T, uint32_t N>
+class FixedDeque {
+public:
+    typedef T value_type;
+
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator(const FixedDeque& deque, const uint32_t idx)
+            : deque_(&deque)
+            , idx_(idx) {}
+
+        reference operator*() const { return (*this->deque_)[this->idx_]; }
+        pointer operator->() const { return &(*this->deque_)[this->idx_]; }
+
+        const_iterator& operator++() {
+            ++this->idx_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator result = *this;
+            ++this->idx_;
+            return result;
+        }
+
+        bool operator==(const const_iterator& other) const { return this->idx_ == other.idx_; }
+        bool operator!=(const const_iterator& other) const { return this->idx_ != other.idx_; }
+
+    private:
+        const FixedDeque *deque_;
+        uint32_t idx_;
+    };
+
+    FixedDeque()
+        : head_(0)
+        , size_(0) {}
+
+    static constexpr uint32_t capacity() { return N; }
+
+    uint32_t size() const { return this->size_; }
+
+    bool empty() const { return 0 == this->size_; }
+
+    bool full() const { return N == this->size_; }
+
+    const T& operator[](const uint32_t idx) const { return this->items_[this->position(idx)]; }
+    T& operator[](const uint32_t idx) { return this->items_[this->position(idx)]; }
+
+    const T& front() const { return this->items_[this->head_]; }
+    const T& back() const { return this->items_[this->position(this->size_ - 1)]; }
+
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, this->size_); }
+
+    bool push_back(const T& value) {
+        if (this->full()) {
+            return false;
+        }
+        this->items_[this->position(this->size_++)] = value;
+        return true;
+    }
+
+    bool push_front(const T& value) {
+        if (this->full()) {
+            return false;
+        }
+        this->head_ = 0 == this->head_ ? N - 1 : this->head_ - 1;
+        this->items_[this->head_] = value;
+        ++this->size_;
+        return true;
+    }
+
+    void pop_front() {
+        if (this->size_) {
+            this->head_ = this->position(1);
+            --this->size_;
+        }
+    }
+
+    void pop_back() {
+        if (this->size_) {
+            --this->size_;
+        }
+    }
+
+    void clear() {
+        this->head_ = 0;
+        this->size_ = 0;
+    }
+
+private:
+    uint32_t position(const uint32_t idx) const {
+        // the index is always less than 2N, so the wrap-around does not need a division
+        const uint32_t pos = this->head_ + idx;
+        return pos >= N ? pos - N : pos;
+    }
+
+    T items_[N];
+    uint32_t head_;
+    uint32_t size_;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <micro/container/vec.hpp>
+#include <micro/control/PID_Controller.hpp>
+#include <micro/utils/units.hpp>
+
+#include <utility>
+
+/* @brief Speed-dependent PID gains, compiled from a table of breakpoints into a uniformly sampled lookup table.
+ * The breakpoints are linearly interpolated when the table is compiled, so a lookup only takes an index calculation.
+ * The first sample is one step above zero speed, and the lower speeds are clamped to it - so that the car is not left
+ * without gains at low speeds, when the standstill breakpoint has zero gains.
+ * The breakpoints may be edited at runtime (e.g. through Params, @see GainScheduleEditor), the changes are applied by compile().
+ * @note The breakpoints are kept in a plain list instead of a sorted map, so they do not need to be sorted,
+ *       and an edited breakpoint speed may move past its neighbours.
+ */
+class GainSchedule {
+public:
+    static constexpr uint32_t MAX_BREAKPOINTS = 20;
+    static constexpr uint32_t NUM_SAMPLES     = 64;
+
+    typedef std::pair<micro::m_per_sec_t, micro::PID_Params> Breakpoint;
+    typedef micro::vec<Breakpoint, MAX_BREAKPOINTS> Breakpoints;
+
+    explicit GainSchedule(const Breakpoints& breakpoints);
+
+    /* @brief Samples the breakpoints uniformly up to the highest breakpoint speed.
+     * @returns True if the samples have changed
+     */
+    bool compile();
+
+    /* @brief Selects the sample closest to the given speed, or the first sample for lower speeds.
+     * @returns True if the selected gains have changed since the previous update, and the controller needs to be retuned
+     */
+    bool update(const micro::m_per_sec_t speed);
+
+    const micro::PID_Params& params() const { return this->samples_[this->sampleIdx_]; }
+
+private:
+    micro::PID_Params interpolate(const micro::m_per_sec_t speed) const;
+
+    const Breakpoints& breakpoints_;
+    micro::PID_Params samples_[NUM_SAMPLES];
+    micro::m_per_sec_t step_;   // Speed difference between neighbouring samples.
+    uint32_t sampleIdx_;
+    bool hasChanged_;           // Indicates that the samples have changed since the previous update.
+};
+
+/* @brief Exposes one breakpoint of a gain schedule at a time, so that the number of registered params does not depend on the number of breakpoints.
+ * The selected index and the values of the selected breakpoint are registered as params.
+ * When the params have been received, apply() either loads the newly selected breakpoint, or writes the edited values into the selected one.
+ */
+class GainScheduleEditor {
+public:
+    explicit GainScheduleEditor(GainSchedule::Breakpoints& breakpoints);
+
+    /* @brief Applies the received params.
+     * @returns True if the selected breakpoint has been edited, and the schedule needs to be recompiled
+     */
+    bool apply();
+
+    uint32_t index;             // Index of the selected breakpoint.
+    micro::m_per_sec_t speed;   // Speed of the selected breakpoint.
+    micro::PID_Params gains;    // Gains of the selected breakpoint.
+
+private:
+    void load();
+
+    GainSchedule::Breakpoints& breakpoints_;
+    uint32_t loadedIndex_;      // Index of the breakpoint whose values are exposed.
+};
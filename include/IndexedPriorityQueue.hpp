@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+/* @brief Fixed-capacity binary min-heap of dense integer keys, supporting priority decrease.
+ * Keys must be in the range [0, N). The heap position of every key is stored,
+ * so that updating the priority of a queued key takes O(log N) time.
+ * Keys of equal priorities are popped in the order of their last push.
+ */
+template <typename T, uint32_t N>
+class IndexedPriorityQueue {
+public:
+    typedef uint16_t key_type;
+
+    static_assert(N < 0xffff, "IndexedPriorityQueue capacity is limited by key_type");
+
+    IndexedPriorityQueue() {
+        this->clear();
+    }
+
+    uint32_t size() const {
+        return this->size_;
+    }
+
+    bool empty() const {
+        return 0 == this->size_;
+    }
+
+    bool contains(const key_type key) const {
+        return INVALID_POS != this->positions_[key];
+    }
+
+    void clear() {
+        this->size_ = 0;
+        this->sequence_ = 0;
+        std::fill(this->positions_, this->positions_ + N, INVALID_POS);
+    }
+
+    /* @brief Inserts key with the given priority, or updates its priority if the key is already in the queue.
+     * @param key The key.
+     * @param priority The priority of the key.
+     */
+    void push(const key_type key, const T& priority) {
+        this->sequences_[key] = this->sequence_++;
+
+        if (this->contains(key)) {
+            const bool isDecreased = priority < this->priorities_[key];
+            this->priorities_[key] = priority;
+            if (isDecreased) {
+                this->siftUp(this->positions_[key]);
+            } else {
+                this->siftDown(this->positions_[key]);
+            }
+        } else {
+            this->priorities_[key] = priority;
+            this->heap_[this->size_] = key;
+            this->positions_[key] = this->size_;
+            this->siftUp(this->size_++);
+        }
+    }
+
+    /* @brief Gets the key with the lowest priority.
+     * @note The queue must not be empty.
+     */
+    key_type top() const {
+        return this->heap_[0];
+    }
+
+    /* @brief Gets the priority of a queued key.
+     * @param key The key.
+     */
+    const T& priority(const key_type key) const {
+        return this->priorities_[key];
+    }
+
+    /* @brief Removes the key from the queue, if present.
+     * @param key The key.
+     */
+    void remove(const key_type key) {
+        if (this->contains(key)) {
+            const key_type pos = this->positions_[key];
+            this->swap(pos, --this->size_);
+            this->positions_[key] = INVALID_POS;
+            if (pos < this->size_) {
+                this->siftUp(pos);
+                this->siftDown(pos);
+            }
+        }
+    }
+
+    /* @brief Removes the key with the lowest priority.
+     * @note The queue must not be empty.
+     * @returns The removed key.
+     */
+    key_type pop() {
+        const key_type key = this->heap_[0];
+        this->swap(0, --this->size_);
+        this->positions_[key] = INVALID_POS;
+        this->siftDown(0);
+        return key;
+    }
+
+private:
+    static constexpr key_type INVALID_POS = 0xffff;
+
+    bool less(const key_type pos1, const key_type pos2) const {
+        const key_type key1 = this->heap_[pos1], key2 = this->heap_[pos2];
+        return this->priorities_[key1] < this->priorities_[key2] ||
+            (!(this->priorities_[key2] < this->priorities_[key1]) && this->sequences_[key1] < this->sequences_[key2]);
+    }
+
+    void swap(const key_type pos1, const key_type pos2) {
+        std::swap(this->heap_[pos1], this->heap_[pos2]);
+        this->positions_[this->heap_[pos1]] = pos1;
+        this->positions_[this->heap_[pos2]] = pos2;
+    }
+
+    void siftUp(key_type pos) {
+        while (pos > 0) {
+            const key_type parent = (pos - 1) / 2;
+            if (!this->less(pos, parent)) {
+                break;
+            }
+            this->swap(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void siftDown(key_type pos) {
+        while (true) {
+            const uint32_t left  = 2 * pos + 1;
+            const uint32_t right = left + 1;
+            key_type smallest    = pos;
+
+            if (left < this->size_ && this->less(left, smallest)) {
+                smallest = left;
+            }
+            if (right < this->size_ && this->less(right, smallest)) {
+                smallest = right;
+            }
+            if (smallest == pos) {
+                break;
+            }
+            this->swap(pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    key_type heap_[N];      // The keys, ordered as a binary heap.
+    key_type positions_[N]; // The heap positions of the keys.
+    T priorities_[N];       // The priorities of the keys.
+    uint32_t sequences_[N]; // The push sequence numbers of the keys, used for ordering keys of equal priorities.
+    uint32_t size_;         // The number of keys in the queue.
+    uint32_t sequence_;     // The next push sequence number.
+};
+
+template <typename T, uint32_t N>
+constexpr typename IndexedPriorityQueue<T, N>::key_type IndexedPriorityQueue<T, N>::INVALID_POS;
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <micro/utils/point2.hpp>
+#include <micro/utils/units.hpp>
+
+#include <cfg_track.hpp>
+
+#include <cstdint>
+
+/* @brief Compile-time description of a labyrinth segment.
+ */
+struct SegmentDescription {
+    char name;
+    uint16_t length;    // The segment length [cm].
+    bool isDeadEnd;
+};
+
+/* @brief Compile-time description of a labyrinth junction.
+ */
+struct JunctionDescription {
+    uint8_t id;
+    int16_t x;          // Junction position X coordinate - relative to car start position [cm].
+    int16_t y;          // Junction position Y coordinate - relative to car start position [cm].
+};
+
+/* @brief Compile-time description of a segment connected to a junction, @see LabyrinthGraph::connect
+ */
+struct DecisionDescription {
+    char segment;
+    uint8_t junction;           // The junction id.
+    int16_t orientation;        // The junction decision orientation [deg] - must be a multiple of 90.
+    micro::Direction direction; // The junction decision direction.
+};
+
+/* @brief Compile-time description of a labyrinth segment connection.
+ */
+struct ConnectionDescription {
+    uint8_t segment1  = 0;  // Index of the first segment.
+    uint8_t segment2  = 0;  // Index of the second segment.
+    uint8_t junction  = 0;  // Index of the junction.
+    uint8_t decision1 = 0;  // Index of the decision of the first segment.
+    uint8_t decision2 = 0;  // Index of the decision of the second segment.
+};
+
+/* @brief Connection list of a labyrinth description, computed at compile time.
+ */
+struct LabyrinthConnections {
+    static constexpr uint32_t CAPACITY = 2 * cfg::MAX_NUM_LABYRINTH_SEGMENTS;
+
+    ConnectionDescription items[CAPACITY] = {};
+    uint32_t size = 0;
+    bool isOverflown = false;   // Indicates that the description has more connections than the capacity.
+};
+
+/* @brief Compile-time labyrinth description.
+ * Describes the segments, junctions and junction decisions of a labyrinth in constexpr tables,
+ * so that the connection list and the validity of the graph are computed by the compiler.
+ * @see LabyrinthGraph::build
+ */
+struct LabyrinthDescription {
+    static constexpr uint8_t INVALID_INDEX = 0xff;
+
+    const SegmentDescription *segments;
+    uint32_t numSegments;
+    const JunctionDescription *junctions;
+    uint32_t numJunctions;
+    const DecisionDescription *decisions;
+    uint32_t numDecisions;
+
+    constexpr uint8_t segmentIndex(const char name) const {
+        for (uint32_t i = 0; i < this->numSegments; ++i) {
+            if (this->segments[i].name == name) {
+                return static_cast<uint8_t>(i);
+            }
+        }
+        return INVALID_INDEX;
+    }
+
+    constexpr uint8_t junctionIndex(const uint8_t id) const {
+        for (uint32_t i = 0; i < this->numJunctions; ++i) {
+            if (this->junctions[i].id == id) {
+                return static_cast<uint8_t>(i);
+            }
+        }
+        return INVALID_INDEX;
+    }
+
+    /* @brief Creates the connection list the same way as LabyrinthGraph::connect does:
+     * every decision is connected to all previous decisions of the opposite side of the same junction.
+     */
+    constexpr LabyrinthConnections connections() const {
+        LabyrinthConnections result;
+
+        for (uint32_t i = 0; i < this->numDecisions; ++i) {
+            const DecisionDescription& decision = this->decisions[i];
+
+            for (uint32_t j = 0; j < i; ++j) {
+                const DecisionDescription& other = this->decisions[j];
+
+                if (other.junction == decision.junction && normalize(other.orientation) == normalize(decision.orientation + 180)) {
+                    if (result.size == LabyrinthConnections::CAPACITY) {
+                        result.isOverflown = true;
+                        return result;
+                    }
+
+                    ConnectionDescription& conn = result.items[result.size++];
+                    conn.segment1  = this->segmentIndex(decision.segment);
+                    conn.segment2  = this->segmentIndex(other.segment);
+                    conn.junction  = this->junctionIndex(decision.junction);
+                    conn.decision1 = static_cast<uint8_t>(i);
+                    conn.decision2 = static_cast<uint8_t>(j);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /* @brief Checks if the description results in a valid graph, with the same rules as LabyrinthGraph::valid.
+     */
+    constexpr bool isValid() const {
+        if (this->numSegments > cfg::MAX_NUM_LABYRINTH_SEGMENTS || this->numJunctions > cfg::MAX_NUM_LABYRINTH_SEGMENTS) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < this->numSegments; ++i) {
+            const SegmentDescription& seg = this->segments[i];
+            if (seg.name < 'A' || seg.name > 'Z' || 0 == seg.length || this->segmentIndex(seg.name) != i) {
+                return false;
+            }
+        }
+
+        for (uint32_t i = 0; i < this->numJunctions; ++i) {
+            if (this->junctionIndex(this->junctions[i].id) != i) {
+                return false;
+            }
+        }
+
+        for (uint32_t i = 0; i < this->numDecisions; ++i) {
+            const DecisionDescription& decision = this->decisions[i];
+            if (INVALID_INDEX == this->segmentIndex(decision.segment) ||
+                INVALID_INDEX == this->junctionIndex(decision.junction) ||
+                0 != decision.orientation % 90) {
+                return false;
+            }
+
+            // a junction side may only have one segment in each direction
+            for (uint32_t j = 0; j < i; ++j) {
+                const DecisionDescription& other = this->decisions[j];
+                if (other.junction == decision.junction && normalize(other.orientation) == normalize(decision.orientation) && other.direction == decision.direction) {
+                    return false;
+                }
+            }
+        }
+
+        const LabyrinthConnections connections = this->connections();
+        if (connections.isOverflown) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < this->numSegments; ++i) {
+            const char name = this->segments[i].name;
+            const bool isDeadEnd = this->segments[i].isDeadEnd;
+
+            // the junction of the first connection of the segment, and the number of different junctions the segment is connected through
+            uint8_t firstJunction = INVALID_INDEX;
+            uint8_t junctions[2] = { INVALID_INDEX, INVALID_INDEX };
+            uint32_t numJunctions = 0;
+
+            for (uint32_t c = 0; c < connections.size; ++c) {
+                const ConnectionDescription& conn = connections.items[c];
+                if (conn.segment1 == i || conn.segment2 == i) {
+                    if (INVALID_INDEX == firstJunction) {
+                        firstJunction = conn.junction;
+                    }
+                    if (conn.junction != junctions[0] && conn.junction != junctions[1]) {
+                        if (numJunctions == 2) {
+                            return false;
+                        }
+                        junctions[numJunctions++] = conn.junction;
+                    }
+                }
+            }
+
+            uint32_t occurences = 0, firstJunctionOccurences = 0;
+            for (uint32_t d = 0; d < this->numDecisions; ++d) {
+                if (this->decisions[d].segment == name) {
+                    ++occurences;
+                    if (this->junctionIndex(this->decisions[d].junction) == firstJunction) {
+                        ++firstJunctionOccurences;
+                    }
+                }
+            }
+
+            const bool isLoop     = INVALID_INDEX != firstJunction && 2 == firstJunctionOccurences;
+            const bool isFloating = !isDeadEnd && numJunctions < 2 && !isLoop;
+
+            if (isFloating || numJunctions != (isDeadEnd || isLoop ? 1u : 2u) || occurences != (isDeadEnd ? 1u : 2u)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static constexpr int16_t normalize(const int16_t orientation) {
+        return static_cast<int16_t>((orientation % 360 + 360) % 360);
+    }
+};
+
+/* @brief Creates a labyrinth description from constexpr tables.
+ */
+template <uint32_t NS, uint32_t NJ, uint32_t ND>
+constexpr LabyrinthDescription describeLabyrinth(const SegmentDescription (&segments)[NS], const JunctionDescription (&junctions)[NJ], const DecisionDescription (&decisions)[ND]) {
+    return LabyrinthDescription{ segments, NS, junctions, NJ, decisions, ND };
+}
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <micro/math/unit_utils.hpp>
 #include <micro/utils/point2.hpp>
 #include <micro/utils/units.hpp>
 #include <micro/container/map.hpp>
 #include <micro/container/vec.hpp>
 
 #include <Graph.hpp>
+#include <LabyrinthDescription.hpp>
 #include <cfg_track.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <utility>
 
 struct JunctionDecision {
     micro::radian_t orientation;
@@ -31,6 +35,29 @@ struct JunctionDecision {
     }
 };
 
+/* @brief Number of junction segments per side, indexed by the side orientation rounded to 90 degrees.
+ */
+struct JunctionTopology {
+    uint8_t numSegments[4] = { 0, 0, 0, 0 };
+
+    static uint8_t side(const micro::radian_t orientation) {
+        return static_cast<uint8_t>(std::lround(micro::normalize360(orientation).get() / micro::PI_2.get()) % 4);
+    }
+
+    /* @brief Checks if the junction has exactly the given number of segments on the given sides.
+     * @note A side without any segments never matches.
+     */
+    bool matches(const micro::vec<std::pair<micro::radian_t, uint8_t>, 2>& sideSegments) const {
+        for (const std::pair<micro::radian_t, uint8_t>& numSegs : sideSegments) {
+            const uint8_t n = this->numSegments[side(numSegs.first)];
+            if (0 == n || n != numSegs.second) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
 struct Junction;
 struct Segment;
 
@@ -39,12 +66,14 @@ struct Segment;
 struct Connection : public Edge<Segment> {
     Connection(Segment& seg1, Segment& seg2, Junction& junction, const JunctionDecision& decision1, const JunctionDecision& decision2)
         : Edge(seg1, seg2)
+        , idx(0)
         , junction(&junction)
         , decision1(decision1)
         , decision2(decision2) {}
 
     Connection()
         : Edge()
+        , idx(0)
         , junction(nullptr)
         , decision1()
         , decision2() {}
@@ -53,6 +82,7 @@ struct Connection : public Edge<Segment> {
 
     JunctionDecision getDecision(const Segment& seg) const;
 
+    uint16_t idx;       // Dense index of the connection in the graph.
     Junction *junction;
     JunctionDecision decision1, decision2;
 };
@@ -65,7 +95,8 @@ struct Junction {
     typedef micro::vec<std::pair<micro::radian_t, micro::Direction>, 2> segment_info;
 
     Junction(uint8_t id, const micro::point2<micro::meter_t>& pos)
-        : id(id)
+        : idx(0)
+        , id(id)
         , pos(pos) {}
 
     Junction() : Junction(0, {}) {}
@@ -80,6 +111,9 @@ struct Junction {
 
     segment_info getSegmentInfo(const Segment& seg) const;
 
+    JunctionTopology getTopology() const;
+
+    uint16_t idx;                      // Dense index of the junction in the graph.
     uint8_t id;
     micro::point2<micro::meter_t> pos; // Junction position - relative to car start position.
     segment_map segments;
@@ -100,7 +134,8 @@ struct Junction {
 struct Segment : public Node<Connection, cfg::MAX_NUM_CROSSING_SEGMENTS> {
 
     Segment(char name, micro::meter_t length, bool isDeadEnd)
-        : name(name)
+        : idx(0)
+        , name(name)
         , length(length)
         , isDeadEnd(isDeadEnd) {}
 
@@ -110,6 +145,7 @@ struct Segment : public Node<Connection, cfg::MAX_NUM_CROSSING_SEGMENTS> {
 
     bool isLoop() const;
 
+    uint16_t idx;           // Dense index of the segment in the graph.
     char name;
     micro::meter_t length;  // The segment length.
     bool isDeadEnd;
@@ -117,8 +153,18 @@ struct Segment : public Node<Connection, cfg::MAX_NUM_CROSSING_SEGMENTS> {
 
 class LabyrinthGraph {
 public:
+    typedef micro::vec<Segment, cfg::MAX_NUM_LABYRINTH_SEGMENTS> Segments;
+    typedef micro::vec<Junction, cfg::MAX_NUM_LABYRINTH_SEGMENTS> Junctions;
+    typedef micro::vec<Connection, cfg::MAX_NUM_LABYRINTH_SEGMENTS * 2> Connections;
+
     LabyrinthGraph() {}
 
+    /* @brief Builds the graph from a compile-time description.
+     * @param desc The labyrinth description - must be valid, @see LabyrinthDescription::isValid
+     * @param connections The connection list of the description, @see LabyrinthDescription::connections
+     */
+    void build(const LabyrinthDescription& desc, const LabyrinthConnections& connections);
+
     void addSegment(const Segment& seg);
     void addJunction(const Junction& junc);
     void connect(Segment *seg, Junction *junc, const JunctionDecision& decision);
@@ -129,17 +175,15 @@ public:
     Junction* findJunction(uint8_t id);
     const Junction* findJunction(uint8_t id) const;
 
-    const Junction* findJunction(const micro::point2m& pos, const micro::vec<std::pair<micro::radian_t, uint8_t>, 2>& numSegments) const;
-
     const Connection* findConnection(const Segment& seg1, const Segment& seg2) const;
 
     bool valid() const;
 
-private:
-    typedef micro::vec<Segment, cfg::MAX_NUM_LABYRINTH_SEGMENTS> Segments;
-    typedef micro::vec<Junction, cfg::MAX_NUM_LABYRINTH_SEGMENTS> Junctions;
-    typedef micro::vec<Connection, cfg::MAX_NUM_LABYRINTH_SEGMENTS * 2> Connections;
+    const Segments& segments() const { return this->segments_; }
+    const Junctions& junctions() const { return this->junctions_; }
+    const Connections& connections() const { return this->connections_; }
 
+private:
     Segments segments_;
     Junctions junctions_;
     Connections connections_;
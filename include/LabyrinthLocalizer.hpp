@@ -0,0 +1,85 @@
+#pragma once
+
+#include <micro/utils/point2.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+
+/* @brief Discrete Bayes (histogram) filter localizing the car in the labyrinth graph.
+ * The belief is a probability distribution over the route states: the current segment and the connection it was approached through,
+ * which also determines the direction of travel in the segment.
+ * At every junction the belief is first updated with the observed junction (position, topology, car orientation
+ * and the distance travelled since the previous junction), then it is propagated through the decision the car takes.
+ * Every likelihood has a lower bound, so a single misdetection only decreases the probability of the correct state,
+ * and the belief recovers at the next junctions.
+ * @note The belief is stored in a fixed-size array, one junction costs O(number of states * number of segment connections).
+ */
+class LabyrinthLocalizer {
+public:
+    typedef CompiledLabyrinthGraph::index_t index_t;
+
+    struct Observation {
+        micro::point2m pos;             // The car position at the junction.
+        micro::radian_t inOrientation;  // Orientation of the junction side the car is coming from.
+        micro::radian_t outOrientation; // Orientation of the junction side the car is going to.
+        uint8_t numInSegments;          // Number of segments on the side the car is coming from.
+        uint8_t numOutSegments;         // Number of segments on the side the car is going to.
+        micro::meter_t distance;        // Distance travelled since the previous junction.
+        bool isReversed;                // Indicates that the car has changed its speed sign since the previous junction.
+    };
+
+    struct Hypothesis {
+        index_t prevConn;   // The connection the current segment was approached through.
+        index_t seg;        // The current segment.
+        index_t junction;   // The junction the car is passing through.
+        float probability;  // The probability of the state.
+    };
+
+    explicit LabyrinthLocalizer(const CompiledLabyrinthGraph& graph);
+
+    /* @brief Initializes the belief to the known state of the car.
+     * @note The graph must be compiled.
+     */
+    void initialize(const index_t prevConn, const index_t seg);
+
+    /* @brief Updates the belief with the observation of the junction the car is passing through.
+     * @returns The most likely state of the car before passing through the junction
+     */
+    Hypothesis observeJunction(const Observation& observation);
+
+    /* @brief Propagates the belief through the junction observed last, the car takes the decision of the given direction.
+     */
+    void passJunction(const micro::Direction dir);
+
+    /* @brief Checks if the new connection can be taken at the next junction, when the car is in the given state.
+     */
+    bool isNextConnection(const index_t prevConn, const index_t seg, const index_t newConn, const bool isReversed) const;
+
+    /* @brief Gets the probability of the given state.
+     */
+    float probability(const index_t prevConn, const index_t seg) const;
+
+private:
+    typedef uint16_t state_t; // Route state, @see LabyrinthRoutePlanner
+
+    static constexpr uint32_t MAX_NUM_STATES = 2 * CompiledLabyrinthGraph::MAX_NUM_CONNECTIONS;
+
+    uint32_t numStates() const;
+
+    state_t getState(const index_t prevConn, const index_t seg) const;
+
+    index_t getConnection(const state_t state) const;
+
+    index_t getSegment(const state_t state) const;
+
+    index_t nextJunction(const state_t state, const bool isReversed) const;
+
+    uint8_t numSideSegments(const index_t junc, const uint8_t side) const;
+
+    float likelihood(const state_t state, const Observation& observation) const;
+
+    void normalize();
+
+    const CompiledLabyrinthGraph& graph_;
+    float belief_[MAX_NUM_STATES];  // Probabilities of the states.
+    bool isReversed_;               // Indicates that the car changed its speed sign before the last observed junction.
+};
@@ -1,17 +1,31 @@
 #pragma once
 
 #include <micro/control/maneuver.hpp>
-#include <micro/math/random_generator.hpp>
 
+#include <CompiledLabyrinthGraph.hpp>
+#include <Distances.hpp>
 #include <LabyrinthGraph.hpp>
+#include <LabyrinthLocalizer.hpp>
 #include <LabyrinthRoute.hpp>
+#include <LabyrinthRouteCost.hpp>
+#include <LabyrinthRoutePlanner.hpp>
+#include <LabyrinthSpeedProfile.hpp>
+#include <LabyrinthTourPlanner.hpp>
 
 class LabyrinthNavigator : public micro::Maneuver {
 public:
     LabyrinthNavigator(const LabyrinthGraph& graph, const Segment *startSeg, const Connection *prevConn, const Segment *laneChangeSeg,
         const micro::m_per_sec_t targetSpeed, const micro::m_per_sec_t targetFastSpeed, const micro::m_per_sec_t targetDeadEndSpeed);
 
-    void initialize();
+    LabyrinthNavigator(const LabyrinthNavigator&) = delete;
+    LabyrinthNavigator(LabyrinthNavigator&&) = delete;
+    LabyrinthNavigator& operator=(const LabyrinthNavigator&) = delete;
+    LabyrinthNavigator& operator=(LabyrinthNavigator&&) = delete;
+
+    /* @brief Compiles the labyrinth graph and resets the navigation state.
+     * @returns Status::OK if the graph has been compiled, otherwise the navigator must not be used
+     */
+    micro::Status initialize();
 
     const Segment* currentSegment() const;
     const Segment* targetSegment() const;
@@ -21,9 +35,34 @@ public:
 
     void setTargetSegment(const Segment *targetSeg, bool isLast);
 
+    /* @brief Plans a tour that visits all the given segments, then the lane change segment, and starts following it.
+     * The target segment is updated automatically whenever the current target is reached, @see LabyrinthTourPlanner
+     * @note A new target segment set by setTargetSegment() cancels the tour.
+     * @param tourPlanner The tour planner - it is owned by the caller, so that its tables are only allocated when tours are used
+     * @param targets The segments to visit
+     * @returns The estimated time of the tour
+     */
+    micro::second_t setTargetSegments(LabyrinthTourPlanner& tourPlanner, const LabyrinthTourPlanner::Targets& targets);
+
+    void setBlocked(const Connection& conn, const bool isBlocked);
+
+    /* @brief Avoids the obstacles (e.g. other cars) in the current segment, in the direction of travel.
+     * The connections of the current segment at the junction ahead are blocked until the car passes the next junction,
+     * so that the route is re-planned through the previous junction.
+     * @param distances The distances of the nearest obstacles in front of and behind the car
+     */
+    void handleObstacles(const Distances& distances);
+
+    const LabyrinthRoutePlanner::Counters& routePlannerCounters() const;
+
     void update(const micro::CarProps& car, const micro::LineInfo& lineInfo, micro::MainLine& mainLine, micro::ControlData& controlData) override;
 
 private:
+    struct SpeedLimit {
+        micro::meter_t distance;    // Distance of the speed limit point from the car.
+        micro::m_per_sec_t speed;   // The speed limit.
+    };
+
     const micro::LinePattern& frontLinePattern(const micro::LineInfo& lineInfo) const;
     const micro::LinePattern& rearLinePattern(const micro::LineInfo& lineInfo) const;
 
@@ -40,17 +79,22 @@ private:
 
     void setControl(const micro::CarProps& car, const micro::LineInfo& lineInfo, micro::MainLine& mainLine, micro::ControlData& controlData) const;
 
-    void reset(const Junction& junc, micro::radian_t negOri);
+    /* @brief Gets the next point of the current segment where the car must not be faster than a speed limit:
+     * the next junction, the end of a dead-end segment, or the junction where the car will change speed sign.
+     */
+    SpeedLimit nextSpeedLimit(const micro::CarProps& car) const;
+
+    const Connection* nextConnection(const LabyrinthLocalizer::Hypothesis& hypothesis);
 
     void updateRoute();
 
-    bool isTargetLineOverrideEnabled(const micro::CarProps& car, const micro::LineInfo& lineInfo) const;
+    void nextTourTarget();
 
-    bool isDeadEnd(const micro::CarProps& car, const micro::LinePattern& pattern) const;
+    void unblockObstacles();
 
-    const Connection* randomConnection(const Junction& junc, const Segment& seg);
+    bool isTargetLineOverrideEnabled(const micro::CarProps& car, const micro::LineInfo& lineInfo) const;
 
-    micro::Direction randomDirection(const uint8_t numOutSegments);
+    bool isDeadEnd(const micro::CarProps& car, const micro::LinePattern& pattern) const;
 
     static bool isJunction(const micro::LinePattern& pattern);
 
@@ -65,17 +109,27 @@ private:
     const Segment *currentSeg_;
     const Segment *targetSeg_;
     const Segment *laneChangeSeg_;
+    CompiledLabyrinthGraph compiledGraph_;
+    LabyrinthLocalizer localizer_;
+    LabyrinthSpeedProfile speedProfile_;
+    LabyrinthTimeCost routeCost_;
+    LabyrinthRoutePlanner routePlanner_;
+    LabyrinthTourPlanner::Targets tourTargets_; // The remaining targets of the tour, after the current target.
+    bool isFollowingTour_;
     LabyrinthRoute route_;
+    const Segment *obstacleSeg_;                                                         // The segment where an obstacle has been detected.
+    micro::vec<const Connection*, cfg::MAX_NUM_CROSSING_SEGMENTS> obstacleBlockedConns_; // The connections blocked by the obstacle.
     bool isLastTarget_;
-    micro::meter_t lastJuncDist_;
+    bool hasPassedJunction_;      // Indicates that the car has passed a junction since the start.
+    micro::meter_t lastJuncDist_; // The car distance at the last junction.
     micro::Direction targetDir_;
     micro::Sign targetSpeedSign_;
     bool isSpeedSignChangeInProgress_;
     micro::meter_t lastSpeedSignChangeDistance_;
-    micro::LineInfo prevLineInfo_;
+    micro::LinePattern prevFrontSensorPattern_; // The previous pattern of the front sensor, independently of the speed sign.
+    micro::LinePattern prevRearSensorPattern_;  // The previous pattern of the rear sensor, independently of the speed sign.
     micro::Pose correctedCarPose_;
     micro::meter_t lastOrientationUpdateDist_;
     bool hasSpeedSignChanged_;
     bool isInJunction_;
-    micro::random_generator random_;
 };
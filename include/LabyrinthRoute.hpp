@@ -1,14 +1,19 @@
 #pragma once
 
+#include <FixedDeque.hpp>
 #include <LabyrinthGraph.hpp>
 
-#include <utility>
-
+/* @brief Labyrinth route: the connections to pass through, in order.
+ * Connections are stored in a ring buffer, so that dropping the first connection at every junction
+ * and building the route backwards from its destination do not shift the remaining connections.
+ */
 struct LabyrinthRoute {
     static constexpr uint32_t MAX_LENGTH = 2 * cfg::MAX_NUM_LABYRINTH_SEGMENTS;
+    typedef FixedDeque<const Connection*, MAX_LENGTH> Connections;
+
     const Segment* startSeg;
     const Segment* destSeg;
-    micro::vec<const Connection*, MAX_LENGTH> connections;
+    Connections connections;
 
     explicit LabyrinthRoute(const Segment *currentSeg = nullptr);
 
@@ -24,5 +29,9 @@ struct LabyrinthRoute {
 
     static bool isForwardConnection(const Connection& prevConn, const Segment& currentSeg, const Connection& newConn);
 
-    static LabyrinthRoute create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, const bool allowBackwardNavigation);
+    /* @brief Checks if the car goes back to the previous junction instead of passing through the current segment.
+     */
+    static bool isReversal(const Connection& prevConn, const Connection& newConn, const bool isStartSeg, const bool allowBackwardNavigation);
+
+    static micro::meter_t connectionCost(const Connection& prevConn, const Segment& currentSeg, const Connection& newConn, const bool isStartSeg, const bool allowBackwardNavigation);
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthSpeedProfile.hpp>
+
+/* @brief Edge-cost policy of the labyrinth route planner.
+ * The cost of a connection is the cost of leaving the middle of the current segment and reaching the middle of the new segment.
+ * Costs are unitless, the planner only compares and sums them.
+ * @note Reversal costs may be negative, but a route cycle must always have a positive cost.
+ */
+class LabyrinthRouteCost {
+public:
+    typedef CompiledLabyrinthGraph::index_t index_t;
+
+    virtual ~LabyrinthRouteCost() = default;
+
+    /* @brief Calculates the route cost of stepping through the new connection.
+     * @param graph The compiled labyrinth graph
+     * @param prevConn The connection the current segment was approached through
+     * @param seg The current segment
+     * @param newConn The new connection
+     * @param isStartSeg Indicates that the current segment is the start segment of the route - reversals are not penalized in the start segment
+     * @param allowBackwardNavigation Indicates that the car may go back to the previous junction
+     */
+    virtual float connectionCost(const CompiledLabyrinthGraph& graph, const index_t prevConn, const index_t seg, const index_t newConn,
+        const bool isStartSeg, const bool allowBackwardNavigation) const = 0;
+};
+
+/* @brief Route cost policy minimizing the route length [m].
+ * @see CompiledLabyrinthGraph::connectionCost
+ */
+class LabyrinthDistanceCost : public LabyrinthRouteCost {
+public:
+    float connectionCost(const CompiledLabyrinthGraph& graph, const index_t prevConn, const index_t seg, const index_t newConn,
+        const bool isStartSeg, const bool allowBackwardNavigation) const override;
+};
+
+/* @brief Route cost policy minimizing the estimated route time [s].
+ * Models the speed profile of the labyrinth navigator: the car drives at base speed near the junctions and after a speed sign change,
+ * between them it accelerates towards fast speed and brakes in time for the next junction, @see LabyrinthSpeedProfile
+ * Dead-end segments are driven until their end, which the car reaches at dead-end speed.
+ * Side (left or right) junction decisions and reversals are penalized with additional time.
+ */
+class LabyrinthTimeCost : public LabyrinthRouteCost {
+public:
+    /* @brief Constructor.
+     * @param speed The base speed, used in the junctions and after speed sign changes
+     * @param fastSpeed The speed in the middle of the segments
+     * @param deadEndSpeed The speed at the end of the dead-end segments
+     * @param speedProfile The acceleration and braking profile of the navigator
+     * @param speedSignChangeTime The time needed to change the speed sign
+     * @param sideDecisionTime The additional time of taking a left or right junction decision, compared to the center one
+     */
+    LabyrinthTimeCost(const micro::m_per_sec_t speed, const micro::m_per_sec_t fastSpeed, const micro::m_per_sec_t deadEndSpeed,
+        const LabyrinthSpeedProfile& speedProfile, const micro::millisecond_t speedSignChangeTime, const micro::millisecond_t sideDecisionTime);
+
+    float connectionCost(const CompiledLabyrinthGraph& graph, const index_t prevConn, const index_t seg, const index_t newConn,
+        const bool isStartSeg, const bool allowBackwardNavigation) const override;
+
+    /* @brief Estimates the time of driving through the whole segment.
+     */
+    micro::second_t segmentTime(const CompiledLabyrinthGraph& graph, const index_t seg) const;
+
+private:
+    micro::second_t deadEndReturnTime(const micro::meter_t length) const;
+
+    micro::second_t sideDecisionTime(const CompiledLabyrinthGraph& graph, const index_t newConn, const index_t newSeg) const;
+
+    const micro::m_per_sec_t speed_;
+    const micro::m_per_sec_t fastSpeed_;
+    const micro::m_per_sec_t deadEndSpeed_;
+    const LabyrinthSpeedProfile speedProfile_;
+    const micro::second_t speedSignChangeTime_;
+    const micro::second_t sideDecisionTime_;
+    const micro::second_t reversalTime_;    // Time of going back to the previous junction, without the time of the current and the new segments.
+};
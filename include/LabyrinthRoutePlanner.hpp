@@ -0,0 +1,95 @@
+#pragma once
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <IndexedPriorityQueue.hpp>
+#include <LabyrinthRoute.hpp>
+#include <LabyrinthRouteCost.hpp>
+
+/* @brief Incremental labyrinth route planner.
+ * Maintains the cost-to-go of the route states towards the destination with a backward Lifelong Planning A* search
+ * (https://en.wikipedia.org/wiki/Lifelong_Planning_A*), as D* Lite does.
+ * The search tree is kept between calls as long as the destination does not change,
+ * so re-planning after a start segment change needs no search at all,
+ * and re-planning after a connection has been blocked or unblocked only updates the affected states.
+ * Connection costs are calculated by a pluggable policy, @see LabyrinthRouteCost
+ * @note The graph must be compiled before the first route is created.
+ */
+class LabyrinthRoutePlanner {
+public:
+    struct Counters {
+        uint32_t numReplans         = 0; // Number of created routes and route cost queries.
+        uint32_t numSearchResets    = 0; // Number of times the search tree was discarded, because the destination changed.
+        uint32_t lastNumExpansions  = 0; // Number of expanded states during the last re-planning.
+        uint32_t lastNumUpdates     = 0; // Number of updated states during the last re-planning, including connection blocking since the previous one.
+        uint32_t totalNumExpansions = 0; // Total number of expanded states.
+        uint32_t totalNumUpdates    = 0; // Total number of updated states.
+    };
+
+    /* @brief Creates a planner that minimizes the route length.
+     */
+    LabyrinthRoutePlanner(const CompiledLabyrinthGraph& graph, const bool allowBackwardNavigation);
+
+    /* @brief Creates a planner that minimizes the route cost calculated by the given policy.
+     * @param routeCost The route cost policy - must outlive the planner
+     */
+    LabyrinthRoutePlanner(const CompiledLabyrinthGraph& graph, const bool allowBackwardNavigation, const LabyrinthRouteCost& routeCost);
+
+    LabyrinthRoute create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg);
+
+    /* @brief Creates the route in place, without copying it.
+     * @param route The route to overwrite
+     */
+    void create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, LabyrinthRoute& route);
+
+    /* @brief Calculates the cost of the route, without creating it.
+     * @returns The route cost, or infinity if the destination is not reachable
+     */
+    float routeCost(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg);
+
+    void setBlocked(const Connection& conn, const bool isBlocked);
+
+    bool isBlocked(const Connection& conn) const;
+
+    const Counters& counters() const;
+
+private:
+    typedef uint16_t state_t; // Route state: the current segment and the connection it was approached through.
+    typedef CompiledLabyrinthGraph::index_t index_t;
+
+    static constexpr uint32_t MAX_NUM_STATES = 2 * CompiledLabyrinthGraph::MAX_NUM_CONNECTIONS; // 2 states for each connection
+
+    uint32_t numStates() const;
+
+    state_t getState(const index_t prevConn, const index_t seg) const;
+
+    index_t getConnection(const state_t state) const;
+
+    index_t getSegment(const state_t state) const;
+
+    bool isAllowed(const index_t prevConn, const index_t seg, const index_t newConn) const;
+
+    float cost(const state_t state, const index_t newConn) const;
+
+    void reset(const index_t destSeg);
+
+    void update(const index_t destSeg);
+
+    void updateState(const state_t state);
+
+    void updatePredecessors(const state_t state);
+
+    index_t nextConnection(const index_t prevConn, const index_t seg, const bool isStartSeg, float& cost) const;
+
+    void computeCosts();
+
+    const CompiledLabyrinthGraph& graph_;
+    const bool allowBackwardNavigation_;
+    const LabyrinthRouteCost& routeCost_;
+    index_t destSeg_;                                              // The destination of the current search tree.
+    float costs_[MAX_NUM_STATES];                           // Cost-to-go of the states (g).
+    float lookaheadCosts_[MAX_NUM_STATES];                  // One-step lookahead cost-to-go of the states (rhs).
+    IndexedPriorityQueue<float, MAX_NUM_STATES> queue_;     // Locally inconsistent states.
+    bool blocked_[MAX_NUM_STATES / 2];                      // Blocked connections.
+    Counters counters_;
+    uint32_t numPendingUpdates_;                            // Number of updated states since the last re-planning.
+};
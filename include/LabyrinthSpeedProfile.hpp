@@ -0,0 +1,43 @@
+#pragma once
+
+#include <micro/utils/units.hpp>
+
+/* @brief Trapezoidal longitudinal speed profile of the labyrinth navigation.
+ * The car accelerates and brakes with constant rates, so that it reaches the speed limit points
+ * (junctions, dead-end ends, reversals) exactly at their speed limits, and drives at the maximum speed between them.
+ * @note Speeds are absolute values, the speed sign is handled by the caller.
+ */
+class LabyrinthSpeedProfile {
+public:
+    /* @brief Constructor.
+     * @param acceleration The maximum acceleration [m/s^2]
+     * @param deceleration The maximum deceleration [m/s^2]
+     */
+    LabyrinthSpeedProfile(const float acceleration, const float deceleration);
+
+    /* @brief Calculates the maximum speed that still allows braking to the end speed within the given distance.
+     * @param endSpeed The speed limit at the end of the distance
+     * @param distance The distance to the speed limit point - negative if the point has already been passed
+     */
+    micro::m_per_sec_t brakingSpeed(const micro::m_per_sec_t endSpeed, const micro::meter_t distance) const;
+
+    /* @brief Calculates the ramp time of changing the speed with the maximum acceleration or deceleration.
+     * @note The speeds must have the same sign.
+     */
+    micro::millisecond_t rampTime(const micro::m_per_sec_t speed, const micro::m_per_sec_t targetSpeed) const;
+
+    /* @brief Calculates the time of driving the given distance: the car accelerates from the start speed towards the maximum speed,
+     * then brakes to reach the end of the distance with the end speed.
+     * @note If the distance is too short for reaching the end speed, the speed is assumed to change linearly.
+     * @param distance The distance
+     * @param startSpeed The speed at the start of the distance
+     * @param maxSpeed The maximum speed - raised to the start and end speeds if they are higher
+     * @param endSpeed The speed at the end of the distance
+     */
+    micro::second_t travelTime(const micro::meter_t distance, const micro::m_per_sec_t startSpeed, const micro::m_per_sec_t maxSpeed,
+        const micro::m_per_sec_t endSpeed) const;
+
+private:
+    const float acceleration_;
+    const float deceleration_;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <LabyrinthRoutePlanner.hpp>
+
+/* @brief Labyrinth tour planner.
+ * Orders the target segments so that visiting all of them and then reaching the final segment has the lowest total route cost
+ * (open travelling salesman problem with a fixed start and end).
+ * The pairwise route costs are calculated by the route planner, then the visiting order is found by Held-Karp dynamic programming
+ * (https://en.wikipedia.org/wiki/Held%E2%80%93Karp_algorithm) over the subsets of the targets.
+ * The memory need of the dynamic programming grows exponentially, therefore when there are more than MAX_NUM_EXACT_TARGETS targets,
+ * the first ones are selected greedily (nearest target first), and only the remaining ones are ordered optimally.
+ * @note The routes between the targets start from the middle of the target segments, regardless of the connection the target was approached through.
+ * This is exact when backward navigation is allowed, otherwise the tour cost is an optimistic estimate.
+ */
+class LabyrinthTourPlanner {
+public:
+    static constexpr uint32_t MAX_NUM_TARGETS       = cfg::NUM_LABYRINTH_GATE_SEGMENTS;
+    static constexpr uint32_t MAX_NUM_EXACT_TARGETS = cfg::LABYRINTH_TOUR_MAX_EXACT_TARGETS;
+
+    typedef micro::vec<const Segment*, MAX_NUM_TARGETS> Targets;
+
+    struct Tour {
+        Targets targets; // The targets in visiting order.
+        float cost;      // The total route cost, including the route from the last target to the final segment.
+    };
+
+    LabyrinthTourPlanner();
+
+    /* @brief Creates a tour.
+     * @param routePlanner The route planner calculating the pairwise route costs - tour planning resets its search tree
+     * @param prevConn The connection the current segment was approached through
+     * @param currentSeg The current segment
+     * @param targets The distinct segments to visit, in any order
+     * @param finalSeg The segment to reach after all the targets have been visited
+     * @returns The tour, or an empty tour with infinite cost if any of the targets or the final segment is not reachable
+     */
+    Tour create(LabyrinthRoutePlanner& routePlanner, const Connection& prevConn, const Segment& currentSeg, const Targets& targets, const Segment& finalSeg);
+
+private:
+    typedef uint8_t node_t; // Tour node: the targets are indexed by their position in the target list, followed by the final and the start segments.
+
+    static constexpr uint32_t MAX_NUM_NODES = MAX_NUM_TARGETS + 2;
+
+    void updateCosts(const Connection& prevConn, const Segment& currentSeg, const Targets& targets, const Segment& finalSeg);
+
+    float orderGreedily(const uint32_t numTargets, Tour& tour);
+
+    float orderOptimally(const uint32_t numTargets, Tour& tour);
+
+    float legCost(const Segment& seg, const Segment& destSeg);
+
+    bool isVisited(const node_t target) const;
+
+    LabyrinthRoutePlanner *routePlanner_;                                       // The route planner of the tour being created.
+    const Targets *targets_;                                                    // The targets of the tour being created.
+    float costs_[MAX_NUM_NODES][MAX_NUM_NODES];                                 // Route costs between the tour nodes.
+    uint32_t visited_;                                                          // Bitmask of the targets already added to the tour.
+    node_t lastNode_;                                                           // The last node added to the tour.
+    float pathCosts_[1 << MAX_NUM_EXACT_TARGETS][MAX_NUM_EXACT_TARGETS];        // Lowest cost of visiting a subset of the remaining targets, ending at a given target.
+    uint8_t pathParents_[1 << MAX_NUM_EXACT_TARGETS][MAX_NUM_EXACT_TARGETS];    // The target visited before the last one on the lowest cost path.
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <micro/utils/units.hpp>
+
+#include <track.hpp>
+
+/* @brief Learns the fast segment speeds and the brake offsets of the race track from lap to lap.
+ * The track is divided into sections: a fast segment and the slow segments that follow it, until the next fast segment.
+ * During a lap the peak line error, the maximum speed and the time of each segment are recorded.
+ * When a lap is finished, the speed and brake offset deltas of each section are adjusted:
+ * - the fast speed is increased if the car reached it and the line error stayed low in the whole section,
+ *   and it is decreased if the line error got too high in the fast segment,
+ * - the brake offset is increased (the car brakes later) if the line error stayed low in the slow segments,
+ *   and it is decreased if the line error got too high in them.
+ * The decrease steps are twice the increase steps, so a lap close to the grip limit is followed by a safer one.
+ * The deltas are kept within bounds, and they are added to the hand-tuned table values.
+ * @note The memory need is fixed, no allocation is made.
+ */
+class LapLearner {
+public:
+    static constexpr uint32_t MAX_NUM_SECTIONS = MAX_NUM_TRACK_SECTIONS;
+
+    struct Section {
+        micro::m_per_sec_t fastSpeedDelta;  // Learned delta of the fast segment speed.
+        micro::meter_t brakeOffsetDelta;    // Learned delta of the brake offset of the slow segments.
+    };
+
+    typedef Section Sections[MAX_NUM_SECTIONS];
+
+    struct SegmentStats {
+        micro::meter_t peakLineError;       // Maximum of the absolute line position error.
+        micro::m_per_sec_t maxSpeed;        // Maximum of the absolute car speed.
+        micro::m_per_sec_t maxTargetSpeed;  // Maximum of the absolute target speed.
+        micro::millisecond_t time;          // Time spent in the segment.
+    };
+
+    explicit LapLearner(const TrackSegments& segments);
+
+    /* @brief Records the car state in the current segment.
+     * @param segIdx Index of the current segment
+     * @param car The car properties
+     * @param lineError The line position error
+     * @param targetSpeed The target speed of the car
+     */
+    void update(const uint32_t segIdx, const micro::CarProps& car, const micro::meter_t lineError, const micro::m_per_sec_t targetSpeed);
+
+    /* @brief Finishes the recording of a segment.
+     * @param segIdx Index of the finished segment
+     * @param time Time spent in the segment
+     */
+    void onSegmentFinished(const uint32_t segIdx, const micro::millisecond_t time);
+
+    /* @brief Adjusts the section deltas according to the segment statistics of the finished lap, and clears the statistics.
+     * @param lapTime The lap time
+     */
+    void onLapFinished(const micro::millisecond_t lapTime);
+
+    /* @brief Gets the index of the section the given segment belongs to.
+     */
+    uint32_t sectionIndex(const uint32_t segIdx) const;
+
+    const Sections& sections() const { return this->sections_; }
+
+    /* @brief Sets the section deltas, e.g. the ones learned in a previous run - the deltas are limited to the bounds.
+     */
+    void setSections(const Sections& sections);
+
+    const SegmentStats& segmentStats(const uint32_t segIdx) const { return this->stats_[segIdx]; }
+
+    micro::millisecond_t lastLapTime() const { return this->lastLapTime_; }
+
+private:
+    const TrackSegments& segments_;
+    SegmentStats stats_[MAX_NUM_TRACK_SEGMENTS];
+    Sections sections_;
+    micro::millisecond_t lastLapTime_;
+};
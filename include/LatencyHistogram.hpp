@@ -0,0 +1,61 @@
+#pragma once
+
+#include <micro/utils/CarProps.hpp>
+#include <micro/utils/units.hpp>
+
+#include <cstdint>
+
+/* @brief Timestamps of the data a control output was calculated from, carried from the sensor tasks to the control task.
+ */
+struct ControlTimestamps {
+    micro::microsecond_t lineRx;    // Reception time of the line info.
+    micro::microsecond_t gyroRead;  // Read time of the gyro data of the car props.
+    micro::microsecond_t decision;  // Time the program task calculated the control data.
+};
+
+/* @brief Car properties with the read time of their gyro data, published together so that the read time always belongs to the properties.
+ */
+struct TimedCarProps {
+    micro::CarProps car;            // The car properties.
+    micro::microsecond_t gyroRead;  // Read time of the gyro data of the car properties.
+};
+
+/* @brief Histogram of latencies with logarithmic bins.
+ * The first bin holds the latencies shorter than the base, each further bin doubles the upper bound of the previous one,
+ * the last bin holds all the longer latencies.
+ * The bin counts are sent to the host as they are, the host decodes them with the same bin layout, @see percentile()
+ * As the params only serialize scalars, the bin counts and the maximum are registered one by one,
+ * as the params <name>0 ... <name>7 and <name>Max of the histogram name.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t NUM_BINS = 8;
+
+    LatencyHistogram();
+
+    void add(const micro::microsecond_t latency);
+
+    void reset();
+
+    uint32_t count(const uint32_t bin) const { return this->counts_[bin]; }
+    uint32_t& count(const uint32_t bin) { return this->counts_[bin]; }
+
+    uint32_t numSamples() const;
+
+    micro::microsecond_t max() const { return this->max_; }
+    micro::microsecond_t& max() { return this->max_; }
+
+    /* @brief Gets the exclusive upper bound of the latencies in a bin.
+     * @note The last bin is unbounded, its upper bound is the longest latency added.
+     */
+    micro::microsecond_t binUpperBound(const uint32_t bin) const;
+
+    /* @brief Gets an upper bound of the given percentile of the latencies: the upper bound of the bin the percentile falls into.
+     * @param ratio The percentile, in the range [0, 1]
+     */
+    micro::microsecond_t percentile(const float ratio) const;
+
+private:
+    uint32_t counts_[NUM_BINS];
+    micro::microsecond_t max_;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <micro/utils/units.hpp>
+
+#include <cstdint>
+
+/* @brief Linear model-predictive lateral controller for four-wheel steering.
+ *
+ * The car is modelled as a linearized kinematic bicycle, relative to the target line:
+ * - pos: lateral offset of the target line from the car center (same sign convention as the PID position error),
+ * - angle: angle of the target line relative to the car (same sign convention as the PID angle error),
+ * - curvature: curvature of the target line, constant over the horizon.
+ *
+ * With front and rear wheel angles df and dr, and speed v:
+ *   d(pos)/dt   = v * (angle - (df + dr) / 2)
+ *   d(angle)/dt = -v * (df - dr) / pivotDist + v * curvature
+ *
+ * The cost is the weighted sum of the squared position and angle errors and the squared wheel angles over the horizon.
+ * Without constraints the optimal control is a linear state feedback, calculated by the finite-horizon Riccati recursion.
+ * The feedback gains only depend on the speed, they are precomputed for uniformly sampled speeds by compile(),
+ * so update() only interpolates the gains and evaluates the feedback - the explicit solution of the unconstrained problem.
+ * The wheel angle constraints are enforced by saturating the output.
+ * Compiling the gains takes long, so it may be done by a lower-priority task than the one that calls update():
+ * the gains are double-buffered, compile() writes the inactive gains and activates them when they are complete.
+ * @note The memory need is fixed, no allocation is made.
+ * @note Only one task may call compile().
+ */
+class LateralMpc {
+public:
+    static constexpr uint32_t HORIZON           = 15;   // Number of prediction steps.
+    static constexpr uint32_t NUM_SPEED_SAMPLES = 33;   // Number of speeds the gains are precomputed for.
+
+    struct Weights {
+        float pos;      // Weight of the squared position error [1/m^2].
+        float angle;    // Weight of the squared angle error [1/rad^2].
+        float wheel;    // Weight of the squared wheel angles [1/rad^2].
+    };
+
+    struct Output {
+        micro::radian_t frontWheelAngle;
+        micro::radian_t rearWheelAngle;
+    };
+
+    /* @brief Constructor - compiles the gains.
+     * @param pivotDist The distance between the front and rear wheel pivots
+     * @param maxWheelAngle The maximum wheel angle
+     * @param step The time step of the prediction
+     * @param maxSpeed The maximum speed the gains are precomputed for, above it the gains of the maximum speed are used
+     * @param weights The cost weights
+     */
+    LateralMpc(const micro::meter_t pivotDist, const micro::radian_t maxWheelAngle, const micro::millisecond_t step,
+        const micro::m_per_sec_t maxSpeed, const Weights& weights);
+
+    /* @brief Precomputes the gains for the sampled speeds - needs to be called after the weights have changed.
+     */
+    void compile();
+
+    /* @brief Checks if the gains have been compiled with the current weights.
+     */
+    bool isCompiled() const;
+
+    /* @brief Calculates the wheel angles.
+     * @param speed The absolute speed of the car
+     * @param posError The position error
+     * @param angleError The angle error
+     * @param curvature The curvature of the target line [1/m]
+     */
+    Output update(const micro::m_per_sec_t speed, const micro::meter_t posError, const micro::radian_t angleError, const float curvature) const;
+
+    Weights weights;
+
+private:
+    struct Gains {
+        float front[3];  // Front wheel angle gains of the position error, angle error and curvature.
+        float rear[3];   // Rear wheel angle gains of the position error, angle error and curvature.
+    };
+
+    Gains calculateGains(const micro::m_per_sec_t speed) const;
+
+    const micro::meter_t pivotDist_;
+    const micro::radian_t maxWheelAngle_;
+    const micro::second_t step_;
+    const micro::m_per_sec_t maxSpeed_;
+    Weights compiledWeights_;               // The weights of the active gains.
+    Gains gains_[2][NUM_SPEED_SAMPLES];     // The active and the inactive gains.
+    volatile uint32_t activeGainsIdx_;      // Index of the active gains.
+};
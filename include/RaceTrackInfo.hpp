@@ -1,19 +1,84 @@
 #pragma once
 
+#include <LapLearner.hpp>
+#include <TrackMap.hpp>
 #include <track.hpp>
 
 struct RaceTrackInfo {
     const TrackSegments& segments;
+    const TrackProfile& profile;
     TrackSegments::const_iterator seg;
     micro::CarProps segStartCarProps;
     micro::ControlData segStartControlData;
     micro::OrientedLine segStartLine;
     uint8_t lap;
     micro::millisecond_t lapStartTime;
+    micro::millisecond_t segStartTime;
+    LapLearner learner;                                  // Learns the fast speeds and brake offsets of the race laps.
+    TrackMap trackMap;                                   // Map of the last safety-car lap that has been recorded from the start line.
+    micro::meter_t segMapDists[MAX_NUM_TRACK_SEGMENTS];  // Start distances of the segments in the track map.
 
-    RaceTrackInfo(const TrackSegments& segments);
+    RaceTrackInfo(const TrackSegments& segments, const TrackProfile& profile);
 
     void update(const micro::CarProps& car, const micro::LineInfo& lineInfo, const micro::MainLine& mainLine, const micro::ControlData& controlData);
 
+    /* @brief Updates the track info at the given time - the segment and lap times are measured with it instead of the system time,
+     * so that recorded logs can be replayed deterministically.
+     */
+    void update(const micro::millisecond_t time, const micro::CarProps& car, const micro::LineInfo& lineInfo, const micro::MainLine& mainLine,
+        const micro::ControlData& controlData);
+
     TrackSegments::const_iterator nextSegment() const;
+
+    /* @brief Gets the control of the current segment, according to its description and the profile of the current lap.
+     * @param car The car properties
+     * @param mainLine The main line
+     * @returns The control data - the speed is given in the direction of travel
+     */
+    micro::ControlData control(const micro::CarProps& car, const micro::MainLine& mainLine) const;
+
+    /* @brief Gets the curvature of the track ahead of the car, from the track map.
+     * @param car The car properties
+     * @param preview The distance ahead of the car
+     * @returns The curvature [1/m], or 0 if the track map has not been recorded
+     */
+    float curvature(const micro::CarProps& car, const micro::meter_t preview) const;
+
+    /* @brief Gets the fast speed of the current section - the table speed adjusted by the lap learner in the race laps.
+     * @param tableSpeed The fast speed from the speed table of the lap
+     */
+    micro::m_per_sec_t fastSpeed(const micro::m_per_sec_t tableSpeed) const;
+
+    /* @brief Gets the brake offset of the current section - the table offset adjusted by the lap learner in the race laps.
+     * @param tableOffset The brake offset from the brake offset table of the lap
+     */
+    micro::meter_t brakeOffset(const micro::meter_t tableOffset) const;
+
+    /* @brief Gets the track map sample ahead of the car.
+     * @note Calling it before the track map has been recorded is undefined behaviour.
+     */
+    TrackMap::Sample trackMapSample(const micro::CarProps& car, const micro::meter_t preview) const;
+
+private:
+    uint32_t segmentIndex() const;
+
+    /* @brief Checks if the given segment has become active - updates the state of the trigger.
+     */
+    bool hasBecomeActive(const TrackSegment& segment, const micro::CarProps& car, const micro::LinePattern& pattern);
+
+    /* @brief Checks if the car has passed the brake sign mapped in the safety-car laps without detecting it.
+     * The braking segment is started then, instead of keeping the fast speed until the distance fallback.
+     * @returns true if the track map has been recorded and it has the brake sign behind the car, at least RACE_MISSED_BRAKE_SIGN_DIST far
+     */
+    bool isMappedBrakeSignPassed(const micro::CarProps& car) const;
+
+    /* @brief Gets the distance of the car in the track map.
+     * The distance is measured from the start of the current segment, so the odometry drift does not accumulate over the lap.
+     */
+    micro::meter_t trackMapDistance(const micro::CarProps& car) const;
+
+    bool isTrackMapRecording_;
+    bool isAccelerateSignDetected_;         // Indicates that an ACCELERATE pattern has been detected, the next fast segment starts after the following straight line.
+    micro::meter_t lastAccelerateSignDist_; // Distance of the last ACCELERATE pattern detection.
+    bool isFastSpeedEnabled_;               // Indicates if the fast segment speed is enabled - disabled when the car gets far from the line.
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <micro/utils/CarProps.hpp>
+#include <micro/utils/ControlData.hpp>
+#include <micro/utils/Line.hpp>
+#include <micro/utils/LinePattern.hpp>
+
+#include <cfg_track.hpp>
+#include <Distances.hpp>
+#include <OvertakeManeuver.hpp>
+#include <RaceTrackInfo.hpp>
+#include <track.hpp>
+#include <TurnAroundManeuver.hpp>
+
+/* @brief Logic of the race track program states: reaching and following the safety car, overtaking it, racing, turning around and finishing.
+ * The program is stepped once for each line info, the step only depends on its input and the state of the program -
+ * the queues, the system time and the program state of the system manager are handled by the caller.
+ * This way the same logic runs on the car and in the host-side replay of recorded logs.
+ */
+class RaceTrackProgram {
+public:
+    struct Input {
+        cfg::ProgramState programState;         // The current program state.
+        micro::millisecond_t time;              // The current time.
+        const micro::CarProps& car;             // The car properties.
+        const micro::LineInfo& lineInfo;        // The line info.
+        const Distances& distances;             // The distances from the obstacles in front of and behind the car.
+        micro::Sign safetyCarFollowSpeedSign;   // Speed sign of the car in the safety car laps.
+        micro::m_per_sec_t testSpeed;           // Target speed of the test state.
+    };
+
+    struct Output {
+        cfg::ProgramState programState;             // The requested program state - the same as the current one when it does not change.
+        micro::ControlData controlData;             // The control data.
+        micro::LineDetectControl lineDetectControl; // The line detection control data.
+        float curvature;                            // The curvature feed-forward of the steering [1/m].
+        bool isLearningLapFinished;                 // Indicates that a learning lap has been finished, the learned track data should be stored.
+    };
+
+    RaceTrackProgram(const TrackSegments& segments, const TrackProfile& profile);
+
+    /* @brief Checks if the program state is handled by the race track program.
+     */
+    static bool handles(const cfg::ProgramState programState);
+
+    /* @brief Runs the program logic for the current input.
+     * @note Needs to be called in the program states not handled by the race track program as well,
+     * so that the program knows when a race track state is entered.
+     * @param input The input
+     * @param output The output - only written when the program state is handled
+     * @returns True if the program state is handled by the race track program
+     */
+    bool step(const Input& input, Output& output);
+
+    RaceTrackInfo trackInfo;
+
+private:
+    /* @brief Gets the n-th fast segment of the track.
+     * @param fastSeg The 1-based index of the fast segment
+     * @returns The fast segment, or the end of the segments if there are less fast segments
+     */
+    TrackSegments::const_iterator getFastSegment(const uint32_t fastSeg) const;
+
+    /* @brief Gets the fast segment the race starts from in the given program state.
+     * @returns The fast segment, or the end of the segments if the program state is not a race state
+     */
+    TrackSegments::const_iterator getFastSegment(const cfg::ProgramState programState) const;
+
+    micro::m_per_sec_t safetyCarFollowSpeed(const micro::meter_t distFromSafetyCar, const bool isFast) const;
+
+    micro::ControlData getControl(const micro::CarProps& car) const;
+
+    const TrackSegments::const_iterator turnAroundSeg_;
+    const TrackSegments::const_iterator overtakeSeg_;
+    micro::MainLine mainLine_;
+    micro::ControlData controlData_;                // Kept between the steps, the states only overwrite the parts they control.
+    micro::LineDetectControl lineDetectControl_;
+    OvertakeManeuver overtake_;
+    TurnAroundManeuver turnAround_;
+    cfg::ProgramState prevProgramState_;
+    micro::Sign targetSpeedSign_;
+    micro::meter_t lastDistWithValidLine_;
+    micro::meter_t lastDistWithSafetyCar_;
+    uint8_t lastOvertakeLap_;
+    uint8_t prevLap_;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/* @brief Fixed-capacity history of sequence-numbered values, shared between a single producer and any number of consumers.
+ * The producer writes the next value in place and publishes it by incrementing the sequence number.
+ * Consumers detect new values by comparing sequence numbers, and read the published values by reference or copy them with read().
+ * The values are stored in a ring buffer: the value of a sequence number is overwritten when the producer starts writing N values later.
+ * Therefore, as in case of a seqlock, a consumer checks with isValid() that the value has not been overwritten while it was being read.
+ * A value read by reference may be overwritten any time later, so consumers that use the value for longer should copy it with read().
+ * @note The first value is default-constructed, it is published with sequence number 0.
+ */
+template <typename T, uint32_t N>
+class SequencedHistory {
+public:
+    static_assert(N >= 2 && 0 == (N & (N - 1)), "Capacity must be a power of 2 in order to keep the slots continuous when the sequence number overflows");
+
+    typedef uint32_t seq_t;
+
+    SequencedHistory()
+        : items_()
+        , seq_(0) {}
+
+    static constexpr uint32_t capacity() { return N; }
+
+    /* @brief Gets the sequence number of the last published value.
+     */
+    seq_t sequence() const { return this->seq_.load(std::memory_order_acquire); }
+
+    /* @brief Gets the value of the given sequence number.
+     * @note The result is only valid if isValid() returns true for the sequence number after the value has been read.
+     */
+    const T& operator[](const seq_t seq) const { return this->items_[seq & (N - 1)]; }
+
+    const T& latest() const { return (*this)[this->sequence()]; }
+
+    /* @brief Copies the value of the given sequence number.
+     * @returns true if the value has not been overwritten while being copied, otherwise the copy is invalid and must be dropped
+     */
+    bool read(const seq_t seq, T& value) const {
+        value = (*this)[seq];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return this->isValid(seq);
+    }
+
+    /* @brief Checks if the value of the given sequence number has not been overwritten, and is not being written by the producer.
+     */
+    bool isValid(const seq_t seq) const { return this->sequence() - seq < N - 1; }
+
+    /* @brief Gets the slot of the next value, to be written in place by the producer.
+     * @note The slot contains an old value, the producer must overwrite all its fields before calling publish().
+     */
+    T& next() { return this->items_[(this->seq_.load(std::memory_order_relaxed) + 1) & (N - 1)]; }
+
+    /* @brief Publishes the next value.
+     */
+    void publish() { this->seq_.store(this->seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    void push(const T& value) {
+        this->next() = value;
+        this->publish();
+    }
+
+private:
+    T items_[N];
+    std::atomic<seq_t> seq_;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <micro/utils/LinePattern.hpp>
+#include <micro/utils/point2.hpp>
+
+#include <cstdint>
+
+/* @brief Distance-indexed map of a track lap, recorded from the car state.
+ * A sample is recorded each time the car passes the next multiple of the sample distance (measured from the start of the recording).
+ * Each sample holds the car pose, the line position and the detected line pattern.
+ * The samples are delta-encoded in a fixed-size buffer:
+ * - the pose of every KEYFRAME_INTERVAL-th sample is stored as a keyframe,
+ * - the pose of each sample is stored as a small integer delta from the pose of the previous sample,
+ *   relative to the decoded previous pose, so the rounding errors do not accumulate.
+ * Looking up a sample by distance decodes at most KEYFRAME_INTERVAL - 1 deltas from the last keyframe, so it takes constant time.
+ * The curvature is not stored, it is calculated from the heading delta of the sample.
+ * @note The memory need is fixed, the recording stops when the buffer is full.
+ */
+class TrackMap {
+public:
+    static constexpr uint32_t CAPACITY          = 1024;  // Maximum number of samples - a lap of 80 meters.
+    static constexpr uint32_t KEYFRAME_INTERVAL = 16;    // Number of samples between the keyframes.
+    static constexpr micro::centimeter_t SAMPLE_DIST = micro::centimeter_t(8); // Distance between the samples.
+
+    struct Sample {
+        micro::Pose pose;                       // The car pose.
+        float curvature;                        // Curvature of the car path before the sample [1/m].
+        micro::millimeter_t linePos;            // The line position.
+        micro::LinePattern::type_t pattern;     // The detected line pattern.
+    };
+
+    TrackMap();
+
+    /* @brief Clears the map, the next recorded state will be the first sample.
+     */
+    void reset();
+
+    /* @brief Records the car state, if the car has passed the distance of the next sample since the previous call.
+     * If the car has passed multiple samples, the pose is interpolated for the skipped ones.
+     * @param dist The distance from the start of the recording
+     * @param pose The car pose
+     * @param linePos The line position
+     * @param pattern The detected line pattern
+     */
+    void record(const micro::meter_t dist, const micro::Pose& pose, const micro::millimeter_t linePos, const micro::LinePattern::type_t pattern);
+
+    uint32_t size() const { return this->size_; }
+
+    /* @brief Gets the distance covered by the recorded samples.
+     */
+    micro::meter_t length() const;
+
+    /* @brief Gets the last recorded sample at or before the given distance.
+     * @note Calling it for an empty map is undefined behaviour.
+     */
+    Sample at(const micro::meter_t dist) const;
+
+private:
+    struct Keyframe {
+        float x;        // [m]
+        float y;        // [m]
+        float angle;    // [rad]
+    };
+
+    struct EncodedSample {
+        int8_t dx;          // X delta from the previous sample [POS_RESOLUTION].
+        int8_t dy;          // Y delta from the previous sample [POS_RESOLUTION].
+        int8_t dAngle;      // Heading delta from the previous sample [ANGLE_RESOLUTION].
+        int8_t linePos;     // The line position [LINE_POS_RESOLUTION].
+        uint8_t pattern;    // The line pattern type.
+    };
+
+    Keyframe decodePose(const uint32_t idx, float& dAngle) const;
+    void encode(const Keyframe& pose, const micro::millimeter_t linePos, const micro::LinePattern::type_t pattern);
+
+    Keyframe keyframes_[CAPACITY / KEYFRAME_INTERVAL];
+    EncodedSample samples_[CAPACITY];
+    uint32_t size_;
+    Keyframe lastDecoded_;      // The decoded pose of the last sample, the reference of the next delta.
+    micro::meter_t lastDist_;   // Distance of the last recorded state.
+    Keyframe lastPose_;         // The last recorded pose, the interpolation start of the skipped samples.
+    bool hasLastPose_;
+};
@@ -15,6 +15,11 @@ constexpr float           DIST_SENSOR_SERVO_TRANSFER_RATE = 1.0f;
 constexpr bool            DIST_SENSOR_SERVO_ENABLED       = false;
 constexpr micro::meter_t  MIN_TURN_RADIUS                 = micro::centimeter_t(40);
 
+constexpr micro::m_per_sec_t CAR_MAX_SPEED                = micro::m_per_sec_t(7.0f); // Top speed of the car, above the fastest speed of the race track tables.
+constexpr float           CAR_MAX_ACCELERATION            = 3.0f;                     // Maximum longitudinal acceleration [m/s^2].
+constexpr float           CAR_MAX_DECELERATION            = 4.0f;                     // Maximum longitudinal deceleration [m/s^2].
+constexpr float           CAR_MAX_LATERAL_ACCELERATION    = 5.0f;                     // Maximum lateral acceleration before the tires slip [m/s^2].
+
 constexpr bool            USE_SAFETY_ENABLE_SIGNAL        = true;
 constexpr bool            INDICATOR_LEDS_ENABLED          = true;
 constexpr uint8_t         REDUCED_LINE_DETECT_SCAN_RADIUS = 12;
@@ -16,6 +16,29 @@ constexpr micro::meter_t  MIN_JUNCTION_LENGTH            = micro::centimeter_t(2
 constexpr uint8_t         NUM_RACE_LAPS                  = 6;
 constexpr micro::radian_t MAX_TARGET_LINE_ANGLE          = micro::degree_t(18);
 
+constexpr micro::millisecond_t RACE_CURVATURE_PREVIEW_TIME                = micro::millisecond_t(50); // Time ahead of the car the curvature feed-forward is taken from, compensates the steering delay.
+constexpr uint8_t             RACE_FIRST_LEARNING_LAP                    = 4;                        // First lap whose speeds are adjusted by the lap learner (the first without the safety car).
+constexpr micro::meter_t       RACE_LEARNING_SAFE_LINE_ERROR              = micro::centimeter_t(5);   // Peak line error below which the lap learner increases the speeds.
+constexpr micro::meter_t       RACE_LEARNING_MAX_LINE_ERROR               = micro::centimeter_t(10);  // Peak line error above which the lap learner decreases the speeds.
+constexpr micro::m_per_sec_t   RACE_LEARNING_SPEED_STEP                   = micro::m_per_sec_t(0.1f); // Fast speed increase step of the lap learner, the decrease step is twice as much.
+constexpr micro::m_per_sec_t   RACE_LEARNING_MAX_SPEED_DELTA              = micro::m_per_sec_t(1.5f); // Maximum absolute fast speed delta of the lap learner.
+constexpr micro::meter_t       RACE_LEARNING_BRAKE_OFFSET_STEP            = micro::centimeter_t(5);   // Brake offset increase step of the lap learner, the decrease step is twice as much.
+constexpr micro::meter_t       RACE_LEARNING_MAX_BRAKE_OFFSET_DELTA       = micro::centimeter_t(100); // Maximum absolute brake offset delta of the lap learner.
+constexpr float               RACE_LEARNING_MIN_SPEED_REACHED_RATIO      = 0.95f;                    // Ratio of the target speed the car needs to reach for the lap learner to increase it.
+constexpr micro::meter_t       RACE_MISSED_BRAKE_SIGN_DIST                = micro::centimeter_t(30);  // Distance after the brake sign mapped in the safety-car laps, where the braking segment starts if the sign has not been detected.
+constexpr micro::meter_t       RACE_LINE_MAX_OFFSET                       = micro::centimeter_t(15);  // Maximum lateral offset of the car from the line on the optimized race line.
+
+constexpr micro::meter_t       LABYRINTH_FAST_SPEED_JUNCTION_MARGIN       = micro::centimeter_t(20);  // Distance from the junctions where fast speed is not allowed.
+constexpr micro::meter_t       LABYRINTH_FAST_SPEED_SIGN_CHANGE_DISTANCE  = micro::centimeter_t(100); // Distance after a speed sign change where fast speed is not allowed.
+constexpr micro::millisecond_t LABYRINTH_SPEED_RAMP_TIME                  = micro::millisecond_t(300);  // Ramp time of the speed sign changes.
+constexpr float               LABYRINTH_MAX_ACCELERATION                 = 2.0f;                     // Maximum acceleration of the labyrinth speed profile [m/s^2].
+constexpr float               LABYRINTH_MAX_DECELERATION                 = 3.0f;                     // Maximum deceleration of the labyrinth speed profile [m/s^2].
+constexpr micro::millisecond_t LABYRINTH_SIDE_DECISION_TIME               = micro::millisecond_t(100); // Estimated additional time of a left or right junction decision.
+constexpr uint8_t             LABYRINTH_TOUR_MAX_EXACT_TARGETS           = 8;                        // Maximum number of tour targets ordered optimally, the memory need grows exponentially.
+constexpr float               LABYRINTH_LOCALIZATION_MIN_PROBABILITY     = 0.5f;                     // Minimum probability of the localized junction for correcting the car position.
+constexpr micro::meter_t       LABYRINTH_OBSTACLE_DISTANCE                = micro::centimeter_t(60);  // Distance below which an obstacle in the direction of travel blocks the junction ahead.
+constexpr micro::meter_t       LABYRINTH_REVERSAL_DISTANCE                = micro::meter_t(1.2f);     // Distance driven when going back to the previous junction instead of passing through the segment.
+
 enum class ProgramState : uint8_t {
     // Start states
     INVALID              = 0,
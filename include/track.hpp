@@ -7,48 +7,96 @@
 
 #include <cfg_track.hpp>
 
-#include <functional>
+struct LabyrinthDescription;
+class LabyrinthGraph;
+
+constexpr uint32_t MAX_NUM_TRACK_SEGMENTS = 20;
+constexpr uint32_t MAX_NUM_TRACK_SECTIONS = 4;  // Maximum number of track sections - a fast segment and the slow segments that follow it.
 
-struct AccelerationRamps {
-    micro::millisecond_t fast1;
-    micro::millisecond_t fast2;
-    micro::millisecond_t fast3;
-    micro::millisecond_t fast4;
+/* @brief The event that activates a track segment.
+ */
+enum class TrackTrigger : uint8_t {
+    Accelerate, // An ACCELERATE pattern, followed by a straight line.
+    BrakeSign,  // A BRAKE pattern - the car brakes in the segment, after the brake offset.
+    SingleLine, // A SINGLE_LINE pattern.
+    Distance    // The length of the previous segment has been covered.
 };
 
-struct BrakeOffsets {
-    micro::meter_t slow1;
-    micro::meter_t slow2;
-    micro::meter_t slow3;
-    micro::meter_t slow4;
+/* @brief Shape of a line target profile along a track segment.
+ */
+enum class TrackProfileShape : uint8_t {
+    Constant,   // The end value in the whole segment.
+    Linear,     // Changes linearly from the target at the segment start to the end value.
+    Pyramid     // Changes linearly from the target at the segment start to the middle value at the half of the segment, then to the end value.
 };
 
-struct RaceTrackInfo;
-class LabyrinthGraph;
+template <typename T>
+struct TrackTargetProfile {
+    TrackProfileShape shape;
+    T middle;
+    T end;
+};
+
+/* @brief Line target profile of a track segment - zero-initialized, it follows the center of the line.
+ * @note The line position values of the linear and pyramid profiles are mirrored when the car is going backwards.
+ */
+struct TrackLineProfile {
+    TrackTargetProfile<micro::millimeter_t> pos;
+    TrackTargetProfile<micro::radian_t> angle;
+};
 
+constexpr TrackTargetProfile<micro::millimeter_t> track_pos_constant(const micro::millimeter_t value) { return { TrackProfileShape::Constant, value, value }; }
+constexpr TrackTargetProfile<micro::millimeter_t> track_pos_linear(const micro::millimeter_t end) { return { TrackProfileShape::Linear, end, end }; }
+constexpr TrackTargetProfile<micro::millimeter_t> track_pos_pyramid(const micro::millimeter_t middle, const micro::millimeter_t end) { return { TrackProfileShape::Pyramid, middle, end }; }
+constexpr TrackTargetProfile<micro::radian_t> track_angle_constant(const micro::radian_t value) { return { TrackProfileShape::Constant, value, value }; }
+constexpr TrackTargetProfile<micro::radian_t> track_angle_linear(const micro::radian_t end) { return { TrackProfileShape::Linear, end, end }; }
+constexpr TrackTargetProfile<micro::radian_t> track_angle_pyramid(const micro::radian_t middle, const micro::radian_t end) { return { TrackProfileShape::Pyramid, middle, end }; }
+
+/* @brief Plain data description of a race track segment, interpreted by RaceTrackInfo.
+ * The speed of a fast segment and of a slow segment is taken from the lap profile.
+ * In a BrakeSign segment the car keeps the speed of the previous (fast) segment until the brake offset.
+ */
 struct TrackSegment {
     bool isFast;
     micro::meter_t length;
-    std::function<bool(const micro::CarProps&, const RaceTrackInfo&, const micro::LinePattern&)> hasBecomeActive;
-    std::function<micro::ControlData(const micro::CarProps&, const RaceTrackInfo&, const micro::MainLine&)> getControl;
+    TrackTrigger trigger;               // The event that activates the segment.
+    TrackLineProfile safetyCarLine;     // Line target profile of the safety car laps (1 and 3).
+    TrackLineProfile raceLine;          // Line target profile of the other laps.
 };
 
-typedef micro::vec<TrackSegment, 20> TrackSegments;
+typedef micro::vec<TrackSegment, MAX_NUM_TRACK_SEGMENTS> TrackSegments;
+
+/* @brief Speeds, speed ramps and brake offsets of the race track laps - can be changed at runtime.
+ * Each table has a row for each lap, the last row is the one of the finish.
+ */
+struct TrackProfile {
+    micro::m_per_sec_t speeds[cfg::NUM_RACE_LAPS + 1][MAX_NUM_TRACK_SEGMENTS];                // Target speeds of the segments.
+    micro::millisecond_t accelerationRamps[cfg::NUM_RACE_LAPS + 1][MAX_NUM_TRACK_SECTIONS];   // Speed ramps of the fast segments and the following brake segments, by section.
+    micro::meter_t brakeOffsets[cfg::NUM_RACE_LAPS + 1][MAX_NUM_TRACK_SECTIONS];              // Distances the brake segments keep the fast speed for, by section.
+};
 
 extern const TrackSegments testTrackSegments;
 extern const TrackSegments raceTrackSegments;
 
+extern TrackProfile testTrackProfile;
+extern TrackProfile raceTrackProfile;
+
+extern const LabyrinthDescription testLabyrinthDescription;
+extern const LabyrinthDescription raceLabyrinthDescription;
+
 LabyrinthGraph buildTestLabyrinthGraph();
 LabyrinthGraph buildRaceLabyrinthGraph();
 
 #if TRACK == RACE_TRACK
 
 #define trackSegments           raceTrackSegments
+#define trackProfile            raceTrackProfile
 #define buildLabyrinthGraph()   buildRaceLabyrinthGraph()
 
 #elif TRACK == TEST_TRACK
 
 #define trackSegments           testTrackSegments
+#define trackProfile            testTrackProfile
 #define buildLabyrinthGraph()   buildTestLabyrinthGraph()
 
 #else
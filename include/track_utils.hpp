@@ -30,10 +30,10 @@ micro::millimeter_t track_map_pos_pyramid(const micro::CarProps& car, const Race
 micro::radian_t track_map_angle_linear(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::radian_t& end);
 micro::radian_t track_map_angle_pyramid(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::radian_t& middle, const micro::radian_t& end);
 
-bool hasBecomeActive_Fast(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::LinePattern& pattern);
-bool hasBecomeActive_BrakeSign(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::LinePattern& pattern);
-bool hasBecomeActive_SingleLine(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::LinePattern& pattern);
-bool hasBecomeActive_distance(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::LinePattern& pattern);
+/* @brief Gets the line position target of the car in the current segment, according to the given profile.
+ */
+micro::millimeter_t track_map_pos(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const TrackTargetProfile<micro::millimeter_t>& profile);
 
-micro::ControlData getControl_CommonFast(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::MainLine& mainLine, const micro::m_per_sec_t targetSpeed);
-micro::ControlData getControl_CommonSlow(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::MainLine& mainLine);
+/* @brief Gets the line angle target of the car in the current segment, according to the given profile.
+ */
+micro::radian_t track_map_angle(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const TrackTargetProfile<micro::radian_t>& profile);
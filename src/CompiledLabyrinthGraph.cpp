@@ -0,0 +1,141 @@
+#include <micro/utils/log.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+
+using namespace micro;
+
+constexpr CompiledLabyrinthGraph::index_t CompiledLabyrinthGraph::INVALID_INDEX;
+constexpr uint32_t CompiledLabyrinthGraph::MAX_NUM_SEGMENTS;
+constexpr uint32_t CompiledLabyrinthGraph::MAX_NUM_JUNCTIONS;
+constexpr uint32_t CompiledLabyrinthGraph::MAX_NUM_CONNECTIONS;
+constexpr uint8_t CompiledLabyrinthGraph::NUM_SIDES;
+constexpr uint8_t CompiledLabyrinthGraph::NUM_DIRECTIONS;
+
+CompiledLabyrinthGraph::CompiledLabyrinthGraph()
+    : source_(nullptr)
+    , numSegments_(0)
+    , numConnections_(0)
+    , numJunctions_(0) {
+
+    std::fill(this->segmentsByName_, this->segmentsByName_ + ('Z' - 'A' + 1), INVALID_INDEX);
+}
+
+Status CompiledLabyrinthGraph::compile(const LabyrinthGraph& graph) {
+    this->source_ = nullptr;
+
+    if (!graph.valid()) {
+        LOG_ERROR("Labyrinth graph is invalid, cannot be compiled");
+        return Status::INVALID_DATA;
+    }
+
+    if (graph.connections().size() >= INVALID_INDEX) {
+        LOG_ERROR("Labyrinth graph has too many connections to be compiled");
+        return Status::INVALID_DATA;
+    }
+
+    this->numSegments_    = static_cast<uint8_t>(graph.segments().size());
+    this->numConnections_ = static_cast<uint8_t>(graph.connections().size());
+    this->numJunctions_   = static_cast<uint8_t>(graph.junctions().size());
+
+    std::fill(this->segmentsByName_, this->segmentsByName_ + ('Z' - 'A' + 1), INVALID_INDEX);
+
+    index_t numEdges = 0;
+    for (const Segment& seg : graph.segments()) {
+        SegmentInfo& info = this->segments_[seg.idx];
+        info.length    = seg.length;
+        info.firstEdge = numEdges;
+        info.numEdges  = static_cast<index_t>(seg.edges.size());
+        info.name      = seg.name;
+        info.isDeadEnd = seg.isDeadEnd;
+
+        for (const Connection *conn : seg.edges) {
+            this->edges_[numEdges++] = static_cast<index_t>(conn->idx);
+        }
+
+        this->segmentsByName_[seg.name - 'A'] = static_cast<index_t>(seg.idx);
+    }
+
+    for (const Connection& conn : graph.connections()) {
+        ConnectionInfo& info = this->connections_[conn.idx];
+        info.segments[0]   = static_cast<index_t>(conn.node1->idx);
+        info.segments[1]   = static_cast<index_t>(conn.node2->idx);
+        info.junction      = static_cast<index_t>(conn.junction->idx);
+        info.sides[0]      = JunctionTopology::side(conn.decision1.orientation);
+        info.sides[1]      = JunctionTopology::side(conn.decision2.orientation);
+        info.directions[0] = conn.decision1.direction;
+        info.directions[1] = conn.decision2.direction;
+    }
+
+    for (const Junction& junc : graph.junctions()) {
+        std::fill(&this->junctionSegments_[junc.idx][0][0], &this->junctionSegments_[junc.idx][0][0] + NUM_SIDES * NUM_DIRECTIONS, INVALID_INDEX);
+
+        for (const Junction::segment_map::entry_type& sideSegments : junc.segments) {
+            const uint8_t side = JunctionTopology::side(sideSegments.first);
+            for (const Junction::side_segment_map::entry_type& seg : sideSegments.second) {
+                this->junctionSegments_[junc.idx][side][directionIndex(seg.first)] = static_cast<index_t>(seg.second->idx);
+            }
+        }
+    }
+
+    this->source_ = &graph;
+    return Status::OK;
+}
+
+CompiledLabyrinthGraph::index_t CompiledLabyrinthGraph::findSegment(char name) const {
+    return isBtw(name, 'A', 'Z') ? this->segmentsByName_[name - 'A'] : INVALID_INDEX;
+}
+
+CompiledLabyrinthGraph::index_t CompiledLabyrinthGraph::findConnection(const index_t seg1, const index_t seg2) const {
+    for (const index_t conn : this->edges(seg1)) {
+        if (this->getOtherSegment(conn, seg1) == seg2) {
+            return conn;
+        }
+    }
+    return INVALID_INDEX;
+}
+
+CompiledLabyrinthGraph::index_t CompiledLabyrinthGraph::getOtherSegment(const index_t conn, const index_t seg) const {
+    const ConnectionInfo& info = this->connections_[conn];
+    return info.segments[0] == seg ? info.segments[1] : info.segments[1] == seg ? info.segments[0] : INVALID_INDEX;
+}
+
+CompiledLabyrinthGraph::index_t CompiledLabyrinthGraph::getJunctionSegment(const index_t junc, const uint8_t side, const Direction dir) const {
+    return this->junctionSegments_[junc][side][directionIndex(dir)];
+}
+
+bool CompiledLabyrinthGraph::isConnected(const index_t junc, const index_t seg) const {
+    const index_t *first = &this->junctionSegments_[junc][0][0];
+    return std::find(first, first + NUM_SIDES * NUM_DIRECTIONS, seg) != first + NUM_SIDES * NUM_DIRECTIONS;
+}
+
+bool CompiledLabyrinthGraph::isForwardConnection(const index_t prevConn, const index_t seg, const index_t newConn) const {
+    const ConnectionInfo& prev = this->connections_[prevConn];
+    const ConnectionInfo& next = this->connections_[newConn];
+    const uint8_t prevDecision = this->decisionIndex(prevConn, seg);
+    const uint8_t nextDecision = this->decisionIndex(newConn, seg);
+
+    // does not permit going backwards
+    const bool isBwd = next.junction == prev.junction &&
+        next.sides[nextDecision] == prev.sides[prevDecision] &&
+        next.directions[nextDecision] == prev.directions[prevDecision];
+    return !isBwd;
+}
+
+meter_t CompiledLabyrinthGraph::connectionCost(const index_t prevConn, const index_t seg, const index_t newConn, const bool isStartSeg, const bool allowBackwardNavigation) const {
+    const meter_t currentLength = this->segments_[seg].length;
+    const meter_t newLength     = this->segments_[this->getOtherSegment(newConn, seg)].length;
+
+    // when going back to the previous junction, distance is not the same as when passing through the whole segment
+    return !isStartSeg && allowBackwardNavigation && this->connections_[prevConn].junction == this->connections_[newConn].junction ?
+        cfg::LABYRINTH_REVERSAL_DISTANCE - currentLength / 2 + newLength / 2 :
+        currentLength / 2 + newLength / 2;
+}
+
+uint8_t CompiledLabyrinthGraph::directionIndex(const Direction dir) {
+    return Direction::LEFT == dir ? 0 : Direction::CENTER == dir ? 1 : 2;
+}
+
+uint8_t CompiledLabyrinthGraph::decisionIndex(const index_t conn, const index_t seg) const {
+    // same as Connection::getDecision
+    return this->connections_[conn].segments[0] == seg ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#include <micro/math/numeric.hpp>
+
+#include <GainSchedule.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace micro;
+
+namespace {
+
+bool isEqual(const PID_Params& a, const PID_Params& b) {
+    return a.P == b.P && a.I == b.I && a.D == b.D;
+}
+
+} // namespace
+
+GainSchedule::GainSchedule(const Breakpoints& breakpoints)
+    : breakpoints_(breakpoints)
+    , samples_()
+    , step_(0)
+    , sampleIdx_(0)
+    , hasChanged_(false) {
+    this->compile();
+    this->hasChanged_ = true;
+}
+
+bool GainSchedule::compile() {
+    m_per_sec_t maxSpeed = m_per_sec_t(0);
+    for (const Breakpoint& breakpoint : this->breakpoints_) {
+        maxSpeed = std::max(maxSpeed, breakpoint.first);
+    }
+
+    this->step_ = maxSpeed / static_cast<float>(NUM_SAMPLES);
+
+    bool hasChanged = false;
+    for (uint32_t i = 0; i < NUM_SAMPLES; ++i) {
+        const PID_Params sample = this->interpolate(this->step_ * static_cast<float>(i + 1));
+        if (!isEqual(sample, this->samples_[i])) {
+            this->samples_[i] = sample;
+            hasChanged = true;
+        }
+    }
+
+    this->hasChanged_ |= hasChanged;
+    return hasChanged;
+}
+
+bool GainSchedule::update(const m_per_sec_t speed) {
+    // sample i is taken at (i + 1) steps, the speeds below the first sample are clamped to it
+    const uint32_t sampleIdx = this->step_ > m_per_sec_t(0) ?
+        static_cast<uint32_t>(clamp(std::round(abs(speed) / this->step_) - 1.0f, 0.0f, static_cast<float>(NUM_SAMPLES - 1))) :
+        0;
+
+    const bool hasChanged = this->hasChanged_ || sampleIdx != this->sampleIdx_;
+    this->sampleIdx_  = sampleIdx;
+    this->hasChanged_ = false;
+    return hasChanged;
+}
+
+PID_Params GainSchedule::interpolate(const m_per_sec_t speed) const {
+    const Breakpoint *lower = nullptr;
+    const Breakpoint *upper = nullptr;
+
+    for (const Breakpoint& breakpoint : this->breakpoints_) {
+        if (breakpoint.first <= speed && (!lower || breakpoint.first > lower->first)) {
+            lower = &breakpoint;
+        }
+        if (breakpoint.first >= speed && (!upper || breakpoint.first < upper->first)) {
+            upper = &breakpoint;
+        }
+    }
+
+    if (!lower || !upper) {
+        return lower ? lower->second : upper ? upper->second : PID_Params{};
+    }
+
+    if (upper->first == lower->first) {
+        return lower->second;
+    }
+
+    const float ratio = (speed - lower->first) / (upper->first - lower->first);
+    return {
+        lower->second.P + (upper->second.P - lower->second.P) * ratio,
+        lower->second.I + (upper->second.I - lower->second.I) * ratio,
+        lower->second.D + (upper->second.D - lower->second.D) * ratio
+    };
+}
+
+GainScheduleEditor::GainScheduleEditor(GainSchedule::Breakpoints& breakpoints)
+    : index(0)
+    , speed(0)
+    , gains()
+    , breakpoints_(breakpoints)
+    , loadedIndex_(0) {
+    this->load();
+}
+
+bool GainScheduleEditor::apply() {
+    // an invalid selection is reverted
+    if (this->index >= this->breakpoints_.size()) {
+        this->index = this->loadedIndex_;
+    }
+
+    if (this->index != this->loadedIndex_) {
+        this->load();
+        return false;
+    }
+
+    if (this->loadedIndex_ >= this->breakpoints_.size()) {
+        return false;
+    }
+
+    GainSchedule::Breakpoint& breakpoint = this->breakpoints_[this->loadedIndex_];
+    const bool hasChanged = breakpoint.first != this->speed || !isEqual(breakpoint.second, this->gains);
+    breakpoint.first  = this->speed;
+    breakpoint.second = this->gains;
+    return hasChanged;
+}
+
+void GainScheduleEditor::load() {
+    this->loadedIndex_ = this->index;
+    if (this->loadedIndex_ < this->breakpoints_.size()) {
+        const GainSchedule::Breakpoint& breakpoint = this->breakpoints_[this->loadedIndex_];
+        this->speed = breakpoint.first;
+        this->gains = breakpoint.second;
+    }
+}
@@ -6,6 +6,9 @@
 
 using namespace micro;
 
+constexpr uint32_t LabyrinthConnections::CAPACITY;
+constexpr uint8_t LabyrinthDescription::INVALID_INDEX;
+
 Segment* Connection::getOtherSegment(const Segment& seg) const {
     return this->node1 == &seg ? this->node2 : this->node2 == &seg ? this->node1 : nullptr;
 }
@@ -96,6 +99,14 @@ Junction::segment_info Junction::getSegmentInfo(const Segment& seg) const {
     return info;
 }
 
+JunctionTopology Junction::getTopology() const {
+    JunctionTopology topology;
+    for (const segment_map::entry_type& sideSegments : this->segments) {
+        topology.numSegments[JunctionTopology::side(sideSegments.first)] = static_cast<uint8_t>(sideSegments.second.size());
+    }
+    return topology;
+}
+
 bool Segment::isFloating() const {
     Junction *j1 = nullptr;
     bool floating = true;
@@ -129,12 +140,49 @@ bool Segment::isLoop() const {
     return this->edges.size() > 0 && this->edges[0]->junction->getSegmentInfo(*this).size() == 2;
 }
 
+void LabyrinthGraph::build(const LabyrinthDescription& desc, const LabyrinthConnections& connections) {
+
+    const auto decision = [&desc](const uint8_t idx) {
+        const DecisionDescription& d = desc.decisions[idx];
+        return JunctionDecision(static_cast<float>(LabyrinthDescription::normalize(d.orientation) / 90) * PI_2, d.direction);
+    };
+
+    for (uint32_t i = 0; i < desc.numSegments; ++i) {
+        const SegmentDescription& seg = desc.segments[i];
+        this->addSegment(Segment(seg.name, centimeter_t(seg.length), seg.isDeadEnd));
+    }
+
+    for (uint32_t i = 0; i < desc.numJunctions; ++i) {
+        const JunctionDescription& junc = desc.junctions[i];
+        this->addJunction(Junction(junc.id, { centimeter_t(junc.x), centimeter_t(junc.y) }));
+    }
+
+    // the connections have already been calculated by the compiler, so the junction sides do not need to be searched
+    for (uint32_t i = 0; i < desc.numDecisions; ++i) {
+        Junction& junc = this->junctions_[desc.junctionIndex(desc.decisions[i].junction)];
+        junc.addSegment(this->segments_[desc.segmentIndex(desc.decisions[i].segment)], decision(i));
+    }
+
+    for (uint32_t i = 0; i < connections.size; ++i) {
+        const ConnectionDescription& c = connections.items[i];
+        Segment& seg1 = this->segments_[c.segment1];
+        Segment& seg2 = this->segments_[c.segment2];
+
+        Connections::iterator conn = this->connections_.push_back(Connection(seg1, seg2, this->junctions_[c.junction], decision(c.decision1), decision(c.decision2)));
+        conn->idx = static_cast<uint16_t>(this->connections_.size() - 1);
+        seg1.edges.push_back(to_raw_pointer(conn));
+        seg2.edges.push_back(to_raw_pointer(conn));
+    }
+}
+
 void LabyrinthGraph::addSegment(const Segment& seg) {
-    this->segments_.push_back(seg);
+    Segments::iterator it = this->segments_.push_back(seg);
+    it->idx = static_cast<uint16_t>(this->segments_.size() - 1);
 }
 
 void LabyrinthGraph::addJunction(const Junction& junc) {
-    this->junctions_.push_back(junc);
+    Junctions::iterator it = this->junctions_.push_back(junc);
+    it->idx = static_cast<uint16_t>(this->junctions_.size() - 1);
 }
 
 void LabyrinthGraph::connect(Segment *seg, Junction *junc, const JunctionDecision& decision) {
@@ -146,6 +194,7 @@ void LabyrinthGraph::connect(Segment *seg, Junction *junc, const JunctionDecisio
     if (otherSideSegments != junc->segments.end()) {
         for (Junction::side_segment_map::iterator out = otherSideSegments->second.begin(); out != otherSideSegments->second.end(); ++out) {
             Connections::iterator conn = this->connections_.push_back(Connection(*seg, *out->second, *junc, decision, { otherSideSegments->first, out->first }));
+            conn->idx = static_cast<uint16_t>(this->connections_.size() - 1);
             seg->edges.push_back(to_raw_pointer(conn));
             out->second->edges.push_back(to_raw_pointer(conn));
         }
@@ -176,71 +225,6 @@ const Junction* LabyrinthGraph::findJunction(uint8_t id) const {
     return it != this->junctions_.end() ? to_raw_pointer(it) : nullptr;
 }
 
-const Junction* LabyrinthGraph::findJunction(const point2m& pos, const micro::vec<std::pair<micro::radian_t, uint8_t>, 2>& numSegments) const {
-
-    Junctions::const_iterator result = this->junctions_.end();
-
-    struct JunctionDist {
-        Junctions::const_iterator junc;
-        meter_t dist;
-    };
-
-    LOG_DEBUG("pos: (%f, %f)", pos.X.get(), pos.Y.get());
-
-    // FIRST:  closest junction to current position
-    // SECOND: closest junction to current position with the correct topology
-    std::pair<JunctionDist, JunctionDist> closest = {
-        { this->junctions_.end(), micro::numeric_limits<meter_t>::infinity() },
-        { this->junctions_.end(), micro::numeric_limits<meter_t>::infinity() }
-    };
-
-    for(Junctions::const_iterator it = this->junctions_.begin(); it != this->junctions_.end(); ++it) {
-        const meter_t dist = pos.distance(it->pos);
-
-        if (dist < closest.first.dist) {
-            closest.first.junc = to_raw_pointer(it);
-            closest.first.dist = dist;
-        }
-
-        if (dist < closest.second.dist) {
-            bool topologyOk = true;
-            for (const std::pair<micro::radian_t, uint8_t>& numSegs : numSegments) {
-                const Junction::segment_map::const_iterator segments = it->getSideSegments(numSegs.first);
-                if (segments == it->segments.end() || segments->second.size() != numSegs.second) {
-                    topologyOk = false;
-                    break;
-                }
-            }
-
-            if (topologyOk) {
-                closest.second.junc = to_raw_pointer(it);
-                closest.second.dist = dist;
-            }
-        }
-    }
-
-    if (closest.first.junc) {
-        LOG_DEBUG("closest: (%f, %f)", closest.first.junc->pos.X.get(), closest.first.junc->pos.Y.get());
-    }
-
-    if (closest.second.junc) {
-        LOG_DEBUG("closest with correct topology: (%f, %f)", closest.second.junc->pos.X.get(), closest.second.junc->pos.Y.get());
-    }
-
-    if (closest.second.dist < centimeter_t(120)) {
-        // a junction at the right position and the correct topology has been found
-        result = closest.second.junc;
-    } else if (closest.first.dist < centimeter_t(80)) {
-        // a junction at the right position but with incorrect topology has been found
-        result = closest.first.junc;
-    } else {
-        // the junction has not been found, returns closest
-        result = closest.first.junc;
-    }
-
-    return result != this->junctions_.end() ? to_raw_pointer(result) : nullptr;
-}
-
 const Connection* LabyrinthGraph::findConnection(const Segment& seg1, const Segment& seg2) const {
     const auto it = std::find_if(this->connections_.begin(), this->connections_.end(), [&seg1, &seg2](const Connection& c) {
         return (c.node1->name == seg1.name && c.node2->name == seg2.name) || (c.node1->name == seg2.name && c.node2->name == seg1.name);
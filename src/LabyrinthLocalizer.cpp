@@ -0,0 +1,236 @@
+#include <micro/utils/log.hpp>
+
+#include <LabyrinthLocalizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace micro;
+
+namespace {
+
+constexpr float TOPOLOGY_MISMATCH_LIKELIHOOD    = 0.1f;   // Likelihood of a junction side with a different number of segments than observed.
+constexpr float ORIENTATION_MISMATCH_LIKELIHOOD = 0.2f;   // Likelihood of a junction side with a different orientation than observed.
+constexpr float MIN_GAUSSIAN_LIKELIHOOD         = 0.01f;  // Lower bound of the position and distance likelihoods.
+constexpr meter_t POSITION_STDDEV               = centimeter_t(50);
+constexpr meter_t DISTANCE_STDDEV               = centimeter_t(20);
+constexpr float DISTANCE_RELATIVE_STDDEV        = 0.1f;   // Standard deviation of the travelled distance, relative to the segment length.
+constexpr float DECISION_PROBABILITY            = 0.9f;   // Probability of taking the decision of the target direction.
+constexpr float KIDNAP_PROBABILITY              = 0.001f; // Probability of any state after a junction, regardless of the previous belief.
+
+float gaussianLikelihood(const float error, const float stddev) {
+    return std::max(std::exp(-error * error / (2.0f * stddev * stddev)), MIN_GAUSSIAN_LIKELIHOOD);
+}
+
+} // namespace
+
+constexpr uint32_t LabyrinthLocalizer::MAX_NUM_STATES;
+
+LabyrinthLocalizer::LabyrinthLocalizer(const CompiledLabyrinthGraph& graph)
+    : graph_(graph)
+    , isReversed_(false) {
+
+    std::fill(this->belief_, this->belief_ + MAX_NUM_STATES, 0.0f);
+}
+
+void LabyrinthLocalizer::initialize(const index_t prevConn, const index_t seg) {
+    std::fill(this->belief_, this->belief_ + MAX_NUM_STATES, 0.0f);
+    this->belief_[this->getState(prevConn, seg)] = 1.0f;
+    this->isReversed_ = false;
+}
+
+LabyrinthLocalizer::Hypothesis LabyrinthLocalizer::observeJunction(const Observation& observation) {
+    float likelihoods[MAX_NUM_STATES];
+    float total = 0.0f;
+
+    for (state_t state = 0; state < this->numStates(); ++state) {
+        likelihoods[state] = this->likelihood(state, observation);
+        total += this->belief_[state] * likelihoods[state];
+    }
+
+    // the prior does not support the observation at all, so the car is localized from the observation only
+    const bool isPriorValid = total > 0.0f;
+    if (!isPriorValid) {
+        LOG_WARN("Observed junction contradicts the labyrinth localization belief");
+    }
+
+    Hypothesis result = { CompiledLabyrinthGraph::INVALID_INDEX, CompiledLabyrinthGraph::INVALID_INDEX, CompiledLabyrinthGraph::INVALID_INDEX, 0.0f };
+    state_t best = 0;
+
+    for (state_t state = 0; state < this->numStates(); ++state) {
+        this->belief_[state] = (isPriorValid ? this->belief_[state] : 1.0f) * likelihoods[state];
+        if (this->belief_[state] > this->belief_[best]) {
+            best = state;
+        }
+    }
+
+    this->normalize();
+    this->isReversed_ = observation.isReversed;
+
+    if (this->belief_[best] > 0.0f) {
+        result.prevConn    = this->getConnection(best);
+        result.seg         = this->getSegment(best);
+        result.junction    = this->nextJunction(best, observation.isReversed);
+        result.probability = this->belief_[best];
+    }
+
+    return result;
+}
+
+void LabyrinthLocalizer::passJunction(const Direction dir) {
+    float belief[MAX_NUM_STATES];
+    std::fill(belief, belief + MAX_NUM_STATES, 0.0f);
+
+    for (state_t state = 0; state < this->numStates(); ++state) {
+        if (0.0f == this->belief_[state]) {
+            continue;
+        }
+
+        const index_t prevConn = this->getConnection(state);
+        const index_t seg      = this->getSegment(state);
+
+        uint8_t numNext = 0, numMatching = 0;
+        for (const index_t newConn : this->graph_.edges(seg)) {
+            if (this->isNextConnection(prevConn, seg, newConn, this->isReversed_)) {
+                const index_t newSeg = this->graph_.getOtherSegment(newConn, seg);
+                const CompiledLabyrinthGraph::ConnectionInfo& conn = this->graph_.connection(newConn);
+                ++numNext;
+                if (conn.directions[conn.segments[0] == newSeg ? 0 : 1] == dir) {
+                    ++numMatching;
+                }
+            }
+        }
+
+        // the car takes the decision of the target direction, unless the junction has no such decision
+        for (const index_t newConn : this->graph_.edges(seg)) {
+            if (this->isNextConnection(prevConn, seg, newConn, this->isReversed_)) {
+                const index_t newSeg = this->graph_.getOtherSegment(newConn, seg);
+                const CompiledLabyrinthGraph::ConnectionInfo& conn = this->graph_.connection(newConn);
+                const bool isMatching = conn.directions[conn.segments[0] == newSeg ? 0 : 1] == dir;
+
+                const float p =
+                    0 == numMatching || numMatching == numNext ? 1.0f / numNext :
+                    isMatching                                 ? DECISION_PROBABILITY / numMatching :
+                    (1.0f - DECISION_PROBABILITY) / (numNext - numMatching);
+
+                belief[this->getState(newConn, newSeg)] += this->belief_[state] * p;
+            }
+        }
+    }
+
+    for (state_t state = 0; state < this->numStates(); ++state) {
+        this->belief_[state] = belief[state] + KIDNAP_PROBABILITY / this->numStates();
+    }
+
+    this->normalize();
+}
+
+bool LabyrinthLocalizer::isNextConnection(const index_t prevConn, const index_t seg, const index_t newConn, const bool isReversed) const {
+    // after a speed sign change the car goes back to the previous junction
+    return isReversed != this->graph_.isForwardConnection(prevConn, seg, newConn);
+}
+
+float LabyrinthLocalizer::probability(const index_t prevConn, const index_t seg) const {
+    return this->belief_[this->getState(prevConn, seg)];
+}
+
+uint32_t LabyrinthLocalizer::numStates() const {
+    return 2 * this->graph_.numConnections();
+}
+
+LabyrinthLocalizer::state_t LabyrinthLocalizer::getState(const index_t prevConn, const index_t seg) const {
+    return static_cast<state_t>(2 * prevConn + (this->graph_.connection(prevConn).segments[1] == seg ? 1 : 0));
+}
+
+LabyrinthLocalizer::index_t LabyrinthLocalizer::getConnection(const state_t state) const {
+    return static_cast<index_t>(state / 2);
+}
+
+LabyrinthLocalizer::index_t LabyrinthLocalizer::getSegment(const state_t state) const {
+    return this->graph_.connection(this->getConnection(state)).segments[state % 2];
+}
+
+LabyrinthLocalizer::index_t LabyrinthLocalizer::nextJunction(const state_t state, const bool isReversed) const {
+    const index_t prevConn = this->getConnection(state);
+    const index_t seg      = this->getSegment(state);
+
+    for (const index_t newConn : this->graph_.edges(seg)) {
+        if (this->isNextConnection(prevConn, seg, newConn, isReversed)) {
+            return this->graph_.connection(newConn).junction;
+        }
+    }
+
+    return CompiledLabyrinthGraph::INVALID_INDEX;
+}
+
+uint8_t LabyrinthLocalizer::numSideSegments(const index_t junc, const uint8_t side) const {
+    uint8_t result = 0;
+    for (const Direction dir : { Direction::LEFT, Direction::CENTER, Direction::RIGHT }) {
+        if (CompiledLabyrinthGraph::INVALID_INDEX != this->graph_.getJunctionSegment(junc, side, dir)) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+float LabyrinthLocalizer::likelihood(const state_t state, const Observation& observation) const {
+    const index_t prevConn = this->getConnection(state);
+    const index_t seg      = this->getSegment(state);
+
+    // finds the sides of the next junction the car is coming from and going to
+    index_t nextConn = CompiledLabyrinthGraph::INVALID_INDEX;
+    for (const index_t newConn : this->graph_.edges(seg)) {
+        if (this->isNextConnection(prevConn, seg, newConn, observation.isReversed)) {
+            nextConn = newConn;
+            break;
+        }
+    }
+
+    // the car cannot leave the segment in the observed direction (e.g. a dead-end segment without speed sign change)
+    if (CompiledLabyrinthGraph::INVALID_INDEX == nextConn) {
+        return 0.0f;
+    }
+
+    const CompiledLabyrinthGraph::ConnectionInfo& conn = this->graph_.connection(nextConn);
+    const uint8_t segDecision = conn.segments[0] == seg ? 0 : 1;
+    const uint8_t inSide      = conn.sides[segDecision];
+    const uint8_t outSide     = conn.sides[1 - segDecision];
+
+    float result = 1.0f;
+
+    if (this->numSideSegments(conn.junction, inSide) != observation.numInSegments) {
+        result *= TOPOLOGY_MISMATCH_LIKELIHOOD;
+    }
+
+    if (this->numSideSegments(conn.junction, outSide) != observation.numOutSegments) {
+        result *= TOPOLOGY_MISMATCH_LIKELIHOOD;
+    }
+
+    if (JunctionTopology::side(observation.inOrientation) != inSide || JunctionTopology::side(observation.outOrientation) != outSide) {
+        result *= ORIENTATION_MISMATCH_LIKELIHOOD;
+    }
+
+    const point2m& juncPos = this->graph_.source().junctions()[conn.junction].pos;
+    result *= gaussianLikelihood(juncPos.distance(observation.pos).get(), POSITION_STDDEV.get());
+
+    // the distance travelled in a segment is only known when the car passes through the whole segment
+    if (!observation.isReversed) {
+        const meter_t length = this->graph_.segment(seg).length;
+        result *= gaussianLikelihood((observation.distance - length).get(), (DISTANCE_STDDEV + length * DISTANCE_RELATIVE_STDDEV).get());
+    }
+
+    return result;
+}
+
+void LabyrinthLocalizer::normalize() {
+    float total = 0.0f;
+    for (state_t state = 0; state < this->numStates(); ++state) {
+        total += this->belief_[state];
+    }
+
+    if (total > 0.0f) {
+        for (state_t state = 0; state < this->numStates(); ++state) {
+            this->belief_[state] /= total;
+        }
+    }
+}
@@ -2,6 +2,9 @@
 
 #include <LabyrinthNavigator.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace micro;
 
 LabyrinthNavigator::LabyrinthNavigator(const LabyrinthGraph& graph, const Segment *startSeg, const Connection *prevConn, const Segment *laneChangeSeg,
@@ -16,18 +19,39 @@ LabyrinthNavigator::LabyrinthNavigator(const LabyrinthGraph& graph, const Segmen
     , currentSeg_(this->startSeg_)
     , targetSeg_(startSeg)
     , laneChangeSeg_(laneChangeSeg)
+    , localizer_(this->compiledGraph_)
+    , speedProfile_(cfg::LABYRINTH_MAX_ACCELERATION, cfg::LABYRINTH_MAX_DECELERATION)
+    , routeCost_(targetSpeed, targetFastSpeed, targetDeadEndSpeed, this->speedProfile_, cfg::LABYRINTH_SPEED_RAMP_TIME, cfg::LABYRINTH_SIDE_DECISION_TIME)
+    , routePlanner_(this->compiledGraph_, true, this->routeCost_)
+    , isFollowingTour_(false)
     , route_(startSeg)
+    , obstacleSeg_(nullptr)
     , isLastTarget_(false)
+    , hasPassedJunction_(false)
     , lastJuncDist_(0)
     , targetDir_(Direction::CENTER)
     , targetSpeedSign_(Sign::POSITIVE)
     , isSpeedSignChangeInProgress_(false)
     , hasSpeedSignChanged_(false)
-    , isInJunction_(false)
-    , random_(0) {}
+    , isInJunction_(false) {}
 
-void LabyrinthNavigator::initialize() {
+Status LabyrinthNavigator::initialize() {
     this->currentSeg_ = this->startSeg_;
+    this->unblockObstacles();
+    this->obstacleSeg_       = nullptr;
+    this->hasPassedJunction_ = false;
+    this->lastJuncDist_      = meter_t(0);
+
+    const Status status = this->compiledGraph_.compile(this->graph_);
+    if (Status::OK != status) {
+        LOG_ERROR("Labyrinth graph compilation failed");
+        return status;
+    }
+
+    if (this->prevConn_) {
+        this->localizer_.initialize(static_cast<CompiledLabyrinthGraph::index_t>(this->prevConn_->idx), static_cast<CompiledLabyrinthGraph::index_t>(this->currentSeg_->idx));
+    }
+    return Status::OK;
 }
 
 const Segment* LabyrinthNavigator::currentSegment() const {
@@ -48,8 +72,65 @@ bool LabyrinthNavigator::isLastTarget() const {
 
 void LabyrinthNavigator::setTargetSegment(const Segment *targetSeg, bool isLast) {
     LOG_DEBUG("Next target segment: %c", targetSeg->name);
-    this->targetSeg_    = targetSeg;
-    this->isLastTarget_ = isLast;
+    this->targetSeg_       = targetSeg;
+    this->isLastTarget_    = isLast;
+    this->isFollowingTour_ = false;
+}
+
+second_t LabyrinthNavigator::setTargetSegments(LabyrinthTourPlanner& tourPlanner, const LabyrinthTourPlanner::Targets& targets) {
+    const LabyrinthTourPlanner::Tour tour = tourPlanner.create(this->routePlanner_, *this->prevConn_, *this->currentSeg_, targets, *this->laneChangeSeg_);
+
+    LOG_DEBUG("Planned tour (estimated time: %f [s]):", tour.cost);
+    for (const Segment *seg : tour.targets) {
+        LOG_DEBUG("-> %c", seg->name);
+    }
+
+    // keeps the current target if the tour is not feasible
+    if (tour.targets.size() == targets.size()) {
+        this->tourTargets_     = tour.targets;
+        this->isFollowingTour_ = true;
+        this->nextTourTarget();
+    }
+
+    return second_t(tour.cost);
+}
+
+void LabyrinthNavigator::setBlocked(const Connection& conn, const bool isBlocked) {
+    this->routePlanner_.setBlocked(conn, isBlocked);
+
+    // forces re-planning, the planner only updates the states affected by the blocked connection
+    this->route_.reset(*this->currentSeg_);
+}
+
+void LabyrinthNavigator::handleObstacles(const Distances& distances) {
+    const meter_t obstacleDist = Sign::POSITIVE == this->targetSpeedSign_ ? distances.front : distances.rear;
+
+    // the car only turns back once in a segment, so obstacles are only avoided on the way to the junction ahead
+    if (obstacleDist > cfg::LABYRINTH_OBSTACLE_DISTANCE || this->obstacleSeg_ == this->currentSeg_ || this->isInJunction_ ||
+        this->hasSpeedSignChanged_ || !this->prevConn_ || this->currentSeg_->isLoop()) {
+        return;
+    }
+
+    this->obstacleSeg_ = this->currentSeg_;
+
+    for (const Connection *conn : this->currentSeg_->edges) {
+        if (conn->junction != this->prevConn_->junction) {
+            this->obstacleBlockedConns_.push_back(conn);
+            this->setBlocked(*conn, true);
+        }
+    }
+
+    if (std::isinf(this->routePlanner_.routeCost(*this->prevConn_, *this->currentSeg_, *this->targetSeg_))) {
+        LOG_WARN("Obstacle detected in segment %c at %f [m], but the target is only reachable through it", this->currentSeg_->name, obstacleDist.get());
+        this->unblockObstacles();
+        this->route_.reset(*this->currentSeg_);
+    } else {
+        LOG_WARN("Obstacle detected in segment %c at %f [m], junction ahead blocked", this->currentSeg_->name, obstacleDist.get());
+    }
+}
+
+const LabyrinthRoutePlanner::Counters& LabyrinthNavigator::routePlannerCounters() const {
+    return this->routePlanner_.counters();
 }
 
 void LabyrinthNavigator::update(const micro::CarProps& car, const micro::LineInfo& lineInfo, micro::MainLine& mainLine, micro::ControlData& controlData) {
@@ -58,8 +139,9 @@ void LabyrinthNavigator::update(const micro::CarProps& car, const micro::LineInf
 
     updateCarOrientation(car, lineInfo);
 
-    const LinePattern& prevFrontPattern = this->frontLinePattern(this->prevLineInfo_);
-    const LinePattern& prevRearPattern  = this->rearLinePattern(this->prevLineInfo_);
+    // only the patterns of the previous line info are stored, the lines are not needed for detecting the pattern changes
+    const LinePattern& prevFrontPattern = Sign::POSITIVE == this->targetSpeedSign_ ? this->prevFrontSensorPattern_ : this->prevRearSensorPattern_;
+    const LinePattern& prevRearPattern  = Sign::POSITIVE == this->targetSpeedSign_ ? this->prevRearSensorPattern_ : this->prevFrontSensorPattern_;
     const LinePattern& frontPattern     = this->frontLinePattern(lineInfo);
     const LinePattern& rearPattern      = this->rearLinePattern(lineInfo);
 
@@ -91,6 +173,10 @@ void LabyrinthNavigator::update(const micro::CarProps& car, const micro::LineInf
         }
     }
 
+    if (this->isFollowingTour_ && this->currentSeg_ == this->targetSeg_ && !this->isLastTarget_) {
+        this->nextTourTarget();
+    }
+
     if (this->targetSeg_ != this->route_.destSeg || this->currentSeg_ != this->route_.startSeg) {
         this->updateRoute();
     }
@@ -106,7 +192,8 @@ void LabyrinthNavigator::update(const micro::CarProps& car, const micro::LineInf
 
     this->setControl(car, lineInfo, mainLine, controlData);
 
-    this->prevLineInfo_ = lineInfo;
+    this->prevFrontSensorPattern_ = lineInfo.front.pattern;
+    this->prevRearSensorPattern_  = lineInfo.rear.pattern;
 
     if (this->isLastTarget_ && (LinePattern::LANE_CHANGE == frontPattern.type || LinePattern::LANE_CHANGE == rearPattern.type)) {
         this->finish();
@@ -147,11 +234,6 @@ void LabyrinthNavigator::handleJunction(const CarProps& car, uint8_t numInSegmen
     const radian_t posOri = round90(car.speed >= m_per_sec_t(0) ? car.pose.angle : car.pose.angle + PI);
     const radian_t negOri = round90(posOri + PI);
 
-    const micro::vec<std::pair<micro::radian_t, uint8_t>, 2> numSegments = {
-        { negOri, numInSegments  },
-        { posOri, numOutSegments }
-    };
-
     LOG_DEBUG("Junction detected (car pos: (%f, %f), angle: %f deg, segments: (in: %u, out: %u))",
         car.pose.pos.X.get(),
         car.pose.pos.Y.get(),
@@ -159,64 +241,78 @@ void LabyrinthNavigator::handleJunction(const CarProps& car, uint8_t numInSegmen
         static_cast<uint32_t>(numInSegments),
         static_cast<uint32_t>(numOutSegments));
 
-    const Junction *junc = this->graph_.findJunction(car.pose.pos, numSegments);
+    const LabyrinthLocalizer::Observation observation = {
+        car.pose.pos, negOri, posOri, numInSegments, numOutSegments, car.distance - this->lastJuncDist_, this->hasSpeedSignChanged_
+    };
 
-    // checks if any junction has been found at the current position
-    if (junc) {
-        LOG_DEBUG("Junction found: %u (%f, %f), current segment: %c",
-            static_cast<uint32_t>(junc->id),
-            junc->pos.X.get(),
-            junc->pos.Y.get(),
-            this->currentSeg_->name);
+    const LabyrinthLocalizer::Hypothesis hypothesis = this->localizer_.observeJunction(observation);
 
-        this->correctedCarPose_.pos = junc->pos;
+    if (CompiledLabyrinthGraph::INVALID_INDEX != hypothesis.junction) {
+        const Junction& junc       = this->graph_.junctions()[hypothesis.junction];
+        const Segment& seg         = this->graph_.segments()[hypothesis.seg];
+        const Connection& prevConn = this->graph_.connections()[hypothesis.prevConn];
 
-        // checks if current segment connects to found junction
-        if (junc->getSegmentInfo(*this->currentSeg_).size() > 0) {
-            const Connection *nextConn = this->route_.firstConnection();
+        LOG_DEBUG("Junction localized: %u (%f, %f), current segment: %c, probability: %f",
+            static_cast<uint32_t>(junc.id),
+            junc.pos.X.get(),
+            junc.pos.Y.get(),
+            seg.name,
+            hypothesis.probability);
 
-            // checks if next connection is available, meaning the route is not yet finished
-            if (nextConn) {
-                if (junc == nextConn->junction) {
-                    this->targetDir_ = nextConn->getDecision(*nextConn->getOtherSegment(*this->route_.startSeg)).direction;
-                    LOG_DEBUG("Next connection ok, target direction: %s", to_string(this->targetDir_));
+        const bool isStateChanged = &seg != this->currentSeg_ || &prevConn != this->prevConn_;
 
-                    this->route_.pop_front();
-                    this->currentSeg_ = this->route_.startSeg;
-                    this->prevConn_   = nextConn;
+        if (hypothesis.probability >= cfg::LABYRINTH_LOCALIZATION_MIN_PROBABILITY || !this->prevConn_) {
+            this->correctedCarPose_.pos = junc.pos;
 
-                } else {
-                    LOG_ERROR("Unexpected junction, resets navigator");
-                    this->reset(*junc, negOri);
-                }
+            // the most likely state differs from the expected one, so the route is re-planned from the most likely state
+            if (isStateChanged) {
+                LOG_WARN("Car relocalized from segment %c to segment %c", this->currentSeg_->name, seg.name);
+                this->currentSeg_ = &seg;
+                this->prevConn_   = &prevConn;
+                this->routePlanner_.create(prevConn, seg, *this->targetSeg_, this->route_);
+            }
+        } else if (isStateChanged) {
+            LOG_WARN("Uncertain localization to segment %c, keeps expected segment %c", seg.name, this->currentSeg_->name);
+        }
+
+        const Segment& currentSeg = *this->currentSeg_;
+        const LabyrinthLocalizer::Hypothesis state = {
+            static_cast<CompiledLabyrinthGraph::index_t>(this->prevConn_->idx),
+            static_cast<CompiledLabyrinthGraph::index_t>(currentSeg.idx),
+            hypothesis.junction,
+            hypothesis.probability
+        };
 
+        const Connection *nextConn = this->nextConnection(state);
+        if (nextConn) {
+            if (nextConn == this->route_.firstConnection()) {
+                this->route_.pop_front();
             } else {
-                LOG_WARN("No next connection available, chooses next connection randomly");
-                nextConn = this->randomConnection(*junc, *this->currentSeg_);
-
-                if (nextConn) {
-                    this->currentSeg_ = nextConn->getOtherSegment(*this->currentSeg_);
-                    this->targetDir_  = nextConn->getDecision(*this->currentSeg_).direction;
-                    this->prevConn_   = nextConn;
-                } else {
-                    LOG_ERROR("nextConn is nullptr after finding a valid connection. Something's wrong...");
-                    this->reset(*junc, negOri);
-                }
+                // forces re-planning from the new segment
+                this->route_.reset(*nextConn->getOtherSegment(currentSeg));
             }
 
+            this->currentSeg_ = nextConn->getOtherSegment(currentSeg);
+            this->targetDir_  = nextConn->getDecision(*this->currentSeg_).direction;
+            this->prevConn_   = nextConn;
+            LOG_DEBUG("Next connection ok, target direction: %s", to_string(this->targetDir_));
         } else {
-            LOG_ERROR("Current segment does not connect to found junction, resets navigator");
-            this->reset(*junc, negOri);
+            LOG_ERROR("No next connection available from segment %c at junction %u. Something's wrong...", currentSeg.name, static_cast<uint32_t>(junc.id));
         }
     } else {
-        LOG_ERROR("Junction not found, chooses target direction randomly. Something's wrong...");
-        this->targetDir_ = this->randomDirection(numOutSegments);
+        LOG_ERROR("Junction not localized, keeps target direction. Something's wrong...");
     }
 
+    this->localizer_.passJunction(this->targetDir_);
+
     LOG_INFO("Current segment: %c", this->currentSeg_->name);
 
+    this->hasPassedJunction_ = true;
     this->lastJuncDist_ = car.distance;
     this->hasSpeedSignChanged_ = false;
+
+    this->unblockObstacles();
+    this->obstacleSeg_ = nullptr;
 }
 
 void LabyrinthNavigator::tryToggleTargetSpeedSign(const micro::meter_t currentDist) {
@@ -270,25 +366,27 @@ void LabyrinthNavigator::setControl(const micro::CarProps& car, const micro::Lin
 
     const m_per_sec_t prevSpeed = controlData.speed;
 
-    if (this->currentSeg_->isDeadEnd && !this->hasSpeedSignChanged_) {
-        controlData.speed = this->targetSpeedSign_ * this->targetDeadEndSpeed_;
+    const bool isFastSpeedAllowed =
+        car.distance - this->lastJuncDist_ >= cfg::LABYRINTH_FAST_SPEED_JUNCTION_MARGIN                                      &&
+        1 == lineInfo.front.lines.size() && LinePattern::SINGLE_LINE == lineInfo.front.pattern.type                          &&
+        1 == lineInfo.rear.lines.size()  && LinePattern::SINGLE_LINE == lineInfo.rear.pattern.type                           &&
+        car.distance - this->lastSpeedSignChangeDistance_ >= cfg::LABYRINTH_FAST_SPEED_SIGN_CHANGE_DISTANCE                  &&
+        !(this->isLastTarget_ && this->currentSeg_ == this->laneChangeSeg_);
 
-    } else if (isBtw(car.distance, this->lastJuncDist_ + centimeter_t(20), this->lastJuncDist_ + this->currentSeg_->length - centimeter_t(20)) &&
-               1 == lineInfo.front.lines.size() && LinePattern::SINGLE_LINE == lineInfo.front.pattern.type                                     &&
-               1 == lineInfo.rear.lines.size()  && LinePattern::SINGLE_LINE == lineInfo.rear.pattern.type                                      &&
-               car.distance - this->lastSpeedSignChangeDistance_ >= centimeter_t(100)                                                          &&
-               !(this->isLastTarget_ && this->currentSeg_ == this->laneChangeSeg_)) {
-        controlData.speed = this->targetSpeedSign_ * this->targetFastSpeed_;
+    // the car brakes in time to reach the next junction, dead-end or reversal with its speed limit
+    const m_per_sec_t maxSpeed = isFastSpeedAllowed ? this->targetFastSpeed_ : this->targetSpeed_;
+    const SpeedLimit limit     = this->nextSpeedLimit(car);
+    const m_per_sec_t speed    = std::min(maxSpeed, std::max(limit.speed, this->speedProfile_.brakingSpeed(limit.speed, limit.distance)));
 
-    } else {
-        controlData.speed = this->targetSpeedSign_ * this->targetSpeed_;
-    }
+    controlData.speed = this->targetSpeedSign_ * speed;
 
     if (car.distance < meter_t(1)) {
         controlData.speed = abs(controlData.speed);
     }
 
-    controlData.rampTime = millisecond_t(300);
+    controlData.rampTime = sgn(controlData.speed) == sgn(car.speed) ?
+        this->speedProfile_.rampTime(car.speed, controlData.speed) :
+        cfg::LABYRINTH_SPEED_RAMP_TIME;
 
     if (controlData.speed != prevSpeed) {
         LOG_DEBUG("Target speed changed to %fm/s", controlData.speed.get());
@@ -302,31 +400,68 @@ void LabyrinthNavigator::setControl(const micro::CarProps& car, const micro::Lin
     controlData.lineControl.target = { millimeter_t(0), radian_t(0) };
 }
 
-void LabyrinthNavigator::reset(const Junction& junc, radian_t negOri) {
-    // Finds a valid previous segment - may be any of the segments behind the car, connecting to the current junction.
-    Junction::segment_map::const_iterator sideSegments = junc.getSideSegments(negOri);
-    if (sideSegments == junc.segments.end()) {
-        sideSegments = junc.getSideSegments(normalize360(negOri + PI)); // if side segments are not found, tries the other orientation
+LabyrinthNavigator::SpeedLimit LabyrinthNavigator::nextSpeedLimit(const micro::CarProps& car) const {
+    // the position of the car in the start segment is unknown until the first junction
+    if (!this->hasPassedJunction_) {
+        return { meter_t(0), this->targetSpeed_ };
     }
 
-    const Segment *prevSeg = sideSegments->second.begin()->second;
-    if (prevSeg) {
-        const Connection * const nextConn = this->randomConnection(junc, *prevSeg);
-        if (nextConn) {
-            this->currentSeg_ = nextConn->getOtherSegment(*prevSeg);
-            this->targetDir_  = nextConn->getDecision(*this->currentSeg_).direction;
-            this->prevConn_   = nextConn;
-        } else {
-            LOG_ERROR("nextConn is nullptr after finding a random valid connection. Something's wrong...");
+    const meter_t segmentDist = car.distance - this->lastJuncDist_;
+
+    // after a speed sign change the car goes back to the previous junction
+    const meter_t junctionDist = this->hasSpeedSignChanged_ ?
+        (this->lastSpeedSignChangeDistance_ - this->lastJuncDist_) - (car.distance - this->lastSpeedSignChangeDistance_) :
+        this->currentSeg_->length - segmentDist;
+
+    if (this->currentSeg_->isDeadEnd && !this->hasSpeedSignChanged_) {
+        // the end of the dead-end segment must be detected at dead-end speed
+        return { junctionDist, this->targetDeadEndSpeed_ };
+    }
+
+    // when the route goes back to the next junction right after passing it, the car changes speed sign after the junction
+    const Connection *nextConn = this->route_.firstConnection();
+    const bool isReversalAhead = nextConn && this->route_.connections.size() > 1 && this->route_.connections[1]->junction == nextConn->junction;
+
+    return {
+        junctionDist - cfg::LABYRINTH_FAST_SPEED_JUNCTION_MARGIN,
+        isReversalAhead ? this->targetDeadEndSpeed_ : this->targetSpeed_
+    };
+}
+
+const Connection* LabyrinthNavigator::nextConnection(const LabyrinthLocalizer::Hypothesis& hypothesis) {
+    typedef CompiledLabyrinthGraph::index_t index_t;
+
+    const Connection *routeConn = this->route_.firstConnection();
+    if (routeConn && this->localizer_.isNextConnection(hypothesis.prevConn, hypothesis.seg, static_cast<index_t>(routeConn->idx), this->hasSpeedSignChanged_)) {
+        return routeConn;
+    }
+
+    // the route cannot be followed at this junction (e.g. the route has finished), so the connection closest to the target is chosen
+    const Connection *result = nullptr;
+    float cost = 0.0f;
+
+    for (const index_t c : this->compiledGraph_.edges(hypothesis.seg)) {
+        if (this->localizer_.isNextConnection(hypothesis.prevConn, hypothesis.seg, c, this->hasSpeedSignChanged_)) {
+            const Connection& conn = this->graph_.connections()[c];
+            const float newCost = this->routePlanner_.routeCost(conn, *conn.getOtherSegment(this->graph_.segments()[hypothesis.seg]), *this->targetSeg_);
+
+            if (!result || newCost < cost) {
+                result = &conn;
+                cost   = newCost;
+            }
         }
-    } else {
-        LOG_ERROR("prevSeg is nullptr after getting side segments. Something's wrong...");
     }
+
+    return result;
 }
 
 void LabyrinthNavigator::updateRoute() {
     LOG_DEBUG("Updating route to: %c", this->targetSeg_->name);
-    this->route_ = LabyrinthRoute::create(*this->prevConn_, *this->currentSeg_, *this->targetSeg_, true);
+    this->routePlanner_.create(*this->prevConn_, *this->currentSeg_, *this->targetSeg_, this->route_);
+
+    const LabyrinthRoutePlanner::Counters& counters = this->routePlanner_.counters();
+    LOG_DEBUG("Route planner: %u expansions, %u updates (total: %u replans, %u resets)",
+        counters.lastNumExpansions, counters.lastNumUpdates, counters.numReplans, counters.numSearchResets);
 
     LOG_DEBUG("Planned route:");
 
@@ -338,45 +473,33 @@ void LabyrinthNavigator::updateRoute() {
     }
 }
 
-bool LabyrinthNavigator::isTargetLineOverrideEnabled(const CarProps& car, const LineInfo& lineInfo) const {
-    const LinePattern& frontPattern = this->frontLinePattern(lineInfo);
-    return isJunction(frontPattern) && Sign::POSITIVE == frontPattern.dir;
-}
+void LabyrinthNavigator::nextTourTarget() {
+    if (this->tourTargets_.size()) {
+        this->targetSeg_ = this->tourTargets_[0];
+        this->tourTargets_.erase(this->tourTargets_.begin());
+    } else {
+        this->targetSeg_    = this->laneChangeSeg_;
+        this->isLastTarget_ = true;
+    }
 
-bool LabyrinthNavigator::isDeadEnd(const micro::CarProps& car, const micro::LinePattern& pattern) const {
-    return LinePattern::NONE == pattern.type && (this->currentSeg_->isDeadEnd || car.distance - pattern.startDist > centimeter_t(10));
+    LOG_DEBUG("Next tour target segment: %c", this->targetSeg_->name);
 }
 
-const Connection* LabyrinthNavigator::randomConnection(const Junction& junc, const Segment& seg) {
-    micro::vec<Connection*, cfg::MAX_NUM_CROSSING_SEGMENTS_SIDE> validConnections;
-
-    for (Connection *c : seg.edges) {
-        if (c->junction->id == junc.id) {
-            validConnections.push_back(c);
-        }
+void LabyrinthNavigator::unblockObstacles() {
+    // obstacles may move, so they are only avoided until the car passes a junction - the current route remains valid
+    for (const Connection *conn : this->obstacleBlockedConns_) {
+        this->routePlanner_.setBlocked(*conn, false);
     }
-
-    return validConnections.size() > 0 ? validConnections[this->random_.get(0, validConnections.size())] : nullptr;
+    this->obstacleBlockedConns_.clear();
 }
 
-Direction LabyrinthNavigator::randomDirection(const uint8_t numOutSegments) {
-    const uint8_t targetLineIdx = this->random_.get(0, numOutSegments);
-
-    Direction dir = Direction::CENTER;
-
-    switch (numOutSegments) {
-    case 3:
-        dir = 0 == targetLineIdx ? Direction::LEFT : 1 == targetLineIdx ? Direction::CENTER : Direction::RIGHT;
-        break;
-    case 2:
-        dir = 0 == targetLineIdx ? Direction::LEFT : Direction::RIGHT;
-        break;
-    default:
-        dir = Direction::CENTER;
-        break;
-    }
+bool LabyrinthNavigator::isTargetLineOverrideEnabled(const CarProps& car, const LineInfo& lineInfo) const {
+    const LinePattern& frontPattern = this->frontLinePattern(lineInfo);
+    return isJunction(frontPattern) && Sign::POSITIVE == frontPattern.dir;
+}
 
-    return dir;
+bool LabyrinthNavigator::isDeadEnd(const micro::CarProps& car, const micro::LinePattern& pattern) const {
+    return LinePattern::NONE == pattern.type && (this->currentSeg_->isDeadEnd || car.distance - pattern.startDist > centimeter_t(10));
 }
 
 bool LabyrinthNavigator::isJunction(const LinePattern& pattern) {
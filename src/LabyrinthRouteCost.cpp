@@ -0,0 +1,74 @@
+#include <LabyrinthRouteCost.hpp>
+
+#include <algorithm>
+
+using namespace micro;
+
+namespace {
+
+second_t travelTime(const meter_t dist, const m_per_sec_t speed) {
+    return second_t(dist.get() / speed.get());
+}
+
+} // namespace
+
+float LabyrinthDistanceCost::connectionCost(const CompiledLabyrinthGraph& graph, const index_t prevConn, const index_t seg, const index_t newConn,
+    const bool isStartSeg, const bool allowBackwardNavigation) const {
+    return graph.connectionCost(prevConn, seg, newConn, isStartSeg, allowBackwardNavigation).get();
+}
+
+LabyrinthTimeCost::LabyrinthTimeCost(const m_per_sec_t speed, const m_per_sec_t fastSpeed, const m_per_sec_t deadEndSpeed,
+    const LabyrinthSpeedProfile& speedProfile, const millisecond_t speedSignChangeTime, const millisecond_t sideDecisionTime)
+    : speed_(speed)
+    , fastSpeed_(fastSpeed)
+    , deadEndSpeed_(deadEndSpeed)
+    , speedProfile_(speedProfile)
+    , speedSignChangeTime_(speedSignChangeTime)
+    , sideDecisionTime_(sideDecisionTime)
+    // after the speed sign change, the car drives at base speed instead of fast speed for a while
+    , reversalTime_(travelTime(cfg::LABYRINTH_REVERSAL_DISTANCE, speed) + static_cast<second_t>(speedSignChangeTime) +
+        travelTime(cfg::LABYRINTH_FAST_SPEED_SIGN_CHANGE_DISTANCE, speed) - travelTime(cfg::LABYRINTH_FAST_SPEED_SIGN_CHANGE_DISTANCE, fastSpeed)) {}
+
+float LabyrinthTimeCost::connectionCost(const CompiledLabyrinthGraph& graph, const index_t prevConn, const index_t seg, const index_t newConn,
+    const bool isStartSeg, const bool allowBackwardNavigation) const {
+
+    const index_t newSeg = graph.getOtherSegment(newConn, seg);
+    const second_t currentTime = this->segmentTime(graph, seg);
+    const second_t newTime     = this->segmentTime(graph, newSeg);
+
+    second_t time = currentTime / 2 + newTime / 2;
+
+    if (!isStartSeg && allowBackwardNavigation && graph.connection(prevConn).junction == graph.connection(newConn).junction) {
+        // a dead-end segment is driven through to its end and back,
+        // otherwise the car does not pass through the whole segment when going back to the previous junction
+        time = graph.segment(seg).isDeadEnd ?
+            currentTime / 2 + this->speedSignChangeTime_ + this->deadEndReturnTime(graph.segment(seg).length) + newTime / 2 :
+            this->reversalTime_ - currentTime / 2 + newTime / 2;
+    }
+
+    return (time + this->sideDecisionTime(graph, newConn, newSeg)).get();
+}
+
+second_t LabyrinthTimeCost::segmentTime(const CompiledLabyrinthGraph& graph, const index_t seg) const {
+    const CompiledLabyrinthGraph::SegmentInfo& info = graph.segment(seg);
+
+    if (info.isDeadEnd) {
+        const meter_t slowLength = std::min(info.length, cfg::LABYRINTH_FAST_SPEED_JUNCTION_MARGIN);
+        return travelTime(slowLength, this->speed_) + this->speedProfile_.travelTime(info.length - slowLength, this->speed_, this->fastSpeed_, this->deadEndSpeed_);
+    }
+
+    const meter_t slowLength = std::min(info.length, cfg::LABYRINTH_FAST_SPEED_JUNCTION_MARGIN * 2);
+    return travelTime(slowLength, this->speed_) + this->speedProfile_.travelTime(info.length - slowLength, this->speed_, this->fastSpeed_, this->speed_);
+}
+
+second_t LabyrinthTimeCost::deadEndReturnTime(const meter_t length) const {
+    // after the speed sign change, the car drives at base speed for a while
+    const meter_t slowLength = std::min(length, cfg::LABYRINTH_FAST_SPEED_SIGN_CHANGE_DISTANCE);
+    return travelTime(slowLength, this->speed_) + this->speedProfile_.travelTime(length - slowLength, this->speed_, this->fastSpeed_, this->speed_);
+}
+
+second_t LabyrinthTimeCost::sideDecisionTime(const CompiledLabyrinthGraph& graph, const index_t newConn, const index_t newSeg) const {
+    const CompiledLabyrinthGraph::ConnectionInfo& conn = graph.connection(newConn);
+    const Direction dir = conn.directions[conn.segments[0] == newSeg ? 0 : 1];
+    return Direction::CENTER == dir ? second_t(0) : this->sideDecisionTime_;
+}
@@ -0,0 +1,257 @@
+#include <micro/utils/log.hpp>
+
+#include <LabyrinthRoutePlanner.hpp>
+
+#include <limits>
+
+using namespace micro;
+
+namespace {
+
+const LabyrinthDistanceCost distanceCost;
+
+constexpr float INFINITE_COST = std::numeric_limits<float>::infinity();
+
+} // namespace
+
+constexpr uint32_t LabyrinthRoutePlanner::MAX_NUM_STATES;
+
+LabyrinthRoutePlanner::LabyrinthRoutePlanner(const CompiledLabyrinthGraph& graph, const bool allowBackwardNavigation)
+    : LabyrinthRoutePlanner(graph, allowBackwardNavigation, distanceCost) {}
+
+LabyrinthRoutePlanner::LabyrinthRoutePlanner(const CompiledLabyrinthGraph& graph, const bool allowBackwardNavigation, const LabyrinthRouteCost& routeCost)
+    : graph_(graph)
+    , allowBackwardNavigation_(allowBackwardNavigation)
+    , routeCost_(routeCost)
+    , destSeg_(CompiledLabyrinthGraph::INVALID_INDEX)
+    , numPendingUpdates_(0) {
+
+    std::fill(this->blocked_, this->blocked_ + MAX_NUM_STATES / 2, false);
+}
+
+LabyrinthRoute LabyrinthRoutePlanner::create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg) {
+    LabyrinthRoute route;
+    this->create(prevConn, currentSeg, destSeg, route);
+    return route;
+}
+
+void LabyrinthRoutePlanner::create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, LabyrinthRoute& route) {
+    const index_t dest = static_cast<index_t>(destSeg.idx);
+    this->update(dest);
+
+    route.reset(currentSeg);
+
+    if (&currentSeg == &destSeg) {
+        return;
+    }
+
+    // follows the lowest cost-to-go from the start state, the first step is selected separately,
+    // because reversals are not penalized in the start segment
+    const LabyrinthGraph::Connections& connections = this->graph_.source().connections();
+    index_t conn    = static_cast<index_t>(prevConn.idx);
+    index_t seg     = static_cast<index_t>(currentSeg.idx);
+    bool isStartSeg = true;
+
+    while (seg != dest && route.connections.size() < LabyrinthRoute::MAX_LENGTH) {
+        float cost;
+        const index_t nextConn = this->nextConnection(conn, seg, isStartSeg, cost);
+
+        if (isStartSeg && cost == INFINITE_COST) {
+            LOG_ERROR("Segment %c is not reachable from segment %c", destSeg.name, currentSeg.name);
+            route.reset(destSeg);
+            return;
+        }
+
+        if (CompiledLabyrinthGraph::INVALID_INDEX == nextConn) {
+            break;
+        }
+
+        route.push_back(connections[nextConn]);
+        seg        = this->graph_.getOtherSegment(nextConn, seg);
+        conn       = nextConn;
+        isStartSeg = false;
+    }
+}
+
+float LabyrinthRoutePlanner::routeCost(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg) {
+    const index_t dest = static_cast<index_t>(destSeg.idx);
+    this->update(dest);
+
+    if (&currentSeg == &destSeg) {
+        return 0.0f;
+    }
+
+    float cost;
+    this->nextConnection(static_cast<index_t>(prevConn.idx), static_cast<index_t>(currentSeg.idx), true, cost);
+    return cost;
+}
+
+void LabyrinthRoutePlanner::setBlocked(const Connection& conn, const bool isBlocked) {
+    if (this->blocked_[conn.idx] != isBlocked) {
+        this->blocked_[conn.idx] = isBlocked;
+
+        // only the states that may step through the connection are affected
+        if (CompiledLabyrinthGraph::INVALID_INDEX != this->destSeg_) {
+            for (const index_t seg : this->graph_.connection(static_cast<index_t>(conn.idx)).segments) {
+                for (const index_t c : this->graph_.edges(seg)) {
+                    this->updateState(this->getState(c, seg));
+                }
+            }
+        }
+    }
+}
+
+bool LabyrinthRoutePlanner::isBlocked(const Connection& conn) const {
+    return this->blocked_[conn.idx];
+}
+
+const LabyrinthRoutePlanner::Counters& LabyrinthRoutePlanner::counters() const {
+    return this->counters_;
+}
+
+uint32_t LabyrinthRoutePlanner::numStates() const {
+    return 2 * this->graph_.numConnections();
+}
+
+LabyrinthRoutePlanner::state_t LabyrinthRoutePlanner::getState(const index_t prevConn, const index_t seg) const {
+    return static_cast<state_t>(2 * prevConn + (this->graph_.connection(prevConn).segments[1] == seg ? 1 : 0));
+}
+
+LabyrinthRoutePlanner::index_t LabyrinthRoutePlanner::getConnection(const state_t state) const {
+    return static_cast<index_t>(state / 2);
+}
+
+LabyrinthRoutePlanner::index_t LabyrinthRoutePlanner::getSegment(const state_t state) const {
+    return this->graph_.connection(this->getConnection(state)).segments[state % 2];
+}
+
+bool LabyrinthRoutePlanner::isAllowed(const index_t prevConn, const index_t seg, const index_t newConn) const {
+    return this->allowBackwardNavigation_ || this->graph_.isForwardConnection(prevConn, seg, newConn);
+}
+
+float LabyrinthRoutePlanner::cost(const state_t state, const index_t newConn) const {
+    const index_t prevConn = this->getConnection(state);
+    const index_t seg      = this->getSegment(state);
+
+    return this->blocked_[newConn] || !this->isAllowed(prevConn, seg, newConn) ?
+        INFINITE_COST :
+        this->routeCost_.connectionCost(this->graph_, prevConn, seg, newConn, false, this->allowBackwardNavigation_);
+}
+
+void LabyrinthRoutePlanner::reset(const index_t destSeg) {
+    this->destSeg_ = destSeg;
+    this->queue_.clear();
+
+    for (state_t state = 0; state < this->numStates(); ++state) {
+        this->costs_[state] = INFINITE_COST;
+
+        if (this->getSegment(state) == destSeg) {
+            this->lookaheadCosts_[state] = 0.0f;
+            this->queue_.push(state, 0.0f);
+        } else {
+            this->lookaheadCosts_[state] = INFINITE_COST;
+        }
+    }
+
+    ++this->counters_.numSearchResets;
+}
+
+void LabyrinthRoutePlanner::update(const index_t destSeg) {
+    if (destSeg != this->destSeg_) {
+        this->reset(destSeg);
+    }
+
+    this->computeCosts();
+}
+
+void LabyrinthRoutePlanner::updateState(const state_t state) {
+    const index_t seg = this->getSegment(state);
+
+    if (seg != this->destSeg_) {
+        float lookaheadCost = INFINITE_COST;
+
+        for (const index_t newConn : this->graph_.edges(seg)) {
+            const state_t newState = this->getState(newConn, this->graph_.getOtherSegment(newConn, seg));
+            const float cost = this->costs_[newState] + this->cost(state, newConn);
+            if (cost < lookaheadCost) {
+                lookaheadCost = cost;
+            }
+        }
+
+        this->lookaheadCosts_[state] = lookaheadCost;
+    }
+
+    const float g = this->costs_[state], rhs = this->lookaheadCosts_[state];
+
+    if (g != rhs) {
+        this->queue_.push(state, rhs < g ? rhs : g);
+    } else {
+        this->queue_.remove(state);
+    }
+
+    ++this->numPendingUpdates_;
+}
+
+void LabyrinthRoutePlanner::updatePredecessors(const state_t state) {
+    // predecessors are the states of the other segment of the connection, from which the connection may be taken
+    const index_t conn = this->getConnection(state);
+    const index_t seg  = this->graph_.getOtherSegment(conn, this->getSegment(state));
+
+    for (const index_t prevConn : this->graph_.edges(seg)) {
+        if (this->isAllowed(prevConn, seg, conn)) {
+            this->updateState(this->getState(prevConn, seg));
+        }
+    }
+}
+
+LabyrinthRoutePlanner::index_t LabyrinthRoutePlanner::nextConnection(const index_t prevConn, const index_t seg, const bool isStartSeg, float& cost) const {
+    index_t result = CompiledLabyrinthGraph::INVALID_INDEX;
+    cost = INFINITE_COST;
+
+    for (const index_t newConn : this->graph_.edges(seg)) {
+        if (!this->blocked_[newConn] && this->isAllowed(prevConn, seg, newConn)) {
+            const state_t newState = this->getState(newConn, this->graph_.getOtherSegment(newConn, seg));
+            const float newCost = this->costs_[newState] +
+                this->routeCost_.connectionCost(this->graph_, prevConn, seg, newConn, isStartSeg, this->allowBackwardNavigation_);
+
+            if (newCost < cost) {
+                cost   = newCost;
+                result = newConn;
+            }
+        }
+    }
+
+    return result;
+}
+
+void LabyrinthRoutePlanner::computeCosts() {
+
+    // Processes the locally inconsistent states until none remains, instead of stopping when the start state becomes consistent.
+    // Reversing edges may have negative costs, so the early termination condition of LPA* does not hold,
+    // but the whole search tree is kept consistent, therefore a start segment change needs no update at all.
+
+    uint32_t numExpansions = 0;
+
+    while (!this->queue_.empty()) {
+        const state_t state = this->queue_.pop();
+        ++numExpansions;
+
+        if (this->lookaheadCosts_[state] < this->costs_[state]) {
+            // over-consistent state: its cost-to-go decreased
+            this->costs_[state] = this->lookaheadCosts_[state];
+        } else {
+            // under-consistent state: its cost-to-go increased, therefore it is re-evaluated together with its predecessors
+            this->costs_[state] = INFINITE_COST;
+            this->updateState(state);
+        }
+
+        this->updatePredecessors(state);
+    }
+
+    ++this->counters_.numReplans;
+    this->counters_.lastNumExpansions   = numExpansions;
+    this->counters_.lastNumUpdates      = this->numPendingUpdates_;
+    this->counters_.totalNumExpansions += numExpansions;
+    this->counters_.totalNumUpdates    += this->numPendingUpdates_;
+    this->numPendingUpdates_            = 0;
+}
@@ -0,0 +1,49 @@
+#include <LabyrinthSpeedProfile.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace micro;
+
+LabyrinthSpeedProfile::LabyrinthSpeedProfile(const float acceleration, const float deceleration)
+    : acceleration_(acceleration)
+    , deceleration_(deceleration) {}
+
+m_per_sec_t LabyrinthSpeedProfile::brakingSpeed(const m_per_sec_t endSpeed, const meter_t distance) const {
+    if (distance <= meter_t(0)) {
+        return endSpeed;
+    }
+
+    // v^2 = v_end^2 + 2 * a * d
+    const float v = endSpeed.get();
+    return m_per_sec_t(std::sqrt(v * v + 2.0f * this->deceleration_ * distance.get()));
+}
+
+millisecond_t LabyrinthSpeedProfile::rampTime(const m_per_sec_t speed, const m_per_sec_t targetSpeed) const {
+    const float rate = abs(targetSpeed) > abs(speed) ? this->acceleration_ : this->deceleration_;
+    return second_t(abs(targetSpeed - speed).get() / rate);
+}
+
+second_t LabyrinthSpeedProfile::travelTime(const meter_t distance, const m_per_sec_t startSpeed, const m_per_sec_t maxSpeed, const m_per_sec_t endSpeed) const {
+    if (distance <= meter_t(0)) {
+        return second_t(0);
+    }
+
+    const float d  = distance.get();
+    const float v0 = startSpeed.get();
+    const float v1 = endSpeed.get();
+    const float vm = std::max(maxSpeed.get(), std::max(v0, v1));
+    const float a  = this->acceleration_;
+    const float b  = this->deceleration_;
+
+    // peak speed of the triangular profile: (v^2 - v0^2) / 2a + (v^2 - v1^2) / 2b = d
+    const float peakSpeed2 = (2.0f * a * b * d + b * v0 * v0 + a * v1 * v1) / (a + b);
+
+    if (peakSpeed2 < std::max(v0 * v0, v1 * v1)) {
+        return second_t(2.0f * d / (v0 + v1));
+    }
+
+    const float v        = std::min(std::sqrt(peakSpeed2), vm);
+    const float rampDist = (v * v - v0 * v0) / (2.0f * a) + (v * v - v1 * v1) / (2.0f * b);
+    return second_t((v - v0) / a + (v - v1) / b + (d - rampDist) / v);
+}
@@ -0,0 +1,193 @@
+#include <micro/utils/log.hpp>
+
+#include <LabyrinthTourPlanner.hpp>
+
+#include <limits>
+
+using namespace micro;
+
+namespace {
+
+constexpr float INFINITE_COST = std::numeric_limits<float>::infinity();
+
+constexpr uint8_t INVALID_PARENT = 0xff;
+
+} // namespace
+
+constexpr uint32_t LabyrinthTourPlanner::MAX_NUM_TARGETS;
+constexpr uint32_t LabyrinthTourPlanner::MAX_NUM_EXACT_TARGETS;
+constexpr uint32_t LabyrinthTourPlanner::MAX_NUM_NODES;
+
+LabyrinthTourPlanner::LabyrinthTourPlanner()
+    : routePlanner_(nullptr)
+    , targets_(nullptr)
+    , visited_(0)
+    , lastNode_(0) {}
+
+LabyrinthTourPlanner::Tour LabyrinthTourPlanner::create(LabyrinthRoutePlanner& routePlanner, const Connection& prevConn, const Segment& currentSeg,
+    const Targets& targets, const Segment& finalSeg) {
+    const uint32_t numTargets = targets.size();
+
+    this->routePlanner_ = &routePlanner;
+    this->targets_      = &targets;
+    this->visited_      = 0;
+    this->lastNode_     = static_cast<node_t>(numTargets + 1);
+
+    this->updateCosts(prevConn, currentSeg, targets, finalSeg);
+
+    Tour tour;
+    tour.cost = this->orderGreedily(numTargets, tour);
+    if (tour.cost != INFINITE_COST) {
+        tour.cost += this->orderOptimally(numTargets, tour);
+    }
+
+    if (tour.cost == INFINITE_COST) {
+        LOG_ERROR("Labyrinth tour from segment %c to segment %c is not feasible", currentSeg.name, finalSeg.name);
+        tour.targets.clear();
+    }
+
+    this->routePlanner_ = nullptr;
+    this->targets_      = nullptr;
+    return tour;
+}
+
+void LabyrinthTourPlanner::updateCosts(const Connection& prevConn, const Segment& currentSeg, const Targets& targets, const Segment& finalSeg) {
+    const uint32_t numTargets = targets.size();
+    const node_t startNode    = static_cast<node_t>(numTargets + 1);
+
+    // iterates over the destinations in the outer loop, so that the route planner builds only one search tree for each destination
+    for (node_t dest = 0; dest <= numTargets; ++dest) {
+        const Segment& destSeg = dest < numTargets ? *targets[dest] : finalSeg;
+
+        for (node_t src = 0; src < numTargets; ++src) {
+            this->costs_[src][dest] = src == dest ? 0.0f : this->legCost(*targets[src], destSeg);
+        }
+
+        this->costs_[startNode][dest] = this->routePlanner_->routeCost(prevConn, currentSeg, destSeg);
+    }
+}
+
+float LabyrinthTourPlanner::orderGreedily(const uint32_t numTargets, Tour& tour) {
+    float cost = 0.0f;
+
+    while (numTargets - tour.targets.size() > MAX_NUM_EXACT_TARGETS) {
+        node_t next = 0;
+        float nextCost = INFINITE_COST;
+
+        for (node_t target = 0; target < numTargets; ++target) {
+            if (!this->isVisited(target) && this->costs_[this->lastNode_][target] < nextCost) {
+                next     = target;
+                nextCost = this->costs_[this->lastNode_][target];
+            }
+        }
+
+        if (nextCost == INFINITE_COST) {
+            return INFINITE_COST;
+        }
+
+        tour.targets.push_back((*this->targets_)[next]);
+        this->visited_ |= 1u << next;
+        this->lastNode_ = next;
+        cost += nextCost;
+    }
+
+    return cost;
+}
+
+float LabyrinthTourPlanner::orderOptimally(const uint32_t numTargets, Tour& tour) {
+    const node_t finalNode = static_cast<node_t>(numTargets);
+
+    // the subsets only contain the targets that have not been visited yet
+    node_t nodes[MAX_NUM_EXACT_TARGETS];
+    uint32_t numNodes = 0;
+    for (node_t target = 0; target < numTargets; ++target) {
+        if (!this->isVisited(target)) {
+            nodes[numNodes++] = target;
+        }
+    }
+
+    if (0 == numNodes) {
+        return this->costs_[this->lastNode_][finalNode];
+    }
+
+    const uint32_t numSubsets = 1u << numNodes;
+    for (uint32_t subset = 1; subset < numSubsets; ++subset) {
+        for (uint32_t last = 0; last < numNodes; ++last) {
+            this->pathCosts_[subset][last]   = subset == (1u << last) ? this->costs_[this->lastNode_][nodes[last]] : INFINITE_COST;
+            this->pathParents_[subset][last] = INVALID_PARENT;
+        }
+    }
+
+    // subsets are processed in increasing order, so all subsets of a subset are processed before the subset itself
+    for (uint32_t subset = 1; subset < numSubsets; ++subset) {
+        for (uint32_t last = 0; last < numNodes; ++last) {
+            const float pathCost = this->pathCosts_[subset][last];
+            if (!(subset & (1u << last)) || pathCost == INFINITE_COST) {
+                continue;
+            }
+
+            for (uint32_t next = 0; next < numNodes; ++next) {
+                if (!(subset & (1u << next))) {
+                    const uint32_t nextSubset = subset | (1u << next);
+                    const float nextCost = pathCost + this->costs_[nodes[last]][nodes[next]];
+
+                    if (nextCost < this->pathCosts_[nextSubset][next]) {
+                        this->pathCosts_[nextSubset][next]   = nextCost;
+                        this->pathParents_[nextSubset][next] = static_cast<uint8_t>(last);
+                    }
+                }
+            }
+        }
+    }
+
+    const uint32_t allNodes = numSubsets - 1;
+    uint8_t last = INVALID_PARENT;
+    float cost   = INFINITE_COST;
+
+    for (uint8_t node = 0; node < numNodes; ++node) {
+        const float tourCost = this->pathCosts_[allNodes][node] + this->costs_[nodes[node]][finalNode];
+        if (tourCost < cost) {
+            cost = tourCost;
+            last = node;
+        }
+    }
+
+    if (INVALID_PARENT == last) {
+        return INFINITE_COST;
+    }
+
+    // walks the path backwards from the last target, then appends the targets in visiting order
+    uint8_t order[MAX_NUM_EXACT_TARGETS];
+    uint32_t subset = allNodes;
+    for (uint32_t i = numNodes; i > 0; --i) {
+        order[i - 1] = last;
+        const uint8_t parent = this->pathParents_[subset][last];
+        subset &= ~(1u << last);
+        last = parent;
+    }
+
+    for (uint32_t i = 0; i < numNodes; ++i) {
+        tour.targets.push_back((*this->targets_)[nodes[order[i]]]);
+        this->visited_ |= 1u << nodes[order[i]];
+    }
+    this->lastNode_ = nodes[order[numNodes - 1]];
+
+    return cost;
+}
+
+float LabyrinthTourPlanner::legCost(const Segment& seg, const Segment& destSeg) {
+    // the route to the next target starts in the middle of the current target,
+    // so the connection the current target was approached through only matters for the forward-only rule
+    float cost = INFINITE_COST;
+    for (const Connection *prevConn : seg.edges) {
+        const float c = this->routePlanner_->routeCost(*prevConn, seg, destSeg);
+        if (c < cost) {
+            cost = c;
+        }
+    }
+    return cost;
+}
+
+bool LabyrinthTourPlanner::isVisited(const node_t target) const {
+    return this->visited_ & (1u << target);
+}
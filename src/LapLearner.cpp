@@ -0,0 +1,96 @@
+#include <micro/math/numeric.hpp>
+
+#include <cfg_track.hpp>
+#include <LapLearner.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace micro;
+
+LapLearner::LapLearner(const TrackSegments& segments)
+    : segments_(segments)
+    , stats_()
+    , sections_()
+    , lastLapTime_(0) {}
+
+void LapLearner::update(const uint32_t segIdx, const CarProps& car, const meter_t lineError, const m_per_sec_t targetSpeed) {
+    SegmentStats& stats = this->stats_[segIdx];
+    stats.peakLineError  = std::max(stats.peakLineError, abs(lineError));
+    stats.maxSpeed       = std::max(stats.maxSpeed, abs(car.speed));
+    stats.maxTargetSpeed = std::max(stats.maxTargetSpeed, abs(targetSpeed));
+}
+
+void LapLearner::onSegmentFinished(const uint32_t segIdx, const millisecond_t time) {
+    this->stats_[segIdx].time = time;
+}
+
+void LapLearner::onLapFinished(const millisecond_t lapTime) {
+    for (uint32_t s = 0; s < MAX_NUM_SECTIONS; ++s) {
+        const SegmentStats *fastStats = nullptr;
+        meter_t slowPeakLineError = meter_t(0);
+        bool isSlowRecorded = false;
+
+        for (uint32_t i = 0; i < this->segments_.size(); ++i) {
+            if (this->sectionIndex(i) != s || this->stats_[i].time == millisecond_t(0)) {
+                continue;
+            }
+
+            if (this->segments_[i].isFast) {
+                fastStats = &this->stats_[i];
+            } else {
+                slowPeakLineError = std::max(slowPeakLineError, this->stats_[i].peakLineError);
+                isSlowRecorded = true;
+            }
+        }
+
+        // only the sections that have been fully recorded in the lap are adjusted
+        if (!fastStats || !isSlowRecorded) {
+            continue;
+        }
+
+        Section& section = this->sections_[s];
+        const meter_t sectionPeakLineError = std::max(fastStats->peakLineError, slowPeakLineError);
+        const bool isSpeedReached = fastStats->maxSpeed >= fastStats->maxTargetSpeed * cfg::RACE_LEARNING_MIN_SPEED_REACHED_RATIO;
+
+        if (fastStats->peakLineError > cfg::RACE_LEARNING_MAX_LINE_ERROR) {
+            section.fastSpeedDelta -= 2 * cfg::RACE_LEARNING_SPEED_STEP;
+        } else if (sectionPeakLineError < cfg::RACE_LEARNING_SAFE_LINE_ERROR && isSpeedReached) {
+            section.fastSpeedDelta += cfg::RACE_LEARNING_SPEED_STEP;
+        }
+
+        if (slowPeakLineError > cfg::RACE_LEARNING_MAX_LINE_ERROR) {
+            section.brakeOffsetDelta -= 2 * cfg::RACE_LEARNING_BRAKE_OFFSET_STEP;
+        } else if (slowPeakLineError < cfg::RACE_LEARNING_SAFE_LINE_ERROR) {
+            section.brakeOffsetDelta += cfg::RACE_LEARNING_BRAKE_OFFSET_STEP;
+        }
+    }
+
+    this->setSections(this->sections_);
+
+    std::fill(std::begin(this->stats_), std::end(this->stats_), SegmentStats{});
+    this->lastLapTime_ = lapTime;
+}
+
+uint32_t LapLearner::sectionIndex(const uint32_t segIdx) const {
+    uint32_t numFastSegments = 0, numFastSegmentsBefore = 0;
+    for (uint32_t i = 0; i < this->segments_.size(); ++i) {
+        if (this->segments_[i].isFast) {
+            ++numFastSegments;
+            if (i <= segIdx) {
+                ++numFastSegmentsBefore;
+            }
+        }
+    }
+
+    // the slow segments before the first fast segment belong to the last section
+    const uint32_t idx = numFastSegmentsBefore > 0 ? numFastSegmentsBefore - 1 : std::max(numFastSegments, 1u) - 1;
+    return std::min(idx, MAX_NUM_SECTIONS - 1);
+}
+
+void LapLearner::setSections(const Sections& sections) {
+    for (uint32_t s = 0; s < MAX_NUM_SECTIONS; ++s) {
+        this->sections_[s].fastSpeedDelta   = clamp(sections[s].fastSpeedDelta, -cfg::RACE_LEARNING_MAX_SPEED_DELTA, cfg::RACE_LEARNING_MAX_SPEED_DELTA);
+        this->sections_[s].brakeOffsetDelta = clamp(sections[s].brakeOffsetDelta, -cfg::RACE_LEARNING_MAX_BRAKE_OFFSET_DELTA, cfg::RACE_LEARNING_MAX_BRAKE_OFFSET_DELTA);
+    }
+}
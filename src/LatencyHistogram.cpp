@@ -0,0 +1,58 @@
+#include <LatencyHistogram.hpp>
+
+using namespace micro;
+
+namespace {
+
+constexpr microsecond_t BIN_BASE = microsecond_t(125);
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : counts_{}
+    , max_(0) {}
+
+void LatencyHistogram::add(const microsecond_t latency) {
+    uint32_t bin = 0;
+    while (bin < NUM_BINS - 1 && latency >= this->binUpperBound(bin)) {
+        ++bin;
+    }
+
+    ++this->counts_[bin];
+
+    if (latency > this->max_) {
+        this->max_ = latency;
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (uint32_t& count : this->counts_) {
+        count = 0;
+    }
+    this->max_ = microsecond_t(0);
+}
+
+uint32_t LatencyHistogram::numSamples() const {
+    uint32_t result = 0;
+    for (const uint32_t count : this->counts_) {
+        result += count;
+    }
+    return result;
+}
+
+microsecond_t LatencyHistogram::binUpperBound(const uint32_t bin) const {
+    return bin < NUM_BINS - 1 ? BIN_BASE * static_cast<float>(1u << bin) : this->max_;
+}
+
+microsecond_t LatencyHistogram::percentile(const float ratio) const {
+    const uint32_t numSamples = this->numSamples();
+    uint32_t numBelow = 0;
+
+    for (uint32_t bin = 0; bin < NUM_BINS; ++bin) {
+        numBelow += this->counts_[bin];
+        if (numBelow > 0 && static_cast<float>(numBelow) >= ratio * static_cast<float>(numSamples)) {
+            return this->binUpperBound(bin);
+        }
+    }
+    return this->max_;
+}
@@ -0,0 +1,193 @@
+#include <micro/math/numeric.hpp>
+
+#include <LateralMpc.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace micro;
+
+namespace {
+
+constexpr uint32_t NUM_STATES = 3;  // position error, angle error, curvature
+constexpr uint32_t NUM_INPUTS = 2;  // front and rear wheel angles
+
+typedef float StateMatrix[NUM_STATES][NUM_STATES];
+typedef float InputMatrix[NUM_STATES][NUM_INPUTS];
+typedef float GainMatrix[NUM_INPUTS][NUM_STATES];
+
+} // namespace
+
+LateralMpc::LateralMpc(const meter_t pivotDist, const radian_t maxWheelAngle, const millisecond_t step, const m_per_sec_t maxSpeed, const Weights& weights)
+    : weights(weights)
+    , pivotDist_(pivotDist)
+    , maxWheelAngle_(maxWheelAngle)
+    , step_(step)
+    , maxSpeed_(maxSpeed)
+    , compiledWeights_(weights)
+    , gains_()
+    , activeGainsIdx_(0) {
+    this->compile();
+}
+
+void LateralMpc::compile() {
+    // the weights may be edited while the gains are being compiled, the compiled weights are the ones at the start
+    this->compiledWeights_ = this->weights;
+
+    const uint32_t inactiveGainsIdx = 1 - this->activeGainsIdx_;
+    Gains * const gains = this->gains_[inactiveGainsIdx];
+    for (uint32_t i = 0; i < NUM_SPEED_SAMPLES; ++i) {
+        gains[i] = this->calculateGains(this->maxSpeed_ * static_cast<float>(i) / static_cast<float>(NUM_SPEED_SAMPLES - 1));
+    }
+
+    // the gains need to be complete before they are activated
+    std::atomic_thread_fence(std::memory_order_release);
+    this->activeGainsIdx_ = inactiveGainsIdx;
+}
+
+bool LateralMpc::isCompiled() const {
+    return this->weights.pos == this->compiledWeights_.pos
+        && this->weights.angle == this->compiledWeights_.angle
+        && this->weights.wheel == this->compiledWeights_.wheel;
+}
+
+LateralMpc::Output LateralMpc::update(const m_per_sec_t speed, const meter_t posError, const radian_t angleError, const float curvature) const {
+    // the gains are linearly interpolated between the neighbouring speed samples
+    const float pos   = clamp(abs(speed) / this->maxSpeed_, 0.0f, 1.0f) * static_cast<float>(NUM_SPEED_SAMPLES - 1);
+    const uint32_t i  = std::min(static_cast<uint32_t>(pos), NUM_SPEED_SAMPLES - 2);
+    const float ratio = pos - static_cast<float>(i);
+
+    const Gains * const gains = this->gains_[this->activeGainsIdx_];
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    const Gains& g1 = gains[i];
+    const Gains& g2 = gains[i + 1];
+    const float x[NUM_STATES] = { posError.get(), angleError.get(), curvature };
+
+    float front = 0.0f, rear = 0.0f;
+    for (uint32_t s = 0; s < NUM_STATES; ++s) {
+        front += (g1.front[s] + (g2.front[s] - g1.front[s]) * ratio) * x[s];
+        rear  += (g1.rear[s]  + (g2.rear[s]  - g1.rear[s])  * ratio) * x[s];
+    }
+
+    return {
+        clamp(radian_t(front), -this->maxWheelAngle_, this->maxWheelAngle_),
+        clamp(radian_t(rear), -this->maxWheelAngle_, this->maxWheelAngle_)
+    };
+}
+
+LateralMpc::Gains LateralMpc::calculateGains(const m_per_sec_t speed) const {
+    const float ds = (speed * this->step_).get();           // distance travelled in one step
+    const float dy = ds / this->pivotDist_.get();            // yaw change of a unit wheel angle difference in one step
+
+    const StateMatrix A = {
+        { 1.0f, ds,   0.0f },
+        { 0.0f, 1.0f, ds   },
+        { 0.0f, 0.0f, 1.0f }
+    };
+
+    const InputMatrix B = {
+        { -ds / 2, -ds / 2 },
+        { -dy,      dy     },
+        { 0.0f,     0.0f   }
+    };
+
+    const float Q[NUM_STATES] = { this->compiledWeights_.pos, this->compiledWeights_.angle, 0.0f };
+    const float R = this->compiledWeights_.wheel;
+
+    // the cost-to-go of the terminal state
+    StateMatrix P = {};
+    for (uint32_t s = 0; s < NUM_STATES; ++s) {
+        P[s][s] = Q[s];
+    }
+
+    GainMatrix K = {};
+
+    for (uint32_t k = 0; k < HORIZON; ++k) {
+        // BtP = B' * P
+        float BtP[NUM_INPUTS][NUM_STATES] = {};
+        for (uint32_t i = 0; i < NUM_INPUTS; ++i) {
+            for (uint32_t j = 0; j < NUM_STATES; ++j) {
+                for (uint32_t s = 0; s < NUM_STATES; ++s) {
+                    BtP[i][j] += B[s][i] * P[s][j];
+                }
+            }
+        }
+
+        // S = R + B' * P * B
+        float S[NUM_INPUTS][NUM_INPUTS] = {};
+        for (uint32_t i = 0; i < NUM_INPUTS; ++i) {
+            for (uint32_t j = 0; j < NUM_INPUTS; ++j) {
+                for (uint32_t s = 0; s < NUM_STATES; ++s) {
+                    S[i][j] += BtP[i][s] * B[s][j];
+                }
+            }
+            S[i][i] += R;
+        }
+
+        // BtPA = B' * P * A
+        float BtPA[NUM_INPUTS][NUM_STATES] = {};
+        for (uint32_t i = 0; i < NUM_INPUTS; ++i) {
+            for (uint32_t j = 0; j < NUM_STATES; ++j) {
+                for (uint32_t s = 0; s < NUM_STATES; ++s) {
+                    BtPA[i][j] += BtP[i][s] * A[s][j];
+                }
+            }
+        }
+
+        // K = S^-1 * B' * P * A
+        const float det = S[0][0] * S[1][1] - S[0][1] * S[1][0];
+        const float Sinv[NUM_INPUTS][NUM_INPUTS] = {
+            {  S[1][1] / det, -S[0][1] / det },
+            { -S[1][0] / det,  S[0][0] / det }
+        };
+
+        for (uint32_t i = 0; i < NUM_INPUTS; ++i) {
+            for (uint32_t j = 0; j < NUM_STATES; ++j) {
+                K[i][j] = Sinv[i][0] * BtPA[0][j] + Sinv[i][1] * BtPA[1][j];
+            }
+        }
+
+        // P = Q + A' * P * (A - B * K)
+        StateMatrix AmBK;
+        for (uint32_t i = 0; i < NUM_STATES; ++i) {
+            for (uint32_t j = 0; j < NUM_STATES; ++j) {
+                AmBK[i][j] = A[i][j] - B[i][0] * K[0][j] - B[i][1] * K[1][j];
+            }
+        }
+
+        StateMatrix PAmBK = {};
+        for (uint32_t i = 0; i < NUM_STATES; ++i) {
+            for (uint32_t j = 0; j < NUM_STATES; ++j) {
+                for (uint32_t s = 0; s < NUM_STATES; ++s) {
+                    PAmBK[i][j] += P[i][s] * AmBK[s][j];
+                }
+            }
+        }
+
+        StateMatrix newP = {};
+        for (uint32_t i = 0; i < NUM_STATES; ++i) {
+            for (uint32_t j = 0; j < NUM_STATES; ++j) {
+                for (uint32_t s = 0; s < NUM_STATES; ++s) {
+                    newP[i][j] += A[s][i] * PAmBK[s][j];
+                }
+            }
+            newP[i][i] += Q[i];
+        }
+
+        // keeps the cost-to-go matrix symmetric despite the rounding errors
+        for (uint32_t i = 0; i < NUM_STATES; ++i) {
+            for (uint32_t j = 0; j < NUM_STATES; ++j) {
+                P[i][j] = (newP[i][j] + newP[j][i]) / 2;
+            }
+        }
+    }
+
+    // the control law is u = -K * x
+    Gains gains;
+    for (uint32_t s = 0; s < NUM_STATES; ++s) {
+        gains.front[s] = -K[0][s];
+        gains.rear[s]  = -K[1][s];
+    }
+    return gains;
+}
@@ -1,32 +1,186 @@
 #include <micro/port/timer.hpp>
 #include <micro/utils/log.hpp>
+
+#include <cfg_track.hpp>
 #include <RaceTrackInfo.hpp>
+#include <track_utils.hpp>
 
 using namespace micro;
 
-RaceTrackInfo::RaceTrackInfo(const TrackSegments& segments)
+RaceTrackInfo::RaceTrackInfo(const TrackSegments& segments, const TrackProfile& profile)
     : segments(segments)
+    , profile(profile)
     , seg(segments.end())
-    , lap(0) {}
+    , lap(0)
+    , learner(segments)
+    , segMapDists()
+    , isTrackMapRecording_(false)
+    , isAccelerateSignDetected_(false)
+    , lastAccelerateSignDist_(0)
+    , isFastSpeedEnabled_(true) {}
 
 void RaceTrackInfo::update(const CarProps& car, const LineInfo& lineInfo, const MainLine& mainLine, const micro::ControlData& controlData) {
+    this->update(getTime(), car, lineInfo, mainLine, controlData);
+}
+
+void RaceTrackInfo::update(const millisecond_t time, const CarProps& car, const LineInfo& lineInfo, const MainLine& mainLine, const micro::ControlData& controlData) {
+    const bool isLearningLap = this->lap >= cfg::RACE_FIRST_LEARNING_LAP && this->lap <= cfg::NUM_RACE_LAPS;
+    if (isLearningLap) {
+        this->learner.update(this->segmentIndex(), car, controlData.lineControl.target.pos - mainLine.centerLine.pos, controlData.speed);
+    }
+
     TrackSegments::const_iterator nextSeg = this->nextSegment();
-    if (nextSeg->hasBecomeActive(car, *this, (car.speed >= m_per_sec_t(0) ? lineInfo.front : lineInfo.rear).pattern) ||
+    if (this->hasBecomeActive(*nextSeg, car, (car.speed >= m_per_sec_t(0) ? lineInfo.front : lineInfo.rear).pattern) ||
+        (TrackTrigger::BrakeSign == nextSeg->trigger && this->isMappedBrakeSignPassed(car)) ||
         (this->lap >= 4 && car.distance - this->segStartCarProps.distance > this->seg->length + meter_t(1.5f))) {
+        if (isLearningLap) {
+            this->learner.onSegmentFinished(this->segmentIndex(), time - this->segStartTime);
+        }
+
+        const meter_t mapDist = this->trackMapDistance(car);
+
         this->seg                 = nextSeg;
+        this->segStartTime        = time;
         this->segStartCarProps    = car;
         this->segStartControlData = controlData;
         this->segStartLine        = mainLine.centerLine;
 
+        if (this->isTrackMapRecording_) {
+            this->segMapDists[this->segmentIndex()] = mapDist;
+        }
+
         if (this->segments.begin() == this->seg) {
-            LOG_INFO("Lap %u finished (time: %f seconds)", static_cast<uint32_t>(this->lap), static_cast<second_t>(getTime() - this->lapStartTime).get());
+            LOG_INFO("Lap %u finished (time: %f seconds)", static_cast<uint32_t>(this->lap), static_cast<second_t>(time - this->lapStartTime).get());
+            if (isLearningLap) {
+                this->learner.onLapFinished(time - this->lapStartTime);
+            }
             ++this->lap;
-            this->lapStartTime = getTime();
+            this->lapStartTime = time;
+
+            // the map is recorded in each safety-car lap that starts at the start line, the last one is kept for the race laps
+            this->isTrackMapRecording_ = this->lap <= cfg::RACE_FIRST_LEARNING_LAP - 1;
+            if (this->isTrackMapRecording_) {
+                this->trackMap.reset();
+                this->segMapDists[0] = meter_t(0);
+            }
         }
         LOG_INFO("Segment %u became active (lap: %u)", static_cast<uint32_t>(std::distance(this->segments.begin(), this->seg)), static_cast<uint32_t>(this->lap));
     }
+
+    // falls back to a safe speed in the fast segments when the car gets far from the line, until it goes straight again
+    if (this->seg->isFast) {
+        if (this->isFastSpeedEnabled_ && abs(mainLine.centerLine.pos) > centimeter_t(12)) {
+            this->isFastSpeedEnabled_ = false;
+        } else if (!this->isFastSpeedEnabled_ && car.orientedDistance > centimeter_t(50)) {
+            this->isFastSpeedEnabled_ = true;
+        }
+    }
+
+    if (this->isTrackMapRecording_) {
+        this->trackMap.record(this->trackMapDistance(car), car.pose, mainLine.centerLine.pos,
+            (car.speed >= m_per_sec_t(0) ? lineInfo.front : lineInfo.rear).pattern.type);
+    }
 }
 
 TrackSegments::const_iterator RaceTrackInfo::nextSegment() const {
     return this->segments.back() == this->seg ? this->segments.begin() : std::next(this->seg);
 }
+
+ControlData RaceTrackInfo::control(const CarProps& car, const MainLine& mainLine) const {
+    const m_per_sec_t *speeds    = track_get(this->profile.speeds, this->lap);
+    const uint32_t segIdx        = this->segmentIndex();
+    const uint32_t sectionIdx    = this->learner.sectionIndex(segIdx);
+    const millisecond_t rampTime = track_get(this->profile.accelerationRamps, this->lap)[sectionIdx];
+
+    ControlData controlData;
+
+    if (this->seg->isFast) {
+        controlData.speed            = this->isFastSpeedEnabled_ ? this->fastSpeed(speeds[segIdx]) : m_per_sec_t(2.0f);
+        controlData.rampTime         = rampTime;
+        controlData.rearSteerEnabled = false;
+    } else if (TrackTrigger::BrakeSign == this->seg->trigger) {
+        const uint32_t prevSegIdx = segIdx > 0 ? segIdx - 1 : this->segments.size() - 1;
+        controlData.speed = car.distance - this->segStartCarProps.distance > this->brakeOffset(track_get(this->profile.brakeOffsets, this->lap)[sectionIdx]) ?
+            speeds[segIdx] : this->fastSpeed(speeds[prevSegIdx]);
+        controlData.rampTime         = rampTime;
+        controlData.rearSteerEnabled = true;
+    } else {
+        controlData.speed            = speeds[segIdx];
+        controlData.rampTime         = millisecond_t(100);
+        controlData.rearSteerEnabled = true;
+    }
+
+    const TrackLineProfile& line = 1 == this->lap || 3 == this->lap ? this->seg->safetyCarLine : this->seg->raceLine;
+    controlData.lineControl.actual       = mainLine.centerLine;
+    controlData.lineControl.target.pos   = track_map_pos(car, *this, line.pos);
+    controlData.lineControl.target.angle = track_map_angle(car, *this, line.angle);
+    return controlData;
+}
+
+float RaceTrackInfo::curvature(const CarProps& car, const meter_t preview) const {
+    return this->trackMap.size() > 0 && !this->isTrackMapRecording_ ? this->trackMapSample(car, preview).curvature : 0.0f;
+}
+
+m_per_sec_t RaceTrackInfo::fastSpeed(const m_per_sec_t tableSpeed) const {
+    return this->lap >= cfg::RACE_FIRST_LEARNING_LAP && this->lap <= cfg::NUM_RACE_LAPS ?
+        std::max(tableSpeed + this->learner.sections()[this->learner.sectionIndex(this->segmentIndex())].fastSpeedDelta, m_per_sec_t(0)) :
+        tableSpeed;
+}
+
+meter_t RaceTrackInfo::brakeOffset(const meter_t tableOffset) const {
+    return this->lap >= cfg::RACE_FIRST_LEARNING_LAP && this->lap <= cfg::NUM_RACE_LAPS ?
+        std::max(tableOffset + this->learner.sections()[this->learner.sectionIndex(this->segmentIndex())].brakeOffsetDelta, meter_t(0)) :
+        tableOffset;
+}
+
+TrackMap::Sample RaceTrackInfo::trackMapSample(const CarProps& car, const meter_t preview) const {
+    return this->trackMap.at(this->trackMapDistance(car) + preview);
+}
+
+bool RaceTrackInfo::isMappedBrakeSignPassed(const CarProps& car) const {
+    return this->trackMap.size() > 0 && !this->isTrackMapRecording_ &&
+        car.distance - this->segStartCarProps.distance > cfg::RACE_MISSED_BRAKE_SIGN_DIST &&
+        LinePattern::BRAKE == this->trackMapSample(car, -cfg::RACE_MISSED_BRAKE_SIGN_DIST).pattern;
+}
+
+uint32_t RaceTrackInfo::segmentIndex() const {
+    return static_cast<uint32_t>(std::distance(this->segments.begin(), this->seg));
+}
+
+bool RaceTrackInfo::hasBecomeActive(const TrackSegment& segment, const CarProps& car, const LinePattern& pattern) {
+    bool active = false;
+
+    switch (segment.trigger) {
+    case TrackTrigger::Accelerate:
+        if (LinePattern::ACCELERATE == pattern.type) {
+            this->isAccelerateSignDetected_ = true;
+            this->lastAccelerateSignDist_   = car.distance;
+        } else if (car.distance - this->lastAccelerateSignDist_ > meter_t(5)) {
+            this->isAccelerateSignDetected_ = false;
+        }
+
+        if (this->isAccelerateSignDetected_ && car.orientedDistance > centimeter_t(25)) {
+            this->isAccelerateSignDetected_ = false;
+            active = true;
+        }
+        break;
+
+    case TrackTrigger::BrakeSign:
+        active = LinePattern::BRAKE == pattern.type;
+        break;
+
+    case TrackTrigger::SingleLine:
+        active = LinePattern::SINGLE_LINE == pattern.type;
+        break;
+
+    case TrackTrigger::Distance:
+        active = car.distance - this->segStartCarProps.distance > this->seg->length;
+        break;
+    }
+
+    return active;
+}
+
+meter_t RaceTrackInfo::trackMapDistance(const CarProps& car) const {
+    return this->segMapDists[this->segmentIndex()] + car.distance - this->segStartCarProps.distance;
+}
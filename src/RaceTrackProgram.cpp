@@ -0,0 +1,270 @@
+#include <micro/math/numeric.hpp>
+#include <micro/utils/log.hpp>
+
+#include <cfg_car.hpp>
+#include <RaceTrackProgram.hpp>
+
+using namespace micro;
+
+namespace {
+
+constexpr centimeter_t MAX_VALID_SAFETY_CAR_DISTANCE = centimeter_t(120);
+
+m_per_sec_t SAFETY_CAR_SLOW_MAX_SPEED     = m_per_sec_t(1.15f);
+m_per_sec_t SAFETY_CAR_FAST_MAX_SPEED     = m_per_sec_t(1.7f);
+m_per_sec_t REACH_SAFETY_CAR_SPEED        = m_per_sec_t(0.6f);
+m_per_sec_t OVERTAKE_BEGIN_SPEED          = m_per_sec_t(1.0f);
+m_per_sec_t OVERTAKE_STRAIGHT_START_SPEED = m_per_sec_t(1.5f);
+m_per_sec_t OVERTAKE_STRAIGHT_SPEED       = m_per_sec_t(4.0f);
+m_per_sec_t OVERTAKE_END_SPEED            = m_per_sec_t(2.0f);
+m_per_sec_t TURN_AROUND_SPEED             = m_per_sec_t(1.0f);
+
+meter_t OVERTAKE_SECTION_LENGTH           = centimeter_t(820);
+meter_t OVERTAKE_PREPARE_DISTANCE         = centimeter_t(100);
+meter_t OVERTAKE_BEGIN_SINE_ARC_LENGTH    = centimeter_t(140);
+meter_t OVERTAKE_END_SINE_ARC_LENGTH      = centimeter_t(180);
+meter_t OVERTAKE_SIDE_DISTANCE            = centimeter_t(50);
+
+meter_t TURN_AROUND_RADIUS                = centimeter_t(40);
+meter_t TURN_AROUND_SINE_ARC_LENGTH       = centimeter_t(60);
+
+// the curvature feed-forward is used when the car is controlled by the track segments
+bool isFollowingTrackSegments(const cfg::ProgramState programState) {
+    return cfg::ProgramState::FollowSafetyCar == programState || cfg::ProgramState::Race == programState;
+}
+
+} // namespace
+
+RaceTrackProgram::RaceTrackProgram(const TrackSegments& segments, const TrackProfile& profile)
+    : trackInfo(segments, profile)
+    , turnAroundSeg_(this->getFastSegment(1))
+    , overtakeSeg_(this->getFastSegment(3))
+    , mainLine_(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST)
+    , prevProgramState_(cfg::ProgramState::INVALID)
+    , targetSpeedSign_(Sign::POSITIVE)
+    , lastDistWithValidLine_(0)
+    , lastDistWithSafetyCar_(0)
+    , lastOvertakeLap_(0)
+    , prevLap_(this->trackInfo.lap) {}
+
+bool RaceTrackProgram::handles(const cfg::ProgramState programState) {
+    return isBtw(enum_cast(programState), enum_cast(cfg::ProgramState::ReachSafetyCar), enum_cast(cfg::ProgramState::Test));
+}
+
+bool RaceTrackProgram::step(const Input& input, Output& output) {
+    const cfg::ProgramState programState = input.programState;
+    const cfg::ProgramState prevProgramState = this->prevProgramState_;
+    this->prevProgramState_ = programState;
+
+    if (!handles(programState)) {
+        return false;
+    }
+
+    const CarProps& car = input.car;
+    const LineInfo& lineInfo = input.lineInfo;
+
+    output.programState          = programState;
+    output.isLearningLapFinished = false;
+
+    // runs for the first time that this program handles the program state
+    if (!handles(prevProgramState)) {
+        if ((this->trackInfo.seg = this->getFastSegment(programState)) != this->trackInfo.segments.end()) { // race
+            this->trackInfo.lap = 3;
+            this->targetSpeedSign_ = Sign::POSITIVE;
+            output.programState = cfg::ProgramState::Race;
+        } else { // reach safety car
+            this->trackInfo.lap = 1;
+            this->trackInfo.seg = this->trackInfo.segments.begin();
+            this->targetSpeedSign_ = input.safetyCarFollowSpeedSign;
+        }
+
+        this->lastDistWithValidLine_ = car.distance;
+        this->lastDistWithSafetyCar_ = car.distance;
+
+        this->trackInfo.lapStartTime = input.time;
+        this->trackInfo.segStartTime = input.time;
+        this->trackInfo.segStartCarProps = car;
+        this->trackInfo.segStartLine = this->mainLine_.centerLine;
+    }
+
+    micro::updateMainLine(lineInfo.front.lines, lineInfo.rear.lines, this->mainLine_);
+
+    // when in turn-around state, does not update track info to prevent logic errors caused by possible line pattern detections
+    if (cfg::ProgramState::TurnAround != programState) {
+        this->trackInfo.update(input.time, car, lineInfo, this->mainLine_, this->controlData_);
+    }
+
+    // the learned data is stored after each learning lap, so that the next run can start from it
+    if (this->trackInfo.lap != this->prevLap_) {
+        output.isLearningLapFinished = this->prevLap_ >= cfg::RACE_FIRST_LEARNING_LAP && this->prevLap_ <= cfg::NUM_RACE_LAPS;
+        this->prevLap_ = this->trackInfo.lap;
+    }
+
+    // sets default lateral control
+    ControlData& controlData = this->controlData_;
+    controlData.rearSteerEnabled    = true;
+    controlData.lineControl.actual  = this->mainLine_.centerLine;
+    controlData.lineControl.target  = { millimeter_t(0), radian_t(0) };
+
+    this->lineDetectControl_.domain = linePatternDomain_t::Race;
+    this->lineDetectControl_.isReducedScanRangeEnabled = false;
+
+    const meter_t distFromSafetyCar = Sign::POSITIVE == this->targetSpeedSign_ ? input.distances.front : input.distances.rear;
+    if (distFromSafetyCar < centimeter_t(100)) {
+        this->lastDistWithSafetyCar_ = car.distance;
+    }
+
+    if (LinePattern::NONE != lineInfo.front.pattern.type || LinePattern::NONE != lineInfo.rear.pattern.type) {
+        this->lastDistWithValidLine_ = car.distance;
+    }
+
+    switch (programState) {
+    case cfg::ProgramState::ReachSafetyCar:
+        controlData.speed = this->targetSpeedSign_ * REACH_SAFETY_CAR_SPEED;
+        controlData.rampTime = millisecond_t(500);
+        if (distFromSafetyCar != centimeter_t(0) && abs(this->safetyCarFollowSpeed(distFromSafetyCar, this->trackInfo.seg->isFast)) < abs(controlData.speed)) {
+            output.programState = cfg::ProgramState::FollowSafetyCar;
+            LOG_DEBUG("Reached safety car, starts following");
+        }
+        break;
+
+    case cfg::ProgramState::FollowSafetyCar:
+        controlData = this->getControl(car);
+        controlData.speed = this->safetyCarFollowSpeed(distFromSafetyCar, this->trackInfo.seg->isFast);
+        controlData.rampTime = millisecond_t(0);
+
+        if (this->overtakeSeg_ == this->trackInfo.seg && (1 == this->trackInfo.lap || 3 == this->trackInfo.lap) && this->trackInfo.lap != this->lastOvertakeLap_) {
+            output.programState = cfg::ProgramState::OvertakeSafetyCar;
+            LOG_DEBUG("Starts overtake");
+        } else if (car.distance - this->lastDistWithSafetyCar_ > MAX_VALID_SAFETY_CAR_DISTANCE && this->trackInfo.seg->isFast) {
+            output.programState = cfg::ProgramState::Race;
+            LOG_DEBUG("Safety car left the track, starts race");
+        }
+        break;
+
+    case cfg::ProgramState::OvertakeSafetyCar:
+        if (programState != prevProgramState) {
+            this->lastOvertakeLap_ = this->trackInfo.lap;
+            this->overtake_.initialize(car, this->targetSpeedSign_,
+                OVERTAKE_BEGIN_SPEED, OVERTAKE_STRAIGHT_START_SPEED, OVERTAKE_STRAIGHT_SPEED, OVERTAKE_END_SPEED,
+                OVERTAKE_SECTION_LENGTH, OVERTAKE_PREPARE_DISTANCE, OVERTAKE_BEGIN_SINE_ARC_LENGTH, OVERTAKE_END_SINE_ARC_LENGTH,
+                OVERTAKE_SIDE_DISTANCE);
+        }
+
+        controlData.speed = this->safetyCarFollowSpeed(distFromSafetyCar, this->trackInfo.seg->isFast);
+        this->overtake_.update(car, lineInfo, this->mainLine_, controlData);
+
+        if (this->overtake_.finished()) {
+            output.programState = cfg::ProgramState::Race;
+            LOG_DEBUG("Overtake finished, starts race");
+        }
+        break;
+
+    case cfg::ProgramState::Race:
+        controlData = this->getControl(car);
+
+        this->lineDetectControl_.isReducedScanRangeEnabled = this->trackInfo.lap >= 4 &&
+                                                             (car.speed > m_per_sec_t(0) ?
+                                                                 lineInfo.front.lines.size() == 1 :
+                                                                 lineInfo.rear.lines.size() == 1);
+
+        if (this->trackInfo.lap > cfg::NUM_RACE_LAPS) {
+            output.programState = cfg::ProgramState::Finish;
+            LOG_DEBUG("Race finished");
+
+        } else if (this->trackInfo.lap <= 3 && distFromSafetyCar < (this->trackInfo.seg->isFast ? MAX_VALID_SAFETY_CAR_DISTANCE - centimeter_t(2) : centimeter_t(80))) {
+            output.programState = cfg::ProgramState::FollowSafetyCar;
+            LOG_DEBUG("Reached safety car, starts following");
+
+        } else if (Sign::NEGATIVE == this->targetSpeedSign_          &&
+                   this->trackInfo.lap == 2                          &&
+                   this->trackInfo.seg == this->turnAroundSeg_       &&
+                   car.distance - this->trackInfo.segStartCarProps.distance > meter_t(3)) {
+
+            output.programState = cfg::ProgramState::TurnAround;
+            LOG_DEBUG("Starts turn-around.");
+        }
+
+        if (car.distance - this->lastDistWithValidLine_ > meter_t(4) && this->trackInfo.lap >= 4) {
+            output.programState = cfg::ProgramState::Error;
+            LOG_ERROR("An error has occurred. Car stopped.");
+        }
+        break;
+
+    case cfg::ProgramState::TurnAround:
+        if (programState != prevProgramState) {
+            this->turnAround_.initialize(car, -this->targetSpeedSign_, TURN_AROUND_SPEED, TURN_AROUND_SINE_ARC_LENGTH, TURN_AROUND_RADIUS);
+        }
+
+        this->turnAround_.update(car, lineInfo, this->mainLine_, controlData);
+
+        if (this->turnAround_.finished()) {
+            this->targetSpeedSign_ = -this->targetSpeedSign_;
+            output.programState = cfg::ProgramState::Race;
+        }
+        break;
+
+    case cfg::ProgramState::Finish:
+        if (this->trackInfo.seg->isFast && car.distance - this->trackInfo.segStartCarProps.distance < meter_t(2.0f)) {
+            controlData = this->getControl(car);
+        } else {
+            controlData.speed = m_per_sec_t(0);
+            controlData.rampTime = millisecond_t(1500);
+        }
+        break;
+
+    case cfg::ProgramState::Error:
+        controlData.speed = m_per_sec_t(0);
+        controlData.rampTime = millisecond_t(1000);
+        break;
+
+    case cfg::ProgramState::Test:
+        controlData.speed = input.testSpeed;
+        controlData.rampTime = millisecond_t(500);
+        break;
+
+    default:
+        LOG_ERROR("Invalid program state counter: [%u]", enum_cast(programState));
+        break;
+    }
+
+    // the feed-forward is only used in the slow sections, where the car turns the most
+    output.curvature = 0.0f;
+    if (isFollowingTrackSegments(programState) && !this->trackInfo.seg->isFast) {
+        output.curvature = this->trackInfo.curvature(car, abs(car.speed) * cfg::RACE_CURVATURE_PREVIEW_TIME);
+    }
+
+    output.controlData       = controlData;
+    output.lineDetectControl = this->lineDetectControl_;
+    return true;
+}
+
+TrackSegments::const_iterator RaceTrackProgram::getFastSegment(const uint32_t fastSeg) const {
+    TrackSegments::const_iterator it = this->trackInfo.segments.begin();
+    uint32_t numFastSegs = 0;
+    for (; it != this->trackInfo.segments.end(); ++it) {
+        if (it->isFast && ++numFastSegs == fastSeg) {
+            break;
+        }
+    }
+    return it;
+}
+
+TrackSegments::const_iterator RaceTrackProgram::getFastSegment(const cfg::ProgramState programState) const {
+    return this->getFastSegment(
+        cfg::ProgramState::Race          == programState ? 1 :
+        cfg::ProgramState::Race_segFast2 == programState ? 2 :
+        cfg::ProgramState::Race_segFast3 == programState ? 3 :
+        cfg::ProgramState::Race_segFast4 == programState ? 4 : micro::numeric_limits<uint32_t>::max()
+    );
+}
+
+m_per_sec_t RaceTrackProgram::safetyCarFollowSpeed(const meter_t distFromSafetyCar, const bool isFast) const {
+    return this->targetSpeedSign_ * map(distFromSafetyCar, meter_t(0.3f), meter_t(0.8f), m_per_sec_t(0), isFast ? SAFETY_CAR_FAST_MAX_SPEED : SAFETY_CAR_SLOW_MAX_SPEED);
+}
+
+ControlData RaceTrackProgram::getControl(const CarProps& car) const {
+    ControlData controlData = this->trackInfo.control(car, this->mainLine_);
+    controlData.speed = this->targetSpeedSign_ * controlData.speed;
+    return controlData;
+}
@@ -0,0 +1,130 @@
+#include <micro/math/numeric.hpp>
+
+#include <TrackMap.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace micro;
+
+namespace {
+
+constexpr float POS_RESOLUTION      = 0.001f;   // [m]
+constexpr float ANGLE_RESOLUTION    = 0.005f;   // [rad]
+constexpr float LINE_POS_RESOLUTION = 0.002f;   // [m]
+
+int8_t quantize(const float value, const float resolution) {
+    return static_cast<int8_t>(clamp(std::lround(value / resolution), -127l, 127l));
+}
+
+} // namespace
+
+constexpr uint32_t TrackMap::CAPACITY;
+constexpr uint32_t TrackMap::KEYFRAME_INTERVAL;
+constexpr centimeter_t TrackMap::SAMPLE_DIST;
+
+static_assert(sizeof(TrackMap) < 8 * 1024, "TrackMap must fit into 8 kilobytes");
+
+TrackMap::TrackMap() {
+    this->reset();
+}
+
+void TrackMap::reset() {
+    this->size_        = 0;
+    this->lastDecoded_ = {};
+    this->lastDist_    = meter_t(0);
+    this->lastPose_    = {};
+    this->hasLastPose_ = false;
+}
+
+void TrackMap::record(const meter_t dist, const Pose& pose, const millimeter_t linePos, const LinePattern::type_t pattern) {
+    const Keyframe current = { pose.pos.X.get(), pose.pos.Y.get(), pose.angle.get() };
+
+    if (!this->hasLastPose_) {
+        this->lastPose_    = current;
+        this->lastDist_    = dist;
+        this->hasLastPose_ = true;
+    }
+
+    while (this->size_ < CAPACITY && SAMPLE_DIST * static_cast<float>(this->size_) <= dist) {
+        const meter_t sampleDist = SAMPLE_DIST * static_cast<float>(this->size_);
+
+        // the samples the car has passed since the previous call are interpolated between the previous and the current pose
+        const float ratio = dist > this->lastDist_ ? std::max((sampleDist - this->lastDist_) / (dist - this->lastDist_), 0.0f) : 1.0f;
+        const float dAngle = normalizePM180(radian_t(current.angle - this->lastPose_.angle)).get();
+
+        const Keyframe samplePose = {
+            this->lastPose_.x + (current.x - this->lastPose_.x) * ratio,
+            this->lastPose_.y + (current.y - this->lastPose_.y) * ratio,
+            this->lastPose_.angle + dAngle * ratio
+        };
+
+        this->encode(samplePose, linePos, pattern);
+    }
+
+    this->lastPose_ = current;
+    this->lastDist_ = dist;
+}
+
+meter_t TrackMap::length() const {
+    return this->size_ > 0 ? meter_t(SAMPLE_DIST * static_cast<float>(this->size_ - 1)) : meter_t(0);
+}
+
+TrackMap::Sample TrackMap::at(const meter_t dist) const {
+    const uint32_t idx = dist > meter_t(0) ? std::min(static_cast<uint32_t>(dist / SAMPLE_DIST), this->size_ - 1) : 0;
+
+    float dAngle = 0.0f;
+    const Keyframe pose = this->decodePose(idx, dAngle);
+    const EncodedSample& encoded = this->samples_[idx];
+
+    Sample sample;
+    sample.pose.pos   = { meter_t(pose.x), meter_t(pose.y) };
+    sample.pose.angle = normalize360(radian_t(pose.angle));
+    sample.curvature  = dAngle / meter_t(SAMPLE_DIST).get();
+    sample.linePos    = meter_t(encoded.linePos * LINE_POS_RESOLUTION);
+    sample.pattern    = static_cast<LinePattern::type_t>(encoded.pattern);
+    return sample;
+}
+
+TrackMap::Keyframe TrackMap::decodePose(const uint32_t idx, float& dAngle) const {
+    const uint32_t keyframeIdx = idx / KEYFRAME_INTERVAL;
+    Keyframe pose = this->keyframes_[keyframeIdx];
+
+    for (uint32_t i = keyframeIdx * KEYFRAME_INTERVAL + 1; i <= idx; ++i) {
+        pose.x     += this->samples_[i].dx * POS_RESOLUTION;
+        pose.y     += this->samples_[i].dy * POS_RESOLUTION;
+        pose.angle += this->samples_[i].dAngle * ANGLE_RESOLUTION;
+    }
+
+    dAngle = this->samples_[idx].dAngle * ANGLE_RESOLUTION;
+    return pose;
+}
+
+void TrackMap::encode(const Keyframe& pose, const millimeter_t linePos, const LinePattern::type_t pattern) {
+    EncodedSample& sample = this->samples_[this->size_];
+
+    // the deltas of the first sample are meaningless, it is always a keyframe
+    if (this->size_ > 0) {
+        sample.dx     = quantize(pose.x - this->lastDecoded_.x, POS_RESOLUTION);
+        sample.dy     = quantize(pose.y - this->lastDecoded_.y, POS_RESOLUTION);
+        sample.dAngle = quantize(normalizePM180(radian_t(pose.angle - this->lastDecoded_.angle)).get(), ANGLE_RESOLUTION);
+    } else {
+        sample.dx = sample.dy = sample.dAngle = 0;
+    }
+
+    sample.linePos = quantize(meter_t(linePos).get(), LINE_POS_RESOLUTION);
+    sample.pattern = static_cast<uint8_t>(pattern);
+
+    if (this->size_ % KEYFRAME_INTERVAL == 0) {
+        // the heading delta of a keyframe sample is still stored, it is needed for the curvature
+        this->keyframes_[this->size_ / KEYFRAME_INTERVAL] = pose;
+        this->lastDecoded_ = pose;
+    } else {
+        // the next delta is relative to the decoded pose, so the rounding errors do not accumulate
+        this->lastDecoded_.x     += sample.dx * POS_RESOLUTION;
+        this->lastDecoded_.y     += sample.dy * POS_RESOLUTION;
+        this->lastDecoded_.angle += sample.dAngle * ANGLE_RESOLUTION;
+    }
+
+    ++this->size_;
+}
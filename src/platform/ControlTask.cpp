@@ -1,29 +1,48 @@
 #include <cfg_board.hpp>
-#include <micro/container/infinite_buffer.hpp>
 #include <micro/container/map.hpp>
 #include <micro/control/PID_Controller.hpp>
 #include <micro/debug/params.hpp>
 #include <micro/debug/SystemManager.hpp>
 #include <micro/panel/CanManager.hpp>
 #include <micro/port/queue.hpp>
+#include <micro/port/semaphore.hpp>
 #include <micro/port/task.hpp>
 #include <micro/sensor/Filter.hpp>
 #include <micro/utils/CarProps.hpp>
 #include <micro/utils/ControlData.hpp>
 #include <micro/utils/Line.hpp>
 #include <micro/utils/log.hpp>
+#include <micro/utils/str_utils.hpp>
 #include <micro/utils/timer.hpp>
 
 #include <cfg_car.hpp>
 #include <cfg_track.hpp>
+#include <DerivativeFilter.hpp>
+#include <GainSchedule.hpp>
+#include <LatencyHistogram.hpp>
+#include <LateralMpc.hpp>
+#include <SequencedHistory.hpp>
+
+#include <cmath>
 
 using namespace micro;
 
 extern queue_t<CarProps, 1> carPropsQueue;
+extern SequencedHistory<microsecond_t, 16> lineDetectCanRxTimeHistory;
+extern semaphore_t lineDetectCanRxSemaphore;
+extern semaphore_t paramsReceivedSemaphore;
 
 CanManager vehicleCanManager(can_Vehicle);
 
 queue_t<ControlData, 1> controlQueue;
+queue_t<ControlTimestamps, 1> controlTimestampsQueue;
+queue_t<float, 1> controlCurvatureQueue; // Curvature of the path ahead of the car [1/m], sent along with the control data.
+semaphore_t controlDataSemaphore;
+
+// the model period of the MPC is the period of the control updates: the controllers are updated once per new control data,
+// which the program tasks write once per line info, i.e. once per FrontLines frame
+// the gains are compiled by the debug task when the weights are edited, so that the compilation does not delay the control loop
+LateralMpc lateralMpc(cfg::CAR_FRONT_REAR_PIVOT_DIST, cfg::WHEEL_MAX_DELTA, can::FrontLines::period(), m_per_sec_t(8.0f), { 400.0f, 10.0f, 1.0f });
 
 namespace {
 
@@ -35,7 +54,7 @@ struct ServoOffsets {
     micro::radian_t extra;
 };
 
-sorted_map<m_per_sec_t, PID_Params, 20> frontLinePosControllerParams = {
+GainSchedule::Breakpoints frontLinePosControllerParams = {
     // speed        P      I      D
     { { 0.00f }, { 0.00f, 0.00f,   0.00f } },
     { { 0.10f }, { 2.20f, 0.00f, 120.00f } },
@@ -52,7 +71,7 @@ sorted_map<m_per_sec_t, PID_Params, 20> frontLinePosControllerParams = {
     { { 7.00f }, { 0.25f, 0.00f, 100.00f } }
 };
 
-sorted_map<m_per_sec_t, PID_Params, 20> rearLineAngleControllerParams = {
+GainSchedule::Breakpoints rearLineAngleControllerParams = {
     // speed        P      I      D
     { { 0.00f }, { 0.00f, 0.00f, 0.00f  } },
     { { 0.10f }, { 0.60f, 0.00f, 30.00f } },
@@ -69,11 +88,22 @@ sorted_map<m_per_sec_t, PID_Params, 20> rearLineAngleControllerParams = {
     { { 9.00f }, { 0.00f, 0.00f,  0.00f } }
 };
 
+GainSchedule frontLinePosGainSchedule(frontLinePosControllerParams);
+GainSchedule rearLineAngleGainSchedule(rearLineAngleControllerParams);
+
+// the breakpoints can be edited at the track, one breakpoint of each schedule at a time
+GainScheduleEditor frontLinePosGainEditor(frontLinePosControllerParams);
+GainScheduleEditor rearLineAngleGainEditor(rearLineAngleControllerParams);
+
 constexpr float SERVO_CONTROLLER_MAX_DELTA = static_cast<degree_t>(2 * cfg::WHEEL_MAX_DELTA).get();
 
 PID_Controller frontLinePosController(PID_Params{}, SERVO_CONTROLLER_MAX_DELTA, std::numeric_limits<float>::infinity(), 0.0f);
 PID_Controller rearLinePosController(PID_Params{}, SERVO_CONTROLLER_MAX_DELTA, std::numeric_limits<float>::infinity(), 0.0f);
 
+// the model-predictive controller can be selected instead of the PID controllers, it controls the front and rear wheels together
+bool isLateralMpcEnabled = false;
+bool isCurvatureFeedForwardEnabled = true;
+
 radian_t frontWheelTargetAngle;
 radian_t rearWheelTargetAngle;
 radian_t frontDistSensorServoTargetAngle;
@@ -83,16 +113,48 @@ CanFrameHandler vehicleCanFrameHandler;
 CanSubscriber::id_t vehicleCanSubscriberId = CanSubscriber::INVALID_ID;
 
 ControlData controlData;
+float controlCurvature = 0.0f;
+
+// latencies of the sensor-to-actuator pipeline stages
+LatencyHistogram lineToDecisionLatency;     // From the reception of the line info to the program task decision.
+LatencyHistogram gyroToDecisionLatency;     // From the gyro data read to the program task decision.
+LatencyHistogram decisionToSendLatency;     // From the program task decision to the LateralControl frame.
+LatencyHistogram lineToSendLatency;         // End-to-end: from the reception of the line info to the LateralControl frame.
+
+// the names of the registered latency histogram params: the bin counts and the maximum of each histogram
+char latencyHistogramParamNames[4 * (LatencyHistogram::NUM_BINS + 1)][12];
+
+ControlTimestamps unsentControlTimestamps;  // Timestamps of the newest control data whose wheel angles have not been sent yet.
+bool hasUnsentControlData = false;
+
 MainLine actualLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
 MainLine targetLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
 
 PID_Params frontParams = { 1.70f, 0.00f, 120.00f };
 PID_Params rearParams  = { 0.40f, 0.00f, 40.00f };
 
-constexpr uint32_t D_FILTER_SIZE = 30;
-infinite_buffer<std::pair<centimeter_t, degree_t>, 100> prevLineErrors;
+// derivatives of the line errors, for the D terms of the front and rear controllers
+// the filters give the derivatives per second, the D gains are tuned for the error changes over the nominal control period
+const second_t NOMINAL_CONTROL_PERIOD = can::FrontLines::period();
+DerivativeFilter<centimeter_t> posErrorDiffFilter(0.2f, DerivativeFilter<centimeter_t>::criticalBeta(0.2f));
+DerivativeFilter<degree_t> angleErrorDiffFilter(0.2f, DerivativeFilter<degree_t>::criticalBeta(0.2f));
+Sign prevSpeedSign = Sign::POSITIVE;
+microsecond_t prevLineRxTime;
+
+/* @brief Calculates the wheel angles that keep the car on a path with the given curvature, in the direction of travel.
+ * The difference of the front and rear wheel angles determines the curvature, it is split evenly when the rear steering is enabled.
+ */
+std::pair<radian_t, radian_t> curvatureFeedForward(const float curvature, const bool rearSteerEnabled) {
+    const float frontRearDiff = curvature * cfg::CAR_FRONT_REAR_PIVOT_DIST.get();
+    return rearSteerEnabled ?
+        std::make_pair(radian_t(std::atan(frontRearDiff / 2)), radian_t(-std::atan(frontRearDiff / 2))) :
+        std::make_pair(radian_t(std::atan(frontRearDiff)), radian_t(0));
+}
 
-void calcTargetAngles(const CarProps& car, const ControlData& controlData) {
+/* @brief Calculates the target wheel angles.
+ * @param dt The time elapsed since the line info of the previous control data was received
+ */
+void calcTargetAngles(const CarProps& car, const ControlData& controlData, const float curvature, const second_t dt) {
 
     const Sign speedSign = micro::sgn(car.speed);
 
@@ -111,30 +173,48 @@ void calcTargetAngles(const CarProps& car, const ControlData& controlData) {
     const radian_t targetControlAngle = targetLine.centerLine.angle;
 
     //frontLinePosController.tune(frontParams);
-    frontLinePosController.tune(frontLinePosControllerParams.lerp(abs(car.speed)));
-
-    const std::pair<centimeter_t, degree_t>& peekBackLineError = prevLineErrors.peek_back(D_FILTER_SIZE);
+    if (frontLinePosGainSchedule.update(car.speed)) {
+        frontLinePosController.tune(frontLinePosGainSchedule.params());
+    }
 
     const centimeter_t posError = targetControlLinePos - actualControlLinePos;
     const degree_t angleError   = targetControlAngle - actualControlAngle;
 
-    const centimeter_t posErrorDiff = (posError - peekBackLineError.first) / D_FILTER_SIZE;
-    const degree_t angleErrorDiff   = (angleError - peekBackLineError.second) / D_FILTER_SIZE;
+    // when the speed sign changes, the position error jumps from the front line to the rear line or vice versa
+    if (speedSign != prevSpeedSign) {
+        posErrorDiffFilter.reset();
+        prevSpeedSign = speedSign;
+    }
 
-    prevLineErrors.push_back({ posError, angleError });
+    const centimeter_t posErrorDiff = posErrorDiffFilter.update(posError, dt) * NOMINAL_CONTROL_PERIOD.get();
+    const degree_t angleErrorDiff   = angleErrorDiffFilter.update(angleError, dt) * NOMINAL_CONTROL_PERIOD.get();
 
-    frontLinePosController.update(posError.get(), posErrorDiff.get());
-    frontWheelTargetAngle = degree_t(frontLinePosController.output()) + targetControlAngle;
-    frontWheelTargetAngle = clamp(frontWheelTargetAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
+    if (isLateralMpcEnabled && controlData.rearSteerEnabled) {
+        // the model of the controller uses the position error at the car center
+        const meter_t centerPosError = targetLine.centerLine.pos - actualLine.centerLine.pos;
+        const LateralMpc::Output out = lateralMpc.update(car.speed, centerPosError, angleError, curvature);
+        frontWheelTargetAngle = clamp(out.frontWheelAngle + targetControlAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
+        rearWheelTargetAngle  = clamp(out.rearWheelAngle + targetControlAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
 
-    if (controlData.rearSteerEnabled) {
-        //rearLinePosController.tune(rearParams);
-        rearLinePosController.tune(rearLineAngleControllerParams.lerp(abs(car.speed)));
-        rearLinePosController.update(angleError.get(), angleErrorDiff.get());
-        rearWheelTargetAngle = degree_t(rearLinePosController.output()) + targetControlAngle;
-        rearWheelTargetAngle = clamp(rearWheelTargetAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
     } else {
-        rearWheelTargetAngle = clamp(targetControlAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
+        // the controllers only need to correct the residual errors of the feed-forward
+        const std::pair<radian_t, radian_t> feedForward = curvatureFeedForward(curvature, controlData.rearSteerEnabled);
+
+        frontLinePosController.update(posError.get(), posErrorDiff.get());
+        frontWheelTargetAngle = degree_t(frontLinePosController.output()) + targetControlAngle + feedForward.first;
+        frontWheelTargetAngle = clamp(frontWheelTargetAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
+
+        if (controlData.rearSteerEnabled) {
+            //rearLinePosController.tune(rearParams);
+            if (rearLineAngleGainSchedule.update(car.speed)) {
+                rearLinePosController.tune(rearLineAngleGainSchedule.params());
+            }
+            rearLinePosController.update(angleError.get(), angleErrorDiff.get());
+            rearWheelTargetAngle = degree_t(rearLinePosController.output()) + targetControlAngle + feedForward.second;
+            rearWheelTargetAngle = clamp(rearWheelTargetAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
+        } else {
+            rearWheelTargetAngle = clamp(targetControlAngle, -cfg::WHEEL_MAX_DELTA, cfg::WHEEL_MAX_DELTA);
+        }
     }
 
     // if the car is going backwards, the front and rear target wheel angles need to be swapped
@@ -145,6 +225,35 @@ void calcTargetAngles(const CarProps& car, const ControlData& controlData) {
     frontDistSensorServoTargetAngle = cfg::DIST_SENSOR_SERVO_ENABLED ? frontWheelTargetAngle * cfg::DIST_SENSOR_SERVO_TRANSFER_RATE : radian_t(0);
 }
 
+/* @brief Checks if the frame pending in the vehicle CAN RX FIFO is a line detect frame.
+ * @note Must be called from the RX interrupt, before the frame is read out of the FIFO.
+ */
+bool isLineDetectFramePending() {
+    const uint32_t rir = can_Vehicle.handle->Instance->sFIFOMailBox[CAN_RX_FIFO0].RIR;
+    if (rir & CAN_RI0R_IDE) {
+        return false; // the line detect frames have standard identifiers
+    }
+
+    const uint32_t id = (rir & CAN_RI0R_STID) >> CAN_RI0R_STID_Pos;
+    return can::FrontLines::id()       == id ||
+           can::RearLines::id()        == id ||
+           can::FrontLinePattern::id() == id ||
+           can::RearLinePattern::id()  == id;
+}
+
+// the params only serialize scalars, so the bin counts and the maximum are registered one by one, @see LatencyHistogram
+void registerLatencyHistogramParams(const char * const name, LatencyHistogram& histogram, uint32_t& paramIdx) {
+    for (uint32_t bin = 0; bin < LatencyHistogram::NUM_BINS; ++bin) {
+        char * const paramName = latencyHistogramParamNames[paramIdx++];
+        sprint(paramName, sizeof(latencyHistogramParamNames[0]), "%s%u", name, bin);
+        micro::Params::instance().registerParam(paramName, histogram.count(bin), true, true);
+    }
+
+    char * const paramName = latencyHistogramParamNames[paramIdx++];
+    sprint(paramName, sizeof(latencyHistogramParamNames[0]), "%sMax", name);
+    micro::Params::instance().registerParam(paramName, histogram.max(), true, true);
+}
+
 void initializeVehicleCan() {
     const CanFrameIds rxFilter = {};
     const CanFrameIds txFilter = {
@@ -177,47 +286,72 @@ extern "C" void runControlTask(void) {
     REGISTER_READ_WRITE_PARAM(rearParams.I);
     REGISTER_READ_WRITE_PARAM(rearParams.D);
 
-//    char paramName[32];
-//    uint32_t i = 0;
-//
-//    for (std::pair<m_per_sec_t, PID_Params>& param : frontLinePosControllerParams) {
-//        sprint(paramName, sizeof(paramName), "front%u_P", i);
-//        micro::Params::instance().registerParam(paramName, param.second.P, false, true);
-//
-//        sprint(paramName, sizeof(paramName), "front%u_I", i);
-//        micro::Params::instance().registerParam(paramName, param.second.I, false, true);
-//
-//        sprint(paramName, sizeof(paramName), "front%u_D", i);
-//        micro::Params::instance().registerParam(paramName, param.second.D, false, true);
-//
-//        ++i;
-//    }
-//
-//    i = 0;
-//    for (std::pair<m_per_sec_t, PID_Params>& param : rearLineAngleControllerParams) {
-//        sprint(paramName, sizeof(paramName), "rear%u_P", i);
-//        micro::Params::instance().registerParam(paramName, param.second.P, false, true);
-//
-//        sprint(paramName, sizeof(paramName), "rear%u_I", i);
-//        micro::Params::instance().registerParam(paramName, param.second.I, false, true);
-//
-//        sprint(paramName, sizeof(paramName), "rear%u_D", i);
-//        micro::Params::instance().registerParam(paramName, param.second.D, false, true);
-//
-//        ++i;
-//    }
+    REGISTER_READ_WRITE_PARAM(posErrorDiffFilter.alpha);
+    REGISTER_READ_WRITE_PARAM(posErrorDiffFilter.beta);
+    REGISTER_READ_WRITE_PARAM(angleErrorDiffFilter.alpha);
+    REGISTER_READ_WRITE_PARAM(angleErrorDiffFilter.beta);
+
+    uint32_t latencyParamIdx = 0;
+    registerLatencyHistogramParams("lineDec", lineToDecisionLatency, latencyParamIdx);
+    registerLatencyHistogramParams("gyroDec", gyroToDecisionLatency, latencyParamIdx);
+    registerLatencyHistogramParams("decSend", decisionToSendLatency, latencyParamIdx);
+    registerLatencyHistogramParams("lineSend", lineToSendLatency, latencyParamIdx);
+
+    REGISTER_READ_WRITE_PARAM(isLateralMpcEnabled);
+    REGISTER_READ_WRITE_PARAM(isCurvatureFeedForwardEnabled);
+    REGISTER_READ_WRITE_PARAM(lateralMpc.weights.pos);
+    REGISTER_READ_WRITE_PARAM(lateralMpc.weights.angle);
+    REGISTER_READ_WRITE_PARAM(lateralMpc.weights.wheel);
+
+    REGISTER_READ_WRITE_PARAM(frontLinePosGainEditor.index);
+    REGISTER_READ_WRITE_PARAM(frontLinePosGainEditor.speed);
+    REGISTER_READ_WRITE_PARAM(frontLinePosGainEditor.gains.P);
+    REGISTER_READ_WRITE_PARAM(frontLinePosGainEditor.gains.I);
+    REGISTER_READ_WRITE_PARAM(frontLinePosGainEditor.gains.D);
+
+    REGISTER_READ_WRITE_PARAM(rearLineAngleGainEditor.index);
+    REGISTER_READ_WRITE_PARAM(rearLineAngleGainEditor.speed);
+    REGISTER_READ_WRITE_PARAM(rearLineAngleGainEditor.gains.P);
+    REGISTER_READ_WRITE_PARAM(rearLineAngleGainEditor.gains.I);
+    REGISTER_READ_WRITE_PARAM(rearLineAngleGainEditor.gains.D);
+
+    Timer lateralControlSendTimer(can::LateralControl::period());
 
     while (true) {
         while (vehicleCanManager.read(vehicleCanSubscriberId, rxCanFrame)) {
             vehicleCanFrameHandler.handleFrame(rxCanFrame);
         }
 
+        // the gain schedules are only recompiled when their breakpoints have been edited
+        if (paramsReceivedSemaphore.take(millisecond_t(0))) {
+            if (frontLinePosGainEditor.apply()) {
+                frontLinePosGainSchedule.compile();
+            }
+
+            if (rearLineAngleGainEditor.apply()) {
+                rearLineAngleGainSchedule.compile();
+            }
+        }
+
         // if no control data is received for a given period, stops motor for safety reasons
-        if (controlQueue.receive(controlData, millisecond_t(0))) {
+        const bool hasNewControlData = controlQueue.receive(controlData, millisecond_t(0));
+        if (hasNewControlData) {
             controlDataWatchdog.reset();
+            hasUnsentControlData = controlTimestampsQueue.receive(unsentControlTimestamps, millisecond_t(0));
+
+            // only the race track program sends the curvature
+            if (!controlCurvatureQueue.receive(controlCurvature, millisecond_t(0))) {
+                controlCurvature = 0.0f;
+            }
+
             CarProps car;
             carPropsQueue.peek(car, millisecond_t(0));
-            calcTargetAngles(car, controlData);
+
+            // the line errors are measured when the line info is received, the derivative filters get the time between the receptions
+            const second_t dt = unsentControlTimestamps.lineRx - prevLineRxTime;
+            prevLineRxTime = unsentControlTimestamps.lineRx;
+
+            calcTargetAngles(car, controlData, isCurvatureFeedForwardEnabled ? controlCurvature : 0.0f, dt);
 
         } else if (controlDataWatchdog.hasTimedOut()) {
             controlData.speed = m_per_sec_t(0);
@@ -227,14 +361,44 @@ extern "C" void runControlTask(void) {
         }
 
         vehicleCanManager.periodicSend<can::LongitudinalControl>(vehicleCanSubscriberId, controlData.speed, cfg::USE_SAFETY_ENABLE_SIGNAL, controlData.rampTime);
-        vehicleCanManager.periodicSend<can::LateralControl>(vehicleCanSubscriberId, frontWheelTargetAngle, rearWheelTargetAngle, frontDistSensorServoTargetAngle);
         vehicleCanManager.periodicSend<can::SetMotorControlParams>(vehicleCanSubscriberId, motorControllerParams.P, motorControllerParams.I);
 
+        // the LateralControl frame is sent manually instead of periodicSend, so that the latencies are measured at the actual send,
+        // for the newest control data whose wheel angles are in the frame - older, overwritten control data is never sent
+        if (lateralControlSendTimer.checkTimeout()) {
+            vehicleCanManager.send<can::LateralControl>(vehicleCanSubscriberId, frontWheelTargetAngle, rearWheelTargetAngle, frontDistSensorServoTargetAngle);
+
+            if (hasUnsentControlData) {
+                const microsecond_t now = getExactTime();
+                lineToDecisionLatency.add(unsentControlTimestamps.decision - unsentControlTimestamps.lineRx);
+                gyroToDecisionLatency.add(unsentControlTimestamps.decision - unsentControlTimestamps.gyroRead);
+                decisionToSendLatency.add(now - unsentControlTimestamps.decision);
+                lineToSendLatency.add(now - unsentControlTimestamps.lineRx);
+                hasUnsentControlData = false;
+            }
+        }
+
         SystemManager::instance().notify(!vehicleCanManager.hasTimedOut(vehicleCanSubscriberId) && !controlDataWatchdog.hasTimedOut());
-        os_sleep(millisecond_t(1));
+
+        // wakes up as soon as new control data is available, the timeout keeps the periodic CAN frames in time
+        // the loop period is therefore irregular, but the controllers are only updated with new control data, once per line info:
+        // the derivative filters get the measured time between the line infos, and the MPC model uses the nominal line info period
+        controlDataSemaphore.take(millisecond_t(1));
     }
 }
 
 void micro_Vehicle_Can_RxFifoMsgPendingCallback() {
+    // the frame needs to be checked and its reception time published before it is read out of the FIFO,
+    // so that the line detect task finds the reception time of every line detect frame it handles
+    const bool isLineDetectFrame = isLineDetectFramePending();
+    if (isLineDetectFrame) {
+        lineDetectCanRxTimeHistory.push(getExactTime());
+    }
+
     vehicleCanManager.onFrameReceived();
+
+    // the other frames are not waited for, they are read by their tasks at the next wake-up
+    if (isLineDetectFrame) {
+        lineDetectCanRxSemaphore.give();
+    }
 }
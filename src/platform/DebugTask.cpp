@@ -9,9 +9,14 @@
 #include <micro/utils/str_utils.hpp>
 #include <micro/utils/timer.hpp>
 
+#include <LateralMpc.hpp>
 
 using namespace micro;
 
+extern LateralMpc lateralMpc;
+
+semaphore_t paramsReceivedSemaphore; // Given when new param values have been received from the host, taken by the control task.
+
 namespace {
 
 #define FAILING_TASKS_LOG_ENABLED false
@@ -70,6 +75,12 @@ extern "C" void runDebugTask(void) {
         if (inCmd) {
             Params::instance().deserializeAll(reinterpret_cast<const char*>(*inCmd), MAX_PARAMS_BUFFER_SIZE);
             rxBuffer.finishRead();
+            paramsReceivedSemaphore.give();
+
+            // compiling the MPC gains takes long, so they are compiled in this low-priority task instead of the control task
+            if (!lateralMpc.isCompiled()) {
+                lateralMpc.compile();
+            }
         }
 
         if (debugParamsSendTimer.checkTimeout()) {
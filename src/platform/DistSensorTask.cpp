@@ -4,6 +4,7 @@
 #include <micro/panel/PanelLink.hpp>
 #include <micro/panel/DistSensorPanelData.hpp>
 #include <micro/port/queue.hpp>
+#include <micro/port/semaphore.hpp>
 #include <micro/port/task.hpp>
 #include <micro/utils/log.hpp>
 #include <micro/utils/timer.hpp>
@@ -19,6 +20,7 @@ PanelLink<DistSensorPanelOutData, DistSensorPanelInData> frontDistSensorPanelLin
 PanelLink<DistSensorPanelOutData, DistSensorPanelInData> rearDistSensorPanelLink(panelLinkRole_t::Master, { uart_RearDistSensor });
 
 Distances distances;
+semaphore_t rxSemaphore;
 
 void parseDistSensorPanelData(const DistSensorPanelOutData& rxData, const bool isFront) {
 
@@ -69,15 +71,19 @@ extern "C" void runDistSensorTask(void) {
         }
 
         SystemManager::instance().notify(frontDistSensorPanelLink.isConnected() && rearDistSensorPanelLink.isConnected());
-        os_sleep(millisecond_t(1));
+
+        // wakes up when data is received from a sensor panel, the timeout keeps the panel links sending
+        rxSemaphore.take(millisecond_t(1));
     }
 }
 
 
 void micro_FrontDistSensor_Uart_RxCpltCallback() {
     frontDistSensorPanelLink.onNewRxData();
+    rxSemaphore.give();
 }
 
 void micro_RearDistSensor_Uart_RxCpltCallback() {
     rearDistSensorPanelLink.onNewRxData();
+    rxSemaphore.give();
 }
@@ -1,6 +1,7 @@
 #include <micro/debug/SystemManager.hpp>
 #include <micro/panel/CanManager.hpp>
 #include <micro/port/queue.hpp>
+#include <micro/port/semaphore.hpp>
 #include <micro/port/task.hpp>
 #include <micro/utils/CarProps.hpp>
 #include <micro/utils/log.hpp>
@@ -9,42 +10,69 @@
 
 #include <cfg_board.hpp>
 #include <cfg_car.hpp>
+#include <SequencedHistory.hpp>
 
 using namespace micro;
 
 extern CanManager vehicleCanManager;
 
 extern queue_t<CarProps, 1> carPropsQueue;
+extern semaphore_t labyrinthLineInfoSemaphore;
+extern semaphore_t raceTrackLineInfoSemaphore;
 queue_t<LineDetectControl, 1> lineDetectControlQueue;
-queue_t<LineInfo, 1> lineInfoQueue;
+SequencedHistory<LineInfo, 8> lineInfoHistory;
+SequencedHistory<microsecond_t, 8> lineInfoRxTimeHistory; // Reception times of the line infos, pushed together with the line infos so that the sequence numbers match.
+SequencedHistory<microsecond_t, 16> lineDetectCanRxTimeHistory; // Reception times of the line detect CAN frames, pushed by the CAN RX interrupt in the order of the frames.
+semaphore_t lineDetectCanRxSemaphore;
 
 namespace {
 
+// the CAN frames only update parts of the line info, the complete line info is published once per cycle
 LineInfo lineInfo;
+microsecond_t lineInfoRxTime;
+bool isLineInfoUpdated = false;
+SequencedHistory<microsecond_t, 16>::seq_t lineDetectCanRxSeq = 0; // Sequence number of the reception time of the last handled line detect frame.
 
 canFrame_t rxCanFrame;
 CanFrameHandler vehicleCanFrameHandler;
 CanSubscriber::id_t vehicleCanSubscriberId = CanSubscriber::INVALID_ID;
 
+// the reception time of a line info is the reception time of its oldest updated part
+void onLineInfoUpdated() {
+    // the frames are handled in the order of their reception, so the n-th handled frame has the n-th reception time
+    microsecond_t rxTime;
+    if (!lineDetectCanRxTimeHistory.read(++lineDetectCanRxSeq, rxTime)) {
+        // the reception time has been overwritten or has not been published, e.g. because frames were dropped:
+        // the handled frames are synchronized to the received ones again, and the frame is stamped with the current time
+        lineDetectCanRxSeq = lineDetectCanRxTimeHistory.sequence();
+        rxTime = getExactTime();
+    }
+
+    if (!isLineInfoUpdated) {
+        lineInfoRxTime    = rxTime;
+        isLineInfoUpdated = true;
+    }
+}
+
 void initializeVehicleCan() {
     vehicleCanFrameHandler.registerHandler(can::FrontLines::id(), [] (const uint8_t * const data) {
         reinterpret_cast<const can::FrontLines*>(data)->acquire(lineInfo.front.lines);
-        lineInfoQueue.overwrite(lineInfo);
+        onLineInfoUpdated();
     });
 
     vehicleCanFrameHandler.registerHandler(can::RearLines::id(), [] (const uint8_t * const data) {
         reinterpret_cast<const can::RearLines*>(data)->acquire(lineInfo.rear.lines);
-        lineInfoQueue.overwrite(lineInfo);
+        onLineInfoUpdated();
     });
 
     vehicleCanFrameHandler.registerHandler(can::FrontLinePattern::id(), [] (const uint8_t * const data) {
         reinterpret_cast<const can::FrontLinePattern*>(data)->acquire(lineInfo.front.pattern);
-        lineInfoQueue.overwrite(lineInfo);
+        onLineInfoUpdated();
     });
 
     vehicleCanFrameHandler.registerHandler(can::RearLinePattern::id(), [] (const uint8_t * const data) {
         reinterpret_cast<const can::RearLinePattern*>(data)->acquire(lineInfo.rear.pattern);
-        lineInfoQueue.overwrite(lineInfo);
+        onLineInfoUpdated();
     });
 
     const CanFrameIds rxFilter = vehicleCanFrameHandler.identifiers();
@@ -64,7 +92,7 @@ extern "C" void runLineDetectTask(void) {
 
     Timer lineDetectControlTimer(can::LineDetectControl::period());
 
-    LineInfo prevLineInfo;
+    LinePattern prevFrontPattern, prevRearPattern;
 
     while (true) {
         CarProps car;
@@ -74,19 +102,28 @@ extern "C" void runLineDetectTask(void) {
             vehicleCanFrameHandler.handleFrame(rxCanFrame);
         }
 
-        if (lineInfo.front.pattern != prevLineInfo.front.pattern) {
+        if (isLineInfoUpdated) {
+            lineInfoRxTimeHistory.push(lineInfoRxTime);
+            lineInfoHistory.push(lineInfo);
+            isLineInfoUpdated = false;
+
+            labyrinthLineInfoSemaphore.give();
+            raceTrackLineInfoSemaphore.give();
+        }
+
+        if (lineInfo.front.pattern != prevFrontPattern) {
             LOG_INFO("Front pattern changed from [%s %s %s] to [%s %s %s]",
-                to_string(prevLineInfo.front.pattern.type), to_string(prevLineInfo.front.pattern.dir), to_string(prevLineInfo.front.pattern.side),
+                to_string(prevFrontPattern.type), to_string(prevFrontPattern.dir), to_string(prevFrontPattern.side),
                 to_string(lineInfo.front.pattern.type), to_string(lineInfo.front.pattern.dir), to_string(lineInfo.front.pattern.side));
 
-            prevLineInfo.front = lineInfo.front;
+            prevFrontPattern = lineInfo.front.pattern;
         }
 
-        if (lineInfo.rear.pattern != prevLineInfo.rear.pattern) {
+        if (lineInfo.rear.pattern != prevRearPattern) {
             LOG_INFO("Rear pattern changed from [%s %s %s] to [%s %s %s]",
-                to_string(prevLineInfo.rear.pattern.type), to_string(prevLineInfo.rear.pattern.dir), to_string(prevLineInfo.rear.pattern.side),
+                to_string(prevRearPattern.type), to_string(prevRearPattern.dir), to_string(prevRearPattern.side),
                 to_string(lineInfo.rear.pattern.type), to_string(lineInfo.rear.pattern.dir), to_string(lineInfo.rear.pattern.side));
-            prevLineInfo.rear = lineInfo.rear;
+            prevRearPattern = lineInfo.rear.pattern;
         }
 
         if (lineDetectControlTimer.checkTimeout()) {
@@ -100,6 +137,8 @@ extern "C" void runLineDetectTask(void) {
         const bool areLinesOk = !((1 != lineInfo.front.lines.size() || 1 != lineInfo.rear.lines.size()) && abs(car.speed) < m_per_sec_t(0.01f));
 
         SystemManager::instance().notify(!vehicleCanManager.hasTimedOut(vehicleCanSubscriberId) && areLinesOk);
-        os_sleep(millisecond_t(1));
+
+        // wakes up when a CAN frame is received, the timeout keeps the periodic tasks running when the line detect panel is silent
+        lineDetectCanRxSemaphore.take(millisecond_t(5));
     }
 }
@@ -1,6 +1,7 @@
 #include <micro/debug/params.hpp>
 #include <micro/debug/SystemManager.hpp>
 #include <micro/port/queue.hpp>
+#include <micro/port/semaphore.hpp>
 #include <micro/port/task.hpp>
 #include <micro/math/numeric.hpp>
 #include <micro/math/unit_utils.hpp>
@@ -15,22 +16,31 @@
 #include <cfg_board.hpp>
 #include <cfg_car.hpp>
 #include <cfg_track.hpp>
+#include <Distances.hpp>
 #include <LaneChangeManeuver.hpp>
+#include <LatencyHistogram.hpp>
 #include <LabyrinthNavigator.hpp>
+#include <SequencedHistory.hpp>
 #include <track.hpp>
 
 using namespace micro;
 
-extern queue_t<CarProps, 1> carPropsQueue;
+extern queue_t<Distances, 1> distancesQueue;
+extern queue_t<TimedCarProps, 1> timedCarPropsQueue;
 extern queue_t<point2m, 1> carPosUpdateQueue;
 extern queue_t<radian_t, 1> carOrientationUpdateQueue;
 extern queue_t<LineDetectControl, 1> lineDetectControlQueue;
-extern queue_t<LineInfo, 1> lineInfoQueue;
+extern SequencedHistory<LineInfo, 8> lineInfoHistory;
+extern SequencedHistory<microsecond_t, 8> lineInfoRxTimeHistory;
 extern queue_t<ControlData, 1> controlQueue;
+extern queue_t<ControlTimestamps, 1> controlTimestampsQueue;
+extern semaphore_t controlDataSemaphore;
 extern queue_t<radian_t, 1> carOrientationUpdateQueue;
 extern queue_t<char, 1> radioRecvQueue;
 extern Sign safetyCarFollowSpeedSign;
 
+semaphore_t labyrinthLineInfoSemaphore;
+
 namespace {
 
 m_per_sec_t LABYRINTH_SPEED          = m_per_sec_t(1.0f);
@@ -90,26 +100,18 @@ bool shouldHandle(const cfg::ProgramState programState) {
     return isBtw(enum_cast(programState), enum_cast(cfg::ProgramState::NavigateLabyrinth), enum_cast(cfg::ProgramState::LaneChange));
 }
 
-void enforceGraphValidity() {
-    if (!graph.valid()) {
-        while (true) {
-            LOG_ERROR("Labyrinth graph is invalid!");
-            SystemManager::instance().notify(false);
-            os_sleep(millisecond_t(100));
-        }
-    }
-}
-
 } // namespace
 
 extern "C" void runProgLabyrinthTask(void const *argument) {
 
     SystemManager::instance().registerTask();
 
-    LineInfo lineInfo;
     ControlData controlData;
     LineDetectControl lineDetectControlData;
     MainLine mainLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
+    LineInfo lineInfo;
+    microsecond_t lineInfoRxTime;
+    Distances distances = { micro::numeric_limits<meter_t>::infinity(), micro::numeric_limits<meter_t>::infinity() };
 
     cfg::ProgramState prevProgramState = cfg::ProgramState::INVALID;
 
@@ -118,12 +120,22 @@ extern "C" void runProgLabyrinthTask(void const *argument) {
 
     while (true) {
         const cfg::ProgramState programState = static_cast<cfg::ProgramState>(SystemManager::instance().programState());
-        if (shouldHandle(programState)) {
 
-            CarProps car;
-            carPropsQueue.peek(car, millisecond_t(0));
+        // the line info is copied, so that the line detect task cannot overwrite it while the control data is being calculated
+        const uint32_t lineInfoSeq = lineInfoHistory.sequence();
+        const bool isLineInfoValid = lineInfoHistory.read(lineInfoSeq, lineInfo) && lineInfoRxTimeHistory.read(lineInfoSeq, lineInfoRxTime);
+        if (!isLineInfoValid) {
+            LOG_WARN("Line info has been overwritten while being copied, cycle skipped");
+        }
+
+        if (isLineInfoValid && shouldHandle(programState)) {
+
+            // the car props and their gyro read time are published together, so that the latency is measured for the same props
+            TimedCarProps timedCar;
+            timedCarPropsQueue.peek(timedCar, millisecond_t(0));
+            const CarProps& car = timedCar.car;
+            const microsecond_t gyroReadTime = timedCar.gyroRead;
 
-            lineInfoQueue.peek(lineInfo, millisecond_t(0));
             micro::updateMainLine(lineInfo.front.lines, lineInfo.rear.lines, mainLine);
 
             lineDetectControlData.domain = linePatternDomain_t::Labyrinth;
@@ -133,13 +145,20 @@ extern "C" void runProgLabyrinthTask(void const *argument) {
             case cfg::ProgramState::NavigateLabyrinth:
             {
                 if (programState != prevProgramState) {
-                    enforceGraphValidity();
                     carOrientationUpdateQueue.overwrite(radian_t(0));
                     endTime = getTime() + second_t(20);
-                    navigator.initialize();
+                    if (Status::OK != navigator.initialize()) {
+                        controlData.speed    = m_per_sec_t(0);
+                        controlData.rampTime = millisecond_t(0);
+                        SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::Error));
+                        break;
+                    }
                 }
 
                 updateTargetSegment();
+
+                distancesQueue.peek(distances, millisecond_t(0));
+                navigator.handleObstacles(distances);
                 navigator.update(car, lineInfo, mainLine, controlData);
 
                 lineDetectControlData.isReducedScanRangeEnabled = false;
@@ -175,12 +194,20 @@ extern "C" void runProgLabyrinthTask(void const *argument) {
                 break;
             }
 
+            controlTimestampsQueue.overwrite({ lineInfoRxTime, gyroReadTime, getExactTime() });
+
             controlQueue.overwrite(controlData);
+            controlDataSemaphore.give();
             lineDetectControlQueue.overwrite(lineDetectControlData);
         }
 
-        prevProgramState = programState;
+        // a skipped cycle does not count, so that the program state entry is handled in the next cycle
+        if (isLineInfoValid) {
+            prevProgramState = programState;
+        }
         SystemManager::instance().notify(true);
-        os_sleep(millisecond_t(2));
+
+        // wakes up when new line info is available, the timeout keeps the task running when the line detection is silent
+        labyrinthLineInfoSemaphore.take(millisecond_t(10));
     }
 }
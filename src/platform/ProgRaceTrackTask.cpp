@@ -5,294 +5,219 @@
 #include <micro/math/numeric.hpp>
 #include <micro/sensor/Filter.hpp>
 #include <micro/port/queue.hpp>
+#include <micro/port/semaphore.hpp>
 #include <micro/port/task.hpp>
 #include <micro/utils/CarProps.hpp>
 #include <micro/utils/ControlData.hpp>
 #include <micro/utils/LinePattern.hpp>
 #include <micro/utils/log.hpp>
 #include <micro/utils/state.hpp>
+#include <micro/utils/str_utils.hpp>
 #include <micro/utils/timer.hpp>
 #include <micro/utils/trajectory.hpp>
 
 #include <cfg_car.hpp>
 #include <cfg_track.hpp>
 #include <Distances.hpp>
+#include <LatencyHistogram.hpp>
 #include <track.hpp>
-#include <OvertakeManeuver.hpp>
-#include <RaceTrackInfo.hpp>
+#include <RaceTrackProgram.hpp>
+#include <SequencedHistory.hpp>
 #include <TestManeuver.hpp>
-#include <TurnAroundManeuver.hpp>
+
+#include <stm32f4xx_hal.h>
+
+#include <algorithm>
+#include <iterator>
 
 using namespace micro;
 
-extern queue_t<CarProps, 1> carPropsQueue;
+extern queue_t<TimedCarProps, 1> timedCarPropsQueue;
 extern queue_t<LineDetectControl, 1> lineDetectControlQueue;
-extern queue_t<LineInfo, 1> lineInfoQueue;
+extern SequencedHistory<LineInfo, 8> lineInfoHistory;
+extern SequencedHistory<microsecond_t, 8> lineInfoRxTimeHistory;
 extern queue_t<ControlData, 1> controlQueue;
+extern queue_t<ControlTimestamps, 1> controlTimestampsQueue;
+extern queue_t<float, 1> controlCurvatureQueue;
+extern semaphore_t controlDataSemaphore;
 extern queue_t<Distances, 1> distancesQueue;
 
+semaphore_t raceTrackLineInfoSemaphore;
 Sign safetyCarFollowSpeedSign = Sign::NEGATIVE;
 
 namespace {
 
-constexpr centimeter_t MAX_VALID_SAFETY_CAR_DISTANCE = centimeter_t(120);
-
-m_per_sec_t SAFETY_CAR_SLOW_MAX_SPEED     = m_per_sec_t(1.15f);
-m_per_sec_t SAFETY_CAR_FAST_MAX_SPEED     = m_per_sec_t(1.7f);
-m_per_sec_t REACH_SAFETY_CAR_SPEED        = m_per_sec_t(0.6f);
-m_per_sec_t OVERTAKE_BEGIN_SPEED          = m_per_sec_t(1.0f);
-m_per_sec_t OVERTAKE_STRAIGHT_START_SPEED = m_per_sec_t(1.5f);
-m_per_sec_t OVERTAKE_STRAIGHT_SPEED       = m_per_sec_t(4.0f);
-m_per_sec_t OVERTAKE_END_SPEED            = m_per_sec_t(2.0f);
-m_per_sec_t TURN_AROUND_SPEED             = m_per_sec_t(1.0f);
-
-meter_t OVERTAKE_SECTION_LENGTH           = centimeter_t(820);
-meter_t OVERTAKE_PREPARE_DISTANCE         = centimeter_t(100);
-meter_t OVERTAKE_BEGIN_SINE_ARC_LENGTH    = centimeter_t(140);
-meter_t OVERTAKE_END_SINE_ARC_LENGTH      = centimeter_t(180);
-meter_t OVERTAKE_SIDE_DISTANCE            = centimeter_t(50);
-
-meter_t TURN_AROUND_RADIUS                = centimeter_t(40);
-meter_t TURN_AROUND_SINE_ARC_LENGTH       = centimeter_t(60);
-
-RaceTrackInfo trackInfo(trackSegments);
-OvertakeManeuver overtake;
-TurnAroundManeuver turnAround;
-TestManeuver testManeuver;
+RaceTrackProgram program(trackSegments, trackProfile);
+RaceTrackInfo& trackInfo = program.trackInfo;
 
-m_per_sec_t safetyCarFollowSpeed(meter_t distFromSafetyCar, const Sign targetSpeedSign, bool isFast) {
-    return targetSpeedSign * map(distFromSafetyCar, meter_t(0.3f), meter_t(0.8f), m_per_sec_t(0), isFast ? SAFETY_CAR_FAST_MAX_SPEED : SAFETY_CAR_SLOW_MAX_SPEED);
-}
+constexpr uint32_t NUM_TUNED_RACE_LAPS = cfg::NUM_RACE_LAPS - cfg::RACE_FIRST_LEARNING_LAP + 1;
 
-TrackSegments::const_iterator getFastSegment(const RaceTrackInfo& trackInfo, const uint32_t fastSeg) {
-    TrackSegments::const_iterator it = trackInfo.segments.begin();
-    uint32_t numFastSegs = 0;
-    for (; it != trackInfo.segments.end(); ++it) {
-        if (it->isFast && ++numFastSegs == fastSeg) {
-            break;
-        }
+char trackProfileParamNames[NUM_TUNED_RACE_LAPS * MAX_NUM_TRACK_SECTIONS * 2][16];
+
+// the learned track data is kept in the backup SRAM, so it survives resets, and power-offs as well when the backup battery is connected
+struct LearnedTrackData {
+    uint32_t magic;                     // Identifies the track and the layout the data has been learned for, @see learnedTrackDataMagic()
+    LapLearner::Sections sections;      // The learned section deltas.
+    uint32_t checksum;                  // Checksum of the sections.
+};
+
+// needs to be incremented whenever the layout of the learned track data changes, e.g. when a field is added to the sections
+constexpr uint32_t LEARNED_TRACK_DATA_VERSION = 1;
+
+LearnedTrackData& learnedTrackData = *reinterpret_cast<LearnedTrackData*>(BKPSRAM_BASE);
+
+bool resetLearnedTrackData = false;
+
+// the track map is dumped to the debug channel one sample per cycle, so that the log queue does not overflow
+bool dumpTrackMap = false;
+uint32_t trackMapDumpIdx = 0;
+
+uint32_t checksum(const LapLearner::Sections& sections) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(sections);
+    uint32_t hash = 5381;
+    for (uint32_t i = 0; i < sizeof(LapLearner::Sections); ++i) {
+        hash = hash * 33 + bytes[i];
     }
-    return it;
+    return hash;
 }
 
-TrackSegments::const_iterator getFastSegment(const RaceTrackInfo& trackInfo, const cfg::ProgramState programState) {
-    return getFastSegment(trackInfo.segments,
-        cfg::ProgramState::Race          == programState ? 1 :
-        cfg::ProgramState::Race_segFast2 == programState ? 2 :
-        cfg::ProgramState::Race_segFast3 == programState ? 3 :
-        cfg::ProgramState::Race_segFast4 == programState ? 4 : micro::numeric_limits<uint32_t>::max()
-    );
+// the data is only valid for the same track, the same number of track segments and the same layout
+uint32_t learnedTrackDataMagic() {
+    return (static_cast<uint32_t>('L') << 24)
+        | ((LEARNED_TRACK_DATA_VERSION & 0xffu) << 16)
+        | ((static_cast<uint32_t>(trackSegments.size()) & 0xffu) << 8)
+        | (static_cast<uint32_t>(TRACK) & 0xffu);
 }
 
-bool shouldHandle(const cfg::ProgramState programState) {
-    return isBtw(enum_cast(programState), enum_cast(cfg::ProgramState::ReachSafetyCar), enum_cast(cfg::ProgramState::Test));
+void enableBackupSram() {
+    __HAL_RCC_PWR_CLK_ENABLE();
+    HAL_PWR_EnableBkUpAccess();
+    __HAL_RCC_BKPSRAM_CLK_ENABLE();
+    HAL_PWREx_EnableBkUpReg();
 }
 
-ControlData getControl(const micro::CarProps& car, const RaceTrackInfo& trackInfo, const micro::MainLine& mainLine, const Sign targetSpeedSign)
-{
-    ControlData controlData = trackInfo.seg->getControl(car, trackInfo, mainLine);
-    controlData.speed = targetSpeedSign * controlData.speed;
-    return controlData;
+void loadLearnedTrackData() {
+    if (learnedTrackDataMagic() == learnedTrackData.magic && checksum(learnedTrackData.sections) == learnedTrackData.checksum) {
+        trackInfo.learner.setSections(learnedTrackData.sections);
+        LOG_INFO("Learned track data loaded");
+    }
 }
 
-} // namespace
-
-extern "C" void runProgRaceTrackTask(void) {
+// the lines are loaded by the host-side racing line optimizer, @see TrackMapDump
+void dumpTrackMapSample() {
+    if (trackMapDumpIdx < trackInfo.trackMap.size()) {
+        const TrackMap::Sample sample = trackInfo.trackMap.at(TrackMap::SAMPLE_DIST * (static_cast<float>(trackMapDumpIdx) + 0.5f));
+        LOG_INFO("track_map %u %f %f %f %f %u", trackMapDumpIdx, sample.pose.pos.X.get(), sample.pose.pos.Y.get(), sample.pose.angle.get(),
+            sample.linePos.get(), static_cast<uint32_t>(sample.pattern));
+        ++trackMapDumpIdx;
+    } else {
+        dumpTrackMap    = false;
+        trackMapDumpIdx = 0;
+        LOG_INFO("Track map dumped");
+    }
+}
 
-    SystemManager::instance().registerTask();
+void storeLearnedTrackData() {
+    std::copy(std::begin(trackInfo.learner.sections()), std::end(trackInfo.learner.sections()), std::begin(learnedTrackData.sections));
+    learnedTrackData.checksum = checksum(learnedTrackData.sections);
+    learnedTrackData.magic    = learnedTrackDataMagic();
+}
 
-    CarProps car;
-    LineInfo lineInfo;
-    ControlData controlData;
-    LineDetectControl lineDetectControlData;
-    Distances distances;
+template <typename T>
+void registerTrackProfileParam(const char * const format, const uint8_t lap, const uint32_t section, T& value, uint32_t& paramIdx) {
+    char * const paramName = trackProfileParamNames[paramIdx++];
+    sprint(paramName, sizeof(trackProfileParamNames[0]), format, static_cast<uint32_t>(lap), section);
+    micro::Params::instance().registerParam(paramName, value, false, true);
+}
 
-    MainLine mainLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
+// the fast speeds and the brake offsets of the race laps can be tuned at the track, the changes are applied immediately
+void registerTrackProfileParams() {
+    uint32_t paramIdx = 0;
+    for (uint8_t lap = cfg::RACE_FIRST_LEARNING_LAP; lap <= cfg::NUM_RACE_LAPS; ++lap) {
+        uint32_t section = 0;
+        for (uint32_t i = 0; i < trackSegments.size() && section < MAX_NUM_TRACK_SECTIONS; ++i) {
+            if (trackSegments[i].isFast) {
+                ++section;
+                registerTrackProfileParam("lap%u_fast%u", lap, section, trackProfile.speeds[lap - 1][i], paramIdx);
+                registerTrackProfileParam("lap%u_brake%u", lap, section, trackProfile.brakeOffsets[lap - 1][section - 1], paramIdx);
+            }
+        }
+    }
+}
 
-    const TrackSegments::const_iterator turnAroundSeg = getFastSegment(trackInfo.segments, 1);
-    const TrackSegments::const_iterator overtakeSeg   = getFastSegment(trackInfo.segments, 3);
+TestManeuver testManeuver;
 
-    meter_t lastDistWithValidLine;
-    meter_t lastDistWithSafetyCar;
+} // namespace
 
-    cfg::ProgramState prevProgramState = cfg::ProgramState::INVALID;
+extern "C" void runProgRaceTrackTask(void) {
 
-    Sign targetSpeedSign;
+    SystemManager::instance().registerTask();
 
-    uint8_t lastOvertakeLap = 0;
+    TimedCarProps timedCar;
+    const CarProps& car = timedCar.car;
+    Distances distances;
+    LineInfo lineInfo;
+    microsecond_t lineInfoRxTime;
+    RaceTrackProgram::Output output;
 
     m_per_sec_t targetSpeed = m_per_sec_t(1);
 
     REGISTER_READ_WRITE_PARAM(targetSpeed);
+    REGISTER_READ_WRITE_PARAM(resetLearnedTrackData);
+    REGISTER_READ_WRITE_PARAM(dumpTrackMap);
+    registerTrackProfileParams();
+
+    enableBackupSram();
+    loadLearnedTrackData();
 
     while (true) {
         const cfg::ProgramState programState = static_cast<cfg::ProgramState>(SystemManager::instance().programState());
-        if (shouldHandle(programState)) {
-
-            carPropsQueue.peek(car, millisecond_t(0));
-            lineInfoQueue.peek(lineInfo, millisecond_t(0));
+        if (RaceTrackProgram::handles(programState)) {
+            // the car props and their gyro read time are published together, so that the latency is measured for the same props
+            timedCarPropsQueue.peek(timedCar, millisecond_t(0));
             distancesQueue.peek(distances, millisecond_t(0));
+        }
 
-            // runs for the first time that this task handles the program state
-            if (!shouldHandle(prevProgramState)) {
-                if ((trackInfo.seg = getFastSegment(trackInfo.segments, programState)) != trackInfo.segments.end()) { // race
-                    trackInfo.lap = 3;
-                    targetSpeedSign = Sign::POSITIVE;
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::Race));
-                } else { // reach safety car
-                    trackInfo.lap = 1;
-                    trackInfo.seg = trackInfo.segments.begin();
-                    targetSpeedSign = safetyCarFollowSpeedSign;
-                }
-
-                lastDistWithValidLine = car.distance;
-                lastDistWithSafetyCar = car.distance;
-
-                trackInfo.lapStartTime = getTime();
-                trackInfo.segStartCarProps = car;
-                trackInfo.segStartLine = mainLine.centerLine;
-            }
-
-            micro::updateMainLine(lineInfo.front.lines, lineInfo.rear.lines, mainLine);
+        // the line info is copied, so that the line detect task cannot overwrite it while the control data is being calculated
+        const uint32_t lineInfoSeq = lineInfoHistory.sequence();
+        const bool isLineInfoValid = lineInfoHistory.read(lineInfoSeq, lineInfo) && lineInfoRxTimeHistory.read(lineInfoSeq, lineInfoRxTime);
+        if (!isLineInfoValid) {
+            LOG_WARN("Line info has been overwritten while being copied, cycle skipped");
+        }
 
-            // when in turn-around state, does not update track info to prevent logic errors caused by possible line pattern detections
-            if (cfg::ProgramState::TurnAround != programState) {
-                trackInfo.update(car, lineInfo, mainLine, controlData);
+        // the program is stepped in the states it does not handle as well, so that it knows when the race track states are entered
+        if (isLineInfoValid && program.step({ programState, getTime(), car, lineInfo, distances, safetyCarFollowSpeedSign, targetSpeed }, output)) {
+            if (output.programState != programState) {
+                SystemManager::instance().setProgramState(enum_cast(output.programState));
             }
 
-            // sets default lateral control
-            controlData.rearSteerEnabled    = true;
-            controlData.lineControl.actual  = mainLine.centerLine;
-            controlData.lineControl.target  = { millimeter_t(0), radian_t(0) };
-
-            lineDetectControlData.domain = linePatternDomain_t::Race;
-            lineDetectControlData.isReducedScanRangeEnabled = false;
-
-            const meter_t distFromSafetyCar = Sign::POSITIVE == targetSpeedSign ? distances.front : distances.rear;
-            if (distFromSafetyCar < centimeter_t(100)) {
-                lastDistWithSafetyCar = car.distance;
+            if (output.isLearningLapFinished) {
+                storeLearnedTrackData();
             }
 
-            if (LinePattern::NONE != lineInfo.front.pattern.type || LinePattern::NONE != lineInfo.rear.pattern.type) {
-                lastDistWithValidLine = car.distance;
-            }
+            controlTimestampsQueue.overwrite({ lineInfoRxTime, timedCar.gyroRead, getExactTime() });
 
-            switch (programState) {
-            case cfg::ProgramState::ReachSafetyCar:
-                controlData.speed = targetSpeedSign * REACH_SAFETY_CAR_SPEED;
-                controlData.rampTime = millisecond_t(500);
-                if (distFromSafetyCar != centimeter_t(0) && abs(safetyCarFollowSpeed(distFromSafetyCar, targetSpeedSign, trackInfo.seg->isFast)) < abs(controlData.speed)) {
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::FollowSafetyCar));
-                    LOG_DEBUG("Reached safety car, starts following");
-                }
-                break;
-
-            case cfg::ProgramState::FollowSafetyCar:
-                controlData = getControl(car, trackInfo, mainLine, targetSpeedSign);
-                controlData.speed = safetyCarFollowSpeed(distFromSafetyCar, targetSpeedSign, trackInfo.seg->isFast);
-                controlData.rampTime = millisecond_t(0);
-
-                if (overtakeSeg == trackInfo.seg && (1 == trackInfo.lap || 3 == trackInfo.lap) && trackInfo.lap != lastOvertakeLap) {
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::OvertakeSafetyCar));
-                    LOG_DEBUG("Starts overtake");
-                } else if (car.distance - lastDistWithSafetyCar > MAX_VALID_SAFETY_CAR_DISTANCE && trackInfo.seg->isFast) {
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::Race));
-                    LOG_DEBUG("Safety car left the track, starts race");
-                }
-                break;
-
-            case cfg::ProgramState::OvertakeSafetyCar:
-                if (programState != prevProgramState) {
-                    lastOvertakeLap = trackInfo.lap;
-                    overtake.initialize(car, targetSpeedSign,
-                        OVERTAKE_BEGIN_SPEED, OVERTAKE_STRAIGHT_START_SPEED, OVERTAKE_STRAIGHT_SPEED, OVERTAKE_END_SPEED,
-                        OVERTAKE_SECTION_LENGTH, OVERTAKE_PREPARE_DISTANCE, OVERTAKE_BEGIN_SINE_ARC_LENGTH, OVERTAKE_END_SINE_ARC_LENGTH,
-                        OVERTAKE_SIDE_DISTANCE);
-                }
-
-                controlData.speed = safetyCarFollowSpeed(distFromSafetyCar, targetSpeedSign, trackInfo.seg->isFast);
-                overtake.update(car, lineInfo, mainLine, controlData);
-
-                if (overtake.finished()) {
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::Race));
-                    LOG_DEBUG("Overtake finished, starts race");
-                }
-                break;
-
-            case cfg::ProgramState::Race:
-                controlData = getControl(car, trackInfo, mainLine, targetSpeedSign);
-
-                lineDetectControlData.isReducedScanRangeEnabled = trackInfo.lap >= 4 &&
-                                                                  (car.speed > m_per_sec_t(0) ?
-                                                                      lineInfo.front.lines.size() == 1 :
-                                                                      lineInfo.rear.lines.size() == 1);
-
-                if (trackInfo.lap > cfg::NUM_RACE_LAPS) {
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::Finish));
-                    LOG_DEBUG("Race finished");
-
-                } else if (trackInfo.lap <= 3 && distFromSafetyCar < (trackInfo.seg->isFast ? MAX_VALID_SAFETY_CAR_DISTANCE - centimeter_t(2) : centimeter_t(80))) {
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::FollowSafetyCar));
-                    LOG_DEBUG("Reached safety car, starts following");
-
-                } else if (Sign::NEGATIVE == targetSpeedSign &&
-                           trackInfo.lap == 2                &&
-                           trackInfo.seg == turnAroundSeg    &&
-                           car.distance - trackInfo.segStartCarProps.distance > meter_t(3)) {
-
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::TurnAround));
-                    LOG_DEBUG("Starts turn-around.");
-                }
-
-                if (car.distance - lastDistWithValidLine > meter_t(4) && trackInfo.lap >= 4) {
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::Error));
-                    LOG_ERROR("An error has occurred. Car stopped.");
-                }
-                break;
-
-            case cfg::ProgramState::TurnAround:
-                if (programState != prevProgramState) {
-                    turnAround.initialize(car, -targetSpeedSign, TURN_AROUND_SPEED, TURN_AROUND_SINE_ARC_LENGTH, TURN_AROUND_RADIUS);
-                }
-
-                turnAround.update(car, lineInfo, mainLine, controlData);
-
-                if (turnAround.finished()) {
-                    targetSpeedSign = -targetSpeedSign;
-                    SystemManager::instance().setProgramState(enum_cast(cfg::ProgramState::Race));
-                }
-                break;
-
-            case cfg::ProgramState::Finish:
-                if (trackInfo.seg->isFast && car.distance - trackInfo.segStartCarProps.distance < meter_t(2.0f)) {
-                    controlData = getControl(car, trackInfo, mainLine, targetSpeedSign);
-                } else {
-                    controlData.speed = m_per_sec_t(0);
-                    controlData.rampTime = millisecond_t(1500);
-                }
-                break;
-
-            case cfg::ProgramState::Error:
-                controlData.speed = m_per_sec_t(0);
-                controlData.rampTime = millisecond_t(1000);
-                break;
-
-            case cfg::ProgramState::Test:
-                controlData.speed = targetSpeed;
-                controlData.rampTime = millisecond_t(500);
-                break;
-
-            default:
-                LOG_ERROR("Invalid program state counter: [%u]", enum_cast(programState));
-                break;
-            }
+            controlCurvatureQueue.overwrite(output.curvature);
+            controlQueue.overwrite(output.controlData);
+            controlDataSemaphore.give();
+            lineDetectControlQueue.overwrite(output.lineDetectControl);
+        }
 
-            controlQueue.overwrite(controlData);
-            lineDetectControlQueue.overwrite(lineDetectControlData);
+        if (resetLearnedTrackData) {
+            const LapLearner::Sections noDeltas = {};
+            trackInfo.learner.setSections(noDeltas);
+            storeLearnedTrackData();
+            resetLearnedTrackData = false;
+            LOG_INFO("Learned track data reset");
+        }
+
+        if (dumpTrackMap) {
+            dumpTrackMapSample();
         }
 
-        prevProgramState = programState;
         SystemManager::instance().notify(true);
-        os_sleep(millisecond_t(1));
+
+        // wakes up when new line info is available, the timeout keeps the task running when the line detection is silent
+        raceTrackLineInfoSemaphore.take(millisecond_t(10));
     }
 }
@@ -10,6 +10,7 @@
 #include <micro/utils/timer.hpp>
 
 #include <cfg_car.hpp>
+#include <LatencyHistogram.hpp>
 
 #if GYRO_BOARD == GYRO_MPU9250
 #include <micro/hw/MPU9250_Gyroscope.hpp>
@@ -25,12 +26,14 @@ using namespace micro;
 extern CanManager vehicleCanManager;
 
 queue_t<CarProps, 1> carPropsQueue;
+queue_t<TimedCarProps, 1> timedCarPropsQueue; // The last car props with the read time of their gyro data, for the latency measurements.
 queue_t<point2m, 1> carPosUpdateQueue;
 queue_t<radian_t, 1> carOrientationUpdateQueue;
 
 namespace {
 
 CarProps car;
+microsecond_t gyroReadTime;
 bool isRemoteControlled = false;
 
 #if GYRO_BOARD == GYRO_MPU9250
@@ -109,6 +112,9 @@ extern "C" void runVehicleStateTask(void) {
     REGISTER_READ_ONLY_PARAM(isRemoteControlled);
 
     while (true) {
+        // wakes up when new gyro data is ready, the timeout keeps the car props updated when the gyro is silent
+        const bool isGyroDataReady = dataReadySemaphore.take(millisecond_t(5));
+
         while (vehicleCanManager.read(vehicleCanSubscriberId, rxCanFrame)) {
             vehicleCanFrameHandler.handleFrame(rxCanFrame);
         }
@@ -126,17 +132,19 @@ extern "C" void runVehicleStateTask(void) {
             car.pose.angle = orientation;
         }
 
-        if (dataReadySemaphore.take(millisecond_t(0))) {
+        if (isGyroDataReady) {
 
             const point3<rad_per_sec_t> gyroData = gyro.readGyroData();
             if (!micro::isinf(gyroData.X)) {
-                car.yawRate = gyroData.Z;
+                car.yawRate  = gyroData.Z;
+                gyroReadTime = getExactTime();
                 gyroDataWd.reset();
             }
         }
 
         updateCarPose();
         carPropsQueue.overwrite(car);
+        timedCarPropsQueue.overwrite({ car, gyroReadTime });
 
         const bool isGyroOk = !gyroDataWd.hasTimedOut();
         if (!isGyroOk) {
@@ -146,7 +154,6 @@ extern "C" void runVehicleStateTask(void) {
         }
 
         SystemManager::instance().notify(!vehicleCanManager.hasTimedOut(vehicleCanSubscriberId) && isGyroOk);
-        os_sleep(millisecond_t(5));
     }
 }
 
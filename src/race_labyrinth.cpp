@@ -4,98 +4,114 @@
 
 using namespace micro;
 
+namespace {
+
+constexpr SegmentDescription SEGMENTS[] = {
+    { 'A', 355,  false },
+    { 'B', 489,  false },
+    { 'C', 237,  false },
+    { 'D', 386,  false },
+    { 'E', 284,  false },
+    { 'F', 257,  false },
+    { 'G', 236,  true  },
+    { 'H', 779,  false },
+    { 'I', 195,  false },
+    { 'J', 609,  false },
+    { 'K', 488,  false },
+    { 'L', 372,  false },
+    { 'M', 195,  false },
+    { 'N', 177,  false },
+    { 'O', 389,  false },
+    { 'P', 205,  false },
+    { 'Q', 197,  false },
+    { 'R', 154,  false },
+    { 'S', 80,   false },
+    { 'T', 196,  false },
+    { 'U', 438,  false },
+};
+
+constexpr JunctionDescription JUNCTIONS[] = {
+    { 1,   -195,  829 },
+    { 2,     -7,  771 },
+    { 3,    207,  709 },
+    { 4,   -221,  707 },
+    { 5,   -321,  571 },
+    { 6,     -3,  579 },
+    { 7,   -221,  476 },
+    { 8,   -143,  471 },
+    { 9,    -29,  357 },
+    { 10,    86,  233 },
+    { 11,  -242,  119 },
+    { 12,   207,  114 },
+    { 13,  -143,    0 },
+};
+
+constexpr DecisionDescription DECISIONS[] = {
+    { 'A', 1,  180, Direction::CENTER },
+    { 'B', 1,  0,   Direction::LEFT   },
+    { 'P', 1,  0,   Direction::RIGHT  },
+
+    { 'C', 2,  180, Direction::LEFT   },
+    { 'P', 2,  180, Direction::RIGHT  },
+    { 'D', 2,  0,   Direction::CENTER },
+
+    { 'B', 3,  90,  Direction::CENTER },
+    { 'G', 3,  270, Direction::CENTER },
+    { 'H', 3,  270, Direction::LEFT   },
+    { 'H', 3,  270, Direction::RIGHT  },
+
+    { 'C', 4,  0,   Direction::LEFT   },
+    { 'E', 4,  0,   Direction::RIGHT  },
+    { 'Q', 4,  180, Direction::CENTER },
+
+    { 'A', 5,  90,  Direction::LEFT   },
+    { 'Q', 5,  90,  Direction::RIGHT  },
+    { 'K', 5,  270, Direction::RIGHT  },
+    { 'R', 5,  270, Direction::LEFT   },
+
+    { 'D', 6,  0,   Direction::CENTER },
+    { 'E', 6,  180, Direction::RIGHT  },
+    { 'F', 6,  180, Direction::LEFT   },
+
+    { 'F', 7,  0,   Direction::LEFT   },
+    { 'S', 7,  0,   Direction::RIGHT  },
+    { 'R', 7,  180, Direction::CENTER },
+
+    { 'I', 8,  0,   Direction::RIGHT  },
+    { 'J', 8,  0,   Direction::LEFT   },
+    { 'S', 8,  180, Direction::CENTER },
+
+    { 'I', 9,  90,  Direction::CENTER },
+    { 'L', 9,  270, Direction::RIGHT  },
+    { 'M', 9,  270, Direction::LEFT   },
+
+    { 'M', 10, 180, Direction::RIGHT  },
+    { 'O', 10, 180, Direction::LEFT   },
+    { 'T', 10, 0,   Direction::CENTER },
+
+    { 'K', 11, 90,  Direction::LEFT   },
+    { 'L', 11, 90,  Direction::RIGHT  },
+    { 'N', 11, 270, Direction::CENTER },
+
+    { 'J', 12, 90,  Direction::RIGHT  },
+    { 'T', 12, 90,  Direction::LEFT   },
+    { 'U', 12, 270, Direction::CENTER },
+
+    { 'N', 13, 180, Direction::CENTER },
+    { 'O', 13, 0,   Direction::LEFT   },
+    { 'U', 13, 0,   Direction::RIGHT  },
+};
+
+} // namespace
+
+extern constexpr LabyrinthDescription raceLabyrinthDescription = describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS);
+
+constexpr LabyrinthConnections raceLabyrinthConnections = raceLabyrinthDescription.connections();
+
+static_assert(raceLabyrinthDescription.isValid(), "Race labyrinth graph is invalid");
+
 LabyrinthGraph buildRaceLabyrinthGraph() {
     LabyrinthGraph graph;
-
-    graph.addSegment(Segment('A', centimeter_t(355), false));
-    graph.addSegment(Segment('B', centimeter_t(489), false));
-    graph.addSegment(Segment('C', centimeter_t(237), false));
-    graph.addSegment(Segment('D', centimeter_t(386), false));
-    graph.addSegment(Segment('E', centimeter_t(284), false));
-    graph.addSegment(Segment('F', centimeter_t(257), false));
-    graph.addSegment(Segment('G', centimeter_t(236), true ));
-    graph.addSegment(Segment('H', centimeter_t(779), false));
-    graph.addSegment(Segment('I', centimeter_t(195), false));
-    graph.addSegment(Segment('J', centimeter_t(609), false));
-    graph.addSegment(Segment('K', centimeter_t(488), false));
-    graph.addSegment(Segment('L', centimeter_t(372), false));
-    graph.addSegment(Segment('M', centimeter_t(195), false));
-    graph.addSegment(Segment('N', centimeter_t(177), false));
-    graph.addSegment(Segment('O', centimeter_t(389), false));
-    graph.addSegment(Segment('P', centimeter_t(205), false));
-    graph.addSegment(Segment('Q', centimeter_t(197), false));
-    graph.addSegment(Segment('R', centimeter_t(154), false));
-    graph.addSegment(Segment('S', centimeter_t(80),  false));
-    graph.addSegment(Segment('T', centimeter_t(196), false));
-    graph.addSegment(Segment('U', centimeter_t(438), false));
-
-    graph.addJunction(Junction(1,  { centimeter_t(-195), centimeter_t(829) }));
-    graph.addJunction(Junction(2,  { centimeter_t(  -7), centimeter_t(771) }));
-    graph.addJunction(Junction(3,  { centimeter_t( 207), centimeter_t(709) }));
-    graph.addJunction(Junction(4,  { centimeter_t(-221), centimeter_t(707) }));
-    graph.addJunction(Junction(5,  { centimeter_t(-321), centimeter_t(571) }));
-    graph.addJunction(Junction(6,  { centimeter_t(  -3), centimeter_t(579) }));
-    graph.addJunction(Junction(7,  { centimeter_t(-221), centimeter_t(476) }));
-    graph.addJunction(Junction(8,  { centimeter_t(-143), centimeter_t(471) }));
-    graph.addJunction(Junction(9,  { centimeter_t( -29), centimeter_t(357) }));
-    graph.addJunction(Junction(10, { centimeter_t(  86), centimeter_t(233) }));
-    graph.addJunction(Junction(11, { centimeter_t(-242), centimeter_t(119) }));
-    graph.addJunction(Junction(12, { centimeter_t( 207), centimeter_t(114) }));
-    graph.addJunction(Junction(13, { centimeter_t(-143), centimeter_t(  0) }));
-
-    graph.connect(graph.findSegment('A'), graph.findJunction(1),   JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('B'), graph.findJunction(1),   JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('P'), graph.findJunction(1),   JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('C'), graph.findJunction(2),   JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('P'), graph.findJunction(2),   JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('D'), graph.findJunction(2),   JunctionDecision(radian_t(0), Direction::CENTER));
-
-    graph.connect(graph.findSegment('B'), graph.findJunction(3),   JunctionDecision(PI_2,        Direction::CENTER));
-    graph.connect(graph.findSegment('G'), graph.findJunction(3),   JunctionDecision(3 * PI_2,    Direction::CENTER));
-    graph.connect(graph.findSegment('H'), graph.findJunction(3),   JunctionDecision(3 * PI_2,    Direction::LEFT));
-    graph.connect(graph.findSegment('H'), graph.findJunction(3),   JunctionDecision(3 * PI_2,    Direction::RIGHT));
-
-    graph.connect(graph.findSegment('C'), graph.findJunction(4),   JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('E'), graph.findJunction(4),   JunctionDecision(radian_t(0), Direction::RIGHT));
-    graph.connect(graph.findSegment('Q'), graph.findJunction(4),   JunctionDecision(PI,          Direction::CENTER));
-
-    graph.connect(graph.findSegment('A'), graph.findJunction(5),   JunctionDecision(PI_2,        Direction::LEFT));
-    graph.connect(graph.findSegment('Q'), graph.findJunction(5),   JunctionDecision(PI_2,        Direction::RIGHT));
-    graph.connect(graph.findSegment('K'), graph.findJunction(5),   JunctionDecision(3 * PI_2,    Direction::RIGHT));
-    graph.connect(graph.findSegment('R'), graph.findJunction(5),   JunctionDecision(3 * PI_2,    Direction::LEFT));
-    
-    graph.connect(graph.findSegment('D'), graph.findJunction(6),   JunctionDecision(radian_t(0), Direction::CENTER));
-    graph.connect(graph.findSegment('E'), graph.findJunction(6),   JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('F'), graph.findJunction(6),   JunctionDecision(PI,          Direction::LEFT));
-    
-    graph.connect(graph.findSegment('F'), graph.findJunction(7),   JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('S'), graph.findJunction(7),   JunctionDecision(radian_t(0), Direction::RIGHT));
-    graph.connect(graph.findSegment('R'), graph.findJunction(7),   JunctionDecision(PI,          Direction::CENTER));
-
-    graph.connect(graph.findSegment('I'), graph.findJunction(8),   JunctionDecision(radian_t(0), Direction::RIGHT));
-    graph.connect(graph.findSegment('J'), graph.findJunction(8),   JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('S'), graph.findJunction(8),   JunctionDecision(PI,          Direction::CENTER));
-
-    graph.connect(graph.findSegment('I'), graph.findJunction(9),   JunctionDecision(PI_2,        Direction::CENTER));
-    graph.connect(graph.findSegment('L'), graph.findJunction(9),   JunctionDecision(3 * PI_2,    Direction::RIGHT));
-    graph.connect(graph.findSegment('M'), graph.findJunction(9),   JunctionDecision(3 * PI_2,    Direction::LEFT));
-
-    graph.connect(graph.findSegment('M'), graph.findJunction(10),  JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('O'), graph.findJunction(10),  JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('T'), graph.findJunction(10),  JunctionDecision(radian_t(0), Direction::CENTER));
-
-    graph.connect(graph.findSegment('K'), graph.findJunction(11),  JunctionDecision(PI_2,        Direction::LEFT));
-    graph.connect(graph.findSegment('L'), graph.findJunction(11),  JunctionDecision(PI_2,        Direction::RIGHT));
-    graph.connect(graph.findSegment('N'), graph.findJunction(11),  JunctionDecision(3 * PI_2,    Direction::CENTER));
-    
-    graph.connect(graph.findSegment('J'), graph.findJunction(12),  JunctionDecision(PI_2,        Direction::RIGHT));
-    graph.connect(graph.findSegment('T'), graph.findJunction(12),  JunctionDecision(PI_2,        Direction::LEFT));
-    graph.connect(graph.findSegment('U'), graph.findJunction(12),  JunctionDecision(3 * PI_2,    Direction::CENTER));
-    
-    graph.connect(graph.findSegment('N'), graph.findJunction(13),  JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('O'), graph.findJunction(13),  JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('U'), graph.findJunction(13),  JunctionDecision(radian_t(0), Direction::RIGHT));
-    
+    graph.build(raceLabyrinthDescription, raceLabyrinthConnections);
     return graph;
 }
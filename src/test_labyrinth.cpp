@@ -4,104 +4,120 @@
 
 using namespace micro;
 
+namespace {
+
+constexpr SegmentDescription SEGMENTS[] = {
+    { 'A', 844,  false },
+    { 'B', 233,  false },
+    { 'C', 274,  false },
+    { 'D', 428,  false },
+    { 'E', 648,  false },
+    { 'F', 192,  false },
+    { 'G', 210,  false },
+    { 'H', 328,  false },
+    { 'I', 222,  false },
+    { 'J', 676,  false },
+    { 'K', 495,  false },
+    { 'L', 445,  false },
+    { 'M', 446,  false },
+    { 'N', 1360, false },
+    { 'O', 398,  true  },
+    { 'P', 100,  false },
+    { 'Q', 198,  false },
+    { 'R', 120,  false },
+    { 'S', 285,  false },
+    { 'T', 245,  false },
+    { 'U', 307,  false },
+    { 'V', 460,  false },
+    { 'W', 539,  false },
+};
+
+constexpr JunctionDescription JUNCTIONS[] = {
+    { 1,  -2250,   60 },
+    { 2,  -2130,   60 },
+    { 3,  -2040,  150 },
+    { 4,  -1865,   60 },
+    { 5,  -1740,   60 },
+    { 6,  -1580,   60 },
+    { 7,  -1415,  150 },
+    { 8,  -1290,   60 },
+    { 9,  -1170,  150 },
+    { 10, -1000,   60 },
+    { 11,  -540,   60 },
+    { 12,  -140,    0 },
+    { 13,   380,  -30 },
+};
+
+constexpr DecisionDescription DECISIONS[] = {
+    { 'A', 1,  180, Direction::LEFT   },
+    { 'A', 1,  180, Direction::RIGHT  },
+    { 'B', 1,  0,   Direction::LEFT   },
+    { 'P', 1,  0,   Direction::RIGHT  },
+
+    { 'P', 2,  180, Direction::CENTER },
+    { 'C', 2,  0,   Direction::LEFT   },
+    { 'D', 2,  0,   Direction::RIGHT  },
+
+    { 'B', 3,  180, Direction::CENTER },
+    { 'E', 3,  0,   Direction::LEFT   },
+    { 'Q', 3,  0,   Direction::RIGHT  },
+
+    { 'C', 4,  180, Direction::LEFT   },
+    { 'Q', 4,  180, Direction::RIGHT  },
+    { 'R', 4,  0,   Direction::CENTER },
+
+    { 'D', 5,  180, Direction::LEFT   },
+    { 'R', 5,  180, Direction::RIGHT  },
+    { 'F', 5,  0,   Direction::CENTER },
+
+    { 'F', 6,  180, Direction::CENTER },
+    { 'G', 6,  0,   Direction::LEFT   },
+    { 'S', 6,  0,   Direction::CENTER },
+    { 'H', 6,  0,   Direction::RIGHT  },
+
+    { 'G', 7,  180, Direction::LEFT   },
+    { 'E', 7,  180, Direction::RIGHT  },
+    { 'T', 7,  0,   Direction::CENTER },
+
+    { 'H', 8,  180, Direction::LEFT   },
+    { 'S', 8,  180, Direction::RIGHT  },
+    { 'U', 8,  0,   Direction::CENTER },
+
+    { 'T', 9,  180, Direction::CENTER },
+    { 'J', 9,  0,   Direction::LEFT   },
+    { 'I', 9,  0,   Direction::RIGHT  },
+
+    { 'U', 10, 180, Direction::LEFT   },
+    { 'I', 10, 180, Direction::RIGHT  },
+    { 'V', 10, 0,   Direction::LEFT   },
+    { 'K', 10, 0,   Direction::RIGHT  },
+
+    { 'K', 11, 180, Direction::LEFT   },
+    { 'V', 11, 180, Direction::CENTER },
+    { 'J', 11, 180, Direction::RIGHT  },
+    { 'N', 11, 0,   Direction::LEFT   },
+    { 'M', 11, 0,   Direction::CENTER },
+    { 'L', 11, 0,   Direction::RIGHT  },
+
+    { 'L', 12, 180, Direction::LEFT   },
+    { 'M', 12, 180, Direction::RIGHT  },
+    { 'W', 12, 0,   Direction::CENTER },
+
+    { 'W', 13, 180, Direction::CENTER },
+    { 'N', 13, 0,   Direction::LEFT   },
+    { 'O', 13, 0,   Direction::RIGHT  },
+};
+
+} // namespace
+
+extern constexpr LabyrinthDescription testLabyrinthDescription = describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS);
+
+constexpr LabyrinthConnections testLabyrinthConnections = testLabyrinthDescription.connections();
+
+static_assert(testLabyrinthDescription.isValid(), "Test labyrinth graph is invalid");
+
 LabyrinthGraph buildTestLabyrinthGraph() {
     LabyrinthGraph graph;
-
-    graph.addSegment(Segment('A', centimeter_t(844),  false));
-    graph.addSegment(Segment('B', centimeter_t(233),  false));
-    graph.addSegment(Segment('C', centimeter_t(274),  false));
-    graph.addSegment(Segment('D', centimeter_t(428),  false));
-    graph.addSegment(Segment('E', centimeter_t(648),  false));
-    graph.addSegment(Segment('F', centimeter_t(192),  false));
-    graph.addSegment(Segment('G', centimeter_t(210),  false));
-    graph.addSegment(Segment('H', centimeter_t(328),  false));
-    graph.addSegment(Segment('I', centimeter_t(222),  false));
-    graph.addSegment(Segment('J', centimeter_t(676),  false));
-    graph.addSegment(Segment('K', centimeter_t(495),  false));
-    graph.addSegment(Segment('L', centimeter_t(445),  false));
-    graph.addSegment(Segment('M', centimeter_t(446),  false));
-    graph.addSegment(Segment('N', centimeter_t(1360), false));
-    graph.addSegment(Segment('O', centimeter_t(398),  true ));
-    graph.addSegment(Segment('P', centimeter_t(100),  false));
-    graph.addSegment(Segment('Q', centimeter_t(198),  false));
-    graph.addSegment(Segment('R', centimeter_t(120),  false));
-    graph.addSegment(Segment('S', centimeter_t(285),  false));
-    graph.addSegment(Segment('T', centimeter_t(245),  false));
-    graph.addSegment(Segment('U', centimeter_t(307),  false));
-    graph.addSegment(Segment('V', centimeter_t(460),  false));
-    graph.addSegment(Segment('W', centimeter_t(539),  false));
-
-    graph.addJunction(Junction(1,  { centimeter_t(-2250), centimeter_t(60)  }));
-    graph.addJunction(Junction(2,  { centimeter_t(-2130), centimeter_t(60)  }));
-    graph.addJunction(Junction(3,  { centimeter_t(-2040), centimeter_t(150) }));
-    graph.addJunction(Junction(4,  { centimeter_t(-1865), centimeter_t(60)  }));
-    graph.addJunction(Junction(5,  { centimeter_t(-1740), centimeter_t(60)  }));
-    graph.addJunction(Junction(6,  { centimeter_t(-1580), centimeter_t(60)  }));
-    graph.addJunction(Junction(7,  { centimeter_t(-1415), centimeter_t(150) }));
-    graph.addJunction(Junction(8,  { centimeter_t(-1290), centimeter_t(60)  }));
-    graph.addJunction(Junction(9,  { centimeter_t(-1170), centimeter_t(150) }));
-    graph.addJunction(Junction(10, { centimeter_t(-1000), centimeter_t(60)  }));
-    graph.addJunction(Junction(11, { centimeter_t(-540),  centimeter_t(60)  }));
-    graph.addJunction(Junction(12, { centimeter_t(-140),  centimeter_t(0)   }));
-    graph.addJunction(Junction(13, { centimeter_t(380),   centimeter_t(-30) }));
-
-    graph.connect(graph.findSegment('A'), graph.findJunction(1),  JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('A'), graph.findJunction(1),  JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('B'), graph.findJunction(1),  JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('P'), graph.findJunction(1),  JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('P'), graph.findJunction(2),  JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('C'), graph.findJunction(2),  JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('D'), graph.findJunction(2),  JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('B'), graph.findJunction(3),  JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('E'), graph.findJunction(3),  JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('Q'), graph.findJunction(3),  JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('C'), graph.findJunction(4),  JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('Q'), graph.findJunction(4),  JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('R'), graph.findJunction(4),  JunctionDecision(radian_t(0), Direction::CENTER));
-
-    graph.connect(graph.findSegment('D'), graph.findJunction(5),  JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('R'), graph.findJunction(5),  JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('F'), graph.findJunction(5),  JunctionDecision(radian_t(0), Direction::CENTER));
-
-    graph.connect(graph.findSegment('F'), graph.findJunction(6),  JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('G'), graph.findJunction(6),  JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('S'), graph.findJunction(6),  JunctionDecision(radian_t(0), Direction::CENTER));
-    graph.connect(graph.findSegment('H'), graph.findJunction(6),  JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('G'), graph.findJunction(7),  JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('E'), graph.findJunction(7),  JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('T'), graph.findJunction(7),  JunctionDecision(radian_t(0), Direction::CENTER));
-
-    graph.connect(graph.findSegment('H'), graph.findJunction(8),  JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('S'), graph.findJunction(8),  JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('U'), graph.findJunction(8),  JunctionDecision(radian_t(0), Direction::CENTER));
-
-    graph.connect(graph.findSegment('T'), graph.findJunction(9),  JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('J'), graph.findJunction(9),  JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('I'), graph.findJunction(9),  JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('U'), graph.findJunction(10), JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('I'), graph.findJunction(10), JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('V'), graph.findJunction(10), JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('K'), graph.findJunction(10), JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('K'), graph.findJunction(11), JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('V'), graph.findJunction(11), JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('J'), graph.findJunction(11), JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('N'), graph.findJunction(11), JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('M'), graph.findJunction(11), JunctionDecision(radian_t(0), Direction::CENTER));
-    graph.connect(graph.findSegment('L'), graph.findJunction(11), JunctionDecision(radian_t(0), Direction::RIGHT));
-
-    graph.connect(graph.findSegment('L'), graph.findJunction(12), JunctionDecision(PI,          Direction::LEFT));
-    graph.connect(graph.findSegment('M'), graph.findJunction(12), JunctionDecision(PI,          Direction::RIGHT));
-    graph.connect(graph.findSegment('W'), graph.findJunction(12), JunctionDecision(radian_t(0), Direction::CENTER));
-
-    graph.connect(graph.findSegment('W'), graph.findJunction(13), JunctionDecision(PI,          Direction::CENTER));
-    graph.connect(graph.findSegment('N'), graph.findJunction(13), JunctionDecision(radian_t(0), Direction::LEFT));
-    graph.connect(graph.findSegment('O'), graph.findJunction(13), JunctionDecision(radian_t(0), Direction::RIGHT));
-
+    graph.build(testLabyrinthDescription, testLabyrinthConnections);
     return graph;
 }
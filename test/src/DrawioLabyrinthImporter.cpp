@@ -0,0 +1,874 @@
+#include <micro/math/numeric.hpp>
+#include <micro/utils/log.hpp>
+
+#include <DrawioLabyrinthImporter.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <utility>
+
+using namespace micro;
+
+namespace {
+
+/* @brief Sequential character source of the XML reader.
+ */
+class CharSource {
+public:
+    virtual ~CharSource() = default;
+    virtual bool get(char& c) = 0;
+};
+
+class StreamCharSource : public CharSource {
+public:
+    explicit StreamCharSource(std::istream& in) : in_(in) {}
+
+    bool get(char& c) override {
+        return static_cast<bool>(this->in_.get(c));
+    }
+
+private:
+    std::istream& in_;
+};
+
+/* @brief Decodes base64 data, whitespaces are skipped.
+ */
+class Base64CharSource : public CharSource {
+public:
+    explicit Base64CharSource(CharSource& src) : src_(src), pos_(0), size_(0) {}
+
+    bool get(char& c) override {
+        if (this->pos_ == this->size_ && !this->decode()) {
+            return false;
+        }
+        c = this->buffer_[this->pos_++];
+        return true;
+    }
+
+private:
+    static int8_t value(const char c) {
+        return isBtw(c, 'A', 'Z') ? c - 'A' :
+               isBtw(c, 'a', 'z') ? c - 'a' + 26 :
+               isBtw(c, '0', '9') ? c - '0' + 52 :
+               c == '+' || c == '-' ? 62 :
+               c == '/' || c == '_' ? 63 : -1;
+    }
+
+    bool decode() {
+        uint32_t bits = 0, numChars = 0;
+        char c;
+        while (numChars < 4 && this->src_.get(c)) {
+            const int8_t v = value(c);
+            if (v >= 0) {
+                bits = (bits << 6) | static_cast<uint32_t>(v);
+                ++numChars;
+            } else if (c == '=') {
+                break;
+            }
+        }
+
+        if (numChars < 2) {
+            return false;
+        }
+
+        bits <<= 6 * (4 - numChars);
+        this->size_ = numChars - 1;
+        this->pos_  = 0;
+        for (uint32_t i = 0; i < this->size_; ++i) {
+            this->buffer_[i] = static_cast<char>((bits >> (16 - 8 * i)) & 0xff);
+        }
+        return true;
+    }
+
+    CharSource& src_;
+    char buffer_[3];
+    uint32_t pos_, size_;
+};
+
+/* @brief Inflates raw deflate data.
+ */
+class InflateCharSource : public CharSource {
+public:
+    explicit InflateCharSource(CharSource& src)
+        : src_(src)
+        , pos_(0)
+        , size_(0)
+        , isFinished_(false) {
+        this->stream_ = z_stream();
+        this->isFinished_ = Z_OK != inflateInit2(&this->stream_, -MAX_WBITS);
+    }
+
+    ~InflateCharSource() override {
+        inflateEnd(&this->stream_);
+    }
+
+    bool get(char& c) override {
+        while (this->pos_ == this->size_) {
+            if (this->isFinished_) {
+                return false;
+            }
+            this->inflate();
+        }
+        c = static_cast<char>(this->out_[this->pos_++]);
+        return true;
+    }
+
+private:
+    void inflate() {
+        if (0 == this->stream_.avail_in) {
+            uint32_t size = 0;
+            char c;
+            while (size < sizeof(this->in_) && this->src_.get(c)) {
+                this->in_[size++] = static_cast<Bytef>(c);
+            }
+            this->stream_.next_in  = this->in_;
+            this->stream_.avail_in = size;
+        }
+
+        this->stream_.next_out  = this->out_;
+        this->stream_.avail_out = sizeof(this->out_);
+
+        const int result = ::inflate(&this->stream_, Z_NO_FLUSH);
+        this->pos_  = 0;
+        this->size_ = static_cast<uint32_t>(sizeof(this->out_) - this->stream_.avail_out);
+
+        if (Z_STREAM_END == result || (Z_OK != result && Z_BUF_ERROR != result) || (Z_BUF_ERROR == result && 0 == this->size_)) {
+            this->isFinished_ = true;
+        }
+    }
+
+    CharSource& src_;
+    z_stream stream_;
+    Bytef in_[256];
+    Bytef out_[1024];
+    uint32_t pos_, size_;
+    bool isFinished_;
+};
+
+int8_t hexValue(const char c) {
+    return isBtw(c, '0', '9') ? c - '0' :
+           isBtw(c, 'a', 'f') ? c - 'a' + 10 :
+           isBtw(c, 'A', 'F') ? c - 'A' + 10 : -1;
+}
+
+/* @brief Decodes URI-encoded (percent-encoded) data.
+ * A truncated escape or an escape with an invalid hexadecimal digit ends the data with an error.
+ */
+class UriDecodeCharSource : public CharSource {
+public:
+    explicit UriDecodeCharSource(CharSource& src) : src_(src), isError_(false) {}
+
+    bool get(char& c) override {
+        if (this->isError_ || !this->src_.get(c)) {
+            return false;
+        }
+
+        if (c == '%') {
+            char hi, lo;
+            if (!this->src_.get(hi) || !this->src_.get(lo)) {
+                return this->fail();
+            }
+
+            const int8_t hiValue = hexValue(hi);
+            const int8_t loValue = hexValue(lo);
+            if (hiValue < 0 || loValue < 0) {
+                return this->fail();
+            }
+            c = static_cast<char>(static_cast<uint8_t>(hiValue) << 4 | static_cast<uint8_t>(loValue));
+        }
+        return true;
+    }
+
+    bool isError() const { return this->isError_; }
+
+private:
+    bool fail() {
+        this->isError_ = true;
+        return false;
+    }
+
+    CharSource& src_;
+    bool isError_;
+};
+
+void appendUtf8(std::string& str, const uint32_t code) {
+    if (code < 0x80) {
+        str += static_cast<char>(code);
+    } else if (code < 0x800) {
+        str += static_cast<char>(0xc0 | (code >> 6));
+        str += static_cast<char>(0x80 | (code & 0x3f));
+    } else {
+        str += static_cast<char>(0xe0 | (code >> 12));
+        str += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+        str += static_cast<char>(0x80 | (code & 0x3f));
+    }
+}
+
+std::string decodeEntities(const std::string& str) {
+    static const std::pair<const char*, char> ENTITIES[] = {
+        { "lt", '<' }, { "gt", '>' }, { "amp", '&' }, { "quot", '"' }, { "apos", '\'' }, { "nbsp", ' ' }
+    };
+
+    std::string result;
+    result.reserve(str.size());
+
+    for (size_t i = 0; i < str.size(); ++i) {
+        const size_t end = '&' == str[i] ? str.find(';', i) : std::string::npos;
+        if (std::string::npos == end) {
+            result += str[i];
+            continue;
+        }
+
+        const std::string entity = str.substr(i + 1, end - i - 1);
+        if (entity.size() > 1 && '#' == entity[0]) {
+            const bool isHex = 'x' == entity[1] || 'X' == entity[1];
+            appendUtf8(result, static_cast<uint32_t>(std::strtoul(entity.c_str() + (isHex ? 2 : 1), nullptr, isHex ? 16 : 10)));
+        } else {
+            const auto it = std::find_if(std::begin(ENTITIES), std::end(ENTITIES), [&entity](const std::pair<const char*, char>& e) {
+                return entity == e.first;
+            });
+            if (it == std::end(ENTITIES)) {
+                result += str[i];
+                continue;
+            }
+            result += it->second;
+        }
+        i = end;
+    }
+
+    return result;
+}
+
+/* @brief Streaming XML reader, reports elements one by one.
+ * Character data is skipped unless it is read through a @see TextSource.
+ */
+class XmlReader {
+public:
+    struct Element {
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> attributes;
+        bool isEnd   = false;   // Indicates an end tag.
+        bool isEmpty = false;   // Indicates a self-closing tag.
+
+        const std::string* attribute(const char *attrName) const {
+            const auto it = std::find_if(this->attributes.begin(), this->attributes.end(), [attrName](const std::pair<std::string, std::string>& attr) {
+                return attr.first == attrName;
+            });
+            return it != this->attributes.end() ? &it->second : nullptr;
+        }
+    };
+
+    /* @brief Reads the character data until the next tag.
+     */
+    class TextSource : public CharSource {
+    public:
+        explicit TextSource(XmlReader& reader) : reader_(reader) {}
+
+        bool get(char& c) override {
+            if (!this->reader_.peek(c) || '<' == c) {
+                return false;
+            }
+            return this->reader_.get(c);
+        }
+
+    private:
+        XmlReader& reader_;
+    };
+
+    explicit XmlReader(CharSource& src) : src_(src), hasPeeked_(false), isError_(false) {}
+
+    /* @brief Reads the next element.
+     * @returns True if an element has been read, false at the end of the input or in case of a syntax error
+     */
+    bool next(Element& element) {
+        char c;
+        while (this->get(c)) {
+            if ('<' != c || !this->get(c)) {
+                continue;
+            }
+
+            if ('?' == c) {
+                this->skipUntil("?>");
+            } else if ('!' == c) {
+                this->skipDeclaration();
+            } else if ('/' == c) {
+                element.isEnd   = true;
+                element.isEmpty = false;
+                element.attributes.clear();
+                element.name.clear();
+                while (this->get(c) && '>' != c) {
+                    if (!std::isspace(static_cast<unsigned char>(c))) {
+                        element.name += c;
+                    }
+                }
+                return true;
+            } else {
+                element.isEnd = false;
+                element.name.assign(1, c);
+                return this->readStartTag(element);
+            }
+        }
+        return false;
+    }
+
+    /* @brief Skips whitespaces and checks if the next character data is not empty.
+     */
+    bool hasText() {
+        char c;
+        while (this->peek(c) && std::isspace(static_cast<unsigned char>(c))) {
+            this->get(c);
+        }
+        return this->peek(c) && '<' != c;
+    }
+
+    bool isError() const { return this->isError_; }
+
+private:
+    bool get(char& c) {
+        if (this->hasPeeked_) {
+            this->hasPeeked_ = false;
+            c = this->peeked_;
+            return true;
+        }
+        return this->src_.get(c);
+    }
+
+    bool peek(char& c) {
+        if (!this->hasPeeked_) {
+            this->hasPeeked_ = this->src_.get(this->peeked_);
+        }
+        c = this->peeked_;
+        return this->hasPeeked_;
+    }
+
+    void skipUntil(const char *terminator) {
+        const size_t length = strlen(terminator);
+        std::string last;
+        char c;
+        while (this->get(c)) {
+            last += c;
+            if (last.size() > length) {
+                last.erase(0, 1);
+            }
+            if (last == terminator) {
+                return;
+            }
+        }
+        this->isError_ = true;
+    }
+
+    void skipDeclaration() {
+        char c;
+        if (this->peek(c) && '-' == c) {
+            this->skipUntil("-->");
+        } else if (this->peek(c) && '[' == c) {
+            this->skipUntil("]]>");
+        } else {
+            this->skipUntil(">");
+        }
+    }
+
+    bool readStartTag(Element& element) {
+        element.attributes.clear();
+        element.isEmpty = false;
+
+        char c;
+        while (this->get(c) && !std::isspace(static_cast<unsigned char>(c)) && '>' != c && '/' != c) {
+            element.name += c;
+        }
+
+        while (true) {
+            while (std::isspace(static_cast<unsigned char>(c)) && this->get(c)) {}
+
+            if ('>' == c) {
+                return true;
+            }
+
+            if ('/' == c) {
+                element.isEmpty = true;
+                return this->get(c) && '>' == c ? true : this->fail();
+            }
+
+            std::string name(1, c);
+            while (this->get(c) && '=' != c && !std::isspace(static_cast<unsigned char>(c))) {
+                name += c;
+            }
+            while (std::isspace(static_cast<unsigned char>(c)) && this->get(c)) {}
+
+            char quote;
+            if ('=' != c || !this->get(quote)) {
+                return this->fail();
+            }
+            while (std::isspace(static_cast<unsigned char>(quote)) && this->get(quote)) {}
+
+            if ('"' != quote && '\'' != quote) {
+                return this->fail();
+            }
+
+            std::string value;
+            while (this->get(c) && quote != c) {
+                value += c;
+            }
+
+            if (quote != c || !this->get(c)) {
+                return this->fail();
+            }
+
+            element.attributes.emplace_back(std::move(name), decodeEntities(value));
+        }
+    }
+
+    bool fail() {
+        this->isError_ = true;
+        return false;
+    }
+
+    CharSource& src_;
+    char peeked_;
+    bool hasPeeked_;
+    bool isError_;
+};
+
+/* @brief Strips the HTML tags and the surrounding whitespaces from a cell label.
+ */
+std::string plainLabel(const std::string& label) {
+    std::string result;
+    bool isTag = false;
+    for (const char c : decodeEntities(label)) {
+        if ('<' == c) {
+            isTag = true;
+        } else if ('>' == c) {
+            isTag = false;
+        } else if (!isTag && !std::isspace(static_cast<unsigned char>(c))) {
+            result += c;
+        }
+    }
+    return result;
+}
+
+float attributeValue(const XmlReader::Element& element, const char *name, const float defaultValue = 0.0f) {
+    const std::string *value = element.attribute(name);
+    return value ? std::strtof(value->c_str(), nullptr) : defaultValue;
+}
+
+/* @brief Collects the junction and segment cells of the drawing from the element stream.
+ */
+class CellCollector {
+public:
+    CellCollector(std::vector<DrawioLabyrinthImporter::JunctionCell>& junctions, std::vector<DrawioLabyrinthImporter::EdgeCell>& edges)
+        : junctions_(junctions)
+        , edges_(edges)
+        , cellType_(CellType::None)
+        , isInPoints_(false) {}
+
+    Status process(XmlReader& reader) {
+        XmlReader::Element element;
+
+        while (reader.next(element)) {
+            if (element.isEnd) {
+                this->onEnd(element);
+            } else if (element.name == "diagram" && !element.isEmpty && reader.hasText()) {
+                // compressed diagram: base64 encoded, deflated, URI-encoded XML
+                XmlReader::TextSource text(reader);
+                Base64CharSource base64(text);
+                InflateCharSource inflated(base64);
+                UriDecodeCharSource decoded(inflated);
+                XmlReader diagramReader(decoded);
+
+                if (Status::OK != this->process(diagramReader) || decoded.isError()) {
+                    return Status::INVALID_DATA;
+                }
+            } else {
+                this->onStart(element);
+                if (element.isEmpty) {
+                    this->onEnd(element);
+                }
+            }
+        }
+
+        return reader.isError() ? Status::INVALID_DATA : Status::OK;
+    }
+
+private:
+    enum class CellType : uint8_t {
+        None,
+        Junction,
+        Edge
+    };
+
+    void onStart(const XmlReader::Element& element) {
+        if (element.name == "object" || element.name == "UserObject") {
+            // cells with custom properties are wrapped in an object element that holds the id, the label and the properties
+            this->object_ = element;
+        } else if (element.name == "mxCell") {
+            this->startCell(element);
+        } else if (CellType::Junction == this->cellType_ && element.name == "mxGeometry") {
+            DrawioLabyrinthImporter::JunctionCell& junc = this->junctions_.back();
+            junc.x      = attributeValue(element, "x");
+            junc.y      = attributeValue(element, "y");
+            junc.width  = attributeValue(element, "width");
+            junc.height = attributeValue(element, "height");
+        } else if (CellType::Edge == this->cellType_ && element.name == "Array") {
+            const std::string *as = element.attribute("as");
+            this->isInPoints_ = as && *as == "points";
+        } else if (CellType::Edge == this->cellType_ && element.name == "mxPoint") {
+            this->addPoint(element);
+        }
+    }
+
+    void onEnd(const XmlReader::Element& element) {
+        if (element.name == "object" || element.name == "UserObject") {
+            this->object_ = XmlReader::Element();
+        } else if (element.name == "mxCell") {
+            this->endCell();
+        } else if (element.name == "Array") {
+            this->isInPoints_ = false;
+        }
+    }
+
+    void startCell(const XmlReader::Element& element) {
+        const XmlReader::Element& data = this->object_.name.empty() ? element : this->object_;
+        const std::string *id     = data.attribute("id");
+        const std::string *label  = data.attribute(this->object_.name.empty() ? "value" : "label");
+        const std::string name    = label ? plainLabel(*label) : std::string();
+        const std::string *vertex = element.attribute("vertex");
+        const std::string *edge   = element.attribute("edge");
+
+        this->cellType_ = CellType::None;
+
+        if (vertex && *vertex == "1" && !name.empty() && std::all_of(name.begin(), name.end(), ::isdigit)) {
+            const unsigned long junctionId = std::strtoul(name.c_str(), nullptr, 10);
+            if (isBtw(junctionId, 1ul, 255ul)) {
+                this->junctions_.push_back({ id ? *id : std::string(), static_cast<uint8_t>(junctionId), 0.0f, 0.0f, 0.0f, 0.0f });
+                this->cellType_ = CellType::Junction;
+            }
+        } else if (edge && *edge == "1" && 1 == name.size() && isBtw(name[0], 'A', 'Z')) {
+            const std::string *length = data.attribute("length");
+            const std::string *source = element.attribute("source");
+            const std::string *target = element.attribute("target");
+
+            DrawioLabyrinthImporter::EdgeCell cell;
+            cell.name           = name[0];
+            cell.length         = length ? static_cast<int32_t>(std::lround(std::strtof(length->c_str(), nullptr))) : -1;
+            cell.source         = source ? *source : std::string();
+            cell.target         = target ? *target : std::string();
+            cell.hasSourcePoint = false;
+            cell.hasTargetPoint = false;
+            cell.points.push_back({ 0.0f, 0.0f });  // placeholder for the source point
+
+            this->edges_.push_back(cell);
+            this->cellType_ = CellType::Edge;
+        }
+    }
+
+    void endCell() {
+        if (CellType::Edge == this->cellType_) {
+            DrawioLabyrinthImporter::EdgeCell& edge = this->edges_.back();
+            edge.points.push_back(this->targetPoint_);
+        }
+        this->cellType_   = CellType::None;
+        this->isInPoints_ = false;
+    }
+
+    void addPoint(const XmlReader::Element& element) {
+        DrawioLabyrinthImporter::EdgeCell& edge = this->edges_.back();
+        const DrawioLabyrinthImporter::Point point = { attributeValue(element, "x"), attributeValue(element, "y") };
+        const std::string *as = element.attribute("as");
+
+        if (this->isInPoints_) {
+            edge.points.push_back(point);
+        } else if (as && *as == "sourcePoint") {
+            edge.points[0]      = point;
+            edge.hasSourcePoint = true;
+        } else if (as && *as == "targetPoint") {
+            this->targetPoint_  = point;
+            edge.hasTargetPoint = true;
+        }
+    }
+
+    std::vector<DrawioLabyrinthImporter::JunctionCell>& junctions_;
+    std::vector<DrawioLabyrinthImporter::EdgeCell>& edges_;
+    XmlReader::Element object_;
+    DrawioLabyrinthImporter::Point targetPoint_;
+    CellType cellType_;
+    bool isInPoints_;
+};
+
+constexpr float DEG_PER_RAD = 180.0f / 3.14159265358979f;
+
+/* @brief Gets the direction of a vector of the drawing [deg], in the car's coordinate system (the Y axis of the drawing points downwards).
+ */
+float angle(const DrawioLabyrinthImporter::Point& from, const DrawioLabyrinthImporter::Point& to) {
+    return std::atan2(from.y - to.y, to.x - from.x) * DEG_PER_RAD;
+}
+
+float normalize180(float angle) {
+    while (angle > 180.0f)   angle -= 360.0f;
+    while (angle <= -180.0f) angle += 360.0f;
+    return angle;
+}
+
+/* @brief A segment end connected to a junction.
+ */
+struct SegmentEnd {
+    char segment;
+    uint8_t junction;
+    int16_t orientation;
+    std::vector<float> turns;   // Directions of the legs of the edge relative to the orientation, starting from the junction [deg].
+};
+
+SegmentEnd createSegmentEnd(const char segment, const uint8_t junction, const std::vector<DrawioLabyrinthImporter::Point>& points) {
+    SegmentEnd end = { segment, junction, 0, {} };
+
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (points[i].x == points[i - 1].x && points[i].y == points[i - 1].y) {
+            continue;
+        }
+
+        const float legAngle = angle(points[i - 1], points[i]);
+        if (end.turns.empty()) {
+            end.orientation = LabyrinthDescription::normalize(static_cast<int16_t>(90 * std::lround(legAngle / 90.0f)));
+        }
+        end.turns.push_back(normalize180(legAngle - end.orientation));
+    }
+
+    return end;
+}
+
+/* @brief Checks if a segment end leaves the junction more to the left than another one.
+ */
+bool isMoreLeft(const SegmentEnd& a, const SegmentEnd& b) {
+    for (size_t i = 0; i < std::min(a.turns.size(), b.turns.size()); ++i) {
+        if (std::fabs(a.turns[i] - b.turns[i]) > 0.01f) {
+            return a.turns[i] > b.turns[i];
+        }
+    }
+    return false;
+}
+
+const char* directionName(const Direction dir) {
+    return Direction::LEFT == dir ? "LEFT" : Direction::CENTER == dir ? "CENTER" : "RIGHT";
+}
+
+} // namespace
+
+DrawioLabyrinthImporter::DrawioLabyrinthImporter()
+    : DrawioLabyrinthImporter(Options()) {}
+
+DrawioLabyrinthImporter::DrawioLabyrinthImporter(const Options& options)
+    : options_(options) {}
+
+Status DrawioLabyrinthImporter::parse(std::istream& in) {
+    this->junctionCells_.clear();
+    this->edgeCells_.clear();
+
+    StreamCharSource src(in);
+    XmlReader reader(src);
+    CellCollector collector(this->junctionCells_, this->edgeCells_);
+
+    if (Status::OK != collector.process(reader)) {
+        LOG_ERROR("Invalid draw.io file");
+        return Status::INVALID_DATA;
+    }
+
+    return this->resolve();
+}
+
+LabyrinthDescription DrawioLabyrinthImporter::description() const {
+    return LabyrinthDescription{
+        this->segments_.data(), static_cast<uint32_t>(this->segments_.size()),
+        this->junctions_.data(), static_cast<uint32_t>(this->junctions_.size()),
+        this->decisions_.data(), static_cast<uint32_t>(this->decisions_.size())
+    };
+}
+
+LabyrinthGraph DrawioLabyrinthImporter::build() const {
+    const LabyrinthDescription desc = this->description();
+    LabyrinthGraph graph;
+    graph.build(desc, desc.connections());
+    return graph;
+}
+
+void DrawioLabyrinthImporter::writeSource(std::ostream& out, const std::string& name) const {
+    std::string capitalName = name;
+    if (!capitalName.empty()) {
+        capitalName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(capitalName[0])));
+    }
+
+    const auto leftAligned = [](const std::string& str, const size_t width) {
+        return str + std::string(str.size() < width ? width - str.size() : 0, ' ');
+    };
+
+    out << "#include <cfg_track.hpp>\n"
+        << "#include <LabyrinthGraph.hpp>\n"
+        << "#include <track.hpp>\n"
+        << "\n"
+        << "using namespace micro;\n"
+        << "\n"
+        << "namespace {\n"
+        << "\n"
+        << "constexpr SegmentDescription SEGMENTS[] = {\n";
+
+    for (const SegmentDescription& seg : this->segments_) {
+        out << "    { '" << seg.name << "', " << leftAligned(std::to_string(seg.length) + ",", 5) << " " << (seg.isDeadEnd ? "true " : "false") << " },\n";
+    }
+
+    out << "};\n"
+        << "\n"
+        << "constexpr JunctionDescription JUNCTIONS[] = {\n";
+
+    for (const JunctionDescription& junc : this->junctions_) {
+        out << "    { " << leftAligned(std::to_string(junc.id) + ",", 3) << std::setw(6) << junc.x << "," << std::setw(5) << junc.y << " },\n";
+    }
+
+    out << "};\n"
+        << "\n"
+        << "constexpr DecisionDescription DECISIONS[] = {\n";
+
+    for (size_t i = 0; i < this->decisions_.size(); ++i) {
+        const DecisionDescription& dec = this->decisions_[i];
+        if (i > 0 && dec.junction != this->decisions_[i - 1].junction) {
+            out << "\n";
+        }
+        out << "    { '" << dec.segment << "', " << leftAligned(std::to_string(dec.junction) + ",", 3) << " " << leftAligned(std::to_string(dec.orientation) + ",", 4) << " "
+            << "Direction::" << leftAligned(directionName(dec.direction), 6) << " },\n";
+    }
+
+    out << "};\n"
+        << "\n"
+        << "} // namespace\n"
+        << "\n"
+        << "extern constexpr LabyrinthDescription " << name << "LabyrinthDescription = describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS);\n"
+        << "\n"
+        << "constexpr LabyrinthConnections " << name << "LabyrinthConnections = " << name << "LabyrinthDescription.connections();\n"
+        << "\n"
+        << "static_assert(" << name << "LabyrinthDescription.isValid(), \"" << capitalName << " labyrinth graph is invalid\");\n"
+        << "\n"
+        << "LabyrinthGraph build" << capitalName << "LabyrinthGraph() {\n"
+        << "    LabyrinthGraph graph;\n"
+        << "    graph.build(" << name << "LabyrinthDescription, " << name << "LabyrinthConnections);\n"
+        << "    return graph;\n"
+        << "}\n";
+}
+
+Status DrawioLabyrinthImporter::resolve() {
+    this->segments_.clear();
+    this->junctions_.clear();
+    this->decisions_.clear();
+
+    std::sort(this->junctionCells_.begin(), this->junctionCells_.end(), [](const JunctionCell& a, const JunctionCell& b) { return a.id < b.id; });
+    std::sort(this->edgeCells_.begin(), this->edgeCells_.end(), [](const EdgeCell& a, const EdgeCell& b) { return a.name < b.name; });
+
+    for (size_t i = 0; i < this->junctionCells_.size(); ++i) {
+        const JunctionCell& cell = this->junctionCells_[i];
+        if (i > 0 && cell.id == this->junctionCells_[i - 1].id) {
+            LOG_ERROR("Junction %u is drawn multiple times", static_cast<uint32_t>(cell.id));
+            return Status::INVALID_DATA;
+        }
+
+        const float x = cell.x + cell.width / 2, y = cell.y + cell.height / 2;
+        this->junctions_.push_back({
+            cell.id,
+            static_cast<int16_t>(std::lround((x - this->options_.originX) * this->options_.cmPerPixel)),
+            static_cast<int16_t>(std::lround((this->options_.originY - y) * this->options_.cmPerPixel))
+        });
+    }
+
+    const auto findJunction = [this](const std::string& cellId, const bool hasPoint, Point& point) -> const JunctionCell* {
+        for (const JunctionCell& cell : this->junctionCells_) {
+            const bool isAttached = !cellId.empty() && cell.cellId == cellId;
+            const bool isInside = hasPoint &&
+                isBtw(point.x, cell.x - this->options_.snapDistance, cell.x + cell.width + this->options_.snapDistance) &&
+                isBtw(point.y, cell.y - this->options_.snapDistance, cell.y + cell.height + this->options_.snapDistance);
+
+            if (isAttached || isInside) {
+                point = { cell.x + cell.width / 2, cell.y + cell.height / 2 };
+                return &cell;
+            }
+        }
+        return nullptr;
+    };
+
+    std::vector<SegmentEnd> ends;
+
+    for (size_t i = 0; i < this->edgeCells_.size(); ++i) {
+        EdgeCell& edge = this->edgeCells_[i];
+        if (i > 0 && edge.name == this->edgeCells_[i - 1].name) {
+            LOG_ERROR("Segment %c is drawn multiple times", edge.name);
+            return Status::INVALID_DATA;
+        }
+
+        const JunctionCell *source = findJunction(edge.source, edge.hasSourcePoint, edge.points.front());
+        const JunctionCell *target = findJunction(edge.target, edge.hasTargetPoint, edge.points.back());
+
+        if (!source && !target) {
+            LOG_ERROR("Segment %c is not connected to any junction", edge.name);
+            return Status::INVALID_DATA;
+        }
+
+        int32_t length = edge.length;
+        if (length < 0) {
+            float polylineLength = 0.0f;
+            for (size_t p = 1; p < edge.points.size(); ++p) {
+                polylineLength += std::hypot(edge.points[p].x - edge.points[p - 1].x, edge.points[p].y - edge.points[p - 1].y);
+            }
+            length = static_cast<int32_t>(std::lround(polylineLength * this->options_.cmPerPixel));
+        }
+
+        this->segments_.push_back({ edge.name, static_cast<uint16_t>(length), !source || !target });
+
+        if (source) {
+            ends.push_back(createSegmentEnd(edge.name, source->id, edge.points));
+        }
+
+        if (target) {
+            std::vector<Point> reversed(edge.points.rbegin(), edge.points.rend());
+            ends.push_back(createSegmentEnd(edge.name, target->id, reversed));
+        }
+    }
+
+    // groups the segment ends by junction and side, and orders them from left to right
+    std::stable_sort(ends.begin(), ends.end(), [](const SegmentEnd& a, const SegmentEnd& b) {
+        return a.junction != b.junction ? a.junction < b.junction :
+               a.orientation != b.orientation ? a.orientation < b.orientation :
+               isMoreLeft(a, b);
+    });
+
+    for (size_t first = 0; first < ends.size();) {
+        size_t last = first + 1;
+        while (last < ends.size() && ends[last].junction == ends[first].junction && ends[last].orientation == ends[first].orientation) {
+            ++last;
+        }
+
+        static const Direction DIRECTIONS[][3] = {
+            { Direction::CENTER },
+            { Direction::LEFT, Direction::RIGHT },
+            { Direction::LEFT, Direction::CENTER, Direction::RIGHT }
+        };
+
+        const size_t count = last - first;
+        if (count > 3) {
+            LOG_ERROR("Junction %u has more than 3 segments on side %d", static_cast<uint32_t>(ends[first].junction), static_cast<int32_t>(ends[first].orientation));
+            return Status::INVALID_DATA;
+        }
+
+        for (size_t i = first; i < last; ++i) {
+            this->decisions_.push_back({ ends[i].segment, ends[i].junction, ends[i].orientation, DIRECTIONS[count - 1][i - first] });
+        }
+
+        first = last;
+    }
+
+    if (!this->description().isValid()) {
+        LOG_ERROR("Labyrinth drawing does not describe a valid graph");
+        return Status::INVALID_DATA;
+    }
+
+    return Status::OK;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <LabyrinthDescription.hpp>
+#include <LabyrinthGraph.hpp>
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* @brief Host-side importer of labyrinth maps drawn in draw.io (diagrams.net).
+ *
+ * The drawing must follow these conventions:
+ * - A junction is a vertex labelled with its id (1-255). Its position is the center of the vertex.
+ * - A segment is an edge labelled with its name (A-Z). Its ends are connected to junction vertices,
+ *   either by attaching the edge to the vertex or by dropping the end point inside the vertex bounds.
+ *   A segment with only one connected end is a dead-end.
+ * - The segment length [cm] is the `length` property of the edge (Edit Data), or the length of the polyline when not set.
+ * - The decision of a segment end is given by the first leg of the edge, starting from the junction:
+ *   its direction snapped to the nearest multiple of 90 degrees is the orientation, and the segments leaving
+ *   on the same side of a junction are ordered from left to right by the direction of their first legs.
+ *
+ * The file is processed as an XML stream, no document tree is built. Compressed diagrams are inflated on the fly.
+ */
+class DrawioLabyrinthImporter {
+public:
+    struct Options {
+        float cmPerPixel   = 1.0f;  // Drawing scale.
+        float originX      = 0.0f;  // X coordinate of the car start position in the drawing [px].
+        float originY      = 0.0f;  // Y coordinate of the car start position in the drawing [px].
+        float snapDistance = 10.0f; // Maximum distance of an unattached edge end point from a junction vertex [px].
+    };
+
+    DrawioLabyrinthImporter();
+    explicit DrawioLabyrinthImporter(const Options& options);
+
+    /* @brief Parses a draw.io file.
+     * @param in The input stream of the file
+     * @returns Status::OK if the drawing describes a valid labyrinth, Status::INVALID_DATA otherwise
+     */
+    micro::Status parse(std::istream& in);
+
+    const std::vector<SegmentDescription>& segments() const { return this->segments_; }
+    const std::vector<JunctionDescription>& junctions() const { return this->junctions_; }
+    const std::vector<DecisionDescription>& decisions() const { return this->decisions_; }
+
+    /* @brief Gets the description of the parsed labyrinth.
+     * @note The description refers to the tables of the importer.
+     */
+    LabyrinthDescription description() const;
+
+    /* @brief Builds the graph of the parsed labyrinth.
+     */
+    LabyrinthGraph build() const;
+
+    /* @brief Writes the description of the parsed labyrinth as a C++ source file, in the format of race_labyrinth.cpp.
+     * @param out The output stream
+     * @param name The name of the labyrinth, e.g. "race" for raceLabyrinthDescription and buildRaceLabyrinthGraph()
+     */
+    void writeSource(std::ostream& out, const std::string& name) const;
+
+    struct JunctionCell {
+        std::string cellId;
+        uint8_t id;
+        float x, y, width, height;
+    };
+
+    struct Point {
+        float x, y;
+    };
+
+    struct EdgeCell {
+        char name;
+        int32_t length;     // The length property [cm], negative if not set.
+        std::string source, target;
+        std::vector<Point> points;  // Source point, waypoints and target point.
+        bool hasSourcePoint, hasTargetPoint;
+    };
+
+private:
+    micro::Status resolve();
+
+    Options options_;
+    std::vector<JunctionCell> junctionCells_;
+    std::vector<EdgeCell> edgeCells_;
+
+    std::vector<SegmentDescription> segments_;
+    std::vector<JunctionDescription> junctions_;
+    std::vector<DecisionDescription> decisions_;
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <micro/math/unit_utils.hpp>
+#include <micro/utils/point2.hpp>
+#include <micro/utils/units.hpp>
+#include <micro/container/vec.hpp>
+
+#include <LabyrinthGraph.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+/* @brief Fixed-capacity spatial index of junction positions and topologies.
+ * Junctions are stored in a hashed uniform grid with the cell size of the topology search radius,
+ * so a lookup only checks the junctions in the 3x3 cells around the position, comparing squared distances.
+ * Keys must be in the range [0, N).
+ * The localizer has replaced the position-based junction lookup, so the index is only kept on the host, with its tests and benchmarks.
+ */
+template <uint32_t N>
+class JunctionIndex {
+public:
+    typedef uint16_t key_type;
+
+    static constexpr key_type INVALID_KEY = 0xffff;
+
+    static_assert(N < INVALID_KEY, "JunctionIndex capacity is limited by key_type");
+
+    JunctionIndex() {
+        this->clear();
+    }
+
+    uint32_t size() const {
+        return this->size_;
+    }
+
+    void clear() {
+        this->size_ = 0;
+        std::fill(this->buckets_, this->buckets_ + N, INVALID_KEY);
+    }
+
+    /* @brief Adds a junction to the index.
+     * @param key The key of the junction.
+     * @param pos The junction position.
+     * @param topology The junction topology.
+     */
+    void insert(const key_type key, const micro::point2m& pos, const JunctionTopology& topology) {
+        const key_type bucket = this->bucket(cell(pos.X), cell(pos.Y));
+
+        this->positions_[key]  = pos;
+        this->topologies_[key] = topology;
+        this->next_[key]       = this->buckets_[bucket];
+        this->buckets_[bucket] = key;
+        this->size_            = std::max<uint32_t>(this->size_, key + 1);
+    }
+
+    /* @brief Updates the topology of a junction, e.g. when a new segment has been connected to it.
+     * @param key The key of the junction.
+     * @param topology The junction topology.
+     */
+    void setTopology(const key_type key, const JunctionTopology& topology) {
+        this->topologies_[key] = topology;
+    }
+
+    /* @brief Finds the junction at the given position, preferring the junctions with the correct topology.
+     * @param pos The position.
+     * @param sideSegments The number of segments on the given sides of the junction.
+     * @returns The closest junction with the correct topology if it is within TOPOLOGY_SEARCH_RADIUS,
+     * otherwise the closest junction, or INVALID_KEY if the index is empty.
+     */
+    key_type find(const micro::point2m& pos, const micro::vec<std::pair<micro::radian_t, uint8_t>, 2>& sideSegments) const {
+        static constexpr float MAX_DIST2 = TOPOLOGY_SEARCH_RADIUS * TOPOLOGY_SEARCH_RADIUS;
+
+        key_type closest = INVALID_KEY, closestWithTopology = INVALID_KEY;
+        float closestDist2 = MAX_DIST2, closestWithTopologyDist2 = MAX_DIST2;
+
+        const int32_t cx = cell(pos.X), cy = cell(pos.Y);
+
+        for (int32_t x = cx - 1; x <= cx + 1; ++x) {
+            for (int32_t y = cy - 1; y <= cy + 1; ++y) {
+                for (key_type key = this->buckets_[this->bucket(x, y)]; key != INVALID_KEY; key = this->next_[key]) {
+                    const float dist2 = this->distance2(key, pos);
+
+                    if (dist2 < closestDist2) {
+                        closest      = key;
+                        closestDist2 = dist2;
+                    }
+
+                    if (dist2 < closestWithTopologyDist2 && this->topologies_[key].matches(sideSegments)) {
+                        closestWithTopology      = key;
+                        closestWithTopologyDist2 = dist2;
+                    }
+                }
+            }
+        }
+
+        // all junctions within the search radius have been checked, so the closest one is only searched globally
+        // when there is no junction within the search radius at all, which means that the car position is wrong
+        if (INVALID_KEY != closestWithTopology) {
+            closest = closestWithTopology;
+        } else if (INVALID_KEY == closest) {
+            closestDist2 = std::numeric_limits<float>::infinity();
+            for (key_type key = 0; key < this->size_; ++key) {
+                const float dist2 = this->distance2(key, pos);
+                if (dist2 < closestDist2) {
+                    closest      = key;
+                    closestDist2 = dist2;
+                }
+            }
+        }
+
+        return closest;
+    }
+
+private:
+    static constexpr float TOPOLOGY_SEARCH_RADIUS = 1.2f; // [m] The grid cell size.
+
+    static int32_t cell(const micro::meter_t coord) {
+        return static_cast<int32_t>(std::floor(coord.get() / TOPOLOGY_SEARCH_RADIUS));
+    }
+
+    static key_type bucket(const int32_t x, const int32_t y) {
+        return static_cast<key_type>((static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u) % N);
+    }
+
+    float distance2(const key_type key, const micro::point2m& pos) const {
+        const float dx = (this->positions_[key].X - pos.X).get();
+        const float dy = (this->positions_[key].Y - pos.Y).get();
+        return dx * dx + dy * dy;
+    }
+
+    micro::point2m positions_[N];     // The junction positions.
+    JunctionTopology topologies_[N];  // The junction topologies.
+    key_type next_[N];                // The next junction in the same bucket.
+    key_type buckets_[N];             // The first junction of each bucket.
+    uint32_t size_;                   // The number of stored keys.
+};
+
+template <uint32_t N>
+constexpr typename JunctionIndex<N>::key_type JunctionIndex<N>::INVALID_KEY;
+
+template <uint32_t N>
+constexpr float JunctionIndex<N>::TOPOLOGY_SEARCH_RADIUS;
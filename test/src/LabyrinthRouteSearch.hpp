@@ -0,0 +1,125 @@
+#pragma once
+
+#include <IndexedPriorityQueue.hpp>
+#include <LabyrinthRoute.hpp>
+
+#include <algorithm>
+#include <utility>
+
+/* @brief Shortest route search for a graph of at most MAX_NUM_CONNECTIONS connections.
+ * The navigator plans with LabyrinthRoutePlanner, so the search is only kept on the host, as a reference of the shortest routes for the route tests.
+ * The search buffers are kept in the object instead of the stack, because they are too large for it.
+ * @note Connections must be indexed densely, @see Connection::idx
+ */
+template <uint32_t MAX_NUM_CONNECTIONS>
+class LabyrinthRouteSearch {
+public:
+    LabyrinthRoute create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, const bool allowBackwardNavigation);
+
+private:
+    // going back to the previous junction decreases the distance, therefore states are ordered by their distance to the start of their segment,
+    // which increases by either a whole segment length or the reversal distance in every step,
+    // equally long routes are ordered by the farthest distance they reach, e.g. the shorter dead-end is preferred for reversing
+    typedef std::pair<micro::meter_t, micro::meter_t> priority_t;
+    typedef IndexedPriorityQueue<priority_t, 2 * MAX_NUM_CONNECTIONS + 1> PriorityQueue;
+    typedef typename PriorityQueue::key_type state_t;
+
+    static constexpr state_t INVALID_STATE = 0xffff;
+    static constexpr state_t START_STATE   = 2 * MAX_NUM_CONNECTIONS;
+
+    struct StateInfo {
+        const Connection *prevConn = nullptr;
+        micro::meter_t dist        = micro::numeric_limits<micro::meter_t>::infinity(); // Distance to the middle of the segment.
+        micro::meter_t startDist   = micro::numeric_limits<micro::meter_t>::infinity(); // Distance to the start of the segment.
+        micro::meter_t maxDist     = micro::numeric_limits<micro::meter_t>::infinity(); // Farthest distance reached by the route.
+        state_t prevState          = INVALID_STATE;
+    };
+
+    static state_t getState(const Connection& conn, const Segment& seg);
+
+    StateInfo info_[2 * MAX_NUM_CONNECTIONS + 1];
+    PriorityQueue queue_;
+};
+
+template <uint32_t MAX_NUM_CONNECTIONS>
+constexpr typename LabyrinthRouteSearch<MAX_NUM_CONNECTIONS>::state_t LabyrinthRouteSearch<MAX_NUM_CONNECTIONS>::INVALID_STATE;
+
+template <uint32_t MAX_NUM_CONNECTIONS>
+constexpr typename LabyrinthRouteSearch<MAX_NUM_CONNECTIONS>::state_t LabyrinthRouteSearch<MAX_NUM_CONNECTIONS>::START_STATE;
+
+template <uint32_t MAX_NUM_CONNECTIONS>
+typename LabyrinthRouteSearch<MAX_NUM_CONNECTIONS>::state_t LabyrinthRouteSearch<MAX_NUM_CONNECTIONS>::getState(const Connection& conn, const Segment& seg) {
+    return static_cast<state_t>(2 * conn.idx + (conn.node2 == &seg ? 1 : 0));
+}
+
+template <uint32_t MAX_NUM_CONNECTIONS>
+LabyrinthRoute LabyrinthRouteSearch<MAX_NUM_CONNECTIONS>::create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, const bool allowBackwardNavigation) {
+
+    // performs Dijkstra-algorithm (https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm) over route states
+    // specifically tuned for forward-moving car in a graph that allows multiple connections between the nodes
+    // a route state is a segment and the connection it was approached through,
+    // because both the forward-only rule and the reversal cost depend on the previous connection,
+    // the start has a separate state, because reversals are not penalized in the start segment
+
+    std::fill(this->info_, this->info_ + START_STATE + 1, StateInfo());
+    this->queue_.clear();
+
+    StateInfo& startInfo = this->info_[START_STATE];
+    startInfo.prevConn  = &prevConn;
+    startInfo.dist      = micro::meter_t(0);
+    startInfo.startDist = -currentSeg.length / 2;
+    startInfo.maxDist   = micro::meter_t(0);
+    this->queue_.push(START_STATE, priority_t(startInfo.startDist, startInfo.maxDist));
+
+    state_t destState = INVALID_STATE;
+
+    while (!this->queue_.empty()) {
+        const state_t state        = this->queue_.pop();
+        const StateInfo& stateInfo = this->info_[state];
+        const bool isStartSeg      = START_STATE == state;
+        const Segment& seg         = isStartSeg ? currentSeg : *(state % 2 ? stateInfo.prevConn->node2 : stateInfo.prevConn->node1);
+
+        if (&seg == &destSeg) {
+            destState = state;
+            break;
+        }
+
+        for (const Connection *newConn : seg.edges) {
+            if (allowBackwardNavigation || LabyrinthRoute::isForwardConnection(*stateInfo.prevConn, seg, *newConn)) {
+                const state_t newState = getState(*newConn, *newConn->getOtherSegment(seg));
+                StateInfo& newInfo     = this->info_[newState];
+
+                const micro::meter_t dist      = stateInfo.dist + LabyrinthRoute::connectionCost(*stateInfo.prevConn, seg, *newConn, isStartSeg, allowBackwardNavigation);
+                const micro::meter_t startDist = stateInfo.startDist +
+                    (LabyrinthRoute::isReversal(*stateInfo.prevConn, *newConn, isStartSeg, allowBackwardNavigation) ? cfg::LABYRINTH_REVERSAL_DISTANCE : seg.length);
+                const micro::meter_t maxDist   = std::max(stateInfo.maxDist, dist);
+
+                if (priority_t(startDist, maxDist) < priority_t(newInfo.startDist, newInfo.maxDist)) {
+                    newInfo.prevConn  = newConn;
+                    newInfo.dist      = dist;
+                    newInfo.startDist = startDist;
+                    newInfo.maxDist   = maxDist;
+                    newInfo.prevState = state;
+                    this->queue_.push(newState, priority_t(startDist, maxDist));
+                }
+            }
+        }
+    }
+
+    LabyrinthRoute route(&destSeg);
+
+    if (INVALID_STATE != destState) {
+        uint32_t length = 0;
+        for (state_t state = destState; state != START_STATE; state = this->info_[state].prevState) {
+            ++length;
+        }
+
+        if (length <= LabyrinthRoute::MAX_LENGTH) {
+            for (state_t state = destState; state != START_STATE; state = this->info_[state].prevState) {
+                route.push_front(*this->info_[state].prevConn);
+            }
+        }
+    }
+
+    return route;
+}
@@ -0,0 +1,135 @@
+#include <micro/utils/log.hpp>
+
+#include "LabyrinthRouteTable.hpp"
+
+using namespace micro;
+
+constexpr uint32_t LabyrinthRouteTable::MAX_NUM_STATES;
+constexpr LabyrinthRouteTable::state_t LabyrinthRouteTable::INVALID_STATE;
+
+LabyrinthRouteTable::LabyrinthRouteTable(const LabyrinthGraph& graph, const bool allowBackwardNavigation)
+    : graph_(graph)
+    , allowBackwardNavigation_(allowBackwardNavigation) {
+
+    std::fill(&this->firstHops_[0][0], &this->firstHops_[0][0] + MAX_NUM_STATES * cfg::MAX_NUM_LABYRINTH_SEGMENTS, INVALID_STATE);
+    std::fill(&this->nextHops_[0][0], &this->nextHops_[0][0] + MAX_NUM_STATES * cfg::MAX_NUM_LABYRINTH_SEGMENTS, INVALID_STATE);
+}
+
+void LabyrinthRouteTable::build() {
+    for (uint8_t destIdx = 0; destIdx < this->graph_.segments().size(); ++destIdx) {
+        this->buildDestination(destIdx);
+    }
+}
+
+LabyrinthRoute LabyrinthRouteTable::create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg) const {
+    LabyrinthRoute route(&currentSeg);
+
+    const uint8_t destIdx = this->getSegmentIndex(destSeg);
+    state_t state = this->firstHops_[this->getState(prevConn, currentSeg)][destIdx];
+
+    if (&currentSeg != &destSeg && INVALID_STATE == state) {
+        LOG_ERROR("Segment %c is not reachable from segment %c", destSeg.name, currentSeg.name);
+        return LabyrinthRoute(&destSeg);
+    }
+
+    while (INVALID_STATE != state && route.connections.size() < LabyrinthRoute::MAX_LENGTH) {
+        route.push_back(this->getConnection(state));
+        state = this->nextHops_[state][destIdx];
+    }
+
+    return route;
+}
+
+uint32_t LabyrinthRouteTable::numStates() const {
+    return 2 * this->graph_.connections().size();
+}
+
+LabyrinthRouteTable::state_t LabyrinthRouteTable::getState(const Connection& prevConn, const Segment& seg) const {
+    return static_cast<state_t>(2 * prevConn.idx + (prevConn.node2 == &seg ? 1 : 0));
+}
+
+const Connection& LabyrinthRouteTable::getConnection(const state_t state) const {
+    return this->graph_.connections()[state / 2];
+}
+
+const Segment& LabyrinthRouteTable::getSegment(const state_t state) const {
+    const Connection& conn = this->getConnection(state);
+    return *(state % 2 ? conn.node2 : conn.node1);
+}
+
+uint8_t LabyrinthRouteTable::getSegmentIndex(const Segment& seg) const {
+    return static_cast<uint8_t>(seg.idx);
+}
+
+bool LabyrinthRouteTable::isAllowed(const Connection& prevConn, const Segment& seg, const Connection& newConn) const {
+    return this->allowBackwardNavigation_ || LabyrinthRoute::isForwardConnection(prevConn, seg, newConn);
+}
+
+void LabyrinthRouteTable::buildDestination(const uint8_t destIdx) {
+
+    // Calculates the cost-to-go of every state with the Bellman-Ford algorithm (https://en.wikipedia.org/wiki/Bellman%E2%80%93Ford_algorithm).
+    // Reversing edges may have negative costs, but the graph contains no negative cycles,
+    // because each cycle includes either a full segment length or a reversal penalty per step.
+
+    const Segment& destSeg = this->graph_.segments()[destIdx];
+    const uint32_t numStates = this->numStates();
+
+    meter_t costs[MAX_NUM_STATES];
+
+    for (state_t state = 0; state < numStates; ++state) {
+        costs[state] = &this->getSegment(state) == &destSeg ? meter_t(0) : micro::numeric_limits<meter_t>::infinity();
+        this->firstHops_[state][destIdx] = INVALID_STATE;
+        this->nextHops_[state][destIdx]  = INVALID_STATE;
+    }
+
+    bool changed = true;
+    for (uint32_t i = 0; changed && i < numStates; ++i) {
+        changed = false;
+
+        for (state_t state = 0; state < numStates; ++state) {
+            const Connection& prevConn = this->getConnection(state);
+            const Segment& seg         = this->getSegment(state);
+
+            if (&seg == &destSeg) {
+                continue;
+            }
+
+            for (const Connection *newConn : seg.edges) {
+                if (this->isAllowed(prevConn, seg, *newConn)) {
+                    const state_t newState = this->getState(*newConn, *newConn->getOtherSegment(seg));
+                    const meter_t cost = costs[newState] + LabyrinthRoute::connectionCost(prevConn, seg, *newConn, false, this->allowBackwardNavigation_);
+
+                    if (cost < costs[state]) {
+                        costs[state] = cost;
+                        this->nextHops_[state][destIdx] = newState;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // the first step of a route is calculated separately, because reversals are not penalized in the start segment
+    for (state_t state = 0; state < numStates; ++state) {
+        const Connection& prevConn = this->getConnection(state);
+        const Segment& seg         = this->getSegment(state);
+
+        if (&seg == &destSeg) {
+            continue;
+        }
+
+        meter_t minCost = micro::numeric_limits<meter_t>::infinity();
+
+        for (const Connection *newConn : seg.edges) {
+            if (this->isAllowed(prevConn, seg, *newConn)) {
+                const state_t newState = this->getState(*newConn, *newConn->getOtherSegment(seg));
+                const meter_t cost = costs[newState] + LabyrinthRoute::connectionCost(prevConn, seg, *newConn, true, this->allowBackwardNavigation_);
+
+                if (cost < minCost) {
+                    minCost = cost;
+                    this->firstHops_[state][destIdx] = newState;
+                }
+            }
+        }
+    }
+}
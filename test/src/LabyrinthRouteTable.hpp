@@ -0,0 +1,44 @@
+#pragma once
+
+#include <LabyrinthRoute.hpp>
+
+/* @brief Host-side precomputed next-hop table for labyrinth routes.
+ * Stores the next connection for every (previous connection, current segment, destination segment) key,
+ * so creating a route does not need any search, only a walk along the table.
+ * The navigator plans with LabyrinthRoutePlanner, which handles blocked connections and time costs,
+ * so the table is only kept on the host, as a reference of the shortest routes for the route tests.
+ * @note The table needs to be rebuilt whenever the graph changes.
+ */
+class LabyrinthRouteTable {
+public:
+    LabyrinthRouteTable(const LabyrinthGraph& graph, const bool allowBackwardNavigation);
+
+    void build();
+
+    LabyrinthRoute create(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg) const;
+
+private:
+    typedef uint8_t state_t; // Route state: the current segment and the connection it was approached through.
+
+    static constexpr uint32_t MAX_NUM_STATES = 2 * 2 * cfg::MAX_NUM_LABYRINTH_SEGMENTS; // 2 states for each connection
+    static constexpr state_t INVALID_STATE   = 0xff;
+
+    uint32_t numStates() const;
+
+    state_t getState(const Connection& prevConn, const Segment& seg) const;
+
+    const Connection& getConnection(const state_t state) const;
+
+    const Segment& getSegment(const state_t state) const;
+
+    uint8_t getSegmentIndex(const Segment& seg) const;
+
+    bool isAllowed(const Connection& prevConn, const Segment& seg, const Connection& newConn) const;
+
+    void buildDestination(const uint8_t destIdx);
+
+    const LabyrinthGraph& graph_;
+    const bool allowBackwardNavigation_;
+    state_t firstHops_[MAX_NUM_STATES][cfg::MAX_NUM_LABYRINTH_SEGMENTS]; // Next states when the route starts from the given state.
+    state_t nextHops_[MAX_NUM_STATES][cfg::MAX_NUM_LABYRINTH_SEGMENTS];  // Next states when the route passes through the given state.
+};
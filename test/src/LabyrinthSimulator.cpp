@@ -0,0 +1,370 @@
+#include <micro/math/numeric.hpp>
+#include <micro/math/unit_utils.hpp>
+
+#include <cfg_car.hpp>
+
+#include "LabyrinthSimulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace micro;
+
+namespace {
+
+constexpr millimeter_t LINE_DIST = millimeter_t(50); // Distance of the neighbouring lines of a junction.
+
+// line ids of the junction directions, the center line keeps the id of the single line
+uint8_t lineId(const Direction dir) {
+    return Direction::CENTER == dir ? 1 : Direction::LEFT == dir ? 2 : 3;
+}
+
+int8_t lateralIndex(const Direction dir) {
+    return Direction::LEFT == dir ? -1 : Direction::CENTER == dir ? 0 : 1;
+}
+
+} // namespace
+
+LabyrinthSimulator::LabyrinthSimulator(const LabyrinthGraph& graph, const Segment& startSeg, const Connection& prevConn, const Segment& laneChangeSeg,
+    const Config& config, const uint32_t seed)
+    : graph_(graph)
+    , status_(this->compiledGraph_.compile(graph))
+    , laneChangeSeg_(static_cast<index_t>(laneChangeSeg.idx))
+    , config_(config)
+    , random_(seed)
+    , prevConn_(static_cast<index_t>(prevConn.idx))
+    , seg_(static_cast<index_t>(startSeg.idx))
+    , pos_(startSeg.length / 2)
+    , isBodyForward_(true)
+    , speed_(0)
+    , targetSpeed_(0)
+    , speedStep_(0)
+    , lastMotionSign_(1)
+    , numDetectedSegments_(0)
+    , mainLine_(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST)
+    , time_(0)
+    , numJunctions_(0)
+    , numMisnavigations_(0)
+    , maxJunctionSpeed_(0)
+    , isOffTrack_(false) {
+
+    this->car_.pose     = this->pose();
+    this->car_.speed    = m_per_sec_t(0);
+    this->car_.distance = meter_t(0);
+
+    this->controlData_.speed    = m_per_sec_t(0);
+    this->controlData_.rampTime = millisecond_t(0);
+}
+
+LabyrinthSimulator::Result LabyrinthSimulator::run(LabyrinthNavigator& navigator, const Mission& mission) {
+    if (Status::OK != this->status_ || Status::OK != navigator.initialize()) {
+        return { false, false, second_t(0), meter_t(0), 0, 0, m_per_sec_t(0) };
+    }
+
+    const Segment& laneChangeSeg = this->graph_.segments()[this->laneChangeSeg_];
+    uint32_t numVisitedTargets = 0;
+
+    // the gates report the visited segments, so the next target is sent as soon as the car reaches the current one
+    const auto sendTarget = [&]() {
+        if (numVisitedTargets < mission.targets.size()) {
+            navigator.setTargetSegment(mission.targets[numVisitedTargets], false);
+        } else {
+            navigator.setTargetSegment(&laneChangeSeg, true);
+        }
+    };
+
+    sendTarget();
+
+    while (!navigator.finished() && !this->isOffTrack_ && this->time_ < this->config_.timeout) {
+        if (numVisitedTargets < mission.targets.size() && &this->currentSegment() == mission.targets[numVisitedTargets]) {
+            ++numVisitedTargets;
+            sendTarget();
+        }
+
+        this->step(navigator);
+    }
+
+    return { navigator.finished(), this->isOffTrack_, this->time_, this->car_.distance, this->numJunctions_, this->numMisnavigations_, this->maxJunctionSpeed_ };
+}
+
+void LabyrinthSimulator::step(LabyrinthNavigator& navigator) {
+    this->updateSpeed();
+    this->move();
+
+    const index_t exitConn = this->exitConnection();
+    const meter_t length   = this->compiledGraph_.segment(this->seg_).length;
+
+    if (CompiledLabyrinthGraph::INVALID_INDEX == exitConn && this->leadingSensorPos() > length + this->config_.maxDeadEndOverrun) {
+        this->isOffTrack_ = true;
+    }
+
+    // the leading sensor has passed through the junction, the car will follow the line selected by the navigator
+    const bool isLeavingJunction = this->motionSign() > 0 ?
+        CompiledLabyrinthGraph::INVALID_INDEX != exitConn && this->leadingSensorPos() > length :
+        this->leadingSensorPos() < meter_t(0);
+
+    Candidates candidates;
+    if (isLeavingJunction) {
+        candidates = this->nextCandidates();
+
+        const SensorView view = this->sensorView(this->leadingSensorPos());
+        this->numDetectedSegments_ = this->numSideSegments(view.junc, view.side);
+
+        if (std::bernoulli_distribution(this->config_.misdetectionProbability)(this->random_)) {
+            this->numDetectedSegments_ = 1 + (this->numDetectedSegments_ + std::uniform_int_distribution<uint32_t>(0, 1)(this->random_)) % 3;
+        }
+    }
+
+    const Pose truePose = this->pose();
+    this->car_.pose.pos   = truePose.pos + this->odometryError_;
+    this->car_.pose.angle = truePose.angle;
+    this->car_.speed      = this->speed_;
+
+    const bool isFrontLeading = (this->motionSign() > 0) == this->isBodyForward_;
+    LinesInfo& leading        = isFrontLeading ? this->lineInfo_.front : this->lineInfo_.rear;
+    LinesInfo& trailing       = isFrontLeading ? this->lineInfo_.rear : this->lineInfo_.front;
+
+    this->updateSensor(leading, this->sensorView(this->leadingSensorPos()), true);
+    this->updateSensor(trailing, this->sensorView(this->trailingSensorPos()), false);
+
+    micro::updateMainLine(this->lineInfo_.front.lines, this->lineInfo_.rear.lines, this->mainLine_);
+    navigator.update(this->car_, this->lineInfo_, this->mainLine_, this->controlData_);
+
+    // the odometry is overwritten with the position corrected by the navigator, as in case of the car
+    if (navigator.correctedCarPose().pos != this->car_.pose.pos) {
+        this->odometryError_ = navigator.correctedCarPose().pos - truePose.pos;
+    }
+
+    if (isLeavingJunction) {
+        const uint8_t selectedId = (isFrontLeading ? this->mainLine_.frontLine : this->mainLine_.rearLine).id;
+
+        index_t conn = candidates[0];
+        for (const index_t c : candidates) {
+            const CompiledLabyrinthGraph::ConnectionInfo& info = this->compiledGraph_.connection(c);
+            const index_t newSeg = this->compiledGraph_.getOtherSegment(c, this->seg_);
+            if (lineId(info.directions[info.segments[0] == newSeg ? 0 : 1]) == selectedId) {
+                conn = c;
+            }
+        }
+
+        this->passJunction(conn);
+
+        if (&this->currentSegment() != navigator.currentSegment()) {
+            ++this->numMisnavigations_;
+        }
+    }
+
+    this->time_ += this->config_.period;
+}
+
+const Segment& LabyrinthSimulator::currentSegment() const {
+    return this->graph_.segments()[this->seg_];
+}
+
+void LabyrinthSimulator::updateSpeed() {
+    if (this->controlData_.speed != this->targetSpeed_) {
+        this->targetSpeed_ = this->controlData_.speed;
+        this->speedStep_   = this->controlData_.rampTime > millisecond_t(0) ?
+            abs(this->targetSpeed_ - this->speed_) * (this->config_.period / this->controlData_.rampTime) :
+            abs(this->targetSpeed_ - this->speed_);
+    }
+
+    if (abs(this->targetSpeed_ - this->speed_) <= this->speedStep_) {
+        this->speed_ = this->targetSpeed_;
+    } else {
+        this->speed_ += this->targetSpeed_ > this->speed_ ? this->speedStep_ : -this->speedStep_;
+    }
+}
+
+void LabyrinthSimulator::move() {
+    const meter_t dist = this->speed_ * this->config_.period;
+    if (dist == meter_t(0)) {
+        return;
+    }
+
+    this->pos_ += this->isBodyForward_ ? dist : -dist;
+    this->lastMotionSign_ = (dist > meter_t(0)) == this->isBodyForward_ ? 1 : -1;
+    this->car_.distance += abs(dist);
+
+    if (this->config_.odometryDrift > 0.0f) {
+        std::normal_distribution<float> drift(0.0f, this->config_.odometryDrift * std::sqrt(abs(dist).get()));
+        this->odometryError_.X += meter_t(drift(this->random_));
+        this->odometryError_.Y += meter_t(drift(this->random_));
+    }
+}
+
+Pose LabyrinthSimulator::pose() const {
+    const CompiledLabyrinthGraph::ConnectionInfo& entry = this->compiledGraph_.connection(this->prevConn_);
+    const index_t exitConn = this->exitConnection();
+    const meter_t length   = this->compiledGraph_.segment(this->seg_).length;
+
+    const point2m entryPos     = this->graph_.junctions()[entry.junction].pos;
+    const radian_t entryAngle  = PI_2 * static_cast<float>(this->segmentSide(this->prevConn_));
+
+    point2m exitPos;
+    radian_t exitAngle;
+
+    if (CompiledLabyrinthGraph::INVALID_INDEX != exitConn) {
+        exitPos   = this->graph_.junctions()[this->compiledGraph_.connection(exitConn).junction].pos;
+        exitAngle = PI_2 * static_cast<float>(this->segmentSide(exitConn)) + PI;
+    } else {
+        exitPos   = entryPos + point2m(length, meter_t(0)).rotate(entryAngle);
+        exitAngle = entryAngle;
+    }
+
+    // the car moves along the chord of the segment, and turns evenly from the entry orientation to the exit orientation
+    const float ratio      = clamp(this->pos_ / length, 0.0f, 1.0f);
+    const radian_t turn    = radian_t(std::atan2(std::sin((exitAngle - entryAngle).get()), std::cos((exitAngle - entryAngle).get())));
+    const radian_t heading = entryAngle + turn * ratio;
+
+    Pose result;
+    result.pos   = entryPos + (exitPos - entryPos) * ratio;
+    result.angle = normalize360(this->isBodyForward_ ? heading : heading + PI);
+    return result;
+}
+
+LabyrinthSimulator::SensorView LabyrinthSimulator::sensorView(const meter_t pos) const {
+    const index_t exitConn = this->exitConnection();
+    const meter_t length   = this->compiledGraph_.segment(this->seg_).length;
+    const bool isForward   = this->motionSign() > 0;
+
+    SensorView view = { LinePattern::SINGLE_LINE, Sign::NEUTRAL, CompiledLabyrinthGraph::INVALID_INDEX, 0 };
+
+    // a sensor sees a junction pattern of the segments on its side of the junction, the direction tells if the car is leaving the junction
+    const auto junctionView = [&view, this](const index_t conn, const uint8_t side, const bool isLeaving) {
+        const index_t junc = this->compiledGraph_.connection(conn).junction;
+        view.type = static_cast<LinePattern::type_t>(enum_cast(LinePattern::JUNCTION_1) + this->numSideSegments(junc, side) - 1);
+        view.dir  = isLeaving ? Sign::POSITIVE : Sign::NEGATIVE;
+        view.junc = junc;
+        view.side = side;
+    };
+
+    if (pos < meter_t(0)) {
+        if (-pos < this->config_.junctionLength) {
+            junctionView(this->prevConn_, this->otherSide(this->prevConn_), !isForward);
+        }
+    } else if (pos < this->config_.junctionLength) {
+        junctionView(this->prevConn_, this->segmentSide(this->prevConn_), isForward);
+
+    } else if (CompiledLabyrinthGraph::INVALID_INDEX == exitConn) {
+        if (pos > length) {
+            view.type = LinePattern::NONE;
+        }
+
+    } else if (pos > length) {
+        if (pos - length < this->config_.junctionLength) {
+            junctionView(exitConn, this->otherSide(exitConn), isForward);
+        }
+    } else if (length - pos < this->config_.junctionLength) {
+        junctionView(exitConn, this->segmentSide(exitConn), !isForward);
+    }
+
+    if (LinePattern::SINGLE_LINE == view.type && this->laneChangeSeg_ == this->seg_ && abs(pos - length / 2) < this->config_.laneChangeLength / 2) {
+        view.type = LinePattern::LANE_CHANGE;
+        view.dir  = isForward ? Sign::POSITIVE : Sign::NEGATIVE;
+    }
+
+    return view;
+}
+
+void LabyrinthSimulator::updateSensor(LinesInfo& sensor, const SensorView& view, const bool isLeading) const {
+    sensor.lines.clear();
+
+    if (CompiledLabyrinthGraph::INVALID_INDEX != view.junc) {
+        // the lines are ordered from left to right in the direction of motion for the leading sensor, and from right to left for the trailing one
+        const int8_t order = isLeading ? 1 : -1;
+        for (const Direction dir : { Direction::LEFT, Direction::CENTER, Direction::RIGHT }) {
+            if (CompiledLabyrinthGraph::INVALID_INDEX != this->compiledGraph_.getJunctionSegment(view.junc, view.side, dir)) {
+                sensor.lines.push_back({ LINE_DIST * static_cast<float>(order * lateralIndex(dir)), lineId(dir) });
+            }
+        }
+        if (!isLeading) {
+            std::reverse(sensor.lines.begin(), sensor.lines.end());
+        }
+    } else if (LinePattern::NONE != view.type) {
+        sensor.lines.push_back({ millimeter_t(0), lineId(Direction::CENTER) });
+    }
+
+    LinePattern pattern = { view.type, view.dir, Direction::CENTER, this->car_.distance };
+
+    // only the leading sensor misdetects the junction it is leaving
+    if (isLeading && CompiledLabyrinthGraph::INVALID_INDEX != view.junc && Sign::POSITIVE == view.dir) {
+        pattern.type = static_cast<LinePattern::type_t>(enum_cast(LinePattern::JUNCTION_1) + this->numDetectedSegments_ - 1);
+    }
+
+    if (pattern.type != sensor.pattern.type || pattern.dir != sensor.pattern.dir) {
+        sensor.pattern = pattern;
+    }
+}
+
+LabyrinthSimulator::Candidates LabyrinthSimulator::nextCandidates() const {
+    const bool isForward = this->motionSign() > 0;
+
+    Candidates result;
+    for (const Direction dir : { Direction::LEFT, Direction::CENTER, Direction::RIGHT }) {
+        for (const index_t c : this->compiledGraph_.edges(this->seg_)) {
+            const CompiledLabyrinthGraph::ConnectionInfo& conn = this->compiledGraph_.connection(c);
+            const index_t newSeg = this->compiledGraph_.getOtherSegment(c, this->seg_);
+
+            if (isForward == this->compiledGraph_.isForwardConnection(this->prevConn_, this->seg_, c) &&
+                conn.directions[conn.segments[0] == newSeg ? 0 : 1] == dir) {
+                result.push_back(c);
+            }
+        }
+    }
+    return result;
+}
+
+void LabyrinthSimulator::passJunction(const index_t conn) {
+    const meter_t length = this->compiledGraph_.segment(this->seg_).length;
+
+    // the new segment is measured from the junction, the car center is still behind it
+    this->pos_              = this->motionSign() > 0 ? this->pos_ - length : -this->pos_;
+    this->isBodyForward_    = this->speed_ > m_per_sec_t(0);
+    this->lastMotionSign_   = 1;
+    this->seg_              = this->compiledGraph_.getOtherSegment(conn, this->seg_);
+    this->prevConn_         = conn;
+    this->maxJunctionSpeed_ = std::max(this->maxJunctionSpeed_, abs(this->speed_));
+    ++this->numJunctions_;
+}
+
+uint8_t LabyrinthSimulator::numSideSegments(const index_t junc, const uint8_t side) const {
+    uint8_t result = 0;
+    for (const Direction dir : { Direction::LEFT, Direction::CENTER, Direction::RIGHT }) {
+        if (CompiledLabyrinthGraph::INVALID_INDEX != this->compiledGraph_.getJunctionSegment(junc, side, dir)) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+uint8_t LabyrinthSimulator::segmentSide(const index_t conn) const {
+    const CompiledLabyrinthGraph::ConnectionInfo& info = this->compiledGraph_.connection(conn);
+    return info.sides[info.segments[0] == this->seg_ ? 0 : 1];
+}
+
+uint8_t LabyrinthSimulator::otherSide(const index_t conn) const {
+    const CompiledLabyrinthGraph::ConnectionInfo& info = this->compiledGraph_.connection(conn);
+    return info.sides[info.segments[0] == this->seg_ ? 1 : 0];
+}
+
+LabyrinthSimulator::index_t LabyrinthSimulator::exitConnection() const {
+    for (const index_t c : this->compiledGraph_.edges(this->seg_)) {
+        if (this->compiledGraph_.isForwardConnection(this->prevConn_, this->seg_, c)) {
+            return c;
+        }
+    }
+    return CompiledLabyrinthGraph::INVALID_INDEX;
+}
+
+int8_t LabyrinthSimulator::motionSign() const {
+    return this->lastMotionSign_;
+}
+
+meter_t LabyrinthSimulator::leadingSensorPos() const {
+    return this->pos_ + cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST / 2 * static_cast<float>(this->motionSign());
+}
+
+meter_t LabyrinthSimulator::trailingSensorPos() const {
+    return this->pos_ - cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST / 2 * static_cast<float>(this->motionSign());
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <micro/utils/CarProps.hpp>
+#include <micro/utils/ControlData.hpp>
+#include <micro/utils/Line.hpp>
+#include <micro/utils/LinePattern.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthGraph.hpp>
+#include <LabyrinthNavigator.hpp>
+
+#include <random>
+#include <vector>
+
+/* @brief Host-side closed-loop kinematic simulator of the car in a labyrinth.
+ *
+ * The car is moved along the segments of the graph, its position and orientation are interpolated between the junctions.
+ * The front and rear line sensors see the line patterns of the geometry:
+ * - JUNCTION_n near a junction, where n is the number of segments on the junction side of the sensor,
+ *   with Sign::NEGATIVE direction when the car is approaching the junction and Sign::POSITIVE when leaving it,
+ * - NONE after the end of a dead-end segment,
+ * - LANE_CHANGE in the middle of the lane change segment,
+ * - SINGLE_LINE otherwise.
+ * The lines of the sensor leading in the direction of motion are ordered from left to right, the lines of the trailing sensor from right to left.
+ *
+ * The loop is closed through the outputs of the navigator: the car speed follows the target speed and ramp time of the control data,
+ * and when the leading sensor passes through a junction, the car takes the segment of the line selected as the main line.
+ * The simulation only depends on the seed, it runs as fast as the host allows.
+ */
+class LabyrinthSimulator {
+public:
+    struct Config {
+        micro::millisecond_t period      = micro::millisecond_t(2);   // The navigator update period.
+        micro::second_t timeout          = micro::second_t(300);      // Maximum mission time.
+        micro::meter_t junctionLength    = micro::centimeter_t(20);   // Length of the junction patterns before and after the junction center.
+        micro::meter_t maxDeadEndOverrun = micro::centimeter_t(30);   // Maximum distance the car may travel after the end of a dead-end segment.
+        micro::meter_t laneChangeLength  = micro::centimeter_t(60);   // Length of the lane change pattern.
+        float odometryDrift              = 0.0f;                      // Standard deviation of the odometry position error, per meter travelled.
+        float misdetectionProbability    = 0.0f;                      // Probability of detecting a wrong number of segments when leaving a junction.
+    };
+
+    /* @brief Mission: the gate segments to visit in the given order, then the lane change segment.
+     */
+    struct Mission {
+        std::vector<const Segment*> targets;
+    };
+
+    struct Result {
+        bool isFinished;                     // Indicates that the navigator has reached the lane change segment after visiting all targets.
+        bool isOffTrack;                     // Indicates that the car has left the track at the end of a dead-end segment.
+        micro::second_t time;                // Mission time.
+        micro::meter_t distance;             // Distance travelled.
+        uint32_t numJunctions;               // Number of junctions passed.
+        uint32_t numMisnavigations;          // Number of junctions after which the car and the navigator were in different segments.
+        micro::m_per_sec_t maxJunctionSpeed; // Maximum speed of the car when passing through a junction.
+    };
+
+    LabyrinthSimulator(const LabyrinthGraph& graph, const Segment& startSeg, const Connection& prevConn, const Segment& laneChangeSeg,
+        const Config& config, const uint32_t seed);
+
+    /* @brief Runs a mission until the navigator finishes, the car leaves the track, or the mission times out.
+     * @param navigator The navigator - must be constructed with the same graph, start segment, previous connection and lane change segment.
+     * @returns The result of the mission - an unfinished empty result if the graph cannot be compiled
+     */
+    Result run(LabyrinthNavigator& navigator, const Mission& mission);
+
+    /* @brief Advances the simulation by one period.
+     */
+    void step(LabyrinthNavigator& navigator);
+
+    const Segment& currentSegment() const;
+
+    /* @brief Gets the status of the graph compilation.
+     */
+    micro::Status status() const { return this->status_; }
+
+    const micro::CarProps& car() const { return this->car_; }
+
+private:
+    typedef CompiledLabyrinthGraph::index_t index_t;
+
+    typedef micro::vec<index_t, CompiledLabyrinthGraph::NUM_DIRECTIONS> Candidates;
+
+    struct SensorView {
+        micro::LinePattern::type_t type;
+        micro::Sign dir;
+        index_t junc;   // The junction of a junction pattern.
+        uint8_t side;   // The junction side of a junction pattern.
+    };
+
+    void updateSpeed();
+
+    void move();
+
+    micro::Pose pose() const;
+
+    SensorView sensorView(const micro::meter_t pos) const;
+
+    void updateSensor(micro::LinesInfo& sensor, const SensorView& view, const bool isLeading) const;
+
+    Candidates nextCandidates() const;
+
+    void passJunction(const index_t conn);
+
+    uint8_t numSideSegments(const index_t junc, const uint8_t side) const;
+
+    uint8_t segmentSide(const index_t conn) const;
+
+    uint8_t otherSide(const index_t conn) const;
+
+    index_t exitConnection() const;
+
+    int8_t motionSign() const;
+
+    micro::meter_t leadingSensorPos() const;
+    micro::meter_t trailingSensorPos() const;
+
+    const LabyrinthGraph& graph_;
+    CompiledLabyrinthGraph compiledGraph_;
+    micro::Status status_;          // The status of the graph compilation.
+    const index_t laneChangeSeg_;
+    const Config config_;
+    std::mt19937 random_;
+
+    index_t prevConn_;              // The connection the current segment was entered through.
+    index_t seg_;                   // The current segment.
+    micro::meter_t pos_;            // Position of the car center in the segment, measured from the end of the previous connection.
+    bool isBodyForward_;            // Indicates that the front of the car faces the far end of the segment.
+    micro::m_per_sec_t speed_;      // The car speed, positive when going forward.
+    micro::m_per_sec_t targetSpeed_;
+    micro::m_per_sec_t speedStep_;  // Absolute value of the speed change in one period during the current speed ramp.
+    int8_t lastMotionSign_;         // Motion direction in the segment when the car last moved.
+    uint8_t numDetectedSegments_;   // Number of segments detected when leaving the last junction, differs from the real number after a misdetection.
+
+    micro::point2m odometryError_;
+    micro::CarProps car_;
+    micro::LineInfo lineInfo_;
+    micro::MainLine mainLine_;
+    micro::ControlData controlData_;
+    micro::second_t time_;
+    uint32_t numJunctions_;
+    uint32_t numMisnavigations_;
+    micro::m_per_sec_t maxJunctionSpeed_;
+    bool isOffTrack_;
+};
@@ -0,0 +1,56 @@
+#include "LatencyHistogramDecoder.hpp"
+
+#include <cstdlib>
+
+using namespace micro;
+
+namespace {
+
+bool findValue(const std::string& params, const std::string& name, double& value) {
+    const std::string key = "\"" + name + "\"";
+
+    size_t pos = params.find(key);
+    if (std::string::npos == pos) {
+        return false;
+    }
+
+    pos = params.find_first_not_of(" \t", pos + key.size());
+    if (std::string::npos == pos || ':' != params[pos]) {
+        return false;
+    }
+
+    const char * const begin = params.c_str() + pos + 1;
+    char *end = nullptr;
+    value = std::strtod(begin, &end);
+    return end != begin;
+}
+
+} // namespace
+
+const LatencyHistogramDecoder::Stage LatencyHistogramDecoder::STAGES[NUM_STAGES] = {
+    { "lineDec",  "line rx -> decision" },
+    { "gyroDec",  "gyro read -> decision" },
+    { "decSend",  "decision -> send" },
+    { "lineSend", "line rx -> send" }
+};
+
+bool LatencyHistogramDecoder::decode(const std::string& params, const char *name, LatencyHistogram& result) {
+    LatencyHistogram histogram;
+
+    for (uint32_t bin = 0; bin < LatencyHistogram::NUM_BINS; ++bin) {
+        double count = 0.0;
+        if (!findValue(params, name + std::to_string(bin), count) || count < 0.0) {
+            return false;
+        }
+        histogram.count(bin) = static_cast<uint32_t>(count);
+    }
+
+    double max = 0.0;
+    if (!findValue(params, std::string(name) + "Max", max)) {
+        return false;
+    }
+    histogram.max() = microsecond_t(static_cast<float>(max));
+
+    result = histogram;
+    return true;
+}
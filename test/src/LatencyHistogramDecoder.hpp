@@ -0,0 +1,30 @@
+#pragma once
+
+#include <LatencyHistogram.hpp>
+
+#include <string>
+
+/* @brief Host-side decoder of the latency histograms the car sends through the debug channel.
+ * The params are serialized as a flat JSON object of name-value pairs. A histogram is sent as its bin counts and maximum,
+ * as the params <name>0 ... <name>7 and <name>Max, @see LatencyHistogram
+ */
+class LatencyHistogramDecoder {
+public:
+    struct Stage {
+        const char *name;   // Name of the registered histogram params.
+        const char *label;  // Description of the pipeline stage.
+    };
+
+    static constexpr uint32_t NUM_STAGES = 4;
+
+    // the pipeline stages the control task measures, in the order of the registration
+    static const Stage STAGES[NUM_STAGES];
+
+    /* @brief Decodes a histogram from the serialized params.
+     * @param params The serialized params
+     * @param name The name of the histogram params
+     * @param result The decoded histogram
+     * @returns true if all the bin counts and the maximum have been found
+     */
+    static bool decode(const std::string& params, const char *name, LatencyHistogram& result);
+};
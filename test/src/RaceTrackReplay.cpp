@@ -0,0 +1,239 @@
+#include <micro/math/numeric.hpp>
+
+#include "RaceTrackReplay.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <string>
+
+using namespace micro;
+
+namespace {
+
+constexpr const char *LOG_HEADER   = "race_track_log";
+constexpr const char *TRACE_HEADER = "race_track_trace";
+
+void writeSensor(std::ostream& out, const LinesInfo& sensor) {
+    out << ' ' << static_cast<int>(sensor.pattern.type)
+        << ' ' << static_cast<int>(sensor.pattern.dir)
+        << ' ' << static_cast<int>(sensor.pattern.side)
+        << ' ' << sensor.pattern.startDist.get()
+        << ' ' << sensor.lines.size();
+
+    for (const Line& line : sensor.lines) {
+        out << ' ' << line.pos.get() << ' ' << static_cast<int>(line.id);
+    }
+}
+
+bool readSensor(std::istream& in, LinesInfo& sensor) {
+    int type = 0, dir = 0, side = 0;
+    float startDist = 0.0f;
+    uint32_t numLines = 0;
+    if (!(in >> type >> dir >> side >> startDist >> numLines) || numLines > sensor.lines.capacity()) {
+        return false;
+    }
+
+    sensor.pattern.type      = static_cast<LinePattern::type_t>(type);
+    sensor.pattern.dir       = static_cast<Sign>(dir);
+    sensor.pattern.side      = static_cast<Direction>(side);
+    sensor.pattern.startDist = meter_t(startDist);
+
+    sensor.lines.clear();
+    for (uint32_t i = 0; i < numLines; ++i) {
+        float pos = 0.0f;
+        int id = 0;
+        if (!(in >> pos >> id)) {
+            return false;
+        }
+        sensor.lines.push_back({ millimeter_t(pos), static_cast<uint8_t>(id) });
+    }
+    return true;
+}
+
+bool readHeader(std::istream& in, const char *expected) {
+    std::string header;
+    return (in >> header) && header == expected;
+}
+
+bool equals(const RaceTrackReplay::TraceRow& row, const RaceTrackReplay::TraceRow& golden, const RaceTrackReplay::Tolerances& tolerances) {
+    const ControlData& a = row.controlData;
+    const ControlData& b = golden.controlData;
+
+    return row.programState == golden.programState                                                      &&
+           a.rampTime == b.rampTime                                                                     &&
+           a.rearSteerEnabled == b.rearSteerEnabled                                                     &&
+           abs(a.speed - b.speed) <= tolerances.speed                                                   &&
+           abs(a.lineControl.actual.pos - b.lineControl.actual.pos) <= tolerances.linePos               &&
+           abs(a.lineControl.actual.angle - b.lineControl.actual.angle) <= tolerances.lineAngle         &&
+           abs(a.lineControl.target.pos - b.lineControl.target.pos) <= tolerances.linePos               &&
+           abs(a.lineControl.target.angle - b.lineControl.target.angle) <= tolerances.lineAngle         &&
+           std::abs(row.curvature - golden.curvature) <= tolerances.curvature;
+}
+
+} // namespace
+
+RaceTrackReplay::RaceTrackReplay(const TrackSegments& segments, const TrackProfile& profile)
+    : segments_(segments)
+    , profile_(profile) {}
+
+RaceTrackReplay::Trace RaceTrackReplay::run(const Log& log) const {
+    // the program is allocated on the heap because of the size of its track map
+    const std::unique_ptr<RaceTrackProgram> program(new RaceTrackProgram(this->segments_, this->profile_));
+
+    Trace trace;
+    trace.reserve(log.frames.size());
+
+    cfg::ProgramState programState = log.programState;
+    RaceTrackProgram::Output output;
+
+    for (uint32_t i = 0; i < log.frames.size(); ++i) {
+        const Frame& frame = log.frames[i];
+        if (program->step({ programState, frame.time, frame.car, frame.lineInfo, frame.distances, log.safetyCarFollowSpeedSign, log.testSpeed }, output)) {
+            trace.push_back({ i, programState, output.controlData, output.curvature });
+            programState = output.programState;
+        }
+    }
+
+    return trace;
+}
+
+RaceTrackReplay::DiffResult RaceTrackReplay::diff(const Trace& trace, const Trace& golden) {
+    return diff(trace, golden, Tolerances());
+}
+
+RaceTrackReplay::DiffResult RaceTrackReplay::diff(const Trace& trace, const Trace& golden, const Tolerances& tolerances) {
+    DiffResult result = { static_cast<uint32_t>(golden.size()), 0, 0 };
+
+    Trace::const_iterator it = trace.begin();
+    for (const TraceRow& goldenRow : golden) {
+        it = std::lower_bound(it, trace.end(), goldenRow.frame, [](const TraceRow& row, const uint32_t frame) {
+            return row.frame < frame;
+        });
+
+        if (it == trace.end() || it->frame != goldenRow.frame || !equals(*it, goldenRow, tolerances)) {
+            if (0 == result.numMismatches++) {
+                result.firstMismatch = goldenRow.frame;
+            }
+        }
+    }
+
+    return result;
+}
+
+void RaceTrackReplay::write(std::ostream& out, const Log& log) {
+    out << std::setprecision(std::numeric_limits<float>::max_digits10);
+    out << LOG_HEADER << ' ' << static_cast<int>(enum_cast(log.programState))
+        << ' ' << static_cast<int>(log.safetyCarFollowSpeedSign)
+        << ' ' << log.testSpeed.get()
+        << ' ' << log.frames.size() << '\n';
+
+    for (const Frame& frame : log.frames) {
+        out << frame.time.get()
+            << ' ' << frame.car.pose.pos.X.get()
+            << ' ' << frame.car.pose.pos.Y.get()
+            << ' ' << frame.car.pose.angle.get()
+            << ' ' << frame.car.speed.get()
+            << ' ' << frame.car.distance.get()
+            << ' ' << frame.car.orientedDistance.get();
+
+        writeSensor(out, frame.lineInfo.front);
+        writeSensor(out, frame.lineInfo.rear);
+
+        out << ' ' << frame.distances.front.get() << ' ' << frame.distances.rear.get() << '\n';
+    }
+}
+
+bool RaceTrackReplay::read(std::istream& in, Log& log) {
+    int programState = 0, sign = 0;
+    float testSpeed = 0.0f;
+    uint32_t numFrames = 0;
+    if (!readHeader(in, LOG_HEADER) || !(in >> programState >> sign >> testSpeed >> numFrames)) {
+        return false;
+    }
+
+    log.programState             = static_cast<cfg::ProgramState>(programState);
+    log.safetyCarFollowSpeedSign = static_cast<Sign>(sign);
+    log.testSpeed                = m_per_sec_t(testSpeed);
+    log.frames.resize(numFrames);
+
+    for (Frame& frame : log.frames) {
+        float time = 0.0f, x = 0.0f, y = 0.0f, angle = 0.0f, speed = 0.0f, distance = 0.0f, orientedDistance = 0.0f;
+        if (!(in >> time >> x >> y >> angle >> speed >> distance >> orientedDistance)) {
+            return false;
+        }
+
+        frame.time                  = millisecond_t(time);
+        frame.car.pose.pos.X        = meter_t(x);
+        frame.car.pose.pos.Y        = meter_t(y);
+        frame.car.pose.angle        = radian_t(angle);
+        frame.car.speed             = m_per_sec_t(speed);
+        frame.car.distance          = meter_t(distance);
+        frame.car.orientedDistance  = meter_t(orientedDistance);
+
+        float front = 0.0f, rear = 0.0f;
+        if (!readSensor(in, frame.lineInfo.front) || !readSensor(in, frame.lineInfo.rear) || !(in >> front >> rear)) {
+            return false;
+        }
+
+        frame.distances.front = meter_t(front);
+        frame.distances.rear  = meter_t(rear);
+    }
+
+    return true;
+}
+
+void RaceTrackReplay::write(std::ostream& out, const Trace& trace, const uint32_t decimation) {
+    std::vector<const TraceRow*> rows;
+    for (uint32_t i = 0; i < trace.size(); ++i) {
+        if (0 == i % decimation || trace[i].programState != trace[i - 1].programState) {
+            rows.push_back(&trace[i]);
+        }
+    }
+
+    out << std::setprecision(std::numeric_limits<float>::max_digits10);
+    out << TRACE_HEADER << ' ' << rows.size() << '\n';
+
+    for (const TraceRow *row : rows) {
+        const ControlData& controlData = row->controlData;
+        out << row->frame
+            << ' ' << static_cast<int>(enum_cast(row->programState))
+            << ' ' << controlData.speed.get()
+            << ' ' << controlData.rampTime.get()
+            << ' ' << static_cast<int>(controlData.rearSteerEnabled)
+            << ' ' << controlData.lineControl.actual.pos.get()
+            << ' ' << controlData.lineControl.actual.angle.get()
+            << ' ' << controlData.lineControl.target.pos.get()
+            << ' ' << controlData.lineControl.target.angle.get()
+            << ' ' << row->curvature << '\n';
+    }
+}
+
+bool RaceTrackReplay::read(std::istream& in, Trace& trace) {
+    uint32_t numRows = 0;
+    if (!readHeader(in, TRACE_HEADER) || !(in >> numRows)) {
+        return false;
+    }
+
+    trace.resize(numRows);
+    for (TraceRow& row : trace) {
+        int programState = 0, rearSteerEnabled = 0;
+        float speed = 0.0f, rampTime = 0.0f, actualPos = 0.0f, actualAngle = 0.0f, targetPos = 0.0f, targetAngle = 0.0f;
+        if (!(in >> row.frame >> programState >> speed >> rampTime >> rearSteerEnabled >> actualPos >> actualAngle >> targetPos >> targetAngle >> row.curvature)) {
+            return false;
+        }
+
+        row.programState                          = static_cast<cfg::ProgramState>(programState);
+        row.controlData.speed                     = m_per_sec_t(speed);
+        row.controlData.rampTime                  = millisecond_t(rampTime);
+        row.controlData.rearSteerEnabled          = 0 != rearSteerEnabled;
+        row.controlData.lineControl.actual.pos    = millimeter_t(actualPos);
+        row.controlData.lineControl.actual.angle  = radian_t(actualAngle);
+        row.controlData.lineControl.target.pos    = millimeter_t(targetPos);
+        row.controlData.lineControl.target.angle  = radian_t(targetAngle);
+    }
+
+    return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <micro/utils/CarProps.hpp>
+#include <micro/utils/ControlData.hpp>
+#include <micro/utils/Line.hpp>
+#include <micro/utils/LinePattern.hpp>
+
+#include <cfg_track.hpp>
+#include <Distances.hpp>
+#include <RaceTrackProgram.hpp>
+#include <track.hpp>
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/* @brief Host-side deterministic replay of the race track program.
+ *
+ * A log is the stream of the race track task inputs recorded on the car: the time, the car properties, the line info
+ * and the distances of each step. The replay feeds the frames of the log to a new RaceTrackProgram as fast as the host allows,
+ * and records the outputs in a trace. The program state is closed-loop: the first frame is processed in the recorded start state,
+ * the next ones in the state requested by the previous step - the same way the system manager applies the requested states on the car.
+ *
+ * The trace can be compared to a golden trace, e.g. one written by a previous version of the program. The golden trace may be decimated,
+ * its rows are matched to the trace by the frame index. The control values are compared with tolerances, so that traces
+ * recorded with a different floating-point implementation (e.g. on the car) can be used as well.
+ *
+ * Both the logs and the traces are written as text, one frame per line, with enough digits to read back the same values.
+ * The logs contain the car properties used by the race track logic: the pose, the speed, the distance and the oriented distance.
+ */
+class RaceTrackReplay {
+public:
+    struct Frame {
+        micro::millisecond_t time;      // Time of the step.
+        micro::CarProps car;            // The car properties.
+        micro::LineInfo lineInfo;       // The line info.
+        Distances distances;            // The distances from the obstacles in front of and behind the car.
+    };
+
+    struct Log {
+        cfg::ProgramState programState;         // Program state of the first frame.
+        micro::Sign safetyCarFollowSpeedSign;   // Speed sign of the car in the safety car laps.
+        micro::m_per_sec_t testSpeed;           // Target speed of the test state.
+        std::vector<Frame> frames;
+    };
+
+    struct TraceRow {
+        uint32_t frame;                     // Index of the frame in the log.
+        cfg::ProgramState programState;     // The program state the frame has been processed in.
+        micro::ControlData controlData;     // The control data output.
+        float curvature;                    // The curvature feed-forward output [1/m].
+    };
+
+    typedef std::vector<TraceRow> Trace;
+
+    struct Tolerances {
+        micro::m_per_sec_t speed    = micro::m_per_sec_t(0.001f);  // Maximum difference of the target speeds.
+        micro::millimeter_t linePos = micro::millimeter_t(0.1f);   // Maximum difference of the line positions.
+        micro::radian_t lineAngle   = micro::radian_t(0.0001f);    // Maximum difference of the line angles.
+        float curvature             = 0.0001f;                     // Maximum difference of the curvature feed-forwards [1/m].
+    };
+
+    struct DiffResult {
+        uint32_t numCompared;       // Number of the golden rows.
+        uint32_t numMismatches;     // Number of the golden rows that are missing from the trace or differ from it.
+        uint32_t firstMismatch;     // Frame index of the first mismatching golden row, only valid if there is a mismatch.
+    };
+
+    RaceTrackReplay(const TrackSegments& segments, const TrackProfile& profile);
+
+    /* @brief Replays a log with a new race track program.
+     * @param log The log
+     * @returns The trace, one row for each frame that has been processed in a race track program state
+     */
+    Trace run(const Log& log) const;
+
+    /* @brief Compares a trace to a golden trace with the default tolerances.
+     */
+    static DiffResult diff(const Trace& trace, const Trace& golden);
+
+    /* @brief Compares a trace to a golden trace.
+     * @param trace The trace
+     * @param golden The golden trace, its rows ordered by the frame index
+     * @param tolerances The tolerances of the control values - the program states, ramp times and rear steer flags must be equal
+     */
+    static DiffResult diff(const Trace& trace, const Trace& golden, const Tolerances& tolerances);
+
+    static void write(std::ostream& out, const Log& log);
+    static bool read(std::istream& in, Log& log);
+
+    /* @brief Writes a trace.
+     * @param out The output stream
+     * @param trace The trace
+     * @param decimation Every n-th row is written, and all the rows where the program state changes
+     */
+    static void write(std::ostream& out, const Trace& trace, const uint32_t decimation = 1);
+    static bool read(std::istream& in, Trace& trace);
+
+private:
+    const TrackSegments& segments_;
+    const TrackProfile& profile_;
+};
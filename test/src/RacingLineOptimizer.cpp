@@ -0,0 +1,430 @@
+#include <micro/math/numeric.hpp>
+
+#include <LapLearner.hpp>
+#include <RacingLineOptimizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+using namespace micro;
+
+namespace {
+
+constexpr uint32_t MAX_ACTIVE_SET_ITERATIONS   = 100;
+constexpr uint32_t MIN_NUM_POINTS              = 8;
+constexpr float    BRAKE_SPEED_TOLERANCE       = 0.01f;  // Speed drop that indicates braking in the speed profile [m/s].
+
+/* @brief Solves a symmetric positive definite linear system with envelope (skyline) Cholesky decomposition, in place.
+ * The entries of row i before column first[i] must be zero - the decomposition keeps this envelope,
+ * so a banded matrix with a few dense rows at the end is decomposed in linear time.
+ * @param a The row-major n x n matrix, the lower triangle is overwritten by the decomposition
+ * @param first The first non-zero column of each row
+ * @param b The right-hand side, overwritten by the solution
+ * @param n The size of the system
+ * @returns True if the matrix is positive definite
+ */
+bool envelopeCholeskySolve(std::vector<double>& a, const std::vector<size_t>& first, std::vector<double>& b, const size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = first[i]; j <= i; ++j) {
+            double s = a[i * n + j];
+            for (size_t k = std::max(first[i], first[j]); k < j; ++k) {
+                s -= a[i * n + k] * a[j * n + k];
+            }
+
+            if (j < i) {
+                a[i * n + j] = s / a[j * n + j];
+            } else if (s > 0.0) {
+                a[i * n + i] = std::sqrt(s);
+            } else {
+                return false;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = first[i]; k < i; ++k) {
+            b[i] -= a[i * n + k] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+
+    for (size_t i = n; i-- > 0;) {
+        b[i] /= a[i * n + i];
+        for (size_t k = first[i]; k < i; ++k) {
+            b[k] -= a[i * n + k] * b[i];
+        }
+    }
+
+    return true;
+}
+
+/* @brief Gets the heading of the line at the given distance, interpolated between the map samples.
+ */
+float heading(const TrackMap& map, const meter_t dist) {
+    const uint32_t idx   = std::min(static_cast<uint32_t>(std::max(dist / TrackMap::SAMPLE_DIST, 0.0f)), map.size() - 2);
+    const meter_t start  = TrackMap::SAMPLE_DIST * static_cast<float>(idx);
+    const float ratio    = (dist - start) / TrackMap::SAMPLE_DIST;
+    const radian_t a0    = map.at(start + TrackMap::SAMPLE_DIST / 2).pose.angle;
+    const radian_t a1    = map.at(start + TrackMap::SAMPLE_DIST * 1.5f).pose.angle;
+    return a0.get() + normalizePM180(a1 - a0).get() * ratio;
+}
+
+size_t prevIdx(const size_t i, const size_t n) { return i > 0 ? i - 1 : n - 1; }
+size_t nextIdx(const size_t i, const size_t n) { return i + 1 < n ? i + 1 : 0; }
+
+} // namespace
+
+RacingLineOptimizer::RacingLineOptimizer()
+    : RacingLineOptimizer(Options()) {}
+
+RacingLineOptimizer::RacingLineOptimizer(const Options& options)
+    : options_(options)
+    , lapTime_(0)
+    , pointDist_(0) {}
+
+Status RacingLineOptimizer::optimize(const TrackMap& map, const TrackSegments& segments) {
+    this->points_.clear();
+    this->segments_.clear();
+    this->brakeOffsets_.clear();
+    this->lapTime_ = second_t(0);
+
+    if (map.size() < 2 || map.length() < this->options_.pointDist * static_cast<float>(MIN_NUM_POINTS) || segments.empty()) {
+        return Status::INVALID_DATA;
+    }
+
+    this->resample(map);
+
+    std::vector<double> offsets(this->points_.size(), 0.0);
+    std::vector<Point> candidate = this->points_;
+    this->lapTime_ = micro::numeric_limits<second_t>::infinity();
+
+    // the first race line is the minimum curvature one, the length weight grows geometrically in the next ones
+    for (uint32_t i = 0; i < this->options_.numLengthWeights; ++i) {
+        const float lengthWeight = i > 0 ? this->options_.minLengthWeight * std::pow(this->options_.lengthWeightRatio, static_cast<float>(i - 1)) : 0.0f;
+
+        this->optimizeOffsets(lengthWeight, offsets);
+        const second_t lapTime = this->updateSpeeds(offsets, candidate);
+
+        if (lapTime < this->lapTime_) {
+            this->lapTime_ = lapTime;
+            this->points_.swap(candidate);
+        }
+    }
+
+    this->summarize(segments);
+    return Status::OK;
+}
+
+void RacingLineOptimizer::resample(const TrackMap& map) {
+    const meter_t length = map.length();
+    const size_t n = std::max(static_cast<size_t>(std::lround(length / this->options_.pointDist)), static_cast<size_t>(MIN_NUM_POINTS));
+    this->pointDist_ = length / static_cast<float>(n);
+
+    // the map is a closed loop, the curvatures around the start and the end are calculated across the seam
+    const auto wrap = [length](const meter_t dist) {
+        return dist < meter_t(0) ? dist + length : dist > length ? dist - length : dist;
+    };
+
+    this->points_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const meter_t dist = this->pointDist_ * static_cast<float>(i);
+        const float before = heading(map, wrap(dist - this->pointDist_ / 2));
+        const float after  = heading(map, wrap(dist + this->pointDist_ / 2));
+
+        Point& point        = this->points_[i];
+        point.dist          = dist;
+        point.lineCurvature = normalizePM180(radian_t(after - before)).get() / this->pointDist_.get();
+        point.offset        = meter_t(0);
+        point.curvature     = point.lineCurvature;
+        point.speed         = m_per_sec_t(0);
+    }
+}
+
+void RacingLineOptimizer::optimizeOffsets(const float lengthWeight, std::vector<double>& offsets) const {
+    const size_t n         = this->points_.size();
+    const double h         = this->pointDist_.get();
+    const double maxOffset = this->options_.maxOffset.get();
+
+    // path curvature: c = k + M * n, where M = D / h^2 + diag(k^2), D being the cyclic second difference operator
+    // path length: sum(h * (1 - k * n) + (dn)^2 / (2 * h)), the second order approximation of the lateral moves
+    // objective: sum(h * c^2) + wl * length + eps * sum(n^2) = 1/2 * n' * A * n + g' * n + const
+    std::vector<double> A(n * n, 0.0), g(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        const double k = this->points_[i].lineCurvature;
+        const size_t next     = nextIdx(i, n);
+        const size_t cols[3]  = { prevIdx(i, n), i, next };
+        const double coefs[3] = { 1.0 / (h * h), -2.0 / (h * h) + k * k, 1.0 / (h * h) };
+
+        for (uint32_t a = 0; a < 3; ++a) {
+            for (uint32_t b = 0; b < 3; ++b) {
+                A[cols[a] * n + cols[b]] += 2.0 * h * coefs[a] * coefs[b];
+            }
+            g[cols[a]] += 2.0 * h * coefs[a] * k;
+        }
+
+        A[i * n + i]       += lengthWeight / h + 2.0 * this->options_.offsetWeight;
+        A[next * n + next] += lengthWeight / h;
+        A[i * n + next]    -= lengthWeight / h;
+        A[next * n + i]    -= lengthWeight / h;
+        g[i]               -= lengthWeight * h * k;
+    }
+
+    // primal-dual active set method, the state of a point is -1 (lower bound), 0 (free) or 1 (upper bound)
+    std::vector<int8_t> state(n, 0), newState(n, 0);
+    std::vector<size_t> freeIdx, first;
+    std::vector<double> reduced, rhs;
+    freeIdx.reserve(n);
+
+    for (uint32_t iter = 0; iter < MAX_ACTIVE_SET_ITERATIONS; ++iter) {
+        freeIdx.clear();
+        for (size_t i = 0; i < n; ++i) {
+            if (state[i]) {
+                offsets[i] = state[i] * maxOffset;
+            } else {
+                freeIdx.push_back(i);
+            }
+        }
+
+        const size_t m = freeIdx.size();
+        reduced.assign(m * m, 0.0);
+        rhs.assign(m, 0.0);
+        first.assign(m, 0);
+        for (size_t r = 0; r < m; ++r) {
+            const size_t i = freeIdx[r];
+            rhs[r]   = -g[i];
+            first[r] = r;
+            for (size_t j = 0; j < n; ++j) {
+                if (state[j]) {
+                    rhs[r] -= A[i * n + j] * offsets[j];
+                }
+            }
+            for (size_t c = 0; c <= r; ++c) {
+                reduced[r * m + c] = A[i * n + freeIdx[c]];
+                if (reduced[r * m + c] != 0.0) {
+                    first[r] = std::min(first[r], c);
+                }
+            }
+        }
+
+        if (!envelopeCholeskySolve(reduced, first, rhs, m)) {
+            break;
+        }
+
+        for (size_t r = 0; r < m; ++r) {
+            offsets[freeIdx[r]] = rhs[r];
+        }
+
+        // the bounded points are released when their multipliers change sign, the free points are bounded when they violate the bounds
+        for (size_t i = 0; i < n; ++i) {
+            if (state[i]) {
+                double gradient = g[i];
+                for (const size_t j : { prevIdx(prevIdx(i, n), n), prevIdx(i, n), i, nextIdx(i, n), nextIdx(nextIdx(i, n), n) }) {
+                    gradient += A[i * n + j] * offsets[j];
+                }
+                newState[i] = state[i] * gradient < 0.0 ? state[i] : 0;
+            } else {
+                newState[i] = offsets[i] > maxOffset ? 1 : offsets[i] < -maxOffset ? -1 : 0;
+            }
+        }
+
+        if (newState == state) {
+            break;
+        }
+        state.swap(newState);
+    }
+
+    for (double& offset : offsets) {
+        offset = clamp(offset, -maxOffset, maxOffset);
+    }
+}
+
+second_t RacingLineOptimizer::updateSpeeds(const std::vector<double>& offsets, std::vector<Point>& points) const {
+    const size_t n  = points.size();
+    const float h   = this->pointDist_.get();
+    std::vector<float> stepDists(n);
+
+    size_t minIdx = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const float k      = points[i].lineCurvature;
+        const float offset = static_cast<float>(offsets[i]);
+        const float next   = static_cast<float>(offsets[nextIdx(i, n)]);
+
+        Point& point    = points[i];
+        point.offset    = meter_t(offset);
+        point.curvature = k + k * k * offset + static_cast<float>(offsets[prevIdx(i, n)] - 2.0 * offsets[i] + offsets[nextIdx(i, n)]) / (h * h);
+
+        const float maxCurveSpeed = std::sqrt(this->options_.maxLateralAcceleration / std::max(std::abs(point.curvature), 1e-6f));
+        point.speed = std::min(this->options_.maxSpeed, m_per_sec_t(maxCurveSpeed));
+
+        // the path is shorter on the inside of the bends, and longer when the car moves sideways
+        const float longitudinal = h * (1.0f - 0.5f * (offset + next) * k);
+        stepDists[i] = std::sqrt(longitudinal * longitudinal + (next - offset) * (next - offset));
+
+        if (point.speed < points[minIdx].speed) {
+            minIdx = i;
+        }
+    }
+
+    // the slowest point cannot be limited by the acceleration or the deceleration, so the passes start there
+    for (size_t s = 0, i = minIdx; s < n; ++s, i = nextIdx(i, n)) {
+        const size_t next = nextIdx(i, n);
+        const float v = points[i].speed.get();
+        points[next].speed = std::min(points[next].speed, m_per_sec_t(std::sqrt(v * v + 2.0f * this->options_.maxAcceleration * stepDists[i])));
+    }
+
+    for (size_t s = 0, i = minIdx; s < n; ++s, i = prevIdx(i, n)) {
+        const size_t prev = prevIdx(i, n);
+        const float v = points[i].speed.get();
+        points[prev].speed = std::min(points[prev].speed, m_per_sec_t(std::sqrt(v * v + 2.0f * this->options_.maxDeceleration * stepDists[prev])));
+    }
+
+    second_t lapTime(0);
+    for (size_t i = 0; i < n; ++i) {
+        lapTime += meter_t(stepDists[i]) / ((points[i].speed + points[nextIdx(i, n)].speed) / 2);
+    }
+    return lapTime;
+}
+
+void RacingLineOptimizer::summarize(const TrackSegments& segments) {
+    const size_t n        = this->points_.size();
+    const meter_t length  = this->pointDist_ * static_cast<float>(n);
+
+    meter_t segmentsLength(0);
+    for (const TrackSegment& seg : segments) {
+        segmentsLength += seg.length;
+    }
+    const float scale = length / segmentsLength;
+
+    const auto offsetAt = [this, n, length](meter_t dist) {
+        dist = dist < meter_t(0) ? dist + length : dist >= length ? dist - length : dist;
+        const size_t idx  = std::min(static_cast<size_t>(dist / this->pointDist_), n - 1);
+        const float ratio = (dist - this->points_[idx].dist) / this->pointDist_;
+        return this->points_[idx].offset + (this->points_[nextIdx(idx, n)].offset - this->points_[idx].offset) * ratio;
+    };
+
+    // the line position is the negative of the offset, the line angle is the angle of the line relative to the car
+    const auto linePosAt = [&offsetAt](const meter_t dist) {
+        return millimeter_t(-offsetAt(dist));
+    };
+
+    // the control task limits the target line angle, so does the race line
+    const auto lineAngleAt = [this, &offsetAt](const meter_t dist) {
+        const meter_t halfDist = this->pointDist_ / 2;
+        const radian_t angle = radian_t(std::atan(-(offsetAt(dist + halfDist) - offsetAt(dist - halfDist)) / this->pointDist_));
+        return clamp(angle, -cfg::MAX_TARGET_LINE_ANGLE, cfg::MAX_TARGET_LINE_ANGLE);
+    };
+
+    const LapLearner learner(segments);
+
+    meter_t start(0);
+    for (uint32_t s = 0; s < segments.size(); ++s) {
+        const TrackSegment& seg = segments[s];
+        const meter_t end = start + seg.length * scale;
+
+        SegmentResult result;
+        result.isFast      = seg.isFast;
+        result.section     = learner.sectionIndex(s);
+        result.speed       = seg.isFast ? m_per_sec_t(0) : this->options_.maxSpeed;
+        result.brakeOffset = meter_t(0);
+
+        for (const Point& point : this->points_) {
+            if (point.dist >= start && point.dist < end) {
+                result.speed = seg.isFast ? std::max(result.speed, point.speed) : std::min(result.speed, point.speed);
+            }
+        }
+
+        const meter_t middle = (start + end) / 2;
+        result.raceLine.pos   = track_pos_pyramid(linePosAt(middle), linePosAt(end));
+        result.raceLine.angle = track_angle_pyramid(lineAngleAt(middle), lineAngleAt(end));
+
+        this->segments_.push_back(result);
+        start = end;
+    }
+
+    // the brake segments keep the fast speed until the speed profile starts decreasing below it
+    this->brakeOffsets_.assign(MAX_NUM_TRACK_SECTIONS, meter_t(0));
+
+    start = meter_t(0);
+    for (uint32_t s = 0; s < segments.size(); ++s) {
+        const meter_t end = start + segments[s].length * scale;
+
+        if (TrackTrigger::BrakeSign == segments[s].trigger) {
+            const m_per_sec_t fastSpeed = this->segments_[s > 0 ? s - 1 : segments.size() - 1].speed;
+            meter_t brakeOffset = end - start;
+
+            for (const Point& point : this->points_) {
+                if (point.dist >= start && point.dist < end && point.speed < fastSpeed - m_per_sec_t(BRAKE_SPEED_TOLERANCE)) {
+                    brakeOffset = std::max(point.dist - start, meter_t(0));
+                    break;
+                }
+            }
+
+            this->segments_[s].brakeOffset = brakeOffset;
+            this->brakeOffsets_[this->segments_[s].section] = brakeOffset;
+        }
+
+        start = end;
+    }
+}
+
+void RacingLineOptimizer::writeSource(std::ostream& out, const std::string& name) const {
+    // the constants are named after the sections, the slow segments are numbered within their section
+    std::vector<std::string> lineNames;
+    uint32_t slowIdx = 0;
+    for (uint32_t s = 0; s < this->segments_.size(); ++s) {
+        const SegmentResult& seg = this->segments_[s];
+        slowIdx = seg.isFast ? 0 : slowIdx + 1;
+        lineNames.push_back(seg.isFast ?
+            "LINE_FAST" + std::to_string(seg.section + 1) + "_RACE" :
+            "LINE_SLOW" + std::to_string(seg.section + 1) + "_" + std::to_string(slowIdx) + "_RACE");
+    }
+
+    size_t nameWidth = 0;
+    for (const std::string& lineName : lineNames) {
+        nameWidth = std::max(nameWidth, lineName.length());
+    }
+
+    char buffer[200];
+
+    snprintf(buffer, sizeof(buffer), "// Race lines of the %s track, optimized for a lap time of %.3f s.\n", name.c_str(), this->lapTime_.get());
+    out << buffer;
+
+    for (uint32_t s = 0; s < this->segments_.size(); ++s) {
+        const TrackLineProfile& line = this->segments_[s].raceLine;
+        snprintf(buffer, sizeof(buffer), "constexpr TrackLineProfile %-*s = { track_pos_pyramid(millimeter_t(%d), millimeter_t(%d)), track_angle_pyramid(degree_t(%.1ff), degree_t(%.1ff)) };\n",
+            static_cast<int>(nameWidth), lineNames[s].c_str(),
+            static_cast<int>(std::lround(line.pos.middle.get())), static_cast<int>(std::lround(line.pos.end.get())),
+            static_cast<degree_t>(line.angle.middle).get(), static_cast<degree_t>(line.angle.end).get());
+        out << buffer;
+    }
+
+    out << "\n"
+        << "// raceLine column of the segment table\n";
+
+    for (uint32_t s = 0; s < this->segments_.size(); ++s) {
+        out << "//  " << lineNames[s] << (s + 1 < this->segments_.size() ? "," : "") << '\n';
+    }
+
+    out << "\n"
+        << "// speeds\n"
+        << "    {";
+
+    for (uint32_t s = 0; s < this->segments_.size(); ++s) {
+        snprintf(buffer, sizeof(buffer), " { %.2ff }%s", std::floor(this->segments_[s].speed.get() * 100.0f) / 100.0f, s + 1 < this->segments_.size() ? "," : "");
+        out << buffer;
+    }
+
+    out << " }, // Optimized\n"
+        << "\n"
+        << "// brake offsets\n"
+        << "    {";
+
+    for (uint32_t s = 0; s < this->brakeOffsets_.size(); ++s) {
+        snprintf(buffer, sizeof(buffer), " centimeter_t(%d)%s", static_cast<int>(centimeter_t(this->brakeOffsets_[s]).get()), s + 1 < this->brakeOffsets_.size() ? "," : "");
+        out << buffer;
+    }
+
+    out << " }, // Optimized\n";
+}
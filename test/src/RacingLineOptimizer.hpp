@@ -0,0 +1,106 @@
+#pragma once
+
+#include <micro/utils/units.hpp>
+
+#include <cfg_car.hpp>
+#include <cfg_track.hpp>
+#include <TrackMap.hpp>
+#include <track.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* @brief Host-side minimum-time race line optimizer of the race track.
+ *
+ * The input is a recorded track map (the curvature of the line versus the distance) and the segments of the track.
+ * The track is treated as a closed loop, the end of the map is connected to its start.
+ * The map is resampled to equidistant points, and the lateral offset of the car from the line is optimized at each point:
+ * - The curvature of the car path is linearized around the line: c = k + k^2 * n + n'', where k is the line curvature
+ *   and n is the offset (to the left of the line).
+ * - The offsets minimize the integral of the squared path curvature plus the weighted path length, within the maximum offset -
+ *   a quadratic program, solved with a primal-dual active set method.
+ * - The speed profile is given by the lateral acceleration limit, and a forward (acceleration) and a backward (deceleration) pass.
+ * - Neither the minimum curvature nor the shortest race line is the fastest one in general (e.g. the shortest is the fastest
+ *   in a long constant-radius bend), so the offsets are optimized with multiple length weights, starting from zero
+ *   (the minimum curvature race line), and the race line with the shortest lap time is kept.
+ *
+ * The result is summarized for each segment in the format of the track tables: the fast segments get the highest speed of the
+ * profile in the segment, the slow segments the lowest one, and the brake segments get the distance they can keep the fast speed for.
+ * The race line is given as a pyramid profile of the line position and the line angle (the line position is the negative of the offset).
+ */
+class RacingLineOptimizer {
+public:
+    struct Options {
+        micro::meter_t pointDist             = micro::centimeter_t(20);          // Distance between the optimized points.
+        micro::meter_t maxOffset             = cfg::RACE_LINE_MAX_OFFSET;        // Maximum lateral offset of the car from the line.
+        micro::m_per_sec_t maxSpeed          = cfg::CAR_MAX_SPEED;               // Maximum speed.
+        float maxAcceleration                = cfg::CAR_MAX_ACCELERATION;        // Maximum longitudinal acceleration [m/s^2].
+        float maxDeceleration                = cfg::CAR_MAX_DECELERATION;        // Maximum longitudinal deceleration [m/s^2].
+        float maxLateralAcceleration         = cfg::CAR_MAX_LATERAL_ACCELERATION; // Maximum lateral acceleration [m/s^2].
+        float offsetWeight                   = 1e-4f;                            // Weight of the squared offsets, keeps the car on the line where nothing else matters [1/m^3].
+        uint32_t numLengthWeights            = 10;                               // Number of the optimized race lines, the first one has zero length weight.
+        float minLengthWeight                = 0.01f;                            // Smallest non-zero weight of the path length [1/m^2].
+        float lengthWeightRatio              = 2.0f;                             // Ratio of the consecutive non-zero length weights.
+    };
+
+    struct Point {
+        micro::meter_t dist;        // Distance of the point along the line.
+        float lineCurvature;        // Curvature of the line [1/m].
+        micro::meter_t offset;      // Lateral offset of the car from the line, positive to the left.
+        float curvature;            // Curvature of the car path [1/m].
+        micro::m_per_sec_t speed;   // Speed of the car.
+    };
+
+    struct SegmentResult {
+        bool isFast;                    // Indicates if the segment is a fast segment.
+        uint32_t section;               // Index of the track section the segment belongs to, @see LapLearner
+        micro::m_per_sec_t speed;       // Target speed of the segment.
+        micro::meter_t brakeOffset;     // Distance the segment keeps the speed of the previous segment for (brake segments only).
+        TrackLineProfile raceLine;      // Line target profile of the race line.
+    };
+
+    RacingLineOptimizer();
+    explicit RacingLineOptimizer(const Options& options);
+
+    /* @brief Optimizes the race line and the speed profile of a track.
+     * The segment lengths are scaled to the length of the map, so that the segments cover the whole map.
+     * @param map The recorded map of a lap
+     * @param segments The track segments, in the order of the map
+     * @returns Status::OK if the race line has been optimized, Status::INVALID_DATA if the map or the segments are empty
+     */
+    micro::Status optimize(const TrackMap& map, const TrackSegments& segments);
+
+    const std::vector<Point>& points() const { return this->points_; }
+    const std::vector<SegmentResult>& segments() const { return this->segments_; }
+
+    /* @brief Gets the brake offsets by track section, in the order of the brake offset table rows.
+     */
+    const std::vector<micro::meter_t>& brakeOffsets() const { return this->brakeOffsets_; }
+
+    /* @brief Gets the lap time of the optimized race line.
+     */
+    micro::second_t lapTime() const { return this->lapTime_; }
+
+    /* @brief Writes the optimized race line profiles, speeds and brake offsets as C++ source, in the format of test_track.cpp.
+     * The race line profiles are written as named constants, e.g. LINE_FAST1_RACE or LINE_SLOW2_3_RACE for the third slow segment
+     * of the second section, followed by the constant names in the order of the segment table.
+     * The speeds and the brake offsets are written as rows of the TrackProfile tables.
+     * @param out The output stream
+     * @param name The name of the track, e.g. "test"
+     */
+    void writeSource(std::ostream& out, const std::string& name) const;
+
+private:
+    void resample(const TrackMap& map);
+    void optimizeOffsets(const float lengthWeight, std::vector<double>& offsets) const;
+    micro::second_t updateSpeeds(const std::vector<double>& offsets, std::vector<Point>& points) const;
+    void summarize(const TrackSegments& segments);
+
+    Options options_;
+    std::vector<Point> points_;
+    std::vector<SegmentResult> segments_;
+    std::vector<micro::meter_t> brakeOffsets_;
+    micro::second_t lapTime_;
+    micro::meter_t pointDist_;  // The actual distance of the points, the map length is divided evenly.
+};
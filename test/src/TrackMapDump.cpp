@@ -0,0 +1,53 @@
+#include "TrackMapDump.hpp"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace micro;
+
+constexpr const char *TrackMapDump::TAG;
+
+void TrackMapDump::write(std::ostream& out, const TrackMap& map) {
+    out << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+    for (uint32_t i = 0; i < map.size(); ++i) {
+        const TrackMap::Sample sample = map.at(TrackMap::SAMPLE_DIST * (static_cast<float>(i) + 0.5f));
+        out << TAG
+            << ' ' << i
+            << ' ' << sample.pose.pos.X.get()
+            << ' ' << sample.pose.pos.Y.get()
+            << ' ' << sample.pose.angle.get()
+            << ' ' << sample.linePos.get()
+            << ' ' << static_cast<int>(sample.pattern) << '\n';
+    }
+}
+
+bool TrackMapDump::read(std::istream& in, TrackMap& map) {
+    map.reset();
+
+    uint32_t numSamples = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        // the debug channel output contains the log prefixes and the other messages as well
+        const size_t tagPos = line.find(std::string(TAG) + ' ');
+        if (std::string::npos == tagPos) {
+            continue;
+        }
+
+        std::istringstream sample(line.substr(tagPos + std::char_traits<char>::length(TAG)));
+        uint32_t idx = 0;
+        float x = 0.0f, y = 0.0f, angle = 0.0f, linePos = 0.0f;
+        int pattern = 0;
+        if (!(sample >> idx >> x >> y >> angle >> linePos >> pattern) || idx != numSamples) {
+            return false;
+        }
+
+        map.record(TrackMap::SAMPLE_DIST * static_cast<float>(idx), { { meter_t(x), meter_t(y) }, radian_t(angle) },
+            millimeter_t(linePos), static_cast<LinePattern::type_t>(pattern));
+        ++numSamples;
+    }
+
+    return numSamples > 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <TrackMap.hpp>
+
+#include <istream>
+#include <ostream>
+
+/* @brief Host-side dump and load of the track map the car records in the safety-car laps.
+ * The map is dumped as text, one sample per line: the tag, the sample index, the X and Y position [m], the heading [rad],
+ * the line position [mm] and the line pattern type. The race track task logs the same lines when its dumpTrackMap param is set,
+ * so the debug channel output of the car can be loaded directly - the lines without the tag are skipped.
+ */
+class TrackMapDump {
+public:
+    static constexpr const char *TAG = "track_map";
+
+    /* @brief Writes the samples of a map.
+     * @param out The output stream
+     * @param map The map
+     */
+    static void write(std::ostream& out, const TrackMap& map);
+
+    /* @brief Loads a map by recording the dumped samples in it.
+     * @param in The input stream
+     * @param map The map, it is reset before the samples are recorded
+     * @returns true if at least one sample has been found and the sample indexes are consecutive from 0
+     */
+    static bool read(std::istream& in, TrackMap& map);
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+/* @brief Measures the average execution time of a function.
+ * @param numRuns Number of times the function is executed.
+ * @param func The function to measure.
+ * @returns The average execution time in microseconds.
+ */
+template <typename F>
+double benchmark(const uint32_t numRuns, F func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numRuns; ++i) {
+        func();
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / numRuns;
+}
+
+inline void printBenchmark(const char *name, const double time_us) {
+    printf("[ BENCH    ] %-48s %12.3f us\n", name, time_us);
+}
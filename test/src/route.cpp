@@ -1,14 +1,24 @@
 #include <micro/test/utils.hpp>
 
-#include <LabyrinthRoute.hpp>
+#include <LabyrinthRouteSearch.hpp>
 
 #include "route.hpp"
 
 using namespace micro;
 
+namespace {
+
+LabyrinthRouteSearch<cfg::MAX_NUM_LABYRINTH_SEGMENTS * 2> routeSearch;
+
+} // namespace
+
+LabyrinthRoute createRoute(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, const bool allowBackwardNavigation) {
+    return routeSearch.create(prevConn, currentSeg, destSeg, allowBackwardNavigation);
+}
+
 void checkRoute(const Connection& prevConn, const Segment& src, const Segment& dest, const bool allowBackwardNavigation, const RouteConnections& expectedConnections) {
     
-    LabyrinthRoute route = LabyrinthRoute::create(prevConn, src, dest, allowBackwardNavigation);
+    LabyrinthRoute route = createRoute(prevConn, src, dest, allowBackwardNavigation);
 
     ASSERT_EQ(expectedConnections.size(), route.connections.size());
 
@@ -22,4 +32,26 @@ void checkRoute(const Connection& prevConn, const Segment& src, const Segment& d
     }
 
     EXPECT_EQ(&dest, route.startSeg);
-}
\ No newline at end of file
+}
+
+meter_t routeCost(const Connection& prevConn, const Segment& src, const LabyrinthRoute& route, const bool allowBackwardNavigation) {
+    meter_t cost(0);
+    const Connection *prev = &prevConn;
+    const Segment *seg     = &src;
+    bool isStartSeg        = true;
+
+    // the route may pass through the previous connection again, so the start segment cannot be identified by the connection
+    for (const Connection *c : route.connections) {
+        cost += LabyrinthRoute::connectionCost(*prev, *seg, *c, isStartSeg, allowBackwardNavigation);
+        seg        = c->getOtherSegment(*seg);
+        prev       = c;
+        isStartSeg = false;
+    }
+    return cost;
+}
+
+CompiledLabyrinthGraph compile(const LabyrinthGraph& graph) {
+    CompiledLabyrinthGraph compiledGraph;
+    EXPECT_EQ(Status::OK, compiledGraph.compile(graph));
+    return compiledGraph;
+}
@@ -2,7 +2,8 @@
 
 #include <micro/container/vec.hpp>
 
-#include <LabyrinthGraph.hpp>
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthRoute.hpp>
 
 struct RouteConnection {
     const Junction *junction;
@@ -19,4 +20,14 @@ struct RouteConnection {
 
 typedef micro::vec<RouteConnection, 50> RouteConnections;
 
-void checkRoute(const Connection& prevConn, const Segment& src, const Segment& dest, const bool allowBackwardNavigation, const RouteConnections& expectedConnections);
\ No newline at end of file
+/* @brief Creates a route with a shared route search.
+ * @note Not reentrant, @see LabyrinthRouteSearch
+ */
+LabyrinthRoute createRoute(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, const bool allowBackwardNavigation);
+
+void checkRoute(const Connection& prevConn, const Segment& src, const Segment& dest, const bool allowBackwardNavigation, const RouteConnections& expectedConnections);
+micro::meter_t routeCost(const Connection& prevConn, const Segment& src, const LabyrinthRoute& route, const bool allowBackwardNavigation);
+
+/* @brief Compiles a labyrinth graph, and expects the compilation to succeed.
+ */
+CompiledLabyrinthGraph compile(const LabyrinthGraph& graph);
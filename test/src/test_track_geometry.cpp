@@ -0,0 +1,18 @@
+#include <micro/math/numeric.hpp>
+
+#include "test_track_geometry.hpp"
+
+#include <cmath>
+
+using namespace micro;
+
+float segmentCurvature(const TrackSegments& segments, const float turnAngles[], const uint32_t segIdx) {
+    return static_cast<radian_t>(degree_t(turnAngles[segIdx])).get() / segments[segIdx].length.get();
+}
+
+void advancePose(Pose& pose, const float curvature, const meter_t ds) {
+    const radian_t angle = pose.angle + radian_t(curvature * ds.get() / 2);
+    pose.pos.X += ds * std::cos(angle.get());
+    pose.pos.Y += ds * std::sin(angle.get());
+    pose.angle  = normalize360(pose.angle + radian_t(curvature * ds.get()));
+}
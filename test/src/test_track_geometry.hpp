@@ -0,0 +1,30 @@
+#pragma once
+
+#include <micro/utils/point2.hpp>
+#include <micro/utils/units.hpp>
+
+#include <track.hpp>
+
+// Heading changes of the segments of the test track [deg]: straight fast segments and brake segments,
+// 90 degree bends after the first and the third fast segment, and roundabouts with chicanes after the second and the fourth.
+constexpr float TEST_TRACK_TURN_ANGLES[] = {
+    0, 0, 90,               // fast1, slow1
+    0, 0, -30, 90, 90, -30, // fast2, slow2
+    0, 0, 90,               // fast3, slow3
+    0, 0, -30, 60, 60, -30  // fast4, slow4
+};
+
+/* @brief Gets the curvature of a segment of a track that consists of constant-curvature segments.
+ * @param segments The track segments
+ * @param turnAngles The heading changes of the segments [deg]
+ * @param segIdx The segment index
+ * @returns The curvature of the segment [1/m]
+ */
+float segmentCurvature(const TrackSegments& segments, const float turnAngles[], const uint32_t segIdx);
+
+/* @brief Moves a pose forward along a constant-curvature path, with midpoint integration of the heading.
+ * @param pose The pose, updated in place
+ * @param curvature The curvature of the path [1/m]
+ * @param ds The distance to move
+ */
+void advancePose(micro::Pose& pose, const float curvature, const micro::meter_t ds);
@@ -0,0 +1,96 @@
+#include <micro/test/utils.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthRoute.hpp>
+#include <track.hpp>
+
+using namespace micro;
+
+namespace {
+
+typedef CompiledLabyrinthGraph::index_t index_t;
+
+void checkCompiledGraph(const LabyrinthGraph& graph) {
+    CompiledLabyrinthGraph compiledGraph;
+    ASSERT_EQ(Status::OK, compiledGraph.compile(graph));
+    ASSERT_TRUE(compiledGraph.isCompiled());
+
+    ASSERT_EQ(graph.segments().size(), compiledGraph.numSegments());
+    ASSERT_EQ(graph.connections().size(), compiledGraph.numConnections());
+    ASSERT_EQ(graph.junctions().size(), compiledGraph.numJunctions());
+
+    for (const Segment& seg : graph.segments()) {
+        const index_t segIdx = static_cast<index_t>(seg.idx);
+        const CompiledLabyrinthGraph::SegmentInfo& info = compiledGraph.segment(segIdx);
+
+        EXPECT_EQ(segIdx, compiledGraph.findSegment(seg.name));
+        EXPECT_EQ(seg.name, info.name);
+        EXPECT_EQ(seg.length.get(), info.length.get());
+        EXPECT_EQ(seg.isDeadEnd, info.isDeadEnd);
+
+        const CompiledLabyrinthGraph::EdgeRange edges = compiledGraph.edges(segIdx);
+        ASSERT_EQ(seg.edges.size(), edges.size());
+
+        for (uint32_t i = 0; i < seg.edges.size(); ++i) {
+            const Connection& prevConn = *seg.edges[i];
+            EXPECT_EQ(prevConn.idx, edges.begin()[i]);
+            EXPECT_EQ(prevConn.getOtherSegment(seg)->idx, compiledGraph.getOtherSegment(edges.begin()[i], segIdx));
+
+            for (const Connection *newConn : seg.edges) {
+                const index_t prevIdx = static_cast<index_t>(prevConn.idx), newIdx = static_cast<index_t>(newConn->idx);
+
+                EXPECT_EQ(LabyrinthRoute::isForwardConnection(prevConn, seg, *newConn), compiledGraph.isForwardConnection(prevIdx, segIdx, newIdx));
+
+                for (const bool isStartSeg : { false, true }) {
+                    for (const bool allowBackwardNavigation : { false, true }) {
+                        EXPECT_EQ(LabyrinthRoute::connectionCost(prevConn, seg, *newConn, isStartSeg, allowBackwardNavigation).get(),
+                            compiledGraph.connectionCost(prevIdx, segIdx, newIdx, isStartSeg, allowBackwardNavigation).get());
+                    }
+                }
+            }
+        }
+    }
+
+    for (const Connection& conn : graph.connections()) {
+        const index_t idx = compiledGraph.findConnection(static_cast<index_t>(conn.node1->idx), static_cast<index_t>(conn.node2->idx));
+        ASSERT_NE(CompiledLabyrinthGraph::INVALID_INDEX, idx);
+        EXPECT_EQ(graph.findConnection(*conn.node1, *conn.node2)->idx, idx);
+        EXPECT_EQ(conn.junction->idx, compiledGraph.connection(idx).junction);
+    }
+
+    for (const Junction& junc : graph.junctions()) {
+        const index_t juncIdx = static_cast<index_t>(junc.idx);
+
+        for (const Junction::segment_map::entry_type& sideSegments : junc.segments) {
+            for (const Junction::side_segment_map::entry_type& seg : sideSegments.second) {
+                EXPECT_EQ(seg.second->idx, compiledGraph.getJunctionSegment(juncIdx, JunctionTopology::side(sideSegments.first), seg.first));
+            }
+        }
+
+        for (const Segment& seg : graph.segments()) {
+            EXPECT_EQ(junc.getSegmentInfo(seg).size() > 0, compiledGraph.isConnected(juncIdx, static_cast<index_t>(seg.idx)));
+        }
+    }
+}
+
+} // namespace
+
+TEST(compiledLabyrinthGraph, race_labyrinth) {
+    const LabyrinthGraph graph = buildRaceLabyrinthGraph();
+    checkCompiledGraph(graph);
+}
+
+TEST(compiledLabyrinthGraph, test_labyrinth) {
+    const LabyrinthGraph graph = buildTestLabyrinthGraph();
+    checkCompiledGraph(graph);
+}
+
+TEST(compiledLabyrinthGraph, invalid_graph) {
+    LabyrinthGraph graph;
+    graph.addSegment(Segment('A', meter_t(1), false));
+
+    CompiledLabyrinthGraph compiledGraph;
+    EXPECT_EQ(Status::INVALID_DATA, compiledGraph.compile(graph));
+    EXPECT_FALSE(compiledGraph.isCompiled());
+    EXPECT_EQ(CompiledLabyrinthGraph::INVALID_INDEX, compiledGraph.findSegment('A'));
+}
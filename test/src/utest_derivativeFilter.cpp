@@ -0,0 +1,137 @@
+#include <micro/test/utils.hpp>
+
+#include <DerivativeFilter.hpp>
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace micro;
+
+constexpr float PI_F = 3.14159265f;
+constexpr second_t SAMPLE_TIME = millisecond_t(1);
+
+/* @brief Calculates the backward difference over a window of evenly spaced samples, the way the line error derivatives used to be calculated.
+ */
+class BackwardDifference {
+public:
+    explicit BackwardDifference(const uint32_t size) : size_(size) {}
+
+    float update(const float value) {
+        this->prev_.push_back(value);
+        if (this->prev_.size() > this->size_ + 1) {
+            this->prev_.pop_front();
+        }
+        return (value - this->prev_.front()) / (this->size_ * SAMPLE_TIME.get());
+    }
+
+private:
+    const uint32_t size_;
+    std::deque<float> prev_;
+};
+
+/* @brief Gets the delay of the estimated signal relative to the expected one, as the shift that maximizes their correlation.
+ */
+uint32_t delay(const std::vector<float>& expected, const std::vector<float>& estimated, const uint32_t maxDelay) {
+    uint32_t bestDelay = 0;
+    float bestCorrelation = -std::numeric_limits<float>::infinity();
+
+    for (uint32_t d = 0; d <= maxDelay; ++d) {
+        float correlation = 0.0f;
+        for (uint32_t i = maxDelay; i < expected.size(); ++i) {
+            correlation += expected[i - d] * estimated[i];
+        }
+        if (correlation > bestCorrelation) {
+            bestCorrelation = correlation;
+            bestDelay = d;
+        }
+    }
+    return bestDelay;
+}
+
+float rms(const std::vector<float>& expected, const std::vector<float>& estimated, const uint32_t start) {
+    float sumSquares = 0.0f;
+    for (uint32_t i = start; i < expected.size(); ++i) {
+        sumSquares += (estimated[i] - expected[i]) * (estimated[i] - expected[i]);
+    }
+    return std::sqrt(sumSquares / (expected.size() - start));
+}
+
+} // namespace
+
+TEST(derivativeFilter, follows_ramp) {
+    DerivativeFilter<float> filter(0.2f, DerivativeFilter<float>::criticalBeta(0.2f));
+
+    EXPECT_EQ(0.0f, filter.update(1.0f, SAMPLE_TIME));
+
+    float rate = 0.0f;
+    for (uint32_t i = 1; i < 200; ++i) {
+        rate = filter.update(1.0f + 0.5f * i, SAMPLE_TIME);
+    }
+    EXPECT_NEAR(500.0f, rate, 0.01f);
+    EXPECT_NEAR(1.0f + 0.5f * 199, filter.value(), 0.0001f);
+
+    // a measurement without elapsed time does not change the estimates
+    EXPECT_NEAR(500.0f, filter.update(0.0f, second_t(0)), 0.01f);
+    EXPECT_NEAR(1.0f + 0.5f * 199, filter.value(), 0.0001f);
+
+    // after a reset the first measurement only initializes the value
+    filter.reset();
+    EXPECT_EQ(0.0f, filter.update(5.0f, SAMPLE_TIME));
+    EXPECT_EQ(5.0f, filter.value());
+}
+
+TEST(derivativeFilter, uneven_sampling) {
+    DerivativeFilter<float> filter(0.2f, DerivativeFilter<float>::criticalBeta(0.2f));
+
+    // the samples of a ramp of 2 units per second are taken 1, 2 or 5 ms apart, like the irregular control updates
+    const millisecond_t dts[] = { millisecond_t(1), millisecond_t(5), millisecond_t(2), millisecond_t(1), millisecond_t(2) };
+
+    second_t time = second_t(0);
+    float rate = filter.update(0.0f, second_t(0));
+    for (uint32_t i = 0; i < 200; ++i) {
+        const second_t dt = dts[i % (sizeof(dts) / sizeof(dts[0]))];
+        time += dt;
+        rate = filter.update(2.0f * time.get(), dt);
+    }
+    EXPECT_NEAR(2.0f, rate, 0.001f);
+    EXPECT_NEAR(2.0f * time.get(), filter.value(), 0.0001f);
+}
+
+TEST(derivativeFilter, phase_lag) {
+    constexpr uint32_t NUM_SAMPLES = 4000;
+    constexpr float PERIOD         = 400.0f; // Period of the test signal in samples, a typical line error oscillation at 1 kHz control rate.
+    constexpr float AMPLITUDE      = 2.0f;
+    constexpr float NOISE          = 0.05f;  // Standard deviation of the measurement noise, the resolution of the line position.
+
+    std::mt19937 random(0);
+    std::normal_distribution<float> noise(0.0f, NOISE);
+
+    BackwardDifference backwardDifference(30);
+    DerivativeFilter<float> filter(0.2f, DerivativeFilter<float>::criticalBeta(0.2f));
+
+    std::vector<float> expected, backwardEstimated, filterEstimated;
+    for (uint32_t i = 0; i < NUM_SAMPLES; ++i) {
+        const float phase = 2 * PI_F * i / PERIOD;
+        const float measured = AMPLITUDE * std::sin(phase) + noise(random);
+
+        expected.push_back(AMPLITUDE * 2 * PI_F / (PERIOD * SAMPLE_TIME.get()) * std::cos(phase));
+        backwardEstimated.push_back(backwardDifference.update(measured));
+        filterEstimated.push_back(filter.update(measured, SAMPLE_TIME));
+    }
+
+    const uint32_t backwardDelay = delay(expected, backwardEstimated, 50);
+    const uint32_t filterDelay   = delay(expected, filterEstimated, 50);
+    const float backwardError    = rms(expected, backwardEstimated, 100);
+    const float filterError      = rms(expected, filterEstimated, 100);
+
+    // the amplitude of the derivative is 31.4 units per second
+    EXPECT_NEAR(15, backwardDelay, 1);
+    EXPECT_NEAR(8, filterDelay, 1);
+    EXPECT_NEAR(5.7f, backwardError, 0.1f);
+    EXPECT_NEAR(3.5f, filterError, 0.1f);
+}
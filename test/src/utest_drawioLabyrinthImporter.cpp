@@ -0,0 +1,160 @@
+#include <micro/test/utils.hpp>
+
+#include <DrawioLabyrinthImporter.hpp>
+#include <track.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using namespace micro;
+
+namespace {
+
+// Junction 1 at (0, 0) and junction 2 at (400, 0), segment A connects the junctions, segments B and C are loops
+const char *TWO_JUNCTIONS_DRAWING =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+    "<mxfile host=\"app.diagrams.net\"><diagram id=\"d\" name=\"Page-1\">"
+    "<mxGraphModel dx=\"1185\" dy=\"614\" grid=\"1\"><root>"
+    "<mxCell id=\"0\"/><mxCell id=\"1\" parent=\"0\"/>"
+    "<!-- junctions -->"
+    "<mxCell id=\"j1\" value=\"1\" style=\"ellipse;\" vertex=\"1\" parent=\"1\"><mxGeometry x=\"-10\" y=\"-10\" width=\"20\" height=\"20\" as=\"geometry\"/></mxCell>"
+    "<mxCell id=\"j2\" value=\"&lt;b&gt;2&lt;/b&gt;\" style=\"ellipse;html=1;\" vertex=\"1\" parent=\"1\"><mxGeometry x=\"390\" y=\"-10\" width=\"20\" height=\"20\" as=\"geometry\"/></mxCell>"
+    "<mxCell id=\"note\" value=\"Start\" style=\"text;\" vertex=\"1\" parent=\"1\"><mxGeometry x=\"0\" y=\"40\" width=\"40\" height=\"20\" as=\"geometry\"/></mxCell>"
+    "<!-- segments -->"
+    "<mxCell id=\"sA\" value=\"A\" style=\"endArrow=none;\" edge=\"1\" parent=\"1\" source=\"j1\" target=\"j2\"><mxGeometry relative=\"1\" as=\"geometry\"/></mxCell>"
+    "<object label=\"B\" length=\"300\" id=\"sB\"><mxCell style=\"endArrow=none;\" edge=\"1\" parent=\"1\" source=\"j1\" target=\"j1\">"
+    "<mxGeometry relative=\"1\" as=\"geometry\"><Array as=\"points\">"
+    "<mxPoint x=\"-30\" y=\"-15\"/><mxPoint x=\"-60\" y=\"-30\"/><mxPoint x=\"-60\" y=\"30\"/><mxPoint x=\"-30\" y=\"15\"/>"
+    "</Array></mxGeometry></mxCell></object>"
+    "<object label=\"&lt;div&gt;C&lt;/div&gt;\" length=\"320\" id=\"sC\"><mxCell style=\"endArrow=none;html=1;\" edge=\"1\" parent=\"1\" target=\"j2\">"
+    "<mxGeometry relative=\"1\" as=\"geometry\"><mxPoint x=\"398\" y=\"3\" as=\"sourcePoint\"/><Array as=\"points\">"
+    "<mxPoint x=\"430\" y=\"-15\"/><mxPoint x=\"460\" y=\"-30\"/><mxPoint x=\"460\" y=\"30\"/><mxPoint x=\"430\" y=\"15\"/>"
+    "</Array></mxGeometry></mxCell></object>"
+    "</root></mxGraphModel></diagram></mxfile>";
+
+bool containsDecision(const LabyrinthDescription& desc, const DecisionDescription& decision) {
+    for (uint32_t i = 0; i < desc.numDecisions; ++i) {
+        const DecisionDescription& d = desc.decisions[i];
+        if (d.segment == decision.segment && d.junction == decision.junction &&
+            LabyrinthDescription::normalize(d.orientation) == LabyrinthDescription::normalize(decision.orientation) &&
+            d.direction == decision.direction) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(drawioLabyrinthImporter, test_labyrinth) {
+    std::ifstream in(TEST_RESOURCES_DIR "/test_labyrinth.drawio");
+    ASSERT_TRUE(in.is_open());
+
+    DrawioLabyrinthImporter importer;
+    ASSERT_EQ(Status::OK, importer.parse(in));
+
+    const LabyrinthDescription expected = testLabyrinthDescription;
+    const LabyrinthDescription desc     = importer.description();
+
+    ASSERT_EQ(expected.numSegments, desc.numSegments);
+    for (uint32_t i = 0; i < expected.numSegments; ++i) {
+        EXPECT_EQ(expected.segments[i].name, desc.segments[i].name);
+        EXPECT_EQ(expected.segments[i].length, desc.segments[i].length);
+        EXPECT_EQ(expected.segments[i].isDeadEnd, desc.segments[i].isDeadEnd);
+    }
+
+    ASSERT_EQ(expected.numJunctions, desc.numJunctions);
+    for (uint32_t i = 0; i < expected.numJunctions; ++i) {
+        EXPECT_EQ(expected.junctions[i].id, desc.junctions[i].id);
+        EXPECT_EQ(expected.junctions[i].x, desc.junctions[i].x);
+        EXPECT_EQ(expected.junctions[i].y, desc.junctions[i].y);
+    }
+
+    ASSERT_EQ(expected.numDecisions, desc.numDecisions);
+    for (uint32_t i = 0; i < expected.numDecisions; ++i) {
+        EXPECT_TRUE(containsDecision(desc, expected.decisions[i]));
+    }
+
+    const LabyrinthGraph graph = importer.build();
+    EXPECT_TRUE(graph.valid());
+    EXPECT_EQ(buildTestLabyrinthGraph().connections().size(), graph.connections().size());
+}
+
+TEST(drawioLabyrinthImporter, uncompressed) {
+    DrawioLabyrinthImporter::Options options;
+    options.cmPerPixel = 2.0f;
+
+    std::istringstream in(TWO_JUNCTIONS_DRAWING);
+    DrawioLabyrinthImporter importer(options);
+    ASSERT_EQ(Status::OK, importer.parse(in));
+
+    ASSERT_EQ(3u, importer.segments().size());
+    EXPECT_EQ('A', importer.segments()[0].name);
+    EXPECT_EQ(800, importer.segments()[0].length);
+    EXPECT_EQ('B', importer.segments()[1].name);
+    EXPECT_EQ(300, importer.segments()[1].length);
+    EXPECT_EQ('C', importer.segments()[2].name);
+    EXPECT_EQ(320, importer.segments()[2].length);
+
+    ASSERT_EQ(2u, importer.junctions().size());
+    EXPECT_EQ(1, importer.junctions()[0].id);
+    EXPECT_EQ(0, importer.junctions()[0].x);
+    EXPECT_EQ(0, importer.junctions()[0].y);
+    EXPECT_EQ(2, importer.junctions()[1].id);
+    EXPECT_EQ(800, importer.junctions()[1].x);
+    EXPECT_EQ(0, importer.junctions()[1].y);
+
+    const LabyrinthDescription desc = importer.description();
+    ASSERT_EQ(6u, desc.numDecisions);
+    EXPECT_TRUE(containsDecision(desc, { 'A', 1, 0,   Direction::CENTER }));
+    EXPECT_TRUE(containsDecision(desc, { 'B', 1, 180, Direction::LEFT   }));
+    EXPECT_TRUE(containsDecision(desc, { 'B', 1, 180, Direction::RIGHT  }));
+    EXPECT_TRUE(containsDecision(desc, { 'A', 2, 180, Direction::CENTER }));
+    EXPECT_TRUE(containsDecision(desc, { 'C', 2, 0,   Direction::LEFT   }));
+    EXPECT_TRUE(containsDecision(desc, { 'C', 2, 0,   Direction::RIGHT  }));
+}
+
+TEST(drawioLabyrinthImporter, writeSource) {
+    std::istringstream in(TWO_JUNCTIONS_DRAWING);
+    DrawioLabyrinthImporter importer;
+    ASSERT_EQ(Status::OK, importer.parse(in));
+
+    std::ostringstream out;
+    importer.writeSource(out, "demo");
+    const std::string source = out.str();
+
+    EXPECT_NE(std::string::npos, source.find("    { 'A', 400,  false },\n"));
+    EXPECT_NE(std::string::npos, source.find("    { 2,    400,    0 },\n"));
+    EXPECT_NE(std::string::npos, source.find("    { 'B', 1,  180, Direction::LEFT   },\n"));
+    EXPECT_NE(std::string::npos, source.find("extern constexpr LabyrinthDescription demoLabyrinthDescription = describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS);"));
+    EXPECT_NE(std::string::npos, source.find("static_assert(demoLabyrinthDescription.isValid(), \"Demo labyrinth graph is invalid\");"));
+    EXPECT_NE(std::string::npos, source.find("LabyrinthGraph buildDemoLabyrinthGraph() {"));
+}
+
+TEST(drawioLabyrinthImporter, invalid) {
+    // segment A is not connected to any junction
+    std::istringstream unconnected(
+        "<mxfile><diagram><mxGraphModel><root>"
+        "<mxCell id=\"j1\" value=\"1\" vertex=\"1\" parent=\"1\"><mxGeometry x=\"0\" y=\"0\" width=\"20\" height=\"20\" as=\"geometry\"/></mxCell>"
+        "<mxCell id=\"sA\" value=\"A\" edge=\"1\" parent=\"1\"><mxGeometry relative=\"1\" as=\"geometry\">"
+        "<mxPoint x=\"100\" y=\"0\" as=\"sourcePoint\"/><mxPoint x=\"200\" y=\"0\" as=\"targetPoint\"/></mxGeometry></mxCell>"
+        "</root></mxGraphModel></diagram></mxfile>");
+    EXPECT_EQ(Status::INVALID_DATA, DrawioLabyrinthImporter().parse(unconnected));
+
+    std::istringstream malformed("<mxfile><diagram><mxGraphModel><root><mxCell id=\"j1 value=\"1\"");
+    EXPECT_EQ(Status::INVALID_DATA, DrawioLabyrinthImporter().parse(malformed));
+}
+
+TEST(drawioLabyrinthImporter, invalid_uri_escape) {
+    // compressed '<mxGraphModel><root></root></mxGraphModel>'
+    std::istringstream valid("<mxfile><diagram>UzV2zq1wL0osyPDNT0nNUTV2VTV2LsrPL4GwVI3cUDhoagE=</diagram></mxfile>");
+    EXPECT_EQ(Status::OK, DrawioLabyrinthImporter().parse(valid));
+
+    // invalid hexadecimal digit: '%ZE' instead of '%3E'
+    std::istringstream invalidDigit("<mxfile><diagram>UzV2zq1wL0osyPDNT0nNUTV2VTV2LsrPL4GwVI3cwJwoKAdNLQA=</diagram></mxfile>");
+    EXPECT_EQ(Status::INVALID_DATA, DrawioLabyrinthImporter().parse(invalidDigit));
+
+    // truncated escape: '%3' at the end of the data
+    std::istringstream truncated("<mxfile><diagram>UzV2zq1wL0osyPDNT0nNUTV2VTV2LsrPL4GwVI3cUDgYagE=</diagram></mxfile>");
+    EXPECT_EQ(Status::INVALID_DATA, DrawioLabyrinthImporter().parse(truncated));
+}
@@ -0,0 +1,70 @@
+#include <micro/test/utils.hpp>
+
+#include <FixedDeque.hpp>
+
+#include <vector>
+
+namespace {
+
+template <typename T, uint32_t N>
+std::vector<T> toVector(const FixedDeque<T, N>& deque) {
+    return std::vector<T>(deque.begin(), deque.end());
+}
+
+} // namespace
+
+TEST(fixedDeque, push_pop) {
+    FixedDeque<int, 4> deque;
+    EXPECT_TRUE(deque.empty());
+
+    EXPECT_TRUE(deque.push_back(2));
+    EXPECT_TRUE(deque.push_back(3));
+    EXPECT_TRUE(deque.push_front(1));
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3 }), toVector(deque));
+    EXPECT_EQ(1, deque.front());
+    EXPECT_EQ(3, deque.back());
+
+    deque.pop_front();
+    EXPECT_EQ(std::vector<int>({ 2, 3 }), toVector(deque));
+
+    deque.pop_back();
+    EXPECT_EQ(std::vector<int>({ 2 }), toVector(deque));
+
+    deque.clear();
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(deque.begin(), deque.end());
+}
+
+TEST(fixedDeque, full) {
+    FixedDeque<int, 3> deque;
+    EXPECT_TRUE(deque.push_back(1));
+    EXPECT_TRUE(deque.push_back(2));
+    EXPECT_TRUE(deque.push_front(0));
+    EXPECT_TRUE(deque.full());
+
+    EXPECT_FALSE(deque.push_back(3));
+    EXPECT_FALSE(deque.push_front(-1));
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2 }), toVector(deque));
+}
+
+TEST(fixedDeque, wrap_around) {
+    FixedDeque<int, 4> deque;
+
+    // the elements keep their order while the ring buffer wraps around several times
+    for (int i = 0; i < 3; ++i) {
+        deque.push_back(i);
+    }
+
+    for (int i = 3; i < 20; ++i) {
+        deque.pop_front();
+        deque.push_back(i);
+        EXPECT_EQ(std::vector<int>({ i - 2, i - 1, i }), toVector(deque));
+        EXPECT_EQ(i - 1, deque[1]);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        deque.push_front(deque.back());
+        deque.pop_back();
+    }
+    EXPECT_EQ(std::vector<int>({ 19, 17, 18 }), toVector(deque));
+}
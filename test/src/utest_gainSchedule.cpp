@@ -0,0 +1,132 @@
+#include <micro/test/utils.hpp>
+
+#include <GainSchedule.hpp>
+
+using namespace micro;
+
+namespace {
+
+void expectParams(const PID_Params& expected, const PID_Params& actual) {
+    EXPECT_NEAR(expected.P, actual.P, 0.0001f);
+    EXPECT_NEAR(expected.I, actual.I, 0.0001f);
+    EXPECT_NEAR(expected.D, actual.D, 0.0001f);
+}
+
+} // namespace
+
+TEST(gainSchedule, interpolates_breakpoints) {
+    const GainSchedule::Breakpoints breakpoints = {
+        { m_per_sec_t(0.0f), PID_Params{ 1.0f, 0.0f, 10.0f } },
+        { m_per_sec_t(1.0f), PID_Params{ 2.0f, 0.0f, 20.0f } },
+        { m_per_sec_t(6.4f), PID_Params{ 0.0f, 1.0f, 20.0f } }
+    };
+
+    GainSchedule schedule(breakpoints);
+
+    // the samples are 0.1 m/s apart
+    schedule.update(m_per_sec_t(0.5f));
+    expectParams({ 1.5f, 0.0f, 15.0f }, schedule.params());
+
+    schedule.update(m_per_sec_t(-0.52f));
+    expectParams({ 1.5f, 0.0f, 15.0f }, schedule.params());
+
+    schedule.update(m_per_sec_t(3.7f));
+    expectParams({ 2.0f * (1.0f - 2.7f / 5.4f), 2.7f / 5.4f, 20.0f }, schedule.params());
+
+    schedule.update(m_per_sec_t(10.0f));
+    expectParams({ 0.0f, 1.0f, 20.0f }, schedule.params());
+}
+
+TEST(gainSchedule, retunes_on_sample_change) {
+    const GainSchedule::Breakpoints breakpoints = {
+        { m_per_sec_t(0.0f), PID_Params{ 1.0f, 0.0f, 10.0f } },
+        { m_per_sec_t(6.4f), PID_Params{ 2.0f, 0.0f, 20.0f } }
+    };
+
+    GainSchedule schedule(breakpoints);
+
+    EXPECT_TRUE(schedule.update(m_per_sec_t(1.0f)));
+    EXPECT_FALSE(schedule.update(m_per_sec_t(1.0f)));
+    EXPECT_FALSE(schedule.update(m_per_sec_t(1.04f)));
+    EXPECT_TRUE(schedule.update(m_per_sec_t(1.06f)));
+
+    // recompiling an unchanged table does not need retuning
+    EXPECT_FALSE(schedule.compile());
+    EXPECT_FALSE(schedule.update(m_per_sec_t(1.06f)));
+}
+
+TEST(gainSchedule, applies_edited_breakpoints) {
+    GainSchedule::Breakpoints breakpoints = {
+        { m_per_sec_t(0.0f), PID_Params{ 1.0f, 0.0f, 10.0f } },
+        { m_per_sec_t(1.0f), PID_Params{ 2.0f, 0.0f, 20.0f } },
+        { m_per_sec_t(6.4f), PID_Params{ 2.0f, 0.0f, 20.0f } }
+    };
+
+    GainSchedule schedule(breakpoints);
+    schedule.update(m_per_sec_t(2.0f));
+
+    breakpoints[1].second.P = 3.0f;
+    EXPECT_FALSE(schedule.update(m_per_sec_t(2.0f)));
+
+    EXPECT_TRUE(schedule.compile());
+    EXPECT_TRUE(schedule.update(m_per_sec_t(2.0f)));
+    expectParams({ 3.0f - 1.0f / 5.4f, 0.0f, 20.0f }, schedule.params());
+
+    // the breakpoint speed is moved past the last breakpoint, the samples are 0.1 m/s apart again
+    breakpoints[1].first = m_per_sec_t(6.4f);
+    breakpoints[2].first = m_per_sec_t(3.2f);
+    EXPECT_TRUE(schedule.compile());
+    EXPECT_TRUE(schedule.update(m_per_sec_t(1.6f)));
+    expectParams({ 1.5f, 0.0f, 15.0f }, schedule.params());
+}
+
+TEST(gainSchedule, clamps_low_speeds_to_first_sample) {
+    const GainSchedule::Breakpoints breakpoints = {
+        { m_per_sec_t(0.0f), PID_Params{ 0.0f, 0.0f,   0.0f } },
+        { m_per_sec_t(0.1f), PID_Params{ 2.2f, 0.0f, 120.0f } },
+        { m_per_sec_t(6.4f), PID_Params{ 2.2f, 0.0f, 120.0f } }
+    };
+
+    GainSchedule schedule(breakpoints);
+
+    // the standstill breakpoint is not sampled, the lowest speeds get the gains of the first sample at 0.1 m/s
+    for (const m_per_sec_t speed : { m_per_sec_t(0.0f), m_per_sec_t(0.03f), m_per_sec_t(-0.06f), m_per_sec_t(0.12f) }) {
+        schedule.update(speed);
+        expectParams({ 2.2f, 0.0f, 120.0f }, schedule.params());
+    }
+}
+
+TEST(gainSchedule, editor) {
+    GainSchedule::Breakpoints breakpoints = {
+        { m_per_sec_t(0.0f), PID_Params{ 1.0f, 0.0f, 10.0f } },
+        { m_per_sec_t(1.0f), PID_Params{ 2.0f, 0.0f, 20.0f } }
+    };
+
+    GainScheduleEditor editor(breakpoints);
+    EXPECT_EQ(0, editor.index);
+    EXPECT_EQ(m_per_sec_t(0.0f), editor.speed);
+    expectParams({ 1.0f, 0.0f, 10.0f }, editor.gains);
+
+    // unchanged values do not need recompiling
+    EXPECT_FALSE(editor.apply());
+
+    // selecting another breakpoint loads its values, and drops the edited ones
+    editor.index   = 1;
+    editor.gains.P = 5.0f;
+    EXPECT_FALSE(editor.apply());
+    EXPECT_EQ(m_per_sec_t(1.0f), editor.speed);
+    expectParams({ 2.0f, 0.0f, 20.0f }, editor.gains);
+
+    // the edited values are written into the selected breakpoint
+    editor.speed   = m_per_sec_t(1.5f);
+    editor.gains.D = 30.0f;
+    EXPECT_TRUE(editor.apply());
+    EXPECT_EQ(m_per_sec_t(1.5f), breakpoints[1].first);
+    expectParams({ 2.0f, 0.0f, 30.0f }, breakpoints[1].second);
+    expectParams({ 1.0f, 0.0f, 10.0f }, breakpoints[0].second);
+
+    // an invalid selection is reverted
+    editor.index = 2;
+    EXPECT_FALSE(editor.apply());
+    EXPECT_EQ(1, editor.index);
+}
@@ -0,0 +1,198 @@
+#include <micro/test/utils.hpp>
+
+#include <JunctionIndex.hpp>
+#include <LabyrinthGraph.hpp>
+#include <track.hpp>
+
+#include "benchmark.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace micro;
+
+namespace {
+
+typedef micro::vec<std::pair<radian_t, uint8_t>, 2> SideSegments;
+
+struct JunctionQuery {
+    point2m pos;
+    SideSegments sideSegments;
+};
+
+constexpr uint32_t NUM_RANDOM_JUNCTIONS = 500;
+constexpr uint32_t NUM_QUERIES          = 1000;
+
+// Reference implementation: linear scan over all junctions.
+const Junction* findJunctionLinearScan(const std::vector<const Junction*>& junctions, const point2m& pos, const SideSegments& numSegments) {
+    std::pair<const Junction*, meter_t> closest             = { nullptr, micro::numeric_limits<meter_t>::infinity() };
+    std::pair<const Junction*, meter_t> closestWithTopology = { nullptr, micro::numeric_limits<meter_t>::infinity() };
+
+    for (const Junction *junc : junctions) {
+        const meter_t dist = pos.distance(junc->pos);
+
+        if (dist < closest.second) {
+            closest = { junc, dist };
+        }
+
+        if (dist < closestWithTopology.second) {
+            bool topologyOk = true;
+            for (const std::pair<radian_t, uint8_t>& numSegs : numSegments) {
+                const Junction::segment_map::const_iterator segments = junc->getSideSegments(numSegs.first);
+                if (segments == junc->segments.end() || segments->second.size() != numSegs.second) {
+                    topologyOk = false;
+                    break;
+                }
+            }
+
+            if (topologyOk) {
+                closestWithTopology = { junc, dist };
+            }
+        }
+    }
+
+    return closestWithTopology.second < centimeter_t(120) ? closestWithTopology.first : closest.first;
+}
+
+std::vector<JunctionQuery> generateQueries(const std::vector<const Junction*>& junctions, const uint32_t numQueries) {
+    std::mt19937 random(numQueries);
+    std::uniform_int_distribution<uint32_t> junctionIdx(0, junctions.size() - 1);
+    std::uniform_int_distribution<uint32_t> side(0, 3);
+    std::uniform_int_distribution<uint32_t> numSegments(1, 3);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+    std::vector<JunctionQuery> queries(numQueries);
+    for (JunctionQuery& query : queries) {
+        const Junction& junc = *junctions[junctionIdx(random)];
+        const radian_t ori   = static_cast<float>(side(random)) * PI_2;
+
+        query.pos = { junc.pos.X + meter_t(offset(random)), junc.pos.Y + meter_t(offset(random)) };
+        query.sideSegments.push_back({ normalize360(ori + PI), static_cast<uint8_t>(numSegments(random)) });
+        query.sideSegments.push_back({ ori, static_cast<uint8_t>(numSegments(random)) });
+    }
+
+    return queries;
+}
+
+void printBenchmarks(const char *graphName, const double indexTime, const double linearScanTime) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s: spatial index junction lookup", graphName);
+    printBenchmark(name, indexTime);
+    snprintf(name, sizeof(name), "%s: linear scan junction lookup", graphName);
+    printBenchmark(name, linearScanTime);
+}
+
+} // namespace
+
+TEST(junctionIndex, topology) {
+    JunctionTopology topology;
+    topology.numSegments[JunctionTopology::side(radian_t(0))] = 2;
+    topology.numSegments[JunctionTopology::side(PI)]          = 1;
+
+    EXPECT_TRUE(topology.matches({ { PI, 1 }, { radian_t(0), 2 } }));
+    EXPECT_TRUE(topology.matches({ { PI + radian_t(0.1f), 1 }, { 2 * PI - radian_t(0.1f), 2 } }));
+    EXPECT_FALSE(topology.matches({ { PI, 2 }, { radian_t(0), 2 } }));
+    EXPECT_FALSE(topology.matches({ { 3 * PI_2, 0 }, { PI_2, 0 } }));
+}
+
+TEST(junctionIndex, race_labyrinth) {
+    const LabyrinthGraph graph = buildRaceLabyrinthGraph();
+
+    std::vector<const Junction*> junctions;
+    static JunctionIndex<cfg::MAX_NUM_LABYRINTH_SEGMENTS> index;
+    index.clear();
+
+    for (const Junction& junc : graph.junctions()) {
+        index.insert(junc.idx, junc.pos, junc.getTopology());
+        junctions.push_back(&junc);
+    }
+
+    const std::vector<JunctionQuery> queries = generateQueries(junctions, NUM_QUERIES);
+
+    const auto findJunction = [&graph](const point2m& pos, const SideSegments& sideSegments) -> const Junction* {
+        const uint16_t idx = index.find(pos, sideSegments);
+        return JunctionIndex<cfg::MAX_NUM_LABYRINTH_SEGMENTS>::INVALID_KEY != idx ? &graph.junctions()[idx] : nullptr;
+    };
+
+    for (const JunctionQuery& query : queries) {
+        EXPECT_EQ(findJunctionLinearScan(junctions, query.pos, query.sideSegments), findJunction(query.pos, query.sideSegments));
+    }
+
+    // a position far from all junctions results in the closest junction
+    const point2m farPos = { meter_t(100), meter_t(100) };
+    EXPECT_EQ(findJunctionLinearScan(junctions, farPos, {}), findJunction(farPos, {}));
+
+    const double indexTime = benchmark(10, [&queries, &findJunction]() {
+        for (const JunctionQuery& query : queries) {
+            const Junction * volatile junc = findJunction(query.pos, query.sideSegments);
+            (void)junc;
+        }
+    }) / NUM_QUERIES;
+
+    const double linearScanTime = benchmark(10, [&junctions, &queries]() {
+        for (const JunctionQuery& query : queries) {
+            const Junction * volatile junc = findJunctionLinearScan(junctions, query.pos, query.sideSegments);
+            (void)junc;
+        }
+    }) / NUM_QUERIES;
+
+    printBenchmarks("race_labyrinth", indexTime, linearScanTime);
+}
+
+TEST(junctionIndex, random_500_junctions) {
+    std::mt19937 random(NUM_RANDOM_JUNCTIONS);
+    std::uniform_real_distribution<float> coord(0.0f, 50.0f);
+    std::uniform_int_distribution<uint32_t> numSegments(1, 3);
+
+    // side segments are only counted, so every junction may point to the same segment
+    Segment seg('A', meter_t(1), false);
+    const Direction directions[] = { Direction::LEFT, Direction::CENTER, Direction::RIGHT };
+
+    std::vector<Junction> junctionStorage(NUM_RANDOM_JUNCTIONS);
+    std::vector<const Junction*> junctions;
+    static JunctionIndex<NUM_RANDOM_JUNCTIONS> index;
+    index.clear();
+
+    for (uint32_t i = 0; i < NUM_RANDOM_JUNCTIONS; ++i) {
+        Junction& junc = junctionStorage[i];
+        junc = Junction(static_cast<uint8_t>(i), { meter_t(coord(random)), meter_t(coord(random)) });
+
+        const radian_t ori = i % 2 ? radian_t(0) : PI_2;
+        for (const radian_t sideOri : { ori, normalize360(ori + PI) }) {
+            const uint32_t n = numSegments(random);
+            for (uint32_t d = 0; d < n; ++d) {
+                junc.addSegment(seg, JunctionDecision(sideOri, directions[d]));
+            }
+        }
+
+        index.insert(static_cast<uint16_t>(i), junc.pos, junc.getTopology());
+        junctions.push_back(&junc);
+    }
+
+    const std::vector<JunctionQuery> queries = generateQueries(junctions, NUM_QUERIES);
+
+    const auto findJunction = [&junctionStorage](const JunctionQuery& query) -> const Junction* {
+        const uint16_t idx = index.find(query.pos, query.sideSegments);
+        return JunctionIndex<NUM_RANDOM_JUNCTIONS>::INVALID_KEY != idx ? &junctionStorage[idx] : nullptr;
+    };
+
+    for (const JunctionQuery& query : queries) {
+        EXPECT_EQ(findJunctionLinearScan(junctions, query.pos, query.sideSegments), findJunction(query));
+    }
+
+    const double indexTime = benchmark(10, [&queries, &findJunction]() {
+        for (const JunctionQuery& query : queries) {
+            const Junction * volatile junc = findJunction(query);
+            (void)junc;
+        }
+    }) / NUM_QUERIES;
+
+    const double linearScanTime = benchmark(10, [&junctions, &queries]() {
+        for (const JunctionQuery& query : queries) {
+            const Junction * volatile junc = findJunctionLinearScan(junctions, query.pos, query.sideSegments);
+            (void)junc;
+        }
+    }) / NUM_QUERIES;
+
+    printBenchmarks("500 junctions", indexTime, linearScanTime);
+}
@@ -0,0 +1,148 @@
+#include <micro/test/utils.hpp>
+
+#include <LabyrinthDescription.hpp>
+#include <LabyrinthGraph.hpp>
+#include <track.hpp>
+
+using namespace micro;
+
+namespace {
+
+constexpr SegmentDescription SEGMENTS[] = {
+    { 'A', 400, false },
+    { 'B', 400, false },
+    { 'C', 400, false },
+};
+
+constexpr JunctionDescription JUNCTIONS[] = {
+    { 1,  200, 0 },
+    { 2, -200, 0 },
+};
+
+constexpr DecisionDescription DECISIONS[] = {
+    { 'A', 1, 180, Direction::CENTER },
+    { 'B', 1, 0,   Direction::LEFT   },
+    { 'B', 1, 0,   Direction::RIGHT  },
+
+    { 'A', 2, 0,   Direction::CENTER },
+    { 'C', 2, 180, Direction::LEFT   },
+    { 'C', 2, 180, Direction::RIGHT  },
+};
+
+constexpr DecisionDescription FLOATING_SEGMENT_DECISIONS[] = {
+    { 'A', 1, 180, Direction::CENTER },
+    { 'B', 1, 0,   Direction::LEFT   },
+    { 'B', 1, 0,   Direction::RIGHT  },
+
+    { 'A', 2, 0,   Direction::CENTER },
+    { 'C', 2, 180, Direction::LEFT   },
+};
+
+constexpr DecisionDescription DUPLICATE_DECISIONS[] = {
+    { 'A', 1, 180, Direction::CENTER },
+    { 'B', 1, 0,   Direction::LEFT   },
+    { 'B', 1, 360, Direction::LEFT   },
+
+    { 'A', 2, 0,   Direction::CENTER },
+    { 'C', 2, 180, Direction::LEFT   },
+    { 'C', 2, 180, Direction::RIGHT  },
+};
+
+constexpr DecisionDescription UNKNOWN_SEGMENT_DECISIONS[] = {
+    { 'A', 1, 180, Direction::CENTER },
+    { 'B', 1, 0,   Direction::LEFT   },
+    { 'B', 1, 0,   Direction::RIGHT  },
+
+    { 'A', 2, 0,   Direction::CENTER },
+    { 'C', 2, 180, Direction::LEFT   },
+    { 'D', 2, 180, Direction::RIGHT  },
+};
+
+static_assert(describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS).isValid(), "Labyrinth should be valid");
+static_assert(4 == describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS).connections().size, "Labyrinth should have 4 connections");
+static_assert(!describeLabyrinth(SEGMENTS, JUNCTIONS, FLOATING_SEGMENT_DECISIONS).isValid(), "Labyrinth with floating segment should be invalid");
+static_assert(!describeLabyrinth(SEGMENTS, JUNCTIONS, DUPLICATE_DECISIONS).isValid(), "Labyrinth with duplicate decisions should be invalid");
+static_assert(!describeLabyrinth(SEGMENTS, JUNCTIONS, UNKNOWN_SEGMENT_DECISIONS).isValid(), "Labyrinth with unknown segment should be invalid");
+
+// Builds the graph from the description with run-time connection search.
+void connectAll(const LabyrinthDescription& desc, LabyrinthGraph& graph) {
+    for (uint32_t i = 0; i < desc.numSegments; ++i) {
+        graph.addSegment(Segment(desc.segments[i].name, centimeter_t(desc.segments[i].length), desc.segments[i].isDeadEnd));
+    }
+
+    for (uint32_t i = 0; i < desc.numJunctions; ++i) {
+        graph.addJunction(Junction(desc.junctions[i].id, { centimeter_t(desc.junctions[i].x), centimeter_t(desc.junctions[i].y) }));
+    }
+
+    for (uint32_t i = 0; i < desc.numDecisions; ++i) {
+        const DecisionDescription& d = desc.decisions[i];
+        graph.connect(graph.findSegment(d.segment), graph.findJunction(d.junction),
+            JunctionDecision(static_cast<float>(LabyrinthDescription::normalize(d.orientation) / 90) * PI_2, d.direction));
+    }
+}
+
+void checkBuiltGraph(const LabyrinthDescription& desc, const LabyrinthGraph& graph) {
+    LabyrinthGraph expected;
+    connectAll(desc, expected);
+
+    ASSERT_TRUE(graph.valid());
+    ASSERT_EQ(expected.segments().size(), graph.segments().size());
+    ASSERT_EQ(expected.junctions().size(), graph.junctions().size());
+    ASSERT_EQ(expected.connections().size(), graph.connections().size());
+
+    for (uint32_t i = 0; i < expected.connections().size(); ++i) {
+        const Connection& e = expected.connections()[i];
+        const Connection& c = graph.connections()[i];
+
+        EXPECT_EQ(e.node1->name, c.node1->name);
+        EXPECT_EQ(e.node2->name, c.node2->name);
+        EXPECT_EQ(e.junction->id, c.junction->id);
+        EXPECT_EQ(e.decision1, c.decision1);
+        EXPECT_EQ(e.decision2, c.decision2);
+    }
+
+    for (uint32_t i = 0; i < expected.segments().size(); ++i) {
+        const Segment& e = expected.segments()[i];
+        const Segment& s = graph.segments()[i];
+
+        EXPECT_EQ(e.name, s.name);
+        EXPECT_EQ(e.length.get(), s.length.get());
+        EXPECT_EQ(e.isDeadEnd, s.isDeadEnd);
+        ASSERT_EQ(e.edges.size(), s.edges.size());
+
+        for (uint32_t j = 0; j < e.edges.size(); ++j) {
+            EXPECT_EQ(e.edges[j]->idx, s.edges[j]->idx);
+        }
+    }
+
+    for (const Junction& e : expected.junctions()) {
+        const Junction *j = graph.findJunction(e.id);
+        ASSERT_NE(nullptr, j);
+        EXPECT_EQ(e.pos, j->pos);
+
+        for (const Segment& seg : expected.segments()) {
+            EXPECT_EQ(e.getSegmentInfo(seg).size(), j->getSegmentInfo(*graph.findSegment(seg.name)).size());
+        }
+    }
+}
+
+} // namespace
+
+TEST(labyrinthDescription, race_labyrinth) {
+    const LabyrinthGraph graph = buildRaceLabyrinthGraph();
+    checkBuiltGraph(raceLabyrinthDescription, graph);
+}
+
+TEST(labyrinthDescription, test_labyrinth) {
+    const LabyrinthGraph graph = buildTestLabyrinthGraph();
+    checkBuiltGraph(testLabyrinthDescription, graph);
+}
+
+TEST(labyrinthDescription, build) {
+    constexpr LabyrinthDescription desc = describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS);
+    constexpr LabyrinthConnections connections = desc.connections();
+
+    LabyrinthGraph graph;
+    graph.build(desc, connections);
+    checkBuiltGraph(desc, graph);
+}
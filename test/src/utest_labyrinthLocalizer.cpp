@@ -0,0 +1,172 @@
+#include <micro/test/utils.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthLocalizer.hpp>
+#include <track.hpp>
+
+#include "route.hpp"
+
+#include <random>
+
+using namespace micro;
+
+namespace {
+
+typedef CompiledLabyrinthGraph::index_t index_t;
+
+/* @brief Replays a random walk of the car in the test labyrinth, and generates the junction observations of the walk.
+ */
+struct Walk {
+    const LabyrinthGraph graph;
+    const CompiledLabyrinthGraph compiledGraph;
+    std::mt19937 random;
+    index_t prevConn;
+    index_t seg;
+
+    explicit Walk(const uint32_t seed)
+        : graph(buildTestLabyrinthGraph())
+        , compiledGraph(compile(graph))
+        , random(seed)
+        , prevConn(compiledGraph.findConnection(compiledGraph.findSegment('M'), compiledGraph.findSegment('W')))
+        , seg(compiledGraph.findSegment('W')) {}
+
+    // the car only changes its speed sign in dead-end segments
+    bool isReversed() const {
+        for (const index_t c : this->compiledGraph.edges(this->seg)) {
+            if (this->compiledGraph.isForwardConnection(this->prevConn, this->seg, c)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint8_t numSideSegments(const index_t junc, const uint8_t side) const {
+        uint8_t result = 0;
+        for (const Direction dir : { Direction::LEFT, Direction::CENTER, Direction::RIGHT }) {
+            if (CompiledLabyrinthGraph::INVALID_INDEX != this->compiledGraph.getJunctionSegment(junc, side, dir)) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    LabyrinthLocalizer::Observation observe(const bool isReversed) {
+        std::normal_distribution<float> posNoise(0.0f, 0.1f);
+
+        index_t nextConn = CompiledLabyrinthGraph::INVALID_INDEX;
+        for (const index_t c : this->compiledGraph.edges(this->seg)) {
+            if (isReversed != this->compiledGraph.isForwardConnection(this->prevConn, this->seg, c)) {
+                nextConn = c;
+                break;
+            }
+        }
+
+        const CompiledLabyrinthGraph::ConnectionInfo& conn = this->compiledGraph.connection(nextConn);
+        const uint8_t inSide  = conn.sides[conn.segments[0] == this->seg ? 0 : 1];
+        const uint8_t outSide = conn.sides[conn.segments[0] == this->seg ? 1 : 0];
+        const point2m& juncPos = this->graph.junctions()[conn.junction].pos;
+
+        return {
+            { juncPos.X + meter_t(posNoise(this->random)), juncPos.Y + meter_t(posNoise(this->random)) },
+            PI_2 * static_cast<float>(inSide),
+            PI_2 * static_cast<float>(outSide),
+            this->numSideSegments(conn.junction, inSide),
+            this->numSideSegments(conn.junction, outSide),
+            this->compiledGraph.segment(this->seg).length * (1.0f + 0.05f * posNoise(this->random)),
+            isReversed
+        };
+    }
+
+    // takes a random decision at the next junction
+    Direction pass(const bool isReversed) {
+        vec<index_t, cfg::MAX_NUM_CROSSING_SEGMENTS> candidates;
+        for (const index_t c : this->compiledGraph.edges(this->seg)) {
+            if (isReversed != this->compiledGraph.isForwardConnection(this->prevConn, this->seg, c)) {
+                candidates.push_back(c);
+            }
+        }
+
+        const index_t newConn = candidates[std::uniform_int_distribution<uint32_t>(0, candidates.size() - 1)(this->random)];
+        const index_t newSeg  = this->compiledGraph.getOtherSegment(newConn, this->seg);
+        const CompiledLabyrinthGraph::ConnectionInfo& conn = this->compiledGraph.connection(newConn);
+
+        this->prevConn = newConn;
+        this->seg      = newSeg;
+        return conn.directions[conn.segments[0] == newSeg ? 0 : 1];
+    }
+};
+
+} // namespace
+
+TEST(labyrinthLocalizer, tracks_random_walk) {
+    Walk walk(1);
+    LabyrinthLocalizer localizer(walk.compiledGraph);
+    localizer.initialize(walk.prevConn, walk.seg);
+
+    for (uint32_t i = 0; i < 200; ++i) {
+        const bool isReversed = walk.isReversed();
+        const LabyrinthLocalizer::Hypothesis hypothesis = localizer.observeJunction(walk.observe(isReversed));
+
+        ASSERT_EQ(walk.prevConn, hypothesis.prevConn);
+        ASSERT_EQ(walk.seg, hypothesis.seg);
+        EXPECT_GE(hypothesis.probability, cfg::LABYRINTH_LOCALIZATION_MIN_PROBABILITY);
+
+        localizer.passJunction(walk.pass(isReversed));
+    }
+}
+
+TEST(labyrinthLocalizer, recovers_from_misdetections) {
+    Walk walk(2);
+    LabyrinthLocalizer localizer(walk.compiledGraph);
+    localizer.initialize(walk.prevConn, walk.seg);
+
+    constexpr uint32_t NUM_JUNCTIONS         = 300;
+    constexpr uint32_t MISDETECTION_INTERVAL = 7;
+    constexpr uint32_t MAX_RECOVERY_LENGTH   = 2;
+
+    uint32_t numCorrect = 0, lastCorrect = 0;
+
+    for (uint32_t i = 0; i < NUM_JUNCTIONS; ++i) {
+        const bool isReversed = walk.isReversed();
+        LabyrinthLocalizer::Observation observation = walk.observe(isReversed);
+
+        // the number of segments is misdetected, and the car position has drifted away
+        if (0 == i % MISDETECTION_INTERVAL) {
+            observation.numOutSegments = 1 + observation.numOutSegments % 3;
+            observation.pos.X += meter_t(1);
+        }
+
+        const LabyrinthLocalizer::Hypothesis hypothesis = localizer.observeJunction(observation);
+
+        if (walk.prevConn == hypothesis.prevConn && walk.seg == hypothesis.seg) {
+            ++numCorrect;
+            lastCorrect = i;
+        } else {
+            EXPECT_LE(i - lastCorrect, MAX_RECOVERY_LENGTH);
+        }
+
+        localizer.passJunction(walk.pass(isReversed));
+    }
+
+    EXPECT_GE(numCorrect, NUM_JUNCTIONS * 9 / 10);
+}
+
+TEST(labyrinthLocalizer, converges_from_wrong_initialization) {
+    Walk walk(3);
+    LabyrinthLocalizer localizer(walk.compiledGraph);
+
+    const index_t wrongSeg = walk.compiledGraph.findSegment('A');
+    localizer.initialize(*walk.compiledGraph.edges(wrongSeg).begin(), wrongSeg);
+
+    for (uint32_t i = 0; i < 20; ++i) {
+        const bool isReversed = walk.isReversed();
+        const LabyrinthLocalizer::Hypothesis hypothesis = localizer.observeJunction(walk.observe(isReversed));
+
+        if (i >= 5) {
+            EXPECT_EQ(walk.prevConn, hypothesis.prevConn);
+            EXPECT_EQ(walk.seg, hypothesis.seg);
+        }
+
+        localizer.passJunction(walk.pass(isReversed));
+    }
+}
@@ -8,6 +8,11 @@
 #include <cfg_car.hpp>
 #include <track.hpp>
 
+#include "route.hpp"
+
+#include <algorithm>
+#include <cmath>
+
 using namespace micro;
 
 namespace {
@@ -30,7 +35,7 @@ const Segment *laneChangeSeg = graph.findSegment(LANE_CHANGE_SEGMENT);
 
 TEST(labyrinthNavigator_test_labyrinth, W_O) {
     LabyrinthNavigator navigator(graph, startSeg, prevConn, laneChangeSeg, LABYRINTH_SPEED, LABYRINTH_FAST_SPEED, LABYRINTH_DEAD_END_SPEED);
-    navigator.initialize();
+    ASSERT_EQ(Status::OK, navigator.initialize());
 
     CarProps car;
     LineInfo lineInfo;
@@ -220,11 +225,11 @@ TEST(labyrinthNavigator_test_labyrinth, W_O) {
 
 TEST(labyrinthNavigator_test_labyrinth, F_H) {
     LabyrinthNavigator navigator(graph, startSeg, prevConn, laneChangeSeg, LABYRINTH_SPEED, LABYRINTH_FAST_SPEED, LABYRINTH_DEAD_END_SPEED);
-    navigator.initialize();
+    ASSERT_EQ(Status::OK, navigator.initialize());
 
     navigator.currentSeg_          = graph.findSegment('F');
     navigator.prevConn_            = graph.findConnection(*navigator.currentSeg_, *graph.findSegment('G'));
-    navigator.route_               = LabyrinthRoute::create(*navigator.prevConn_, *navigator.currentSeg_, *graph.findSegment('H'), true);
+    navigator.route_               = createRoute(*navigator.prevConn_, *navigator.currentSeg_, *graph.findSegment('H'), true);
     navigator.isLastTarget_        = false;
     navigator.lastJuncDist_        = meter_t(1);
     navigator.targetDir_           = Direction::CENTER;
@@ -274,3 +279,130 @@ TEST(labyrinthNavigator_test_labyrinth, F_H) {
     navigator.update(car, lineInfo, mainLine, controlData);
     car.speed = controlData.speed;
 }
+
+TEST(labyrinthNavigator_test_labyrinth, obstacle_ahead) {
+    LabyrinthNavigator navigator(graph, startSeg, prevConn, laneChangeSeg, LABYRINTH_SPEED, LABYRINTH_FAST_SPEED, LABYRINTH_DEAD_END_SPEED);
+    ASSERT_EQ(Status::OK, navigator.initialize());
+    navigator.setTargetSegment(graph.findSegment('N'), false);
+
+    CarProps car;
+    LineInfo lineInfo;
+    MainLine mainLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
+    ControlData controlData;
+
+    car.distance = centimeter_t(50);
+    car.speed    = LABYRINTH_SPEED;
+
+    lineInfo.front.lines   = { { centimeter_t(0), 1 } };
+    lineInfo.front.pattern = { LinePattern::SINGLE_LINE, Sign::NEUTRAL, Direction::CENTER, meter_t(0) };
+    lineInfo.rear.lines    = { { centimeter_t(0), 1 } };
+    lineInfo.rear.pattern  = { LinePattern::SINGLE_LINE, Sign::NEUTRAL, Direction::CENTER, meter_t(0) };
+
+    micro::updateMainLine(lineInfo.front.lines, lineInfo.rear.lines, mainLine);
+    navigator.handleObstacles({ micro::numeric_limits<meter_t>::infinity(), centimeter_t(30) });
+    navigator.update(car, lineInfo, mainLine, controlData);
+
+    // an obstacle behind the car does not change the route
+    ASSERT_NE(nullptr, navigator.route_.firstConnection());
+    EXPECT_NE(prevConn->junction, navigator.route_.firstConnection()->junction);
+    EXPECT_EQ(Sign::POSITIVE, navigator.targetSpeedSign_);
+
+    navigator.handleObstacles({ centimeter_t(30), micro::numeric_limits<meter_t>::infinity() });
+    navigator.update(car, lineInfo, mainLine, controlData);
+
+    // the route goes back through the previous junction
+    ASSERT_NE(nullptr, navigator.route_.firstConnection());
+    EXPECT_EQ(prevConn->junction, navigator.route_.firstConnection()->junction);
+    EXPECT_EQ(Sign::NEGATIVE, navigator.targetSpeedSign_);
+
+    for (const Connection *conn : startSeg->edges) {
+        EXPECT_EQ(conn->junction != prevConn->junction, navigator.routePlanner_.isBlocked(*conn));
+    }
+
+    navigator.unblockObstacles();
+    for (const Connection *conn : startSeg->edges) {
+        EXPECT_FALSE(navigator.routePlanner_.isBlocked(*conn));
+    }
+}
+
+TEST(labyrinthNavigator_test_labyrinth, obstacle_ahead_only_route) {
+    LabyrinthNavigator navigator(graph, startSeg, prevConn, laneChangeSeg, LABYRINTH_SPEED, LABYRINTH_FAST_SPEED, LABYRINTH_DEAD_END_SPEED);
+    ASSERT_EQ(Status::OK, navigator.initialize());
+
+    // segment O is only reachable through the junction ahead
+    navigator.setTargetSegment(graph.findSegment('O'), false);
+    navigator.handleObstacles({ centimeter_t(30), micro::numeric_limits<meter_t>::infinity() });
+
+    for (const Connection *conn : startSeg->edges) {
+        EXPECT_FALSE(navigator.routePlanner_.isBlocked(*conn));
+    }
+}
+
+TEST(labyrinthNavigator_test_labyrinth, tour) {
+    LabyrinthNavigator navigator(graph, startSeg, prevConn, laneChangeSeg, LABYRINTH_SPEED, LABYRINTH_FAST_SPEED, LABYRINTH_DEAD_END_SPEED);
+    ASSERT_EQ(Status::OK, navigator.initialize());
+
+    LabyrinthTourPlanner tourPlanner;
+    const LabyrinthTourPlanner::Targets targets = { graph.findSegment('A'), graph.findSegment('K'), graph.findSegment('S') };
+
+    const second_t tourTime = navigator.setTargetSegments(tourPlanner, targets);
+    EXPECT_LT(second_t(0), tourTime);
+    EXPECT_TRUE(std::isfinite(tourTime.get()));
+
+    // the first target of the tour is followed, the remaining ones are stored
+    EXPECT_TRUE(navigator.isFollowingTour_);
+    EXPECT_NE(targets.end(), std::find(targets.begin(), targets.end(), navigator.targetSegment()));
+    EXPECT_EQ(targets.size() - 1, navigator.tourTargets_.size());
+    EXPECT_FALSE(navigator.isLastTarget());
+
+    // a new target segment cancels the tour
+    navigator.setTargetSegment(graph.findSegment('O'), false);
+    EXPECT_FALSE(navigator.isFollowingTour_);
+}
+
+TEST(labyrinthNavigator_test_labyrinth, uncertain_localization) {
+    LabyrinthNavigator navigator(graph, startSeg, prevConn, laneChangeSeg, LABYRINTH_SPEED, LABYRINTH_FAST_SPEED, LABYRINTH_DEAD_END_SPEED);
+    ASSERT_EQ(Status::OK, navigator.initialize());
+    navigator.setTargetSegment(graph.findSegment('O'), false);
+    navigator.updateRoute();
+
+    const Connection *routeConn = navigator.route_.firstConnection();
+    ASSERT_NE(nullptr, routeConn);
+
+    // the car may be anywhere in the labyrinth, so no state is likely enough to be committed
+    const uint32_t numStates = navigator.localizer_.numStates();
+    std::fill(navigator.localizer_.belief_, navigator.localizer_.belief_ + numStates, 1.0f / numStates);
+
+    CarProps car;
+    car.pose.pos   = { meter_t(100), meter_t(100) };
+    car.pose.angle = radian_t(0);
+    car.speed      = LABYRINTH_SPEED;
+    car.distance   = meter_t(1);
+
+    navigator.handleJunction(car, 1, 1);
+
+    // the car follows the route from the expected state, and the position is not corrected
+    EXPECT_EQ(routeConn, navigator.prevConn_);
+    EXPECT_EQ(routeConn->getOtherSegment(*startSeg), navigator.currentSegment());
+    EXPECT_NE(routeConn->junction->pos, navigator.correctedCarPose().pos);
+}
+
+TEST(labyrinthNavigator_test_labyrinth, junction_at_zero_distance) {
+    LabyrinthNavigator navigator(graph, startSeg, prevConn, laneChangeSeg, LABYRINTH_SPEED, LABYRINTH_FAST_SPEED, LABYRINTH_DEAD_END_SPEED);
+    ASSERT_EQ(Status::OK, navigator.initialize());
+    navigator.setTargetSegment(graph.findSegment('O'), false);
+    navigator.updateRoute();
+
+    CarProps car;
+    car.pose.pos   = navigator.route_.firstConnection()->junction->pos;
+    car.pose.angle = radian_t(0);
+    car.speed      = LABYRINTH_SPEED;
+    car.distance   = meter_t(0);
+
+    // the position in the start segment is unknown until the first junction
+    EXPECT_EQ(meter_t(0), navigator.nextSpeedLimit(car).distance);
+
+    // the junction is passed at zero odometry distance, the position in the new segment is known
+    navigator.handleJunction(car, 1, 1);
+    EXPECT_EQ(navigator.currentSegment()->length, navigator.nextSpeedLimit(car).distance);
+}
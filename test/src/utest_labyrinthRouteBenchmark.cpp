@@ -0,0 +1,278 @@
+#include <micro/test/utils.hpp>
+
+#include <LabyrinthRouteSearch.hpp>
+
+#include "benchmark.hpp"
+#include "route.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace micro;
+
+namespace {
+
+constexpr uint32_t MAX_NUM_GRID_SEGMENTS    = 400;
+constexpr uint32_t MAX_NUM_GRID_CONNECTIONS = 2 * MAX_NUM_GRID_SEGMENTS;
+
+LabyrinthRouteSearch<MAX_NUM_GRID_CONNECTIONS> gridRouteSearch;
+
+/* @brief Synthetic labyrinth with a grid-like topology, that exceeds the capacity of LabyrinthGraph.
+ * Every junction has 2 incoming and 2 outgoing segments. Outgoing segments of junction J lead to junctions J + 1 and J + stride,
+ * which makes the distance between any two junctions about the square root of the number of junctions.
+ */
+struct SyntheticLabyrinth {
+    std::vector<Segment> segments;
+    std::vector<Junction> junctions;
+    std::vector<Connection> connections;
+
+    explicit SyntheticLabyrinth(const uint32_t numSegments)
+        : segments(numSegments)
+        , junctions(numSegments / 2) {
+
+        std::mt19937 random(numSegments);
+        std::uniform_int_distribution<uint32_t> lengths(100, 500);
+
+        const uint32_t numJunctions = numSegments / 2;
+        const uint32_t stride       = static_cast<uint32_t>(std::sqrt(numJunctions));
+
+        for (uint32_t i = 0; i < numSegments; ++i) {
+            segments[i]     = Segment(static_cast<char>('A' + i % 26), centimeter_t(lengths(random)), false);
+            segments[i].idx = static_cast<uint16_t>(i);
+        }
+
+        for (uint32_t j = 0; j < numJunctions; ++j) {
+            junctions[j] = Junction(static_cast<uint8_t>(j), { meter_t(0), meter_t(0) });
+        }
+
+        connections.reserve(2 * numSegments);
+
+        for (uint32_t j = 0; j < numJunctions; ++j) {
+            Segment *in[]  = { &segments[2 * ((j + numJunctions - 1) % numJunctions) + 1], &segments[2 * ((j + numJunctions - stride) % numJunctions)] };
+            Segment *out[] = { &segments[2 * j], &segments[2 * j + 1] };
+
+            for (uint32_t i = 0; i < 2; ++i) {
+                for (uint32_t o = 0; o < 2; ++o) {
+                    connections.push_back(Connection(*in[i], *out[o], junctions[j],
+                        JunctionDecision(PI, i ? Direction::RIGHT : Direction::LEFT),
+                        JunctionDecision(radian_t(0), o ? Direction::RIGHT : Direction::LEFT)));
+
+                    Connection& conn = connections.back();
+                    conn.idx = static_cast<uint16_t>(connections.size() - 1);
+                    in[i]->edges.push_back(&conn);
+                    out[o]->edges.push_back(&conn);
+                }
+            }
+        }
+    }
+};
+
+// Reference implementation: Dijkstra-algorithm with linear minimum search and de-duplication over an unsorted state list.
+template <uint32_t N>
+LabyrinthRoute createLinearScan(const Connection& prevConn, const Segment& currentSeg, const Segment& destSeg, const bool allowBackwardNavigation) {
+
+    struct SegmentRouteInfo {
+        const Segment *seg            = nullptr;
+        meter_t dist                  = micro::numeric_limits<meter_t>::infinity();
+        const Connection *prevConn    = nullptr;
+        bool isDistMinimized          = false;
+        SegmentRouteInfo *prevSegInfo = nullptr;
+    };
+    typedef micro::vec<SegmentRouteInfo, N> SegmentRouteInfos;
+
+    SegmentRouteInfos info;
+
+    info.push_back(SegmentRouteInfo{ &currentSeg, meter_t(0), &prevConn, false, nullptr });
+    typename SegmentRouteInfos::iterator segInfo = info.begin();
+
+    while (true) {
+        segInfo = std::min_element(info.begin(), info.end(), [](const SegmentRouteInfo& a, const SegmentRouteInfo& b) {
+            return a.isDistMinimized == b.isDistMinimized ? a.dist < b.dist : !a.isDistMinimized;
+        });
+
+        if (segInfo->seg == &destSeg) {
+            break;
+        } else if (segInfo->isDistMinimized) {
+            segInfo->prevSegInfo = nullptr;
+            break;
+        }
+
+        for (Connection *newConn : segInfo->seg->edges) {
+            if (allowBackwardNavigation || LabyrinthRoute::isForwardConnection(*segInfo->prevConn, *segInfo->seg, *newConn)) {
+
+                SegmentRouteInfo newSegInfo;
+                newSegInfo.seg             = newConn->getOtherSegment(*segInfo->seg);
+                newSegInfo.prevConn        = newConn;
+                newSegInfo.isDistMinimized = false;
+                newSegInfo.prevSegInfo     = segInfo;
+                newSegInfo.dist            = segInfo->dist + LabyrinthRoute::connectionCost(*segInfo->prevConn, *segInfo->seg, *newConn, segInfo == info.begin(), allowBackwardNavigation);
+
+                typename SegmentRouteInfos::iterator existingSegInfo = std::find_if(info.begin(), info.end(), [&newSegInfo, allowBackwardNavigation](const SegmentRouteInfo& element) {
+                    return element.seg == newSegInfo.seg &&
+                           (allowBackwardNavigation ||
+                               (element.prevConn->junction == newSegInfo.prevConn->junction &&
+                                element.prevConn->getDecision(*newSegInfo.seg) == newSegInfo.prevConn->getDecision(*newSegInfo.seg)));
+                });
+
+                if (existingSegInfo != info.end()) {
+                    if (newSegInfo.dist < existingSegInfo->dist) {
+                        *existingSegInfo = newSegInfo;
+                    }
+                } else {
+                    info.push_back(newSegInfo);
+                }
+            }
+        }
+
+        segInfo->isDistMinimized = true;
+    }
+
+    LabyrinthRoute route(&destSeg);
+
+    while (segInfo->prevSegInfo) {
+        route.push_front(*segInfo->prevConn);
+        segInfo = segInfo->prevSegInfo;
+    }
+
+    return route;
+}
+
+template <typename F>
+void forEachRoute(const SyntheticLabyrinth& labyrinth, const uint32_t numRoutes, F func) {
+    for (uint32_t i = 0; i < numRoutes; ++i) {
+        const Connection& prevConn = labyrinth.connections[(i * 7) % labyrinth.connections.size()];
+        const uint32_t numConnectedSegments = 2 * labyrinth.junctions.size(); // the last segment is floating when the number of segments is odd
+        const Segment& dest        = labyrinth.segments[(i * 13 + numConnectedSegments / 2) % numConnectedSegments];
+        func(prevConn, *prevConn.node2, dest);
+    }
+}
+
+void benchmarkSyntheticLabyrinth(const uint32_t numSegments, const bool allowBackwardNavigation) {
+    static constexpr uint32_t NUM_ROUTES = 50;
+
+    const SyntheticLabyrinth labyrinth(numSegments);
+
+    forEachRoute(labyrinth, NUM_ROUTES, [allowBackwardNavigation](const Connection& prevConn, const Segment& src, const Segment& dest) {
+        const LabyrinthRoute route    = gridRouteSearch.create(prevConn, src, dest, allowBackwardNavigation);
+        const LabyrinthRoute expected = createLinearScan<2 * MAX_NUM_GRID_SEGMENTS>(prevConn, src, dest, allowBackwardNavigation);
+
+        EXPECT_EQ(&src, route.startSeg);
+        EXPECT_EQ(&dest, route.destSeg);
+        EXPECT_LE(routeCost(prevConn, src, route, allowBackwardNavigation).get(),
+            routeCost(prevConn, src, expected, allowBackwardNavigation).get() + 0.001f);
+    });
+
+    const double heapTime = benchmark(5, [&labyrinth, allowBackwardNavigation]() {
+        forEachRoute(labyrinth, NUM_ROUTES, [allowBackwardNavigation](const Connection& prevConn, const Segment& src, const Segment& dest) {
+            volatile uint32_t size = gridRouteSearch.create(prevConn, src, dest, allowBackwardNavigation).connections.size();
+            (void)size;
+        });
+    }) / NUM_ROUTES;
+
+    const double linearScanTime = benchmark(5, [&labyrinth, allowBackwardNavigation]() {
+        forEachRoute(labyrinth, NUM_ROUTES, [allowBackwardNavigation](const Connection& prevConn, const Segment& src, const Segment& dest) {
+            volatile uint32_t size = createLinearScan<2 * MAX_NUM_GRID_SEGMENTS>(prevConn, src, dest, allowBackwardNavigation).connections.size();
+            (void)size;
+        });
+    }) / NUM_ROUTES;
+
+    char name[64];
+    snprintf(name, sizeof(name), "%u segments: binary heap route", numSegments);
+    printBenchmark(name, heapTime);
+    snprintf(name, sizeof(name), "%u segments: linear scan route", numSegments);
+    printBenchmark(name, linearScanTime);
+}
+
+// Reference route storage: the remaining connections are shifted whenever the first one is dropped.
+struct ShiftingRoute {
+    const Segment *startSeg;
+    micro::vec<const Connection*, LabyrinthRoute::MAX_LENGTH> connections;
+
+    explicit ShiftingRoute(const LabyrinthRoute& route)
+        : startSeg(route.startSeg) {
+        for (const Connection *c : route.connections) {
+            this->connections.push_back(c);
+        }
+    }
+
+    void pop_front() {
+        this->startSeg = this->connections[0]->getOtherSegment(*this->startSeg);
+        this->connections.erase(this->connections.begin());
+    }
+};
+
+} // namespace
+
+TEST(labyrinthRouteBenchmark, junction_events) {
+    static constexpr uint32_t NUM_ROUTES = 50;
+
+    const SyntheticLabyrinth labyrinth(400);
+
+    std::vector<LabyrinthRoute> routes;
+    std::vector<ShiftingRoute> shiftingRoutes;
+    uint32_t numJunctionEvents = 0;
+
+    forEachRoute(labyrinth, NUM_ROUTES, [&routes, &shiftingRoutes, &numJunctionEvents](const Connection& prevConn, const Segment& src, const Segment& dest) {
+        routes.push_back(gridRouteSearch.create(prevConn, src, dest, true));
+        shiftingRoutes.push_back(ShiftingRoute(routes.back()));
+        numJunctionEvents += routes.back().connections.size();
+    });
+
+    ASSERT_GT(numJunctionEvents, 0);
+
+    // the navigator drops the first connection of the route at every junction
+    for (uint32_t i = 0; i < routes.size(); ++i) {
+        LabyrinthRoute route        = routes[i];
+        ShiftingRoute shiftingRoute = shiftingRoutes[i];
+
+        while (route.connections.size()) {
+            ASSERT_EQ(shiftingRoute.connections[0], route.firstConnection());
+            route.pop_front();
+            shiftingRoute.pop_front();
+            ASSERT_EQ(shiftingRoute.startSeg, route.startSeg);
+        }
+        EXPECT_EQ(route.destSeg, route.startSeg);
+    }
+
+    const double ringTime = benchmark(100, [&routes]() {
+        for (const LabyrinthRoute& r : routes) {
+            LabyrinthRoute route = r;
+            while (route.connections.size()) {
+                route.pop_front();
+            }
+            volatile const Segment *seg = route.startSeg;
+            (void)seg;
+        }
+    }) / numJunctionEvents;
+
+    const double shiftingTime = benchmark(100, [&shiftingRoutes]() {
+        for (const ShiftingRoute& r : shiftingRoutes) {
+            ShiftingRoute route = r;
+            while (route.connections.size()) {
+                route.pop_front();
+            }
+            volatile const Segment *seg = route.startSeg;
+            (void)seg;
+        }
+    }) / numJunctionEvents;
+
+    printBenchmark("junction event: ring buffer route", ringTime);
+    printBenchmark("junction event: shifting route", shiftingTime);
+}
+
+TEST(labyrinthRouteBenchmark, grid_25_segments) {
+    benchmarkSyntheticLabyrinth(25, true);
+    benchmarkSyntheticLabyrinth(25, false);
+}
+
+TEST(labyrinthRouteBenchmark, grid_100_segments) {
+    benchmarkSyntheticLabyrinth(100, true);
+    benchmarkSyntheticLabyrinth(100, false);
+}
+
+TEST(labyrinthRouteBenchmark, grid_400_segments) {
+    benchmarkSyntheticLabyrinth(400, true);
+    benchmarkSyntheticLabyrinth(400, false);
+}
@@ -0,0 +1,160 @@
+#include <micro/test/utils.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthRouteCost.hpp>
+#include <LabyrinthRoutePlanner.hpp>
+#include <track.hpp>
+
+#include "route.hpp"
+
+using namespace micro;
+
+namespace {
+
+// Two routes from S to D: a long straight segment (P), or a chain of short segments (Q, R, T, U) with a shorter total length.
+constexpr SegmentDescription SEGMENTS[] = {
+    { 'D', 100, true  },
+    { 'P', 280, false },
+    { 'Q', 50,  false },
+    { 'R', 50,  false },
+    { 'S', 100, true  },
+    { 'T', 50,  false },
+    { 'U', 50,  false },
+};
+
+constexpr JunctionDescription JUNCTIONS[] = {
+    { 1,    0,   0 },
+    { 2,   50, -50 },
+    { 3,  100, -50 },
+    { 4,  150, -50 },
+    { 5,  200,   0 },
+};
+
+constexpr DecisionDescription DECISIONS[] = {
+    { 'S', 1, 180, Direction::CENTER },
+    { 'P', 1, 0,   Direction::LEFT   },
+    { 'Q', 1, 0,   Direction::RIGHT  },
+
+    { 'Q', 2, 180, Direction::CENTER },
+    { 'R', 2, 0,   Direction::CENTER },
+
+    { 'R', 3, 180, Direction::CENTER },
+    { 'T', 3, 0,   Direction::CENTER },
+
+    { 'T', 4, 180, Direction::CENTER },
+    { 'U', 4, 0,   Direction::CENTER },
+
+    { 'P', 5, 180, Direction::LEFT   },
+    { 'U', 5, 180, Direction::RIGHT  },
+    { 'D', 5, 0,   Direction::CENTER },
+};
+
+constexpr LabyrinthDescription TWO_ROUTES = describeLabyrinth(SEGMENTS, JUNCTIONS, DECISIONS);
+
+static_assert(TWO_ROUTES.isValid(), "Labyrinth should be valid");
+
+LabyrinthGraph buildTwoRoutesGraph() {
+    LabyrinthGraph graph;
+    graph.build(TWO_ROUTES, TWO_ROUTES.connections());
+    return graph;
+}
+
+const LabyrinthSpeedProfile speedProfile(2.0f, 3.0f);
+const LabyrinthTimeCost timeCost(m_per_sec_t(1), m_per_sec_t(2), m_per_sec_t(0.5f), speedProfile, millisecond_t(300), millisecond_t(100));
+
+float routeCost(const CompiledLabyrinthGraph& graph, const LabyrinthRouteCost& costPolicy, const Connection& prevConn, const Segment& src, const LabyrinthRoute& route) {
+    typedef CompiledLabyrinthGraph::index_t index_t;
+
+    float cost = 0.0f;
+    const Connection *prev = &prevConn;
+    const Segment *seg     = &src;
+    bool isStartSeg        = true;
+
+    for (const Connection *c : route.connections) {
+        cost += costPolicy.connectionCost(graph, static_cast<index_t>(prev->idx), static_cast<index_t>(seg->idx), static_cast<index_t>(c->idx), isStartSeg, true);
+        seg        = c->getOtherSegment(*seg);
+        prev       = c;
+        isStartSeg = false;
+    }
+    return cost;
+}
+
+} // namespace
+
+TEST(labyrinthRouteCost, segmentTime) {
+    const LabyrinthGraph graph = buildTwoRoutesGraph();
+    const CompiledLabyrinthGraph compiledGraph = compile(graph);
+
+    // 40cm at base speed, the rest accelerating to fast speed and braking back to base speed
+    const second_t fastTimeP = speedProfile.travelTime(centimeter_t(240), m_per_sec_t(1), m_per_sec_t(2), m_per_sec_t(1));
+    EXPECT_NEAR(0.4f + 1.4083f, timeCost.segmentTime(compiledGraph, compiledGraph.findSegment('P')).get(), 0.0001f);
+    EXPECT_NEAR(0.4f + fastTimeP.get(), timeCost.segmentTime(compiledGraph, compiledGraph.findSegment('P')).get(), 0.0001f);
+
+    // only 10cm for accelerating and braking, fast speed is not reached
+    const second_t fastTimeQ = speedProfile.travelTime(centimeter_t(10), m_per_sec_t(1), m_per_sec_t(2), m_per_sec_t(1));
+    EXPECT_LT(0.05f, fastTimeQ.get());
+    EXPECT_GT(0.1f, fastTimeQ.get());
+    EXPECT_NEAR(0.4f + fastTimeQ.get(), timeCost.segmentTime(compiledGraph, compiledGraph.findSegment('Q')).get(), 0.0001f);
+
+    // 20cm at base speed, then braking to dead-end speed by the end of the segment
+    const second_t fastTimeS = speedProfile.travelTime(centimeter_t(80), m_per_sec_t(1), m_per_sec_t(2), m_per_sec_t(0.5f));
+    EXPECT_NEAR(0.2f + fastTimeS.get(), timeCost.segmentTime(compiledGraph, compiledGraph.findSegment('S')).get(), 0.0001f);
+}
+
+TEST(labyrinthRouteCost, fastest_route_differs_from_shortest) {
+    const LabyrinthGraph graph = buildTwoRoutesGraph();
+    const CompiledLabyrinthGraph compiledGraph = compile(graph);
+
+    const Segment& src  = *graph.findSegment('S');
+    const Segment& dest = *graph.findSegment('D');
+    const Connection& prevConn = *graph.findConnection(*graph.findSegment('P'), src);
+
+    LabyrinthRoutePlanner shortestPlanner(compiledGraph, true);
+    const LabyrinthRoute shortest = shortestPlanner.create(prevConn, src, dest);
+    ASSERT_EQ(5, shortest.connections.size());
+    EXPECT_EQ(graph.findSegment('Q'), shortest.connections[0]->getOtherSegment(src));
+
+    LabyrinthRoutePlanner fastestPlanner(compiledGraph, true, timeCost);
+    const LabyrinthRoute fastest = fastestPlanner.create(prevConn, src, dest);
+    ASSERT_EQ(2, fastest.connections.size());
+    EXPECT_EQ(graph.findSegment('P'), fastest.connections[0]->getOtherSegment(src));
+
+    const LabyrinthDistanceCost distanceCost;
+    EXPECT_LT(routeCost(compiledGraph, distanceCost, prevConn, src, shortest), routeCost(compiledGraph, distanceCost, prevConn, src, fastest));
+    EXPECT_LT(routeCost(compiledGraph, timeCost, prevConn, src, fastest), routeCost(compiledGraph, timeCost, prevConn, src, shortest));
+}
+
+TEST(labyrinthRouteCost, fastest_routes_test_labyrinth) {
+    const LabyrinthGraph graph = buildTestLabyrinthGraph();
+    const CompiledLabyrinthGraph compiledGraph = compile(graph);
+    const LabyrinthDistanceCost distanceCost;
+
+    LabyrinthRoutePlanner shortestPlanner(compiledGraph, true);
+    LabyrinthRoutePlanner fastestPlanner(compiledGraph, true, timeCost);
+
+    uint32_t numFasterRoutes = 0;
+
+    for (const Segment& dest : graph.segments()) {
+        for (const Connection& prevConn : graph.connections()) {
+            for (const Segment *src : { prevConn.node1, prevConn.node2 }) {
+                const LabyrinthRoute shortest = shortestPlanner.create(prevConn, *src, dest);
+                const LabyrinthRoute fastest  = fastestPlanner.create(prevConn, *src, dest);
+
+                ASSERT_EQ(shortest.connections.size() > 0, fastest.connections.size() > 0);
+
+                const float fastestTime  = routeCost(compiledGraph, timeCost, prevConn, *src, fastest);
+                const float shortestTime = routeCost(compiledGraph, timeCost, prevConn, *src, shortest);
+
+                // each route is optimal according to its own cost policy
+                EXPECT_LE(fastestTime, shortestTime + 0.001f);
+                EXPECT_LE(routeCost(compiledGraph, distanceCost, prevConn, *src, shortest), routeCost(compiledGraph, distanceCost, prevConn, *src, fastest) + 0.001f);
+
+                if (fastestTime < shortestTime - 0.001f) {
+                    ++numFasterRoutes;
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(numFasterRoutes, 0);
+}
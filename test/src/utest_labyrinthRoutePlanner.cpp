@@ -0,0 +1,138 @@
+#include <micro/test/utils.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthRoute.hpp>
+#include <LabyrinthRoutePlanner.hpp>
+#include <track.hpp>
+
+#include "route.hpp"
+
+#include <algorithm>
+
+using namespace micro;
+
+namespace {
+
+void checkAllRoutes(const LabyrinthGraph& graph, const bool allowBackwardNavigation) {
+    const CompiledLabyrinthGraph compiledGraph = compile(graph);
+    LabyrinthRoutePlanner planner(compiledGraph, allowBackwardNavigation);
+
+    for (const Segment& dest : graph.segments()) {
+        for (const Connection& prevConn : graph.connections()) {
+            for (const Segment *src : { prevConn.node1, prevConn.node2 }) {
+                const LabyrinthRoute expected = createRoute(prevConn, *src, dest, allowBackwardNavigation);
+                const LabyrinthRoute route    = planner.create(prevConn, *src, dest);
+
+                // an unreachable destination results in an empty route
+                if (src != &dest && 0 == expected.connections.size()) {
+                    EXPECT_EQ(0, route.connections.size());
+                    continue;
+                }
+
+                ASSERT_EQ(src, route.startSeg);
+                ASSERT_EQ(&dest, route.destSeg);
+                EXPECT_NEAR(routeCost(prevConn, *src, expected, allowBackwardNavigation).get(),
+                    routeCost(prevConn, *src, route, allowBackwardNavigation).get(), 0.001f);
+                EXPECT_NEAR(routeCost(prevConn, *src, expected, allowBackwardNavigation).get(), planner.routeCost(prevConn, *src, dest), 0.001f);
+
+                LabyrinthRoute inPlaceRoute(&dest);
+                planner.create(prevConn, *src, dest, inPlaceRoute);
+                ASSERT_EQ(route.connections.size(), inPlaceRoute.connections.size());
+                EXPECT_TRUE(std::equal(route.connections.begin(), route.connections.end(), inPlaceRoute.connections.begin()));
+            }
+        }
+    }
+
+    // the search tree is only discarded when the destination changes
+    EXPECT_EQ(graph.segments().size(), planner.counters().numSearchResets);
+}
+
+void checkBlockedConnections(const LabyrinthGraph& graph, const Connection& prevConn, const Segment& src, const Segment& dest) {
+    const CompiledLabyrinthGraph compiledGraph = compile(graph);
+    LabyrinthRoutePlanner planner(compiledGraph, true);
+    LabyrinthRoute route = planner.create(prevConn, src, dest);
+    ASSERT_GT(route.connections.size(), 0);
+
+    // blocks the connections of the planned route one by one, and compares the repaired route to a route planned from scratch
+    for (uint32_t i = 0; i < 3 && route.connections.size() > 0; ++i) {
+        const Connection& blockedConn = *route.connections[route.connections.size() / 2];
+        planner.setBlocked(blockedConn, true);
+
+        route = planner.create(prevConn, src, dest);
+        EXPECT_EQ(1, planner.counters().numSearchResets);
+
+        LabyrinthRoutePlanner expectedPlanner(compiledGraph, true);
+        for (const Connection& conn : graph.connections()) {
+            expectedPlanner.setBlocked(conn, planner.isBlocked(conn));
+        }
+        const LabyrinthRoute expected = expectedPlanner.create(prevConn, src, dest);
+
+        ASSERT_EQ(expected.connections.size() > 0, route.connections.size() > 0);
+        EXPECT_NEAR(routeCost(prevConn, src, expected, true).get(), routeCost(prevConn, src, route, true).get(), 0.001f);
+
+        for (const Connection *c : route.connections) {
+            EXPECT_FALSE(planner.isBlocked(*c));
+        }
+    }
+}
+
+} // namespace
+
+TEST(labyrinthRoutePlanner, race_labyrinth) {
+    LabyrinthGraph graph = buildRaceLabyrinthGraph();
+    checkAllRoutes(graph, true);
+    checkAllRoutes(graph, false);
+}
+
+TEST(labyrinthRoutePlanner, test_labyrinth) {
+    LabyrinthGraph graph = buildTestLabyrinthGraph();
+    checkAllRoutes(graph, true);
+    checkAllRoutes(graph, false);
+}
+
+TEST(labyrinthRoutePlanner, start_segment_change) {
+    LabyrinthGraph graph = buildTestLabyrinthGraph();
+    const CompiledLabyrinthGraph compiledGraph = compile(graph);
+    LabyrinthRoutePlanner planner(compiledGraph, true);
+
+    const Segment& dest = *graph.findSegment('A');
+    const Connection& prevConn = graph.connections()[0];
+    planner.create(prevConn, *prevConn.node2, dest);
+    EXPECT_GT(planner.counters().lastNumExpansions, 0);
+
+    // the search tree is already consistent, only the route needs to be read from it
+    const Connection& newPrevConn = graph.connections()[graph.connections().size() - 1];
+    planner.create(newPrevConn, *newPrevConn.node1, dest);
+    EXPECT_EQ(0, planner.counters().lastNumExpansions);
+    EXPECT_EQ(0, planner.counters().lastNumUpdates);
+    EXPECT_EQ(1, planner.counters().numSearchResets);
+    EXPECT_EQ(2, planner.counters().numReplans);
+}
+
+TEST(labyrinthRoutePlanner, blocked_connections) {
+    LabyrinthGraph graph = buildTestLabyrinthGraph();
+    const Segment& src  = *graph.findSegment('W');
+    const Segment& dest = *graph.findSegment('A');
+    checkBlockedConnections(graph, *graph.findConnection(*graph.findSegment('M'), src), src, dest);
+}
+
+TEST(labyrinthRoutePlanner, unblock_connection) {
+    LabyrinthGraph graph = buildTestLabyrinthGraph();
+    const CompiledLabyrinthGraph compiledGraph = compile(graph);
+    LabyrinthRoutePlanner planner(compiledGraph, true);
+
+    const Segment& src = *graph.findSegment('W');
+    const Segment& dest = *graph.findSegment('A');
+    const Connection& prevConn = *graph.findConnection(*graph.findSegment('M'), src);
+
+    const LabyrinthRoute expected = planner.create(prevConn, src, dest);
+    ASSERT_GT(expected.connections.size(), 0);
+
+    const Connection& blockedConn = *expected.connections[0];
+    planner.setBlocked(blockedConn, true);
+    planner.create(prevConn, src, dest);
+
+    planner.setBlocked(blockedConn, false);
+    const LabyrinthRoute route = planner.create(prevConn, src, dest);
+    EXPECT_NEAR(routeCost(prevConn, src, expected, true).get(), routeCost(prevConn, src, route, true).get(), 0.001f);
+}
@@ -0,0 +1,100 @@
+#include <micro/test/utils.hpp>
+
+#include <LabyrinthRoute.hpp>
+#include <LabyrinthRouteTable.hpp>
+#include <track.hpp>
+
+#include "benchmark.hpp"
+#include "route.hpp"
+
+using namespace micro;
+
+namespace {
+
+template <typename F>
+void forEachRoute(const LabyrinthGraph& graph, F func) {
+    for (const Connection& prevConn : graph.connections()) {
+        for (const Segment *src : { prevConn.node1, prevConn.node2 }) {
+            for (const Segment& dest : graph.segments()) {
+                func(prevConn, *src, dest);
+            }
+        }
+    }
+}
+
+void checkAllRoutes(const LabyrinthGraph& graph, const bool allowBackwardNavigation) {
+    LabyrinthRouteTable routeTable(graph, allowBackwardNavigation);
+    routeTable.build();
+
+    forEachRoute(graph, [&routeTable, allowBackwardNavigation](const Connection& prevConn, const Segment& src, const Segment& dest) {
+        const LabyrinthRoute expected = createRoute(prevConn, src, dest, allowBackwardNavigation);
+        const LabyrinthRoute route    = routeTable.create(prevConn, src, dest);
+
+        // an unreachable destination results in an empty route
+        if (&src != &dest && 0 == expected.connections.size()) {
+            EXPECT_EQ(0, route.connections.size());
+            return;
+        }
+
+        ASSERT_EQ(&src, route.startSeg);
+        ASSERT_EQ(&dest, route.destSeg);
+        EXPECT_LE(routeCost(prevConn, src, route, allowBackwardNavigation).get(),
+            routeCost(prevConn, src, expected, allowBackwardNavigation).get() + 0.001f);
+    });
+}
+
+void benchmarkAllRoutes(const LabyrinthGraph& graph, const char *graphName) {
+    LabyrinthRouteTable routeTable(graph, true);
+    routeTable.build();
+
+    uint32_t numRoutes = 0;
+    forEachRoute(graph, [&numRoutes](const Connection&, const Segment&, const Segment&) { ++numRoutes; });
+
+    const double dijkstraTime = benchmark(10, [&graph]() {
+        forEachRoute(graph, [](const Connection& prevConn, const Segment& src, const Segment& dest) {
+            volatile uint32_t size = createRoute(prevConn, src, dest, true).connections.size();
+            (void)size;
+        });
+    }) / numRoutes;
+
+    const double tableTime = benchmark(10, [&graph, &routeTable]() {
+        forEachRoute(graph, [&routeTable](const Connection& prevConn, const Segment& src, const Segment& dest) {
+            volatile uint32_t size = routeTable.create(prevConn, src, dest).connections.size();
+            (void)size;
+        });
+    }) / numRoutes;
+
+    const double buildTime = benchmark(10, [&routeTable]() { routeTable.build(); });
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s: Dijkstra route", graphName);
+    printBenchmark(name, dijkstraTime);
+    snprintf(name, sizeof(name), "%s: route table lookup", graphName);
+    printBenchmark(name, tableTime);
+    snprintf(name, sizeof(name), "%s: route table build", graphName);
+    printBenchmark(name, buildTime);
+}
+
+} // namespace
+
+TEST(labyrinthRouteTable, race_labyrinth) {
+    LabyrinthGraph graph = buildRaceLabyrinthGraph();
+    checkAllRoutes(graph, true);
+    checkAllRoutes(graph, false);
+}
+
+TEST(labyrinthRouteTable, test_labyrinth) {
+    LabyrinthGraph graph = buildTestLabyrinthGraph();
+    checkAllRoutes(graph, true);
+    checkAllRoutes(graph, false);
+}
+
+TEST(labyrinthRouteTable, benchmark_race_labyrinth) {
+    LabyrinthGraph graph = buildRaceLabyrinthGraph();
+    benchmarkAllRoutes(graph, "race_labyrinth");
+}
+
+TEST(labyrinthRouteTable, benchmark_test_labyrinth) {
+    LabyrinthGraph graph = buildTestLabyrinthGraph();
+    benchmarkAllRoutes(graph, "test_labyrinth");
+}
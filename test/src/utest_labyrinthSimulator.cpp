@@ -0,0 +1,133 @@
+#include <micro/test/utils.hpp>
+
+#include <LabyrinthNavigator.hpp>
+#include <track.hpp>
+
+#include "LabyrinthSimulator.hpp"
+#include "benchmark.hpp"
+
+#include <random>
+
+using namespace micro;
+
+namespace {
+
+constexpr m_per_sec_t LABYRINTH_SPEED          = m_per_sec_t(1.0f);
+constexpr m_per_sec_t LABYRINTH_FAST_SPEED     = m_per_sec_t(1.2f);
+constexpr m_per_sec_t LABYRINTH_DEAD_END_SPEED = m_per_sec_t(0.85f);
+
+struct MissionStats {
+    uint32_t numMissions         = 0;
+    uint32_t numFinished         = 0;
+    uint32_t numMisnavigations   = 0;
+    m_per_sec_t maxJunctionSpeed = m_per_sec_t(0);
+
+    void add(const LabyrinthSimulator::Result& result) {
+        ++this->numMissions;
+        this->numFinished       += result.isFinished ? 1 : 0;
+        this->numMisnavigations += result.numMisnavigations;
+        this->maxJunctionSpeed   = std::max(this->maxJunctionSpeed, result.maxJunctionSpeed);
+    }
+};
+
+struct SimulatorFixture {
+    const LabyrinthGraph graph;
+    const Segment& startSeg;
+    const Connection& prevConn;
+    const Segment& laneChangeSeg;
+    m_per_sec_t fastSpeed;
+
+    SimulatorFixture()
+        : graph(buildTestLabyrinthGraph())
+        , startSeg(*graph.findSegment('W'))
+        , prevConn(*graph.findConnection(*graph.findSegment('M'), startSeg))
+        , laneChangeSeg(*graph.findSegment('N'))
+        , fastSpeed(LABYRINTH_FAST_SPEED) {}
+
+    LabyrinthSimulator::Result run(const LabyrinthSimulator::Config& config, const uint32_t seed, const LabyrinthSimulator::Mission& mission) const {
+        LabyrinthNavigator navigator(this->graph, &this->startSeg, &this->prevConn, &this->laneChangeSeg, LABYRINTH_SPEED, this->fastSpeed, LABYRINTH_DEAD_END_SPEED);
+        LabyrinthSimulator simulator(this->graph, this->startSeg, this->prevConn, this->laneChangeSeg, config, seed);
+        EXPECT_EQ(Status::OK, simulator.status());
+        return simulator.run(navigator, mission);
+    }
+
+    // random gate segments, a segment is never the same as the previous target
+    LabyrinthSimulator::Mission randomMission(std::mt19937& random) const {
+        LabyrinthSimulator::Mission mission;
+        const uint32_t numTargets = std::uniform_int_distribution<uint32_t>(1, 5)(random);
+
+        while (mission.targets.size() < numTargets) {
+            const Segment *seg = &this->graph.segments()[std::uniform_int_distribution<uint32_t>(0, this->graph.segments().size() - 1)(random)];
+            if (seg != &this->laneChangeSeg && seg != &this->startSeg && (mission.targets.empty() || seg != mission.targets.back())) {
+                mission.targets.push_back(seg);
+            }
+        }
+        return mission;
+    }
+
+    MissionStats runRandomMissions(const LabyrinthSimulator::Config& config, const uint32_t numMissions) const {
+        std::mt19937 random(numMissions);
+        MissionStats stats;
+        for (uint32_t i = 0; i < numMissions; ++i) {
+            stats.add(this->run(config, i, this->randomMission(random)));
+        }
+        return stats;
+    }
+};
+
+} // namespace
+
+TEST(labyrinthSimulator, lane_change) {
+    SimulatorFixture fixture;
+
+    const LabyrinthSimulator::Result result = fixture.run(LabyrinthSimulator::Config(), 0, {});
+    EXPECT_TRUE(result.isFinished);
+    EXPECT_FALSE(result.isOffTrack);
+    EXPECT_EQ(0, result.numMisnavigations);
+}
+
+TEST(labyrinthSimulator, dead_end) {
+    SimulatorFixture fixture;
+
+    const LabyrinthSimulator::Result result = fixture.run(LabyrinthSimulator::Config(), 0, { { fixture.graph.findSegment('O') } });
+    EXPECT_TRUE(result.isFinished);
+    EXPECT_FALSE(result.isOffTrack);
+    EXPECT_EQ(0, result.numMisnavigations);
+}
+
+TEST(labyrinthSimulator, random_missions) {
+    SimulatorFixture fixture;
+
+    MissionStats stats;
+    const double time_us = benchmark(1, [&fixture, &stats]() {
+        stats = fixture.runRandomMissions(LabyrinthSimulator::Config(), 200);
+    });
+
+    printBenchmark("labyrinthSimulator: 200 random missions", time_us);
+
+    EXPECT_EQ(stats.numMissions, stats.numFinished);
+    EXPECT_EQ(0, stats.numMisnavigations);
+}
+
+TEST(labyrinthSimulator, random_missions_brake_for_junctions) {
+    SimulatorFixture fixture;
+    fixture.fastSpeed = m_per_sec_t(2.0f);
+
+    const MissionStats stats = fixture.runRandomMissions(LabyrinthSimulator::Config(), 200);
+
+    EXPECT_EQ(stats.numMissions, stats.numFinished);
+    EXPECT_EQ(0, stats.numMisnavigations);
+    EXPECT_LE(stats.maxJunctionSpeed, LABYRINTH_SPEED + m_per_sec_t(0.05f));
+}
+
+TEST(labyrinthSimulator, random_missions_with_sensor_errors) {
+    SimulatorFixture fixture;
+
+    LabyrinthSimulator::Config config;
+    config.odometryDrift           = 0.1f;
+    config.misdetectionProbability = 0.1f;
+
+    const MissionStats stats = fixture.runRandomMissions(config, 200);
+
+    EXPECT_GE(stats.numFinished, stats.numMissions * 9 / 10);
+}
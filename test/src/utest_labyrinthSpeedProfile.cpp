@@ -0,0 +1,47 @@
+#include <micro/test/utils.hpp>
+
+#include <LabyrinthSpeedProfile.hpp>
+
+#include <cmath>
+
+using namespace micro;
+
+TEST(labyrinthSpeedProfile, braking_speed) {
+    const LabyrinthSpeedProfile profile(2.0f, 3.0f);
+
+    // v^2 = 1^2 + 2 * 3 * 0.5
+    EXPECT_NEAR(2.0f, profile.brakingSpeed(m_per_sec_t(1), centimeter_t(50)).get(), 0.0001f);
+    EXPECT_NEAR(std::sqrt(3.0f), profile.brakingSpeed(m_per_sec_t(0), centimeter_t(50)).get(), 0.0001f);
+
+    // the speed limit point is reached or has already been passed
+    EXPECT_NEAR(1.0f, profile.brakingSpeed(m_per_sec_t(1), meter_t(0)).get(), 0.0001f);
+    EXPECT_NEAR(1.0f, profile.brakingSpeed(m_per_sec_t(1), centimeter_t(-20)).get(), 0.0001f);
+}
+
+TEST(labyrinthSpeedProfile, ramp_time) {
+    const LabyrinthSpeedProfile profile(2.0f, 3.0f);
+
+    EXPECT_NEAR(500.0f, profile.rampTime(m_per_sec_t(1), m_per_sec_t(2)).get(), 0.01f);
+    EXPECT_NEAR(500.0f, profile.rampTime(m_per_sec_t(-1), m_per_sec_t(-2)).get(), 0.01f);
+    EXPECT_NEAR(333.33f, profile.rampTime(m_per_sec_t(2), m_per_sec_t(1)).get(), 0.01f);
+    EXPECT_NEAR(0.0f, profile.rampTime(m_per_sec_t(1), m_per_sec_t(1)).get(), 0.01f);
+}
+
+TEST(labyrinthSpeedProfile, travel_time) {
+    const LabyrinthSpeedProfile profile(2.0f, 3.0f);
+
+    // constant speed
+    EXPECT_NEAR(2.0f, profile.travelTime(meter_t(2), m_per_sec_t(1), m_per_sec_t(1), m_per_sec_t(1)).get(), 0.0001f);
+
+    // accelerates in 0.75m and 0.5s, brakes in 0.5m and 0.333s, the remaining 0.75m is driven at maximum speed
+    EXPECT_NEAR(0.5f + 0.3333f + 0.375f, profile.travelTime(meter_t(2), m_per_sec_t(1), m_per_sec_t(2), m_per_sec_t(1)).get(), 0.0001f);
+
+    // the maximum speed is not reached: v^2 = (2 * 2 * 3 * 0.5 + 3 * 1 + 2 * 1) / 5 = 2.2
+    const float peakSpeed = std::sqrt(2.2f);
+    EXPECT_NEAR((peakSpeed - 1.0f) / 2.0f + (peakSpeed - 1.0f) / 3.0f, profile.travelTime(centimeter_t(50), m_per_sec_t(1), m_per_sec_t(2), m_per_sec_t(1)).get(), 0.0001f);
+
+    // too short for braking to the end speed
+    EXPECT_NEAR(0.1f / 3.0f, profile.travelTime(centimeter_t(5), m_per_sec_t(2), m_per_sec_t(2), m_per_sec_t(1)).get(), 0.0001f);
+
+    EXPECT_NEAR(0.0f, profile.travelTime(meter_t(0), m_per_sec_t(1), m_per_sec_t(2), m_per_sec_t(1)).get(), 0.0001f);
+}
@@ -0,0 +1,140 @@
+#include <micro/test/utils.hpp>
+
+#include <CompiledLabyrinthGraph.hpp>
+#include <LabyrinthRouteCost.hpp>
+#include <LabyrinthRoutePlanner.hpp>
+#include <LabyrinthTourPlanner.hpp>
+#include <track.hpp>
+
+#include "route.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace micro;
+
+namespace {
+
+const LabyrinthTimeCost timeCost(m_per_sec_t(1), m_per_sec_t(1.2f), m_per_sec_t(0.85f), LabyrinthSpeedProfile(2.0f, 3.0f), millisecond_t(300), millisecond_t(100));
+
+struct TourFixture {
+    const LabyrinthGraph graph;
+    const CompiledLabyrinthGraph compiledGraph;
+    LabyrinthRoutePlanner routePlanner;
+    LabyrinthRoutePlanner legPlanner;
+    const Segment& startSeg;
+    const Connection& prevConn;
+    const Segment& finalSeg;
+
+    TourFixture()
+        : graph(buildTestLabyrinthGraph())
+        , compiledGraph(compile(graph))
+        , routePlanner(compiledGraph, true, timeCost)
+        , legPlanner(compiledGraph, true, timeCost)
+        , startSeg(*graph.findSegment('W'))
+        , prevConn(*graph.findConnection(*graph.findSegment('M'), startSeg))
+        , finalSeg(*graph.findSegment('N')) {}
+
+    // backward navigation is allowed, so the route from the middle of a target does not depend on how the target was approached
+    float legCost(const Segment& src, const Segment& dest) {
+        return this->legPlanner.routeCost(*src.edges[0], src, dest);
+    }
+
+    float tourCost(const LabyrinthTourPlanner::Targets& order) {
+        float cost = this->legPlanner.routeCost(this->prevConn, this->startSeg, order.size() ? *order[0] : this->finalSeg);
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            cost += this->legCost(*order[i], i + 1 < order.size() ? *order[i + 1] : this->finalSeg);
+        }
+        return cost;
+    }
+
+    float bruteForceTourCost(LabyrinthTourPlanner::Targets targets) {
+        std::sort(targets.begin(), targets.end());
+        float cost = std::numeric_limits<float>::infinity();
+        do {
+            cost = std::min(cost, this->tourCost(targets));
+        } while (std::next_permutation(targets.begin(), targets.end()));
+        return cost;
+    }
+
+    float greedyTourCost(const LabyrinthTourPlanner::Targets& targets) {
+        LabyrinthTourPlanner::Targets remaining = targets, order;
+        const Segment *seg = nullptr;
+
+        while (remaining.size()) {
+            auto next = remaining.begin();
+            for (auto it = remaining.begin(); it != remaining.end(); ++it) {
+                const float cost     = seg ? this->legCost(*seg, **it) : this->legPlanner.routeCost(this->prevConn, this->startSeg, **it);
+                const float nextCost = seg ? this->legCost(*seg, **next) : this->legPlanner.routeCost(this->prevConn, this->startSeg, **next);
+                if (cost < nextCost) {
+                    next = it;
+                }
+            }
+            seg = *next;
+            order.push_back(seg);
+            remaining.erase(next);
+        }
+
+        return this->tourCost(order);
+    }
+
+    LabyrinthTourPlanner::Targets targets(const char *names) const {
+        LabyrinthTourPlanner::Targets result;
+        for (const char *name = names; *name; ++name) {
+            result.push_back(this->graph.findSegment(*name));
+        }
+        return result;
+    }
+};
+
+bool containsAll(const LabyrinthTourPlanner::Targets& tour, const LabyrinthTourPlanner::Targets& targets) {
+    for (const Segment *seg : targets) {
+        if (std::count(tour.begin(), tour.end(), seg) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(labyrinthTourPlanner, no_targets) {
+    TourFixture fixture;
+    LabyrinthTourPlanner tourPlanner;
+
+    const LabyrinthTourPlanner::Tour tour = tourPlanner.create(fixture.routePlanner, fixture.prevConn, fixture.startSeg, {}, fixture.finalSeg);
+    EXPECT_EQ(0, tour.targets.size());
+    EXPECT_NEAR(fixture.legPlanner.routeCost(fixture.prevConn, fixture.startSeg, fixture.finalSeg), tour.cost, 0.001f);
+}
+
+TEST(labyrinthTourPlanner, optimal_order) {
+    TourFixture fixture;
+    LabyrinthTourPlanner tourPlanner;
+
+    for (const char *names : { "A", "KB", "JDS", "OEIA", "BQVHT", "CAUOGL", "DKQSIFV" }) {
+        const LabyrinthTourPlanner::Targets targets = fixture.targets(names);
+        const LabyrinthTourPlanner::Tour tour = tourPlanner.create(fixture.routePlanner, fixture.prevConn, fixture.startSeg, targets, fixture.finalSeg);
+
+        ASSERT_EQ(targets.size(), tour.targets.size());
+        EXPECT_TRUE(containsAll(tour.targets, targets));
+        EXPECT_NEAR(fixture.tourCost(tour.targets), tour.cost, 0.001f);
+        EXPECT_NEAR(fixture.bruteForceTourCost(targets), tour.cost, 0.001f);
+        EXPECT_LE(tour.cost, fixture.greedyTourCost(targets) + 0.001f);
+    }
+}
+
+TEST(labyrinthTourPlanner, gate_segments) {
+    TourFixture fixture;
+    LabyrinthTourPlanner tourPlanner;
+
+    // more targets than the ones ordered optimally, the first ones are selected greedily
+    const LabyrinthTourPlanner::Targets targets = fixture.targets("ABCDEFGHIJKLOPQ");
+    ASSERT_GT(targets.size(), LabyrinthTourPlanner::MAX_NUM_EXACT_TARGETS);
+
+    const LabyrinthTourPlanner::Tour tour = tourPlanner.create(fixture.routePlanner, fixture.prevConn, fixture.startSeg, targets, fixture.finalSeg);
+
+    ASSERT_EQ(targets.size(), tour.targets.size());
+    EXPECT_TRUE(containsAll(tour.targets, targets));
+    EXPECT_NEAR(fixture.tourCost(tour.targets), tour.cost, 0.001f);
+    EXPECT_LE(tour.cost, fixture.greedyTourCost(targets) + 0.001f);
+}
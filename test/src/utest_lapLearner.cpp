@@ -0,0 +1,121 @@
+#include <micro/test/utils.hpp>
+
+#include <cfg_track.hpp>
+#include <LapLearner.hpp>
+
+using namespace micro;
+
+namespace {
+
+// two sections: fast segments 1 and 4, slow segments 0 (belongs to the last section), 2 and 3
+const TrackSegments segments = {
+    { false, meter_t(2), TrackTrigger::Distance, {}, {} },
+    { true,  meter_t(5), TrackTrigger::Distance, {}, {} },
+    { false, meter_t(3), TrackTrigger::Distance, {}, {} },
+    { false, meter_t(2), TrackTrigger::Distance, {}, {} },
+    { true,  meter_t(5), TrackTrigger::Distance, {}, {} }
+};
+
+CarProps carWithSpeed(const m_per_sec_t speed) {
+    CarProps car;
+    car.speed = speed;
+    return car;
+}
+
+/* @brief Records a lap with the given peak line errors of the segments, the car reaching the target speed everywhere.
+ */
+void recordLap(LapLearner& learner, const std::initializer_list<meter_t> lineErrors) {
+    uint32_t i = 0;
+    for (const meter_t lineError : lineErrors) {
+        learner.update(i, carWithSpeed(m_per_sec_t(3)), meter_t(0), m_per_sec_t(3));
+        learner.update(i, carWithSpeed(m_per_sec_t(3)), -lineError, m_per_sec_t(3));
+        learner.onSegmentFinished(i, millisecond_t(1000));
+        ++i;
+    }
+    learner.onLapFinished(millisecond_t(5000));
+}
+
+} // namespace
+
+TEST(lapLearner, sections) {
+    LapLearner learner(segments);
+    EXPECT_EQ(1, learner.sectionIndex(0));
+    EXPECT_EQ(0, learner.sectionIndex(1));
+    EXPECT_EQ(0, learner.sectionIndex(2));
+    EXPECT_EQ(0, learner.sectionIndex(3));
+    EXPECT_EQ(1, learner.sectionIndex(4));
+}
+
+TEST(lapLearner, segment_stats) {
+    LapLearner learner(segments);
+    learner.update(2, carWithSpeed(m_per_sec_t(-2)), centimeter_t(3), m_per_sec_t(-2.5f));
+    learner.update(2, carWithSpeed(m_per_sec_t(1)), centimeter_t(-4), m_per_sec_t(1));
+    learner.onSegmentFinished(2, millisecond_t(700));
+
+    const LapLearner::SegmentStats& stats = learner.segmentStats(2);
+    EXPECT_NEAR_UNIT(centimeter_t(4), stats.peakLineError, centimeter_t(0.01f));
+    EXPECT_EQ(m_per_sec_t(2), stats.maxSpeed);
+    EXPECT_EQ(m_per_sec_t(2.5f), stats.maxTargetSpeed);
+    EXPECT_EQ(millisecond_t(700), stats.time);
+
+    learner.onLapFinished(millisecond_t(10000));
+    EXPECT_EQ(meter_t(0), learner.segmentStats(2).peakLineError);
+    EXPECT_EQ(millisecond_t(10000), learner.lastLapTime());
+}
+
+TEST(lapLearner, adjusts_sections) {
+    LapLearner learner(segments);
+
+    // section 0: low errors everywhere, section 1: too high error in the slow segment
+    recordLap(learner, { centimeter_t(12), centimeter_t(2), centimeter_t(3), centimeter_t(1), centimeter_t(2) });
+    EXPECT_NEAR_UNIT(cfg::RACE_LEARNING_SPEED_STEP, learner.sections()[0].fastSpeedDelta, m_per_sec_t(0.001f));
+    EXPECT_NEAR_UNIT(cfg::RACE_LEARNING_BRAKE_OFFSET_STEP, learner.sections()[0].brakeOffsetDelta, centimeter_t(0.01f));
+    EXPECT_NEAR_UNIT(m_per_sec_t(0), learner.sections()[1].fastSpeedDelta, m_per_sec_t(0.001f));
+    EXPECT_NEAR_UNIT(meter_t(-2 * cfg::RACE_LEARNING_BRAKE_OFFSET_STEP), learner.sections()[1].brakeOffsetDelta, centimeter_t(0.01f));
+
+    // section 0: too high error in the fast segment
+    recordLap(learner, { centimeter_t(1), centimeter_t(11), centimeter_t(3), centimeter_t(1), centimeter_t(2) });
+    EXPECT_NEAR_UNIT(m_per_sec_t(-cfg::RACE_LEARNING_SPEED_STEP), learner.sections()[0].fastSpeedDelta, m_per_sec_t(0.001f));
+    EXPECT_NEAR_UNIT(meter_t(2 * cfg::RACE_LEARNING_BRAKE_OFFSET_STEP), learner.sections()[0].brakeOffsetDelta, centimeter_t(0.01f));
+    EXPECT_NEAR_UNIT(cfg::RACE_LEARNING_SPEED_STEP, learner.sections()[1].fastSpeedDelta, m_per_sec_t(0.001f));
+    EXPECT_NEAR_UNIT(meter_t(-cfg::RACE_LEARNING_BRAKE_OFFSET_STEP), learner.sections()[1].brakeOffsetDelta, centimeter_t(0.01f));
+}
+
+TEST(lapLearner, speed_not_reached) {
+    LapLearner learner(segments);
+
+    for (uint32_t i = 0; i < segments.size(); ++i) {
+        learner.update(i, carWithSpeed(m_per_sec_t(2)), centimeter_t(1), m_per_sec_t(3));
+        learner.onSegmentFinished(i, millisecond_t(1000));
+    }
+    learner.onLapFinished(millisecond_t(5000));
+
+    // increasing the target speed has no effect if the car cannot reach it
+    EXPECT_EQ(m_per_sec_t(0), learner.sections()[0].fastSpeedDelta);
+    EXPECT_NEAR_UNIT(cfg::RACE_LEARNING_BRAKE_OFFSET_STEP, learner.sections()[0].brakeOffsetDelta, centimeter_t(0.01f));
+}
+
+TEST(lapLearner, partial_lap) {
+    LapLearner learner(segments);
+
+    // only section 0 is recorded
+    recordLap(learner, { centimeter_t(1), centimeter_t(1), centimeter_t(1), centimeter_t(1) });
+    EXPECT_NEAR_UNIT(cfg::RACE_LEARNING_SPEED_STEP, learner.sections()[0].fastSpeedDelta, m_per_sec_t(0.001f));
+    EXPECT_EQ(m_per_sec_t(0), learner.sections()[1].fastSpeedDelta);
+    EXPECT_EQ(meter_t(0), learner.sections()[1].brakeOffsetDelta);
+}
+
+TEST(lapLearner, bounds) {
+    LapLearner learner(segments);
+
+    for (uint32_t lap = 0; lap < 100; ++lap) {
+        recordLap(learner, { centimeter_t(1), centimeter_t(1), centimeter_t(1), centimeter_t(1), centimeter_t(1) });
+    }
+    EXPECT_NEAR_UNIT(cfg::RACE_LEARNING_MAX_SPEED_DELTA, learner.sections()[0].fastSpeedDelta, m_per_sec_t(0.001f));
+    EXPECT_NEAR_UNIT(cfg::RACE_LEARNING_MAX_BRAKE_OFFSET_DELTA, learner.sections()[0].brakeOffsetDelta, centimeter_t(0.01f));
+
+    LapLearner::Sections sections = {};
+    sections[1].fastSpeedDelta = m_per_sec_t(-10);
+    learner.setSections(sections);
+    EXPECT_NEAR_UNIT(m_per_sec_t(-cfg::RACE_LEARNING_MAX_SPEED_DELTA), learner.sections()[1].fastSpeedDelta, m_per_sec_t(0.001f));
+}
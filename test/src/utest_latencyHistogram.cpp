@@ -0,0 +1,69 @@
+#include <micro/test/utils.hpp>
+
+#include <LatencyHistogram.hpp>
+#include <LatencyHistogramDecoder.hpp>
+
+using namespace micro;
+
+TEST(latencyHistogram, bins) {
+    LatencyHistogram histogram;
+
+    histogram.add(microsecond_t(50));
+    histogram.add(microsecond_t(125));
+    histogram.add(microsecond_t(300));
+    histogram.add(microsecond_t(499));
+    histogram.add(microsecond_t(20000));
+
+    EXPECT_EQ(5, histogram.numSamples());
+    EXPECT_EQ(1, histogram.count(0));
+    EXPECT_EQ(1, histogram.count(1));
+    EXPECT_EQ(2, histogram.count(2));
+    EXPECT_EQ(1, histogram.count(LatencyHistogram::NUM_BINS - 1));
+    EXPECT_EQ(microsecond_t(20000), histogram.max());
+
+    histogram.reset();
+    EXPECT_EQ(0, histogram.numSamples());
+    EXPECT_EQ(microsecond_t(0), histogram.max());
+}
+
+TEST(latencyHistogram, percentile) {
+    LatencyHistogram histogram;
+
+    for (uint32_t i = 0; i < 90; ++i) {
+        histogram.add(microsecond_t(100));
+    }
+    for (uint32_t i = 0; i < 9; ++i) {
+        histogram.add(microsecond_t(700));
+    }
+    histogram.add(microsecond_t(12000));
+
+    EXPECT_EQ(microsecond_t(125), histogram.percentile(0.5f));
+    EXPECT_EQ(microsecond_t(125), histogram.percentile(0.9f));
+    EXPECT_EQ(microsecond_t(1000), histogram.percentile(0.99f));
+    EXPECT_EQ(microsecond_t(12000), histogram.percentile(1.0f));
+}
+
+TEST(latencyHistogram, decode) {
+    const std::string params =
+        "{\"targetSpeed\":1.5,"
+        "\"lineSend0\":0,\"lineSend1\":12,\"lineSend2\":80,\"lineSend3\":7,"
+        "\"lineSend4\":1,\"lineSend5\":0,\"lineSend6\":0,\"lineSend7\":0,\"lineSendMax\":1400.5,"
+        "\"decSend0\":100}";
+
+    LatencyHistogram histogram;
+    ASSERT_TRUE(LatencyHistogramDecoder::decode(params, "lineSend", histogram));
+
+    EXPECT_EQ(100, histogram.numSamples());
+    EXPECT_EQ(0, histogram.count(0));
+    EXPECT_EQ(12, histogram.count(1));
+    EXPECT_EQ(80, histogram.count(2));
+    EXPECT_EQ(7, histogram.count(3));
+    EXPECT_EQ(1, histogram.count(4));
+    EXPECT_EQ(microsecond_t(1400.5f), histogram.max());
+    EXPECT_EQ(microsecond_t(500), histogram.percentile(0.9f));
+    EXPECT_EQ(microsecond_t(2000), histogram.percentile(1.0f));
+
+    // the decision to send histogram is incomplete
+    EXPECT_FALSE(LatencyHistogramDecoder::decode(params, "decSend", histogram));
+    EXPECT_FALSE(LatencyHistogramDecoder::decode(params, "lineDec", histogram));
+}
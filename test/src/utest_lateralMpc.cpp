@@ -0,0 +1,178 @@
+#include <micro/math/numeric.hpp>
+#include <micro/test/utils.hpp>
+
+#include <cfg_car.hpp>
+#include <LateralMpc.hpp>
+
+#include "benchmark.hpp"
+
+#include <cmath>
+
+using namespace micro;
+
+namespace {
+
+constexpr float SIM_STEP          = 0.001f;  // Integration time step of the simulation [s].
+constexpr uint32_t CONTROL_PERIOD = 5;       // Number of simulation steps between two controller updates.
+constexpr float SERVO_MAX_RATE    = 10.0f;   // Maximum angular speed of the steering servos [rad/s].
+
+const LateralMpc::Weights DEFAULT_WEIGHTS = { 400.0f, 10.0f, 1.0f };
+
+LateralMpc createMpc() {
+    return LateralMpc(cfg::CAR_FRONT_REAR_PIVOT_DIST, cfg::WHEEL_MAX_DELTA, millisecond_t(20), m_per_sec_t(8.0f), DEFAULT_WEIGHTS);
+}
+
+/* @brief Curvature of the synthetic test track: a straight, a 90 degree turn and an S-curve, followed by a straight.
+ * @param s The distance along the track [m]
+ */
+float trackCurvature(const float s) {
+    constexpr float R1 = 2.0f, R2 = 1.5f;
+    constexpr float PI_F = 3.14159265f;
+
+    float start = 3.0f;
+    if (s < start) return 0.0f;
+    if (s < (start += R1 * PI_F / 2)) return 1.0f / R1;
+    if (s < (start += 1.0f)) return 0.0f;
+    if (s < (start += R2 * PI_F / 3)) return 1.0f / R2;
+    if (s < (start += R2 * PI_F / 3)) return -1.0f / R2;
+    return 0.0f;
+}
+
+constexpr float TRACK_LENGTH = 3.0f + 2.0f * 3.14159265f / 2 + 1.0f + 2 * 1.5f * 3.14159265f / 3 + 3.0f;
+
+struct TrackingError {
+    float rms;  // RMS of the lateral error [m].
+    float max;  // Maximum of the lateral error [m].
+};
+
+/* @brief Simulates the car following the test track with the MPC, using the nonlinear four-wheel steering kinematic model
+ * in the path coordinate frame, with rate-limited steering servos.
+ * @param useCurvature Indicates if the controller knows the curvature of the track.
+ */
+TrackingError simulate(const LateralMpc& mpc, const m_per_sec_t speed, const bool useCurvature) {
+    const float v = speed.get();
+    const float L = cfg::CAR_FRONT_REAR_PIVOT_DIST.get();
+    const float maxDelta = cfg::WHEEL_MAX_DELTA.get();
+
+    float s = 0.0f, e = 0.05f, psi = 0.0f; // distance along the track, lateral offset of the car and its angle relative to the track
+    float df = 0.0f, dr = 0.0f;             // actual wheel angles
+    float dfTarget = 0.0f, drTarget = 0.0f; // target wheel angles
+
+    float sumSquares = 0.0f, maxError = 0.0f;
+    uint32_t numSamples = 0;
+
+    for (uint32_t i = 0; s < TRACK_LENGTH; ++i) {
+        const float k = trackCurvature(s);
+
+        if (0 == i % CONTROL_PERIOD) {
+            const LateralMpc::Output out = mpc.update(speed, meter_t(-e), radian_t(-psi), useCurvature ? k : 0.0f);
+            dfTarget = out.frontWheelAngle.get();
+            drTarget = out.rearWheelAngle.get();
+
+            // skips the initial transient
+            if (s > 1.0f) {
+                sumSquares += e * e;
+                maxError = std::max(maxError, std::abs(e));
+                ++numSamples;
+            }
+        }
+
+        const float maxDiff = SERVO_MAX_RATE * SIM_STEP;
+        df = clamp(df + clamp(dfTarget - df, -maxDiff, maxDiff), -maxDelta, maxDelta);
+        dr = clamp(dr + clamp(drTarget - dr, -maxDiff, maxDiff), -maxDelta, maxDelta);
+
+        const float beta   = std::atan((std::tan(df) + std::tan(dr)) / 2);
+        const float yawVel = v * std::cos(beta) * (std::tan(df) - std::tan(dr)) / L;
+        const float sVel   = v * std::cos(psi + beta) / (1.0f - k * e);
+
+        s   += sVel * SIM_STEP;
+        e   += v * std::sin(psi + beta) * SIM_STEP;
+        psi += (yawVel - k * sVel) * SIM_STEP;
+    }
+
+    return { std::sqrt(sumSquares / numSamples), maxError };
+}
+
+} // namespace
+
+TEST(lateralMpc, zero_error) {
+    const LateralMpc mpc = createMpc();
+    const LateralMpc::Output out = mpc.update(m_per_sec_t(3.0f), meter_t(0), radian_t(0), 0.0f);
+    EXPECT_EQ(radian_t(0), out.frontWheelAngle);
+    EXPECT_EQ(radian_t(0), out.rearWheelAngle);
+}
+
+TEST(lateralMpc, steers_towards_line) {
+    const LateralMpc mpc = createMpc();
+
+    // line on the left: both wheels turn left, the car moves sideways
+    const LateralMpc::Output posOut = mpc.update(m_per_sec_t(3.0f), centimeter_t(2), radian_t(0), 0.0f);
+    EXPECT_LT(radian_t(0), posOut.frontWheelAngle + posOut.rearWheelAngle);
+
+    // line turns left: the car turns left
+    const LateralMpc::Output angleOut = mpc.update(m_per_sec_t(3.0f), meter_t(0), degree_t(5), 0.0f);
+    EXPECT_LT(angleOut.rearWheelAngle, angleOut.frontWheelAngle);
+
+    // the curvature feed-forward turns the car in the direction of the curve
+    const LateralMpc::Output curveOut = mpc.update(m_per_sec_t(3.0f), meter_t(0), radian_t(0), 1.0f);
+    EXPECT_LT(curveOut.rearWheelAngle, curveOut.frontWheelAngle);
+
+    // the speed sign does not matter
+    const LateralMpc::Output reverseOut = mpc.update(m_per_sec_t(-3.0f), centimeter_t(2), radian_t(0), 0.0f);
+    EXPECT_NEAR_UNIT(posOut.frontWheelAngle, reverseOut.frontWheelAngle, radian_t(0.0001f));
+    EXPECT_NEAR_UNIT(posOut.rearWheelAngle, reverseOut.rearWheelAngle, radian_t(0.0001f));
+}
+
+TEST(lateralMpc, saturates_output) {
+    const LateralMpc mpc = createMpc();
+    const LateralMpc::Output out = mpc.update(m_per_sec_t(3.0f), meter_t(1), radian_t(0), 0.0f);
+    EXPECT_NEAR_UNIT(cfg::WHEEL_MAX_DELTA, out.frontWheelAngle, radian_t(0.0001f));
+    EXPECT_NEAR_UNIT(cfg::WHEEL_MAX_DELTA, out.rearWheelAngle, radian_t(0.0001f));
+}
+
+TEST(lateralMpc, compile) {
+    LateralMpc mpc = createMpc();
+    EXPECT_TRUE(mpc.isCompiled());
+
+    const LateralMpc::Output out = mpc.update(m_per_sec_t(3.0f), centimeter_t(2), radian_t(0), 0.0f);
+
+    // the edited weights are only applied when the gains are compiled
+    mpc.weights.pos *= 4;
+    EXPECT_FALSE(mpc.isCompiled());
+    const LateralMpc::Output notCompiledOut = mpc.update(m_per_sec_t(3.0f), centimeter_t(2), radian_t(0), 0.0f);
+    EXPECT_EQ(out.frontWheelAngle, notCompiledOut.frontWheelAngle);
+    EXPECT_EQ(out.rearWheelAngle, notCompiledOut.rearWheelAngle);
+
+    mpc.compile();
+    EXPECT_TRUE(mpc.isCompiled());
+    const LateralMpc::Output compiledOut = mpc.update(m_per_sec_t(3.0f), centimeter_t(2), radian_t(0), 0.0f);
+    EXPECT_LT(out.frontWheelAngle + out.rearWheelAngle, compiledOut.frontWheelAngle + compiledOut.rearWheelAngle);
+}
+
+TEST(lateralMpc, tracking) {
+    const LateralMpc mpc = createMpc();
+
+    for (const float speed : { 3.0f, 5.0f, 7.0f }) {
+        const TrackingError feedback = simulate(mpc, m_per_sec_t(speed), false);
+        const TrackingError feedforward = simulate(mpc, m_per_sec_t(speed), true);
+
+        EXPECT_GT(0.005f, feedback.rms);
+        EXPECT_GT(0.015f, feedback.max);
+        EXPECT_GT(0.005f, feedforward.rms);
+        EXPECT_GT(0.025f, feedforward.max);
+    }
+}
+
+TEST(lateralMpc, benchmark) {
+    LateralMpc mpc = createMpc();
+
+    volatile float sum = 0.0f;
+    float posError = 0.0f;
+    printBenchmark("LateralMpc::update", benchmark(100000, [&mpc, &sum, &posError]() {
+        posError = posError > 0.1f ? -0.1f : posError + 0.0001f;
+        const LateralMpc::Output out = mpc.update(m_per_sec_t(5.0f + posError), meter_t(posError), radian_t(posError), posError);
+        sum = sum + out.frontWheelAngle.get();
+    }));
+
+    printBenchmark("LateralMpc::compile", benchmark(100, [&mpc]() { mpc.compile(); }));
+}
@@ -0,0 +1,312 @@
+#include <micro/math/numeric.hpp>
+#include <micro/test/utils.hpp>
+
+#include <benchmark.hpp>
+#include <cfg_car.hpp>
+#include <RaceTrackReplay.hpp>
+#include <test_track_geometry.hpp>
+#include <track.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+using namespace micro;
+
+namespace {
+
+constexpr millisecond_t PERIOD                = millisecond_t(5);
+constexpr second_t TIMEOUT                    = second_t(600);
+constexpr meter_t NO_OBSTACLE_DISTANCE        = meter_t(3);
+constexpr meter_t SAFETY_CAR_START_DISTANCE   = meter_t(1);
+constexpr m_per_sec_t SAFETY_CAR_START_SPEED  = m_per_sec_t(0.5f);
+constexpr m_per_sec_t SAFETY_CAR_SPEED        = m_per_sec_t(1.0f);
+constexpr second_t SAFETY_CAR_START_TIME      = second_t(8);
+constexpr meter_t ACCELERATE_PATTERN_LENGTH   = centimeter_t(30);
+constexpr float SAFETY_CAR_LAPS               = 3.0f;  // The safety car leaves the track when the car starts its fourth lap.
+constexpr float SAFETY_CAR_LAPS_NO_OVERTAKE   = 0.3f;  // The safety car leaves the track in the second fast segment, before the overtake section.
+
+/* @brief Closed-loop kinematic model of the car and the safety car on the test track, used to record a race track log.
+ * The car follows the line exactly, its speed follows the target speed of the program with the acceleration limits of the car.
+ * The line sensors see the trigger patterns of the segments: ACCELERATE at the start of the fast segments,
+ * BRAKE along the brake segments, and SINGLE_LINE everywhere else.
+ * The safety car goes around the track until the car has covered the given number of laps, and it is only seen by the front distance sensor
+ * when it is close to the car. While the car is overtaking it, the car is beside the safety car, so it is not seen.
+ */
+class TrackModel {
+public:
+    explicit TrackModel(const float safetyCarLaps)
+        : safetyCarLaps_(safetyCarLaps)
+        , trackLength_(0)
+        , trackDist_(0)
+        , safetyCarDist_(SAFETY_CAR_START_DISTANCE)
+        , segIdx_(0)
+        , segDist_(0)
+        , time_(0) {
+
+        for (const TrackSegment& segment : testTrackSegments) {
+            this->trackLength_ += segment.length;
+        }
+
+        this->car_.pose.pos         = { meter_t(0), meter_t(0) };
+        this->car_.pose.angle       = radian_t(0);
+        this->car_.speed            = m_per_sec_t(0);
+        this->car_.distance         = meter_t(0);
+        this->car_.orientedDistance = meter_t(0);
+    }
+
+    RaceTrackReplay::Frame frame(const cfg::ProgramState programState) const {
+        RaceTrackReplay::Frame frame;
+        frame.time = this->time_;
+        frame.car  = this->car_;
+
+        const TrackSegment& segment = testTrackSegments[this->segIdx_];
+        const LinePattern::type_t pattern =
+            TrackTrigger::Accelerate == segment.trigger && this->segDist_ < ACCELERATE_PATTERN_LENGTH ? LinePattern::ACCELERATE :
+            TrackTrigger::BrakeSign == segment.trigger ? LinePattern::BRAKE : LinePattern::SINGLE_LINE;
+
+        for (LinesInfo *sensor : { &frame.lineInfo.front, &frame.lineInfo.rear }) {
+            sensor->pattern = { pattern, Sign::NEUTRAL, Direction::CENTER, meter_t(0) };
+            sensor->lines.push_back({ millimeter_t(0), 1 });
+        }
+
+        const meter_t gap = this->safetyCarDist_ - this->trackDist_;
+        const bool isSafetyCarVisible = this->isSafetyCarOnTrack() && cfg::ProgramState::OvertakeSafetyCar != programState &&
+                                        gap > meter_t(0) && gap < NO_OBSTACLE_DISTANCE;
+
+        frame.distances.front = isSafetyCarVisible ? gap : NO_OBSTACLE_DISTANCE;
+        frame.distances.rear  = NO_OBSTACLE_DISTANCE;
+        return frame;
+    }
+
+    void update(const ControlData& controlData) {
+        const second_t dt = PERIOD;
+        const m_per_sec_t targetSpeed = controlData.speed;
+
+        if (controlData.rampTime == millisecond_t(0)) {
+            this->car_.speed = targetSpeed;
+        } else {
+            const m_per_sec_t maxSpeedStep = m_per_sec_t((targetSpeed > this->car_.speed ? cfg::CAR_MAX_ACCELERATION : cfg::CAR_MAX_DECELERATION) * dt.get());
+            this->car_.speed += clamp(targetSpeed - this->car_.speed, -maxSpeedStep, maxSpeedStep);
+        }
+
+        const meter_t ds = this->car_.speed * dt;
+        advancePose(this->car_.pose, segmentCurvature(testTrackSegments, TEST_TRACK_TURN_ANGLES, this->segIdx_), ds);
+        this->car_.distance         += ds;
+        this->car_.orientedDistance  = 0 == TEST_TRACK_TURN_ANGLES[this->segIdx_] ? this->car_.orientedDistance + ds : meter_t(0);
+
+        this->trackDist_ += ds;
+        this->segDist_   += ds;
+        while (this->segDist_ >= testTrackSegments[this->segIdx_].length) {
+            this->segDist_ -= testTrackSegments[this->segIdx_].length;
+            this->segIdx_ = (this->segIdx_ + 1) % testTrackSegments.size();
+        }
+
+        const m_per_sec_t safetyCarSpeed = this->time_ < SAFETY_CAR_START_TIME ? SAFETY_CAR_START_SPEED : SAFETY_CAR_SPEED;
+        this->safetyCarDist_ += safetyCarSpeed * dt;
+
+        // the overtaken safety car gets in front of the car again when the car laps it
+        if (this->safetyCarDist_ < this->trackDist_ - meter_t(1)) {
+            this->safetyCarDist_ += this->trackLength_;
+        }
+
+        this->time_ += PERIOD;
+    }
+
+    millisecond_t time() const { return this->time_; }
+
+private:
+    bool isSafetyCarOnTrack() const {
+        return this->trackDist_ < this->trackLength_ * this->safetyCarLaps_;
+    }
+
+    const float safetyCarLaps_;
+    meter_t trackLength_;
+    meter_t trackDist_;     // Distance of the car along the track, from the start of the first lap.
+    meter_t safetyCarDist_; // Distance of the safety car along the track, from the start of the first lap of the car.
+    uint32_t segIdx_;
+    meter_t segDist_;
+    millisecond_t time_;
+    CarProps car_;
+};
+
+/* @brief Records a log of a race on the test track, driven by the race track program in closed loop.
+ * @param trace The trace of the program outputs while recording
+ * @param safetyCarLaps Number of laps of the car after which the safety car leaves the track
+ * @returns The recorded log - from the start until the car stops after the finish
+ */
+RaceTrackReplay::Log recordLog(RaceTrackReplay::Trace& trace, const float safetyCarLaps = SAFETY_CAR_LAPS) {
+    RaceTrackReplay::Log log;
+    log.programState             = cfg::ProgramState::ReachSafetyCar;
+    log.safetyCarFollowSpeedSign = Sign::POSITIVE;
+    log.testSpeed                = m_per_sec_t(1);
+
+    const std::unique_ptr<RaceTrackProgram> program(new RaceTrackProgram(testTrackSegments, testTrackProfile));
+    TrackModel model(safetyCarLaps);
+    cfg::ProgramState programState = log.programState;
+    RaceTrackProgram::Output output;
+    millisecond_t stopTime = micro::numeric_limits<millisecond_t>::infinity();
+
+    trace.clear();
+    while (model.time() < TIMEOUT && model.time() < stopTime + second_t(1)) {
+        const RaceTrackReplay::Frame frame = model.frame(programState);
+        log.frames.push_back(frame);
+
+        program->step({ programState, frame.time, frame.car, frame.lineInfo, frame.distances, log.safetyCarFollowSpeedSign, log.testSpeed }, output);
+        trace.push_back({ static_cast<uint32_t>(log.frames.size() - 1), programState, output.controlData, output.curvature });
+
+        if (cfg::ProgramState::Finish == programState && frame.car.speed == m_per_sec_t(0) && stopTime > model.time()) {
+            stopTime = model.time();
+        }
+
+        programState = output.programState;
+        model.update(output.controlData);
+    }
+
+    return log;
+}
+
+bool hasState(const RaceTrackReplay::Trace& trace, const cfg::ProgramState programState) {
+    return std::any_of(trace.begin(), trace.end(), [programState](const RaceTrackReplay::TraceRow& row) {
+        return row.programState == programState;
+    });
+}
+
+} // namespace
+
+TEST(raceTrackReplay, six_laps) {
+    RaceTrackReplay::Trace expected;
+    const RaceTrackReplay::Log log = recordLog(expected, SAFETY_CAR_LAPS_NO_OVERTAKE);
+
+    EXPECT_TRUE(hasState(expected, cfg::ProgramState::FollowSafetyCar));
+    EXPECT_FALSE(hasState(expected, cfg::ProgramState::OvertakeSafetyCar));
+    EXPECT_TRUE(hasState(expected, cfg::ProgramState::Race));
+    EXPECT_FALSE(hasState(expected, cfg::ProgramState::Error));
+    ASSERT_EQ(cfg::ProgramState::Finish, expected.back().programState);
+    EXPECT_EQ(m_per_sec_t(0), log.frames.back().car.speed);
+
+    // the golden trace has been recorded in the same closed-loop model, with the race track task logic
+    // before it was moved to RaceTrackProgram - the overtake is left out, because the maneuver follows a micro-utils trajectory
+    std::ifstream in(TEST_RESOURCES_DIR "/race_track_six_laps.trace");
+    RaceTrackReplay::Trace golden;
+    ASSERT_TRUE(RaceTrackReplay::read(in, golden));
+
+    RaceTrackReplay::DiffResult result = RaceTrackReplay::diff(expected, golden);
+    EXPECT_EQ(golden.size(), result.numCompared);
+    EXPECT_EQ(0, result.numMismatches) << "first mismatching frame: " << result.firstMismatch;
+
+    const RaceTrackReplay replay(testTrackSegments, testTrackProfile);
+    const RaceTrackReplay::Trace trace = replay.run(log);
+    ASSERT_EQ(expected.size(), trace.size());
+
+    result = RaceTrackReplay::diff(trace, expected, RaceTrackReplay::Tolerances{ m_per_sec_t(0), millimeter_t(0), radian_t(0), 0.0f });
+    EXPECT_EQ(expected.size(), result.numCompared);
+    EXPECT_EQ(0, result.numMismatches);
+}
+
+TEST(raceTrackReplay, safety_car_overtake) {
+    RaceTrackReplay::Trace expected;
+    const RaceTrackReplay::Log log = recordLog(expected);
+
+    EXPECT_TRUE(hasState(expected, cfg::ProgramState::FollowSafetyCar));
+    EXPECT_TRUE(hasState(expected, cfg::ProgramState::OvertakeSafetyCar));
+    EXPECT_TRUE(hasState(expected, cfg::ProgramState::Race));
+    EXPECT_FALSE(hasState(expected, cfg::ProgramState::Error));
+    ASSERT_EQ(cfg::ProgramState::Finish, expected.back().programState);
+    EXPECT_EQ(m_per_sec_t(0), log.frames.back().car.speed);
+
+    const RaceTrackReplay replay(testTrackSegments, testTrackProfile);
+    const RaceTrackReplay::Trace trace = replay.run(log);
+    ASSERT_EQ(expected.size(), trace.size());
+
+    const RaceTrackReplay::DiffResult result = RaceTrackReplay::diff(trace, expected, RaceTrackReplay::Tolerances{ m_per_sec_t(0), millimeter_t(0), radian_t(0), 0.0f });
+    EXPECT_EQ(expected.size(), result.numCompared);
+    EXPECT_EQ(0, result.numMismatches);
+}
+
+TEST(raceTrackReplay, log_write_read) {
+    RaceTrackReplay::Trace expected;
+    const RaceTrackReplay::Log log = recordLog(expected);
+
+    std::stringstream stream;
+    RaceTrackReplay::write(stream, log);
+
+    RaceTrackReplay::Log readLog;
+    ASSERT_TRUE(RaceTrackReplay::read(stream, readLog));
+    EXPECT_EQ(log.programState, readLog.programState);
+    EXPECT_EQ(log.safetyCarFollowSpeedSign, readLog.safetyCarFollowSpeedSign);
+    ASSERT_EQ(log.frames.size(), readLog.frames.size());
+
+    const RaceTrackReplay replay(testTrackSegments, testTrackProfile);
+    const RaceTrackReplay::DiffResult result = RaceTrackReplay::diff(replay.run(readLog), expected);
+    EXPECT_EQ(0, result.numMismatches);
+
+    std::stringstream invalid("race_track_trace 0");
+    EXPECT_FALSE(RaceTrackReplay::read(invalid, readLog));
+}
+
+TEST(raceTrackReplay, decimated_golden_trace) {
+    RaceTrackReplay::Trace trace;
+    recordLog(trace);
+
+    std::stringstream stream;
+    RaceTrackReplay::write(stream, trace, 100);
+
+    RaceTrackReplay::Trace golden;
+    ASSERT_TRUE(RaceTrackReplay::read(stream, golden));
+    EXPECT_LT(golden.size(), trace.size() / 50);
+
+    // the rows of the program state changes are kept
+    for (uint32_t i = 1; i < trace.size(); ++i) {
+        if (trace[i].programState != trace[i - 1].programState) {
+            EXPECT_TRUE(std::any_of(golden.begin(), golden.end(), [&trace, i](const RaceTrackReplay::TraceRow& row) { return row.frame == trace[i].frame; }));
+        }
+    }
+
+    RaceTrackReplay::DiffResult result = RaceTrackReplay::diff(trace, golden);
+    EXPECT_EQ(golden.size(), result.numCompared);
+    EXPECT_EQ(0, result.numMismatches);
+
+    golden[golden.size() / 2].controlData.speed += m_per_sec_t(0.01f);
+    golden.back().programState = cfg::ProgramState::Error;
+    result = RaceTrackReplay::diff(trace, golden);
+    EXPECT_EQ(2, result.numMismatches);
+    EXPECT_EQ(golden[golden.size() / 2].frame, result.firstMismatch);
+}
+
+TEST(raceTrackReplay, detects_changed_behaviour) {
+    RaceTrackReplay::Trace golden;
+    RaceTrackReplay::Log log = recordLog(golden);
+
+    // a missed brake pattern in the fourth lap keeps the car in the fast segment
+    const std::vector<RaceTrackReplay::Frame>::iterator brakeStart = std::find_if(
+        log.frames.begin() + log.frames.size() * 3 / 4, log.frames.end(), [](const RaceTrackReplay::Frame& frame) {
+            return LinePattern::BRAKE == frame.lineInfo.front.pattern.type;
+        });
+    ASSERT_NE(log.frames.end(), brakeStart);
+
+    const uint32_t brakeFrame = static_cast<uint32_t>(std::distance(log.frames.begin(), brakeStart));
+    for (std::vector<RaceTrackReplay::Frame>::iterator it = brakeStart; it != log.frames.end() && LinePattern::BRAKE == it->lineInfo.front.pattern.type; ++it) {
+        it->lineInfo.front.pattern.type = LinePattern::SINGLE_LINE;
+    }
+
+    const RaceTrackReplay replay(testTrackSegments, testTrackProfile);
+    const RaceTrackReplay::DiffResult result = RaceTrackReplay::diff(replay.run(log), golden);
+    EXPECT_GT(result.numMismatches, 0);
+    EXPECT_GE(result.firstMismatch, brakeFrame);
+}
+
+TEST(raceTrackReplay, benchmark) {
+    RaceTrackReplay::Trace expected;
+    const RaceTrackReplay::Log log = recordLog(expected);
+    const RaceTrackReplay replay(testTrackSegments, testTrackProfile);
+
+    RaceTrackReplay::Trace trace;
+    const double time_us = benchmark(3, [&replay, &log, &trace]() {
+        trace = replay.run(log);
+    });
+
+    printBenchmark("RaceTrackReplay::run (6 laps)", time_us);
+    EXPECT_EQ(expected.size(), trace.size());
+}
@@ -0,0 +1,161 @@
+#include <micro/math/numeric.hpp>
+#include <micro/test/utils.hpp>
+
+#include <benchmark.hpp>
+#include <RacingLineOptimizer.hpp>
+#include <test_track_geometry.hpp>
+#include <track.hpp>
+
+#include <sstream>
+
+using namespace micro;
+
+namespace {
+
+constexpr meter_t RECORD_STEP = centimeter_t(1);
+
+/* @brief Records a lap of a track that consists of constant-curvature segments.
+ */
+void recordTrack(TrackMap& map, const TrackSegments& segments, const float turnAngles[]) {
+    Pose pose;
+    pose.pos   = { meter_t(0), meter_t(0) };
+    pose.angle = radian_t(0);
+    meter_t dist(0);
+
+    for (uint32_t s = 0; s < segments.size(); ++s) {
+        const float curvature = segmentCurvature(segments, turnAngles, s);
+
+        for (meter_t segDist(0); segDist < segments[s].length; segDist += RECORD_STEP) {
+            map.record(dist, pose, millimeter_t(0), LinePattern::SINGLE_LINE);
+            advancePose(pose, curvature, RECORD_STEP);
+            dist += RECORD_STEP;
+        }
+    }
+}
+
+second_t centerLineLapTime(const TrackMap& map, const TrackSegments& segments) {
+    RacingLineOptimizer::Options options;
+    options.maxOffset = meter_t(0);
+
+    RacingLineOptimizer optimizer(options);
+    optimizer.optimize(map, segments);
+    return optimizer.lapTime();
+}
+
+} // namespace
+
+TEST(racingLineOptimizer, invalid) {
+    TrackMap map;
+    RacingLineOptimizer optimizer;
+    EXPECT_EQ(Status::INVALID_DATA, optimizer.optimize(map, testTrackSegments));
+
+    recordTrack(map, testTrackSegments, TEST_TRACK_TURN_ANGLES);
+    EXPECT_EQ(Status::INVALID_DATA, optimizer.optimize(map, TrackSegments{}));
+}
+
+TEST(racingLineOptimizer, circle) {
+    const TrackSegments segments = {
+        { false, meter_t(2 * PI.get()), TrackTrigger::Distance, {}, {} }
+    };
+    constexpr float TURN_ANGLES[] = { 360 };
+
+    TrackMap map;
+    recordTrack(map, segments, TURN_ANGLES);
+
+    RacingLineOptimizer optimizer;
+    ASSERT_EQ(Status::OK, optimizer.optimize(map, segments));
+
+    // the lap time of a circle is proportional to the square root of the radius, so the car goes on the inside (left)
+    for (const RacingLineOptimizer::Point& point : optimizer.points()) {
+        EXPECT_NEAR_UNIT(cfg::RACE_LINE_MAX_OFFSET, point.offset, centimeter_t(1));
+    }
+    EXPECT_LT(optimizer.lapTime(), centerLineLapTime(map, segments));
+}
+
+TEST(racingLineOptimizer, test_track) {
+    TrackMap map;
+    recordTrack(map, testTrackSegments, TEST_TRACK_TURN_ANGLES);
+
+    RacingLineOptimizer optimizer;
+    ASSERT_EQ(Status::OK, optimizer.optimize(map, testTrackSegments));
+    ASSERT_EQ(testTrackSegments.size(), optimizer.segments().size());
+
+    const std::vector<RacingLineOptimizer::Point>& points = optimizer.points();
+    for (uint32_t i = 0; i < points.size(); ++i) {
+        const RacingLineOptimizer::Point& point = points[i];
+        const RacingLineOptimizer::Point& next  = points[(i + 1) % points.size()];
+        const float v = point.speed.get(), vNext = next.speed.get();
+
+        EXPECT_LE(abs(point.offset), cfg::RACE_LINE_MAX_OFFSET + millimeter_t(0.1f));
+        EXPECT_LE(point.speed, cfg::CAR_MAX_SPEED);
+        EXPECT_LE(v * v * std::abs(point.curvature), cfg::CAR_MAX_LATERAL_ACCELERATION * 1.001f);
+
+        // the distance of the points on the path is at most 25% longer than on the line
+        EXPECT_LE(vNext * vNext - v * v, 2 * cfg::CAR_MAX_ACCELERATION * 0.25f);
+        EXPECT_LE(v * v - vNext * vNext, 2 * cfg::CAR_MAX_DECELERATION * 0.25f);
+    }
+
+    const std::vector<RacingLineOptimizer::SegmentResult>& segments = optimizer.segments();
+    m_per_sec_t minSpeed = cfg::CAR_MAX_SPEED;
+    for (uint32_t s = 0; s < segments.size(); ++s) {
+        if (testTrackSegments[s].isFast) {
+            EXPECT_EQ(cfg::CAR_MAX_SPEED, segments[s].speed);
+        }
+        EXPECT_LE(abs(segments[s].raceLine.angle.middle), cfg::MAX_TARGET_LINE_ANGLE);
+        EXPECT_LE(abs(segments[s].raceLine.angle.end), cfg::MAX_TARGET_LINE_ANGLE);
+        minSpeed = std::min(minSpeed, segments[s].speed);
+    }
+
+    // the roundabout of the second section is the slowest part of the track, the car cuts it on the inside (left) - the line is on its right
+    EXPECT_EQ(minSpeed, std::min(segments[6].speed, segments[7].speed));
+    EXPECT_LT(segments[6].raceLine.pos.end, millimeter_t(-50));
+
+    // the car brakes for the first bend in the brake segment
+    EXPECT_GT(segments[1].brakeOffset, meter_t(0));
+    EXPECT_LT(segments[1].brakeOffset, testTrackSegments[1].length);
+    EXPECT_EQ(segments[1].brakeOffset, optimizer.brakeOffsets()[0]);
+
+    // regression values of the test track
+    const second_t centerLapTime = centerLineLapTime(map, testTrackSegments);
+    EXPECT_NEAR_UNIT(second_t(15.40f), centerLapTime, millisecond_t(20));
+    EXPECT_NEAR_UNIT(second_t(13.40f), optimizer.lapTime(), millisecond_t(20));
+    EXPECT_LT(optimizer.lapTime(), centerLapTime * 0.95f);
+}
+
+TEST(racingLineOptimizer, writeSource) {
+    TrackMap map;
+    recordTrack(map, testTrackSegments, TEST_TRACK_TURN_ANGLES);
+
+    RacingLineOptimizer optimizer;
+    ASSERT_EQ(Status::OK, optimizer.optimize(map, testTrackSegments));
+
+    std::ostringstream out;
+    optimizer.writeSource(out, "test");
+    const std::string source = out.str();
+
+    uint32_t numLines = 0;
+    for (size_t pos = source.find("constexpr TrackLineProfile LINE_"); pos != std::string::npos; pos = source.find("constexpr TrackLineProfile LINE_", pos + 1)) {
+        ++numLines;
+    }
+    EXPECT_EQ(testTrackSegments.size(), numLines);
+
+    // the constants are named after the sections of the test track, as in test_track.cpp
+    EXPECT_NE(std::string::npos, source.find("constexpr TrackLineProfile LINE_FAST1_RACE "));
+    EXPECT_NE(std::string::npos, source.find("constexpr TrackLineProfile LINE_SLOW2_5_RACE "));
+    EXPECT_NE(std::string::npos, source.find("// raceLine column of the segment table\n//  LINE_FAST1_RACE,\n//  LINE_SLOW1_1_RACE,\n"));
+
+    EXPECT_NE(std::string::npos, source.find("// speeds\n    { { 7.00f },"));
+    EXPECT_NE(std::string::npos, source.find("// brake offsets\n    { centimeter_t("));
+}
+
+TEST(racingLineOptimizer, benchmark) {
+    TrackMap map;
+    recordTrack(map, testTrackSegments, TEST_TRACK_TURN_ANGLES);
+
+    RacingLineOptimizer optimizer;
+    const double time_us = benchmark(3, [&optimizer, &map]() {
+        optimizer.optimize(map, testTrackSegments);
+    });
+
+    printBenchmark("RacingLineOptimizer::optimize (test track)", time_us);
+}
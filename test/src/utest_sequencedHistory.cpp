@@ -0,0 +1,74 @@
+#include <micro/test/utils.hpp>
+
+#include <SequencedHistory.hpp>
+
+TEST(sequencedHistory, push_read) {
+    SequencedHistory<int, 4> history;
+    EXPECT_EQ(0, history.sequence());
+    EXPECT_EQ(0, history.latest());
+
+    history.push(1);
+    history.push(2);
+    EXPECT_EQ(2, history.sequence());
+    EXPECT_EQ(2, history.latest());
+    EXPECT_EQ(1, history[1]);
+
+    // the producer writes the next value in place, it is only visible after publishing
+    history.next() = 3;
+    EXPECT_EQ(2, history.sequence());
+    EXPECT_EQ(2, history.latest());
+
+    history.publish();
+    EXPECT_EQ(3, history.sequence());
+    EXPECT_EQ(3, history.latest());
+}
+
+TEST(sequencedHistory, is_valid) {
+    SequencedHistory<int, 4> history;
+
+    const uint32_t seq = history.sequence();
+    const int& value   = history[seq];
+
+    history.push(1);
+    history.push(2);
+    EXPECT_TRUE(history.isValid(seq));
+    EXPECT_EQ(0, value);
+
+    // the slot of the value is the next slot to be written by the producer
+    history.push(3);
+    EXPECT_FALSE(history.isValid(seq));
+
+    history.push(4);
+    EXPECT_FALSE(history.isValid(seq));
+    EXPECT_EQ(4, value);
+}
+
+TEST(sequencedHistory, read) {
+    SequencedHistory<int, 4> history;
+    history.push(1);
+
+    const uint32_t seq = history.sequence();
+    int value = 0;
+    EXPECT_TRUE(history.read(seq, value));
+    EXPECT_EQ(1, value);
+
+    // the copy is not affected by the producer
+    history.push(2);
+    history.push(3);
+    history.push(4);
+    EXPECT_EQ(1, value);
+
+    // the value has been overwritten
+    EXPECT_FALSE(history.read(seq, value));
+}
+
+TEST(sequencedHistory, sequence_overflow) {
+    SequencedHistory<int, 4> history;
+
+    for (int i = 1; i <= 10; ++i) {
+        history.push(i);
+        EXPECT_EQ(i, history.latest());
+        EXPECT_EQ(i - 1, history[history.sequence() - 1]);
+        EXPECT_TRUE(history.isValid(history.sequence() - 2));
+    }
+}
@@ -1,13 +1,14 @@
 #include <micro/test/utils.hpp>
 
 #include <cfg_car.hpp>
+#include <cfg_track.hpp>
 #include <RaceTrackInfo.hpp>
 #include <track.hpp>
 
 using namespace micro;
 
 TEST(raceTrackInfo, test) {
-    RaceTrackInfo trackInfo(testTrackSegments);
+    RaceTrackInfo trackInfo(testTrackSegments, testTrackProfile);
     trackInfo.lap = 1;
     trackInfo.seg = trackInfo.segments.begin();
 
@@ -95,3 +96,94 @@ TEST(raceTrackInfo, test) {
 
     EXPECT_EQ(2, trackInfo.lap);
 }
+
+namespace {
+
+RaceTrackInfo startSegment(const uint8_t lap, const uint32_t segIdx) {
+    RaceTrackInfo trackInfo(testTrackSegments, testTrackProfile);
+    trackInfo.lap = lap;
+    trackInfo.seg = trackInfo.segments.begin() + segIdx;
+    trackInfo.segStartCarProps.distance = meter_t(0);
+    trackInfo.segStartControlData.lineControl.target = { millimeter_t(0), radian_t(0) };
+    return trackInfo;
+}
+
+CarProps carAtDistance(const meter_t distance) {
+    CarProps car;
+    car.distance = distance;
+    car.speed    = m_per_sec_t(1);
+    return car;
+}
+
+} // namespace
+
+TEST(raceTrackInfo, control_fast) {
+    RaceTrackInfo trackInfo = startSegment(4, 0);
+    MainLine mainLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
+    LineInfo lineInfo;
+    const CarProps car = carAtDistance(meter_t(1));
+
+    ControlData controlData = trackInfo.control(car, mainLine);
+    EXPECT_NEAR_UNIT(m_per_sec_t(3), controlData.speed, m_per_sec_t(0.001f));
+    EXPECT_EQ(millisecond_t(1000), controlData.rampTime);
+    EXPECT_FALSE(controlData.rearSteerEnabled);
+    EXPECT_EQ(millimeter_t(0), controlData.lineControl.target.pos);
+
+    // falls back to a safe speed when the car gets far from the line
+    mainLine.centerLine.pos = centimeter_t(15);
+    trackInfo.update(car, lineInfo, mainLine, controlData);
+    EXPECT_EQ(testTrackSegments.begin(), trackInfo.seg);
+    EXPECT_NEAR_UNIT(m_per_sec_t(2), trackInfo.control(car, mainLine).speed, m_per_sec_t(0.001f));
+}
+
+TEST(raceTrackInfo, missed_brake_sign) {
+    RaceTrackInfo trackInfo = startSegment(4, 0);
+    const MainLine mainLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
+    const LineInfo lineInfo;
+    const ControlData controlData;
+
+    // the brake sign of the first braking segment is mapped at the end of the first fast segment
+    for (meter_t dist = meter_t(0); dist < meter_t(12); dist += centimeter_t(1)) {
+        trackInfo.trackMap.record(dist, { { dist, meter_t(0) }, radian_t(0) }, millimeter_t(0),
+            dist >= testTrackSegments[0].length ? LinePattern::BRAKE : LinePattern::SINGLE_LINE);
+    }
+
+    // the car keeps the fast segment until it gets far enough from the mapped sign
+    CarProps car = carAtDistance(testTrackSegments[0].length + cfg::RACE_MISSED_BRAKE_SIGN_DIST / 2);
+    trackInfo.update(millisecond_t(0), car, lineInfo, mainLine, controlData);
+    EXPECT_EQ(testTrackSegments.begin(), trackInfo.seg);
+
+    car = carAtDistance(testTrackSegments[0].length + cfg::RACE_MISSED_BRAKE_SIGN_DIST + centimeter_t(10));
+    trackInfo.update(millisecond_t(0), car, lineInfo, mainLine, controlData);
+    EXPECT_EQ(testTrackSegments.begin() + 1, trackInfo.seg);
+}
+
+TEST(raceTrackInfo, control_brake) {
+    const RaceTrackInfo trackInfo = startSegment(4, 1);
+    const MainLine mainLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
+
+    // keeps the fast speed of the previous segment until the brake offset
+    ControlData controlData = trackInfo.control(carAtDistance(meter_t(0)), mainLine);
+    EXPECT_NEAR_UNIT(m_per_sec_t(3), controlData.speed, m_per_sec_t(0.001f));
+    EXPECT_EQ(millisecond_t(1000), controlData.rampTime);
+    EXPECT_TRUE(controlData.rearSteerEnabled);
+
+    controlData = trackInfo.control(carAtDistance(centimeter_t(10)), mainLine);
+    EXPECT_NEAR_UNIT(m_per_sec_t(2), controlData.speed, m_per_sec_t(0.001f));
+}
+
+TEST(raceTrackInfo, control_line_profiles) {
+    const MainLine mainLine(cfg::CAR_FRONT_REAR_SENSOR_ROW_DIST);
+
+    // constant profile in the safety car laps
+    ControlData controlData = startSegment(1, 6).control(carAtDistance(centimeter_t(20)), mainLine);
+    EXPECT_NEAR_UNIT(m_per_sec_t(1.2f), controlData.speed, m_per_sec_t(0.001f));
+    EXPECT_EQ(millisecond_t(100), controlData.rampTime);
+    EXPECT_NEAR_UNIT(centimeter_t(5), controlData.lineControl.target.pos, millimeter_t(0.1f));
+    EXPECT_NEAR_UNIT(degree_t(-15), controlData.lineControl.target.angle, degree_t(0.1f));
+
+    // linear profile in the race laps
+    controlData = startSegment(4, 6).control(carAtDistance(testTrackSegments[6].length / 2), mainLine);
+    EXPECT_NEAR_UNIT(centimeter_t(6), controlData.lineControl.target.pos, millimeter_t(0.1f));
+    EXPECT_NEAR_UNIT(radian_t(0), controlData.lineControl.target.angle, degree_t(0.1f));
+}
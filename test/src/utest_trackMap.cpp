@@ -0,0 +1,131 @@
+#include <micro/math/numeric.hpp>
+#include <micro/test/utils.hpp>
+
+#include <TrackMap.hpp>
+#include <TrackMapDump.hpp>
+
+#include <sstream>
+
+using namespace micro;
+
+namespace {
+
+constexpr meter_t STRAIGHT_LENGTH = meter_t(4);
+constexpr meter_t ARC_RADIUS      = meter_t(1.5f);
+
+/* @brief Gets the pose on a path that consists of a straight in the X direction and a left arc.
+ */
+Pose pathPose(const meter_t dist) {
+    Pose pose;
+    if (dist <= STRAIGHT_LENGTH) {
+        pose.pos   = { dist, meter_t(0) };
+        pose.angle = radian_t(0);
+    } else {
+        const radian_t arcAngle = radian_t((dist - STRAIGHT_LENGTH) / ARC_RADIUS);
+        pose.pos   = { STRAIGHT_LENGTH + ARC_RADIUS * std::sin(arcAngle.get()), ARC_RADIUS * (1.0f - std::cos(arcAngle.get())) };
+        pose.angle = normalize360(arcAngle);
+    }
+    return pose;
+}
+
+LinePattern::type_t pathPattern(const meter_t dist) {
+    return dist >= meter_t(3) && dist < meter_t(3.5f) ? LinePattern::BRAKE : LinePattern::SINGLE_LINE;
+}
+
+void recordPath(TrackMap& map, const meter_t length, const meter_t step) {
+    for (meter_t dist = meter_t(0); dist <= length; dist += step) {
+        map.record(dist, pathPose(dist), centimeter_t(3), pathPattern(dist));
+    }
+}
+
+} // namespace
+
+TEST(trackMap, empty) {
+    TrackMap map;
+    EXPECT_EQ(0, map.size());
+    EXPECT_EQ(meter_t(0), map.length());
+}
+
+TEST(trackMap, straight_and_arc) {
+    TrackMap map;
+    recordPath(map, meter_t(12), millimeter_t(10));
+
+    EXPECT_NEAR_UNIT(meter_t(12), map.length(), centimeter_t(8));
+
+    for (uint32_t i = 0; i < map.size(); ++i) {
+        const meter_t sampleDist = TrackMap::SAMPLE_DIST * static_cast<float>(i);
+        const TrackMap::Sample sample = map.at(sampleDist + centimeter_t(1));
+        const Pose expected = pathPose(sampleDist);
+        EXPECT_NEAR_UNIT(expected.pos.X, sample.pose.pos.X, centimeter_t(1));
+        EXPECT_NEAR_UNIT(expected.pos.Y, sample.pose.pos.Y, centimeter_t(1));
+        EXPECT_TRUE(eqWithOverflow360(expected.angle, sample.pose.angle, degree_t(1)));
+        EXPECT_NEAR_UNIT(centimeter_t(3), sample.linePos, millimeter_t(1));
+    }
+
+    EXPECT_NEAR(0.0f, map.at(meter_t(2)).curvature, 0.05f);
+    EXPECT_NEAR(1.0f / ARC_RADIUS.get(), map.at(meter_t(6)).curvature, 0.05f);
+    EXPECT_NEAR(1.0f / ARC_RADIUS.get(), map.at(meter_t(11)).curvature, 0.05f);
+}
+
+TEST(trackMap, interpolates_skipped_samples) {
+    TrackMap map;
+    recordPath(map, meter_t(8), centimeter_t(30));
+
+    for (uint32_t i = 0; i < map.size(); ++i) {
+        const meter_t sampleDist = TrackMap::SAMPLE_DIST * static_cast<float>(i);
+        const TrackMap::Sample sample = map.at(sampleDist + centimeter_t(1));
+        const Pose expected = pathPose(sampleDist);
+        EXPECT_NEAR_UNIT(expected.pos.X, sample.pose.pos.X, centimeter_t(2));
+        EXPECT_NEAR_UNIT(expected.pos.Y, sample.pose.pos.Y, centimeter_t(2));
+    }
+}
+
+TEST(trackMap, stops_when_full) {
+    TrackMap map;
+    recordPath(map, meter_t(100), centimeter_t(5));
+
+    EXPECT_EQ(TrackMap::CAPACITY, map.size());
+    EXPECT_NEAR_UNIT(TrackMap::SAMPLE_DIST * static_cast<float>(TrackMap::CAPACITY - 1), map.length(), millimeter_t(1));
+}
+
+TEST(trackMap, reset) {
+    TrackMap map;
+    recordPath(map, meter_t(5), millimeter_t(10));
+    map.reset();
+    EXPECT_EQ(0, map.size());
+
+    map.record(meter_t(0), pathPose(meter_t(6)), centimeter_t(-5), LinePattern::ACCELERATE);
+    EXPECT_EQ(1, map.size());
+    EXPECT_NEAR_UNIT(pathPose(meter_t(6)).pos.X, map.at(meter_t(0)).pose.pos.X, millimeter_t(1));
+    EXPECT_EQ(LinePattern::ACCELERATE, map.at(meter_t(0)).pattern);
+}
+
+TEST(trackMap, dump_and_load) {
+    TrackMap map;
+    recordPath(map, meter_t(12), millimeter_t(10));
+
+    // the dumped lines are loaded from the debug channel output, between the other messages
+    std::ostringstream out;
+    out << "[I] Lap 3 finished (time: 20.000000 seconds)\n";
+    TrackMapDump::write(out, map);
+    out << "[I] Track map dumped\n";
+
+    TrackMap loaded;
+    std::istringstream in(out.str());
+    ASSERT_TRUE(TrackMapDump::read(in, loaded));
+    ASSERT_EQ(map.size(), loaded.size());
+
+    for (uint32_t i = 0; i < map.size(); ++i) {
+        const meter_t sampleDist = TrackMap::SAMPLE_DIST * static_cast<float>(i) + centimeter_t(1);
+        const TrackMap::Sample expected = map.at(sampleDist);
+        const TrackMap::Sample sample = loaded.at(sampleDist);
+        EXPECT_NEAR_UNIT(expected.pose.pos.X, sample.pose.pos.X, millimeter_t(1));
+        EXPECT_NEAR_UNIT(expected.pose.pos.Y, sample.pose.pos.Y, millimeter_t(1));
+        EXPECT_TRUE(eqWithOverflow360(expected.pose.angle, sample.pose.angle, degree_t(0.5f)));
+        EXPECT_NEAR_UNIT(expected.linePos, sample.linePos, millimeter_t(2));
+        EXPECT_EQ(expected.pattern, sample.pattern);
+    }
+
+    std::istringstream empty("[I] Track map dumped\n");
+    EXPECT_FALSE(TrackMapDump::read(empty, loaded));
+}
@@ -0,0 +1,44 @@
+#include <LatencyHistogramDecoder.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+/* @brief Prints the latency histograms of the control pipeline from the debug channel output of the car.
+ * Reads the debug channel output from the standard input, and prints the histograms of the last params message that contains all of them.
+ * Usage: latency_decoder < debug.log
+ */
+int main() {
+    LatencyHistogram histograms[LatencyHistogramDecoder::NUM_STAGES];
+    bool isFound = false;
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        LatencyHistogram decoded[LatencyHistogramDecoder::NUM_STAGES];
+        bool isComplete = true;
+        for (uint32_t i = 0; i < LatencyHistogramDecoder::NUM_STAGES && isComplete; ++i) {
+            isComplete = LatencyHistogramDecoder::decode(line, LatencyHistogramDecoder::STAGES[i].name, decoded[i]);
+        }
+
+        if (isComplete) {
+            std::copy(std::begin(decoded), std::end(decoded), std::begin(histograms));
+            isFound = true;
+        }
+    }
+
+    if (!isFound) {
+        std::fprintf(stderr, "No latency histograms found in the input\n");
+        return 1;
+    }
+
+    std::printf("%-24s %8s %8s %8s %8s %8s  [us]\n", "stage", "samples", "p50 <", "p90 <", "p99 <", "max");
+    for (uint32_t i = 0; i < LatencyHistogramDecoder::NUM_STAGES; ++i) {
+        const LatencyHistogram& histogram = histograms[i];
+        std::printf("%-24s %8u %8.0f %8.0f %8.0f %8.0f\n", LatencyHistogramDecoder::STAGES[i].label, histogram.numSamples(),
+            histogram.percentile(0.5f).get(), histogram.percentile(0.9f).get(), histogram.percentile(0.99f).get(), histogram.max().get());
+    }
+
+    return 0;
+}
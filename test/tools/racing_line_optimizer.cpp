@@ -0,0 +1,49 @@
+#include <RacingLineOptimizer.hpp>
+#include <TrackMapDump.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/* @brief Optimizes the race line of a track from a track map recorded on the car, and prints it as C++ source.
+ * The map is read from the debug channel output of the car, @see TrackMapDump
+ * Usage: racing_line_optimizer <test|race> [debug.log]
+ */
+int main(int argc, char *argv[]) {
+    const TrackSegments *segments = nullptr;
+    if (argc >= 2 && 0 == std::strcmp(argv[1], "test")) {
+        segments = &testTrackSegments;
+    } else if (argc >= 2 && 0 == std::strcmp(argv[1], "race")) {
+        segments = &raceTrackSegments;
+    }
+
+    if (!segments || argc > 3) {
+        std::fprintf(stderr, "Usage: %s <test|race> [debug.log]\n", argv[0]);
+        return 1;
+    }
+
+    TrackMap map;
+    bool isLoaded = false;
+    if (3 == argc) {
+        std::ifstream in(argv[2]);
+        isLoaded = TrackMapDump::read(in, map);
+    } else {
+        isLoaded = TrackMapDump::read(std::cin, map);
+    }
+
+    if (!isLoaded) {
+        std::fprintf(stderr, "No complete track map found in the input\n");
+        return 1;
+    }
+
+    RacingLineOptimizer optimizer;
+    if (micro::Status::OK != optimizer.optimize(map, *segments)) {
+        std::fprintf(stderr, "Race line optimization failed\n");
+        return 1;
+    }
+
+    std::fprintf(stderr, "Track map: %u samples (%.2f m), lap time: %.3f s\n", map.size(), map.length().get(), optimizer.lapTime().get());
+    optimizer.writeSource(std::cout, argv[1]);
+    return 0;
+}